@@ -1,5 +1,21 @@
 #include "MillisTaskManager.h"
 
+#if MTM_USE_STAT
+#  include "Print.h"
+#  ifndef MTM_GET_CYCLE
+#    include "mcu_type.h"
+#    define MTM_GET_CYCLE()     (DWT->CYCCNT)
+#    define MTM_CYCLE_INIT()    do{CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk; DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;}while(0)
+#  endif
+#endif
+
+#define TASK_QUEUE_NONE     0
+#define TASK_QUEUE_TIMER    1
+#define TASK_QUEUE_READY    2
+#define TASK_QUEUE_RUNNING  3
+
+#define TASK_DEADLINE(task) ((task)->TimePoint + (task)->IntervalTime)
+
 /**
   * @brief  初始化任务列表
   * @param  TaskNum_MAX_Set:设定任务列表总长度
@@ -7,12 +23,26 @@
   */
 MillisTaskManager::MillisTaskManager(TaskNum_t TaskNum_MAX_Set)
 {
-    if(TaskList != 0) delete TaskList;//清空列表
     TaskList = new MillisTaskManager_TypeDef[TaskNum_MAX_Set];//为任务列表申请内存
+    TimerHeap.Item = new TaskNum_t[TaskNum_MAX_Set];
+    TimerHeap.Count = 0;
+    ReadyHeap.Item = new TaskNum_t[TaskNum_MAX_Set];
+    ReadyHeap.Count = 0;
     TaskNum_MAX = TaskNum_MAX_Set;//记录任务列表总长度
+    TimeSeed = 0;
+
+#if MTM_USE_STAT
+    TaskStat = new TaskStat_TypeDef[TaskNum_MAX_Set];
+    MTM_CYCLE_INIT();
+    TaskStatReset();
+#endif
 
     for(TaskNum_t i = 0; i < TaskNum_MAX; i++)//初始化任务列表，清零
+    {
+        TaskList[i].Queue = TASK_QUEUE_NONE;
+        TaskList[i].HeapIndex = 0;
         TaskClear(i);
+    }
 }
 
 /**
@@ -22,7 +52,12 @@ MillisTaskManager::MillisTaskManager(TaskNum_t TaskNum_MAX_Set)
   */
 MillisTaskManager::~MillisTaskManager()
 {
-    if(TaskList != 0) delete TaskList;
+    delete[] TaskList;
+    delete[] TimerHeap.Item;
+    delete[] ReadyHeap.Item;
+#if MTM_USE_STAT
+    delete[] TaskStat;
+#endif
 }
 
 /**
@@ -34,15 +69,164 @@ void MillisTaskManager::TaskClear(TaskNum_t ID)
 {
     TaskList[ID].Function = 0;
     TaskList[ID].State = false;
+    TaskList[ID].OneShot = false;
+    TaskList[ID].Priority = 0;
     TaskList[ID].IntervalTime = 0;
     TaskList[ID].TimePoint = 0;
+    TaskUpdate(ID);
+#if MTM_USE_STAT
+    TaskStatClear(ID);
+#endif
+}
+
+/**
+  * @brief  按任务当前状态重新加入队列(private)
+  * @param  ID:任务ID
+  * @retval 无
+  */
+void MillisTaskManager::TaskUpdate(TaskNum_t ID)
+{
+    MillisTaskManager_TypeDef* task = &TaskList[ID];
+    TaskHeap_TypeDef* heap = &TimerHeap;
+
+    if(task->Queue == TASK_QUEUE_RUNNING)//正在执行，执行完成后再处理
+        return;
+
+    if(task->Queue != TASK_QUEUE_NONE)
+    {
+        heap = (task->Queue == TASK_QUEUE_READY) ? &ReadyHeap : &TimerHeap;//本轮已到期的任务留在本轮
+        HeapRemove(heap, task->HeapIndex);
+    }
+
+    if(task->Function && task->State)
+        HeapInsert(heap, ID);
+}
+
+/**
+  * @brief  比较两个任务的先后(private)
+  * @param  A:任务ID
+  * @param  B:任务ID
+  * @param  Ready:true:按优先级优先比较 ; false:按触发时间优先比较
+  * @retval true:A在B之前
+  */
+bool MillisTaskManager::TaskBefore(TaskNum_t A, TaskNum_t B, bool Ready)
+{
+    const MillisTaskManager_TypeDef* a = &TaskList[A];
+    const MillisTaskManager_TypeDef* b = &TaskList[B];
+    int32_t diff = (int32_t)(TASK_DEADLINE(a) - TASK_DEADLINE(b));
+
+    if(Ready && a->Priority != b->Priority)
+        return a->Priority > b->Priority;
+
+    if(diff != 0)
+        return diff < 0;
+
+    if(a->Priority != b->Priority)
+        return a->Priority > b->Priority;
+
+    return A < B;
+}
+
+/**
+  * @brief  设置堆中的一个位置(private)
+  * @param  Heap:堆
+  * @param  Index:位置
+  * @param  ID:任务ID
+  * @retval 无
+  */
+void MillisTaskManager::HeapSet(TaskHeap_TypeDef* Heap, TaskNum_t Index, TaskNum_t ID)
+{
+    Heap->Item[Index] = ID;
+    TaskList[ID].HeapIndex = Index;
+}
+
+/**
+  * @brief  向上调整堆(private)
+  * @param  Heap:堆
+  * @param  Index:位置
+  * @retval 无
+  */
+void MillisTaskManager::HeapSiftUp(TaskHeap_TypeDef* Heap, TaskNum_t Index)
+{
+    bool ready = (Heap == &ReadyHeap);
+    TaskNum_t id = Heap->Item[Index];
+
+    while(Index > 0)
+    {
+        TaskNum_t parent = (Index - 1) / 2;
+        if(!TaskBefore(id, Heap->Item[parent], ready))
+            break;
+        HeapSet(Heap, Index, Heap->Item[parent]);
+        Index = parent;
+    }
+    HeapSet(Heap, Index, id);
+}
+
+/**
+  * @brief  向下调整堆(private)
+  * @param  Heap:堆
+  * @param  Index:位置
+  * @retval 无
+  */
+void MillisTaskManager::HeapSiftDown(TaskHeap_TypeDef* Heap, TaskNum_t Index)
+{
+    bool ready = (Heap == &ReadyHeap);
+    TaskNum_t id = Heap->Item[Index];
+
+    for(;;)
+    {
+        uint16_t child = (uint16_t)Index * 2 + 1;
+        if(child >= Heap->Count)
+            break;
+        if(child + 1 < Heap->Count && TaskBefore(Heap->Item[child + 1], Heap->Item[child], ready))
+            child++;
+        if(!TaskBefore(Heap->Item[child], id, ready))
+            break;
+        HeapSet(Heap, Index, Heap->Item[child]);
+        Index = child;
+    }
+    HeapSet(Heap, Index, id);
+}
+
+/**
+  * @brief  任务加入堆(private)
+  * @param  Heap:堆
+  * @param  ID:任务ID
+  * @retval 无
+  */
+void MillisTaskManager::HeapInsert(TaskHeap_TypeDef* Heap, TaskNum_t ID)
+{
+    TaskNum_t index = Heap->Count++;
+    HeapSet(Heap, index, ID);
+    TaskList[ID].Queue = (Heap == &ReadyHeap) ? TASK_QUEUE_READY : TASK_QUEUE_TIMER;
+    HeapSiftUp(Heap, index);
+}
+
+/**
+  * @brief  从堆中移除任务(private)
+  * @param  Heap:堆
+  * @param  Index:任务在堆中的位置
+  * @retval 无
+  */
+void MillisTaskManager::HeapRemove(TaskHeap_TypeDef* Heap, TaskNum_t Index)
+{
+    TaskNum_t last = Heap->Item[--Heap->Count];
+
+    TaskList[Heap->Item[Index]].Queue = TASK_QUEUE_NONE;
+
+    if(Index < Heap->Count)
+    {
+        HeapSet(Heap, Index, last);
+        HeapSiftUp(Heap, Index);
+        HeapSiftDown(Heap, TaskList[last].HeapIndex);
+    }
 }
 
 /**
   * @brief  在任务列表内的一个位置注册一个任务，设定间隔执行时间
   * @param  ID:任务ID
   * @param  Function:任务函数指针
-  * @param  TimeSetMs:时间设定(毫秒)
+  * @param  TimeSetMs:时间设定(与Running传入的时钟单位相同)
   * @param  TaskState:任务开关
   * @retval true:成功 ; false:失败
   */
@@ -52,12 +236,34 @@ bool MillisTaskManager::TaskRegister(TaskNum_t ID, void_TaskFunction_t Function,
     {
         TaskList[ID].Function = Function;//注册函数指针
         TaskList[ID].State = TaskState;//初始状态设定
+        TaskList[ID].OneShot = false;
         TaskList[ID].IntervalTime = TimeSetMs;//注册时间
+        TaskList[ID].TimePoint = TimeSeed;//从上一次调度的时间开始计时
+        TaskUpdate(ID);
+#if MTM_USE_STAT
+        TaskStatClear(ID);
+#endif
         return true;//注册成功
     }
     else return false;//注册失败
 }
 
+/**
+  * @brief  注册一个单次任务，延时到达后执行一次并自动关闭，可用TaskStateCtrl再次开启
+  * @param  ID:任务ID
+  * @param  Function:任务函数指针
+  * @param  DelayTime:延时(与Running传入的时钟单位相同)
+  * @retval true:成功 ; false:失败
+  */
+bool MillisTaskManager::TaskRegisterOnce(TaskNum_t ID, void_TaskFunction_t Function, uint32_t DelayTime)
+{
+    if(!TaskRegister(ID, Function, DelayTime, true))
+        return false;
+
+    TaskList[ID].OneShot = true;
+    return true;
+}
+
 /**
   * @brief  寻找任务,返回任务注册地址
   * @param  Function:任务函数指针
@@ -134,10 +340,7 @@ bool MillisTaskManager::TaskStateCtrl(void_TaskFunction_t Function, bool TaskSta
 {
     TaskNum_t ID = 0;
     if(TaskFind(Function, &ID) == true)
-    {
-        TaskList[ID].State = TaskState;
-        return true;
-    }
+        return TaskStateCtrl(ID, TaskState);
     else
         return false;
 }
@@ -152,7 +355,10 @@ bool MillisTaskManager::TaskStateCtrl(TaskNum_t ID, bool TaskState)
 {
     if(ID < TaskNum_MAX)
     {
+        if(TaskState && !TaskList[ID].State)//重新开启，从上一次调度的时间开始计时
+            TaskList[ID].TimePoint = TimeSeed;
         TaskList[ID].State = TaskState;
+        TaskUpdate(ID);
         return true;
     }
     else
@@ -169,10 +375,7 @@ bool MillisTaskManager::TaskSetIntervalTime(void_TaskFunction_t Function, uint32
 {
     TaskNum_t ID = 0;
     if(TaskFind(Function, &ID) == true)
-    {
-        TaskList[ID].IntervalTime = TimeSetMs;
-        return true;
-    }
+        return TaskSetIntervalTime(ID, TimeSetMs);
     else
         return false;
 }
@@ -188,28 +391,238 @@ bool MillisTaskManager::TaskSetIntervalTime(TaskNum_t ID, uint32_t TimeSetMs)
     if(ID < TaskNum_MAX)
     {
         TaskList[ID].IntervalTime = TimeSetMs;
+        TaskUpdate(ID);
         return true;
     }
     else
         return false;
 }
 
+/**
+  * @brief  任务优先级设置，同一轮到期的任务按优先级从高到低执行
+  * @param  Function:任务函数指针
+  * @param  Priority:优先级，数值越大越优先
+  * @retval true:成功 ; false:失败
+  */
+bool MillisTaskManager::TaskSetPriority(void_TaskFunction_t Function, TaskPriority_t Priority)
+{
+    TaskNum_t ID = 0;
+    if(TaskFind(Function, &ID) == true)
+        return TaskSetPriority(ID, Priority);
+    else
+        return false;
+}
+
+/**
+  * @brief  任务优先级设置，同一轮到期的任务按优先级从高到低执行
+  * @param  ID:任务ID
+  * @param  Priority:优先级，数值越大越优先
+  * @retval true:成功 ; false:失败
+  */
+bool MillisTaskManager::TaskSetPriority(TaskNum_t ID, TaskPriority_t Priority)
+{
+    if(ID < TaskNum_MAX)
+    {
+        TaskList[ID].Priority = Priority;
+        TaskUpdate(ID);
+        return true;
+    }
+    else
+        return false;
+}
+
+/**
+  * @brief  获取距离下一个任务触发的时间，空闲时可据此休眠
+  * @param  MillisSeed:当前时钟
+  * @retval 剩余时间，0:已有任务到期 ; 0xFFFFFFFF:没有等待中的任务
+  */
+uint32_t MillisTaskManager::GetNextTaskTime(uint32_t MillisSeed)
+{
+    int32_t remain;
+
+    if(ReadyHeap.Count)
+        return 0;
+
+    if(!TimerHeap.Count)
+        return 0xFFFFFFFF;
+
+    remain = (int32_t)(TASK_DEADLINE(&TaskList[TimerHeap.Item[0]]) - MillisSeed);
+    return (remain > 0) ? remain : 0;
+}
+
 /**
   * @brief  调度器(内核)
-  * @param  MillisSeed:提供一个精确到毫秒的系统时钟变量
+  * @param  MillisSeed:提供一个系统时钟变量(millis()或micros())
   * @retval 无
   */
 void MillisTaskManager::Running(uint32_t MillisSeed)
 {
-    for(TaskNum_t i = 0; i < TaskNum_MAX; i++)//遍历任务列表
+    TimeSeed = MillisSeed;
+
+#if MTM_USE_STAT
+    uint32_t cycle = MTM_GET_CYCLE();
+    StatTotalCycles += (uint32_t)(cycle - StatLastCycle);
+    StatLastCycle = cycle;
+#endif
+
+    while(TimerHeap.Count)//取出所有到期任务
     {
-        if(TaskList[i].Function)//判断是否为空函数
+        TaskNum_t id = TimerHeap.Item[0];
+        if((int32_t)(MillisSeed - TASK_DEADLINE(&TaskList[id])) < 0)
+            break;
+        HeapRemove(&TimerHeap, 0);
+        HeapInsert(&ReadyHeap, id);
+    }
+
+    while(ReadyHeap.Count)//按优先级执行，每个任务每轮最多执行一次
+    {
+        TaskNum_t id = ReadyHeap.Item[0];
+        MillisTaskManager_TypeDef* task = &TaskList[id];
+        uint32_t timePoint = task->TimePoint;
+
+        HeapRemove(&ReadyHeap, 0);
+        task->Queue = TASK_QUEUE_RUNNING;
+        if(task->OneShot)
+            task->State = false;
+
+#if MTM_USE_STAT
+        TaskStat_TypeDef* stat = &TaskStat[id];
+        uint32_t late = MillisSeed - TASK_DEADLINE(task);
+        uint32_t start = MTM_GET_CYCLE();
+#endif
+
+        task->Function();//执行任务
+
+#if MTM_USE_STAT
+        uint32_t elapsed = MTM_GET_CYCLE() - start;
+        StatBusyCycles += elapsed;
+        stat->RunCount++;
+        stat->CycleSum += elapsed;
+        if(elapsed < stat->CycleMin)
+            stat->CycleMin = elapsed;
+        if(elapsed > stat->CycleMax)
+            stat->CycleMax = elapsed;
+        stat->LateLast = late;
+        if(late > stat->LateMax)
+            stat->LateMax = late;
+#endif
+
+        task->Queue = TASK_QUEUE_NONE;
+
+        if(!task->OneShot && task->TimePoint == timePoint)//执行期间未被重新设置
         {
-            if(TaskList[i].State && (MillisSeed - TaskList[i].TimePoint >= TaskList[i].IntervalTime))//判断是否运行任务，是否到达触发时间点
+            uint32_t interval = task->IntervalTime;
+            task->TimePoint += interval;//按间隔累加，不随执行延迟漂移
+
+            if((int32_t)(MillisSeed - TASK_DEADLINE(task)) >= 0)//落后超过一个周期，跳过错过的周期
             {
-                TaskList[i].TimePoint = MillisSeed;//标记下一个时间点
-                TaskList[i].Function();//执行任务
+#if MTM_USE_STAT
+                if(interval)
+                    stat->MissCount += (MillisSeed - task->TimePoint) / interval;
+#endif
+                task->TimePoint = (interval == 0)
+                                  ? MillisSeed
+                                  : MillisSeed - (MillisSeed - task->TimePoint) % interval;
             }
         }
+
+        TaskUpdate(id);
+    }
+}
+
+#if MTM_USE_STAT
+/**
+  * @brief  清除一个任务的统计(private)
+  * @param  ID:任务ID
+  * @retval 无
+  */
+void MillisTaskManager::TaskStatClear(TaskNum_t ID)
+{
+    TaskStat[ID].RunCount = 0;
+    TaskStat[ID].CycleMin = 0xFFFFFFFF;
+    TaskStat[ID].CycleMax = 0;
+    TaskStat[ID].CycleSum = 0;
+    TaskStat[ID].LateLast = 0;
+    TaskStat[ID].LateMax = 0;
+    TaskStat[ID].MissCount = 0;
+}
+
+/**
+  * @brief  获取任务统计
+  * @param  ID:任务ID
+  * @param  *Stat:统计输出
+  * @retval true:成功 ; false:失败
+  */
+bool MillisTaskManager::TaskGetStat(TaskNum_t ID, TaskStat_TypeDef* Stat)
+{
+    if(ID < TaskNum_MAX)
+    {
+        *Stat = TaskStat[ID];
+        return true;
+    }
+    else
+        return false;
+}
+
+/**
+  * @brief  清除所有任务统计，重新开始CPU占用率统计窗口
+  * @param  无
+  * @retval 无
+  */
+void MillisTaskManager::TaskStatReset()
+{
+    for(TaskNum_t i = 0; i < TaskNum_MAX; i++)
+        TaskStatClear(i);
+
+    StatTotalCycles = 0;
+    StatBusyCycles = 0;
+    StatLastCycle = MTM_GET_CYCLE();
+}
+
+/**
+  * @brief  获取CPU占用率(任务执行时间占调度总时间的比例)
+  * @param  无
+  * @retval 自上次TaskStatReset以来的占用率(0.0~100.0)
+  */
+float MillisTaskManager::GetCPUUsage()
+{
+    if(StatTotalCycles == 0)
+        return 0.0f;
+
+    return (float)StatBusyCycles * 100.0f / (float)StatTotalCycles;
+}
+
+/**
+  * @brief  输出所有已注册任务的统计，执行时间单位为CPU周期，延迟单位为时钟单位
+  * @param  p:输出对象(如&Serial)
+  * @retval 无
+  */
+void MillisTaskManager::TaskStatDump(Print* p)
+{
+    uint32_t usage = (uint32_t)(GetCPUUsage() * 10.0f + 0.5f);
+
+    p->printf("CPU usage: %lu.%lu%%\r\n", (unsigned long)(usage / 10), (unsigned long)(usage % 10));
+    p->printf("ID  Function    Interval  Runs      CycMin    CycAvg    CycMax    LateMax   Miss\r\n");
+
+    for(TaskNum_t i = 0; i < TaskNum_MAX; i++)
+    {
+        const TaskStat_TypeDef* stat = &TaskStat[i];
+
+        if(!TaskList[i].Function)
+            continue;
+
+        p->printf(
+            "%-3d 0x%08lX  %-9lu %-9lu %-9lu %-9lu %-9lu %-9lu %lu\r\n",
+            i,
+            (unsigned long)TaskList[i].Function,
+            (unsigned long)TaskList[i].IntervalTime,
+            (unsigned long)stat->RunCount,
+            (unsigned long)(stat->RunCount ? stat->CycleMin : 0),
+            (unsigned long)(stat->RunCount ? stat->CycleSum / stat->RunCount : 0),
+            (unsigned long)stat->CycleMax,
+            (unsigned long)stat->LateMax,
+            (unsigned long)stat->MissCount
+        );
     }
 }
+#endif
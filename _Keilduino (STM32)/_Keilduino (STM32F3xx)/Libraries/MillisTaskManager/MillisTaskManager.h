@@ -1,4 +1,3 @@
-
 /**********     超轻量级分时合作式任务调度器     **********/
 /**********        Designed By _VIFEXTech        **********/
 
@@ -9,28 +8,65 @@
 //Update   2018.12.17 v1.4 将 TaskCtrl 修改为 TaskStateCtrl，添加修改任务间隔时间的接口，添加 TaskFind 用于遍历列表寻找任务
 //Update   2019.2.5   v1.5 添加析构函数，用于释放内存
 //Update   2019.3.4   v1.6 将FuncPos改为ID，添加TaskFind(void_TaskFunction_t Function)
+//Update   2026.10.19 v2.0 按到期时间建最小堆，调度不再遍历列表；触发时间点按间隔累加，不随执行延迟漂移；
+//                         添加任务优先级、单次任务、GetNextTaskTime；时间单位由传入的时钟决定，可使用micros()
+//Update   2026.10.19 v2.1 添加任务运行统计(MTM_USE_STAT)：执行周期数、触发延迟、错过周期计数、CPU占用率，可输出到Print
 
 #ifndef __MILLISTASKMANAGER_H
 #define __MILLISTASKMANAGER_H
 
-#define _MILLISTASKMANAGER_VERSION "v1.5"
+#define _MILLISTASKMANAGER_VERSION "v2.1"
 
 #include "stdint.h"
 
+/*
+ * 任务运行统计开关，使用DWT周期计数器测量每个任务的执行时间，
+ * 两次调度的间隔需小于周期计数器回绕时间(72MHz约59秒)
+ */
+#ifndef MTM_USE_STAT
+#  define MTM_USE_STAT 0
+#endif
+
+#if MTM_USE_STAT
+class Print;
+#endif
+
+/*
+ * 时间单位与 Running() 传入的时钟一致(millis()或micros())，
+ * 间隔时间需小于2^31个单位(毫秒约24.8天，微秒约35.8分钟)。
+ */
 class MillisTaskManager {
 public:
     typedef void(*void_TaskFunction_t)(void);//回调函数定义
     typedef uint8_t TaskNum_t;
+    typedef uint8_t TaskPriority_t;
     typedef struct {
         bool State; //任务状态
+        bool OneShot; //单次任务，执行后自动关闭
+        TaskPriority_t Priority; //优先级，数值越大越优先
+        uint8_t Queue; //所在队列(private)
+        TaskNum_t HeapIndex; //在队列中的位置(private)
         void_TaskFunction_t Function; //任务函数指针
         uint32_t IntervalTime; //任务触发间隔时间
-        uint32_t TimePoint; //任务触发时间点
+        uint32_t TimePoint; //上一次计划触发的时间点，下一次为 TimePoint + IntervalTime
     } MillisTaskManager_TypeDef; //任务类型定义
-	
+
+#if MTM_USE_STAT
+    typedef struct {
+        uint32_t RunCount; //执行次数
+        uint32_t CycleMin; //最短执行时间(CPU周期)
+        uint32_t CycleMax; //最长执行时间(CPU周期)
+        uint64_t CycleSum; //总执行时间(CPU周期)
+        uint32_t LateLast; //最近一次相对计划触发时间的延迟(时钟单位)
+        uint32_t LateMax; //最大延迟(时钟单位)
+        uint32_t MissCount; //错过的周期数
+    } TaskStat_TypeDef; //任务统计
+#endif
+
     MillisTaskManager(TaskNum_t TaskNum_MAX_Set);
     ~MillisTaskManager();
     bool TaskRegister(TaskNum_t ID, void_TaskFunction_t Function, uint32_t TimeSetMs, bool TaskState = true);
+    bool TaskRegisterOnce(TaskNum_t ID, void_TaskFunction_t Function, uint32_t DelayTime);
     bool TaskFind(void_TaskFunction_t Function, TaskNum_t *ID);
     int16_t TaskFind(void_TaskFunction_t Function);
     bool TaskLogout(void_TaskFunction_t Function);
@@ -39,11 +75,43 @@ public:
     bool TaskStateCtrl(TaskNum_t ID, bool TaskState);
     bool TaskSetIntervalTime(void_TaskFunction_t Function, uint32_t TimeSetMs);
     bool TaskSetIntervalTime(TaskNum_t ID, uint32_t TimeSetMs);
+    bool TaskSetPriority(void_TaskFunction_t Function, TaskPriority_t Priority);
+    bool TaskSetPriority(TaskNum_t ID, TaskPriority_t Priority);
+    uint32_t GetNextTaskTime(uint32_t MillisSeed);
     void Running(uint32_t MillisSeed);
+#if MTM_USE_STAT
+    bool TaskGetStat(TaskNum_t ID, TaskStat_TypeDef* Stat);
+    void TaskStatReset();
+    float GetCPUUsage();
+    void TaskStatDump(Print* p);
+#endif
 private:
+    typedef struct {
+        TaskNum_t* Item;
+        TaskNum_t Count;
+    } TaskHeap_TypeDef;
+
     MillisTaskManager_TypeDef* TaskList;//任务列表
     TaskNum_t TaskNum_MAX;//任务列表长度
+    TaskHeap_TypeDef TimerHeap;//等待队列，按触发时间排序
+    TaskHeap_TypeDef ReadyHeap;//本轮已到期队列，按优先级排序
+    uint32_t TimeSeed;//上一次调度的时间
+#if MTM_USE_STAT
+    TaskStat_TypeDef* TaskStat;//任务统计列表
+    uint64_t StatTotalCycles;//统计窗口总周期数
+    uint64_t StatBusyCycles;//统计窗口内任务执行周期数
+    uint32_t StatLastCycle;//上一次调度时的周期计数
+    void TaskStatClear(TaskNum_t ID);
+#endif
+
     void TaskClear(TaskNum_t ID);//清除任务
+    void TaskUpdate(TaskNum_t ID);//按状态重新加入队列
+    bool TaskBefore(TaskNum_t A, TaskNum_t B, bool Ready);
+    void HeapInsert(TaskHeap_TypeDef* Heap, TaskNum_t ID);
+    void HeapRemove(TaskHeap_TypeDef* Heap, TaskNum_t Index);
+    void HeapSiftUp(TaskHeap_TypeDef* Heap, TaskNum_t Index);
+    void HeapSiftDown(TaskHeap_TypeDef* Heap, TaskNum_t Index);
+    void HeapSet(TaskHeap_TypeDef* Heap, TaskNum_t Index, TaskNum_t ID);
 };
 
 #endif
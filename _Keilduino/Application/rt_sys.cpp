@@ -25,9 +25,22 @@
 #include <stdlib.h>
 #include <time.h>
 #include "Arduino.h"
+#include "stdio_port.h"
 
 #pragma import(__use_no_semihosting)
 
+#ifndef STDIO_OUT_BUFFER_SIZE
+#  define STDIO_OUT_BUFFER_SIZE 256
+#endif
+
+#ifndef STDIO_ERR_BUFFER_SIZE
+#  define STDIO_ERR_BUFFER_SIZE 64
+#endif
+
+#ifndef STDIO_IN_LINE_SIZE
+#  define STDIO_IN_LINE_SIZE    64
+#endif
+
 enum
 {
     STDIN,
@@ -36,6 +49,180 @@ enum
     STDMAX
 };
 #define IS_STD_FILEHANDLE(fh) ((fh) >= 0 && (fh) < STDMAX)
+#define IS_OUT_FILEHANDLE(fh) ((int)(fh) == STDOUT || (int)(fh) == STDERR)
+
+static uint8_t Stdio_OutBuffer[STDIO_OUT_BUFFER_SIZE];
+static uint8_t Stdio_ErrBuffer[STDIO_ERR_BUFFER_SIZE];
+static char Stdio_LineBuffer[STDIO_IN_LINE_SIZE];
+static StdioBuf_TypeDef Stdio_Out[STDMAX];
+static StdioLine_TypeDef Stdio_Line;
+static Stream* Stdio_Input = &Serial;
+static bool Stdio_IsInit = false;
+
+/*
+ * 输出端：阻塞版本直接调用write()，适用于任意Print(如SD卡文件)；
+ * 不阻塞版本只写入 availableForWrite() 个字节，需要输出对象实现该函数。
+ */
+static uint32_t Stdio_PrintWrite(void* userData, const uint8_t* data, uint32_t length)
+{
+    return ((Print*)userData)->write(data, length);
+}
+
+static uint32_t Stdio_PrintWriteNonBlock(void* userData, const uint8_t* data, uint32_t length)
+{
+    Print* p = (Print*)userData;
+    int n = p->availableForWrite();
+
+    if(n <= 0)
+    {
+        return 0;
+    }
+
+    return p->write(data, ((uint32_t)n < length) ? n : length);
+}
+
+static void Stdio_Init()
+{
+    if(Stdio_IsInit)
+    {
+        return;
+    }
+
+    StdioBuf_Init(&Stdio_Out[STDOUT], Stdio_OutBuffer, sizeof(Stdio_OutBuffer), STDIO_BUF_NONE, STDIO_POLICY_BLOCK);
+    StdioBuf_Init(&Stdio_Out[STDERR], Stdio_ErrBuffer, sizeof(Stdio_ErrBuffer), STDIO_BUF_NONE, STDIO_POLICY_BLOCK);
+    StdioBuf_SetSink(&Stdio_Out[STDOUT], Stdio_PrintWrite, &Serial, yield);
+    StdioBuf_SetSink(&Stdio_Out[STDERR], Stdio_PrintWrite, &Serial, yield);
+    StdioLine_Init(&Stdio_Line, Stdio_LineBuffer, sizeof(Stdio_LineBuffer), true);
+    Stdio_IsInit = true;
+}
+
+static bool Stdio_PollInput()
+{
+    while(!Stdio_Line.Ready && Stdio_Input && Stdio_Input->available() > 0)
+    {
+        StdioLine_Input(&Stdio_Line, (char)Stdio_Input->read(), &Stdio_Out[STDOUT]);
+    }
+
+    return Stdio_Line.Ready;
+}
+
+/**
+  * @brief  设置输出缓冲模式
+  * @param  Handle: STDIO_OUT 或 STDIO_ERR
+  * @param  Mode: 缓冲模式
+  * @param  Policy: 缓冲满且输出端忙时的策略
+  * @retval 无
+  */
+void Stdio_SetMode(Stdio_Handle_t Handle, StdioBuf_Mode_t Mode, StdioBuf_Policy_t Policy)
+{
+    Stdio_Init();
+    if(IS_OUT_FILEHANDLE(Handle))
+    {
+        StdioBuf_Flush(&Stdio_Out[Handle], true);
+        Stdio_Out[Handle].Mode = Mode;
+        Stdio_Out[Handle].Policy = Policy;
+    }
+}
+
+/**
+  * @brief  设置输出端
+  * @param  Handle: STDIO_OUT 或 STDIO_ERR
+  * @param  Write: 输出函数，不阻塞，返回本次接受的字节数；NULL为只保存在RAM，用 Stdio_ReadRing 读取
+  * @param  UserData: 用户数据
+  * @retval 无
+  */
+void Stdio_SetSink(Stdio_Handle_t Handle, StdioBuf_Write_t Write, void* UserData)
+{
+    Stdio_Init();
+    if(IS_OUT_FILEHANDLE(Handle))
+    {
+        StdioBuf_Flush(&Stdio_Out[Handle], true);
+        StdioBuf_SetSink(&Stdio_Out[Handle], Write, UserData, yield);
+    }
+}
+
+/**
+  * @brief  设置输出到Print(如Serial2、SD卡文件)
+  * @param  Handle: STDIO_OUT 或 STDIO_ERR
+  * @param  p: 输出对象
+  * @param  Blocking: true: 直接调用write()，false: 只写入 availableForWrite() 个字节
+  * @retval 无
+  */
+void Stdio_SetOutput(Stdio_Handle_t Handle, Print* p, bool Blocking)
+{
+    Stdio_SetSink(Handle, p ? (Blocking ? Stdio_PrintWrite : Stdio_PrintWriteNonBlock) : NULL, p);
+}
+
+/**
+  * @brief  设置stdin的输入流
+  * @param  s: 输入流，NULL为无输入
+  * @retval 无
+  */
+void Stdio_SetInput(Stream* s)
+{
+    Stdio_Input = s;
+}
+
+/**
+  * @brief  设置stdin回显(回显写入stdout)
+  * @param  Echo: 是否回显
+  * @retval 无
+  */
+void Stdio_SetEcho(bool Echo)
+{
+    Stdio_Init();
+    Stdio_Line.Echo = Echo;
+}
+
+/**
+  * @brief  发送输出缓冲中的数据
+  * @param  Handle: STDIO_OUT 或 STDIO_ERR
+  * @param  Block: true: 等待发送完成，false: 未发送完的部分由 Stdio_Process 继续发送
+  * @retval true: 缓冲已空
+  */
+bool Stdio_Flush(Stdio_Handle_t Handle, bool Block)
+{
+    Stdio_Init();
+    return IS_OUT_FILEHANDLE(Handle) ? StdioBuf_Flush(&Stdio_Out[Handle], Block) : false;
+}
+
+/**
+  * @brief  后台处理：读取输入并回显，发送输出缓冲，在主循环中调用
+  * @param  无
+  * @retval 无
+  */
+void Stdio_Process(void)
+{
+    Stdio_Init();
+    Stdio_PollInput();
+    StdioBuf_Process(&Stdio_Out[STDERR]);
+    StdioBuf_Process(&Stdio_Out[STDOUT]);
+}
+
+/**
+  * @brief  读取保存在RAM中的输出(输出端为NULL时)
+  * @param  Handle: STDIO_OUT 或 STDIO_ERR
+  * @param  Data: 数据
+  * @param  Length: 最大长度
+  * @retval 读取的字节数
+  */
+uint32_t Stdio_ReadRing(Stdio_Handle_t Handle, uint8_t* Data, uint32_t Length)
+{
+    Stdio_Init();
+    return IS_OUT_FILEHANDLE(Handle) ? StdioBuf_Read(&Stdio_Out[Handle], Data, Length) : 0;
+}
+
+/**
+  * @brief  获取因缓冲满丢弃的字节数
+  * @param  Handle: STDIO_OUT 或 STDIO_ERR
+  * @param  Clear: 读取后清零
+  * @retval 字节数
+  */
+uint32_t Stdio_GetDropped(Stdio_Handle_t Handle, bool Clear)
+{
+    Stdio_Init();
+    return IS_OUT_FILEHANDLE(Handle) ? StdioBuf_GetDropped(&Stdio_Out[Handle], Clear) : 0;
+}
 
 /*
  * These names are used during library initialization as the
@@ -90,11 +277,13 @@ int _sys_write(FILEHANDLE fh, const unsigned char *buf,
 {
     if(IS_STD_FILEHANDLE(fh))
     {
-        if(fh == STDOUT || fh == STDERR)
+        /*DROP策略丢弃的部分计入统计，不作为错误返回*/
+        if(IS_OUT_FILEHANDLE(fh))
         {
-            Serial.write(buf, len);
+            Stdio_Init();
+            StdioBuf_Write(&Stdio_Out[fh], buf, len);
         }
-        return len;
+        return 0;
     }
 
     return -1;
@@ -128,6 +317,24 @@ int _sys_write(FILEHANDLE fh, const unsigned char *buf,
 int _sys_read(FILEHANDLE fh, unsigned char *buf,
               unsigned len, int mode)
 {
+    if(fh == STDIN)
+    {
+        Stdio_Init();
+        if(!Stdio_Input)
+        {
+            return (int)(0x80000000 | len);
+        }
+
+        /*等待一行输入完成，期间继续发送输出*/
+        while(!Stdio_PollInput())
+        {
+            Stdio_Process();
+            yield();
+        }
+
+        return len - StdioLine_Read(&Stdio_Line, buf, len);
+    }
+
     if(IS_STD_FILEHANDLE(fh))
     {
         return 0;
@@ -142,6 +349,10 @@ int _sys_read(FILEHANDLE fh, unsigned char *buf,
  */
 void _ttywrch(int ch)
 {
+    unsigned char c = ch;
+    Stdio_Init();
+    StdioBuf_Write(&Stdio_Out[STDERR], &c, 1);
+    StdioBuf_Flush(&Stdio_Out[STDERR], true);
 }
 
 /*
@@ -168,7 +379,13 @@ int _sys_seek(FILEHANDLE fh, long pos)
  */
 int _sys_ensure(FILEHANDLE fh)
 {
-    return -1;
+    if(IS_OUT_FILEHANDLE(fh))
+    {
+        Stdio_Init();
+        return StdioBuf_Flush(&Stdio_Out[fh], true) ? 0 : -1;
+    }
+
+    return IS_STD_FILEHANDLE(fh) ? 0 : -1;
 }
 
 /*
@@ -0,0 +1,411 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "stdio_buffer.h"
+#include <stddef.h>
+#include <string.h>
+
+#define STDIO_MIN(a, b)     ((a) < (b) ? (a) : (b))
+
+/**
+  * @brief  输出缓冲初始化
+  * @param  Buf: 输出缓冲
+  * @param  Buffer: 缓冲区
+  * @param  Size: 缓冲区大小
+  * @param  Mode: 缓冲模式
+  * @param  Policy: 缓冲满且输出端忙时的策略
+  * @retval 无
+  */
+void StdioBuf_Init(StdioBuf_TypeDef* Buf, uint8_t* Buffer, uint32_t Size, StdioBuf_Mode_t Mode, StdioBuf_Policy_t Policy)
+{
+    Buf->Buffer = Buffer;
+    Buf->Size = Size;
+    Buf->Head = 0;
+    Buf->Count = 0;
+    Buf->Dropped = 0;
+    Buf->Mode = Mode;
+    Buf->Policy = Policy;
+    Buf->Write = NULL;
+    Buf->Wait = NULL;
+    Buf->UserData = NULL;
+    Buf->Pending = false;
+}
+
+/**
+  * @brief  设置输出端
+  * @param  Buf: 输出缓冲
+  * @param  Write: 输出函数，不阻塞，返回本次接受的字节数；NULL为只保存在RAM
+  * @param  UserData: 用户数据
+  * @param  Wait: 阻塞等待时调用(如yield)，可为NULL
+  * @retval 无
+  */
+void StdioBuf_SetSink(StdioBuf_TypeDef* Buf, StdioBuf_Write_t Write, void* UserData, StdioBuf_Wait_t Wait)
+{
+    Buf->Write = Write;
+    Buf->UserData = UserData;
+    Buf->Wait = Wait;
+}
+
+static void StdioBuf_Push(StdioBuf_TypeDef* Buf, const uint8_t* Data, uint32_t Length)
+{
+    uint32_t tail = Buf->Head + Buf->Count;
+    uint32_t first;
+
+    if(tail >= Buf->Size)
+    {
+        tail -= Buf->Size;
+    }
+
+    first = STDIO_MIN(Length, Buf->Size - tail);
+    memcpy(&Buf->Buffer[tail], Data, first);
+    memcpy(Buf->Buffer, Data + first, Length - first);
+    Buf->Count += Length;
+}
+
+static void StdioBuf_Discard(StdioBuf_TypeDef* Buf, uint32_t Length)
+{
+    Buf->Head += Length;
+    if(Buf->Head >= Buf->Size)
+    {
+        Buf->Head -= Buf->Size;
+    }
+    Buf->Count -= Length;
+}
+
+/**
+  * @brief  写入数据
+  * @param  Buf: 输出缓冲
+  * @param  Data: 数据
+  * @param  Length: 长度
+  * @retval 写入缓冲的字节数，DROP策略下缓冲满时小于Length
+  */
+uint32_t StdioBuf_Write(StdioBuf_TypeDef* Buf, const uint8_t* Data, uint32_t Length)
+{
+    uint32_t accepted = 0;
+
+    while(accepted < Length)
+    {
+        uint32_t remain = Length - accepted;
+        uint32_t space = Buf->Size - Buf->Count;
+        uint32_t n;
+
+        if(space == 0)
+        {
+            StdioBuf_Drain(Buf);
+            space = Buf->Size - Buf->Count;
+        }
+
+        if(space == 0)
+        {
+            if(Buf->Policy == STDIO_POLICY_BLOCK && Buf->Write)
+            {
+                if(Buf->Wait)
+                {
+                    Buf->Wait();
+                }
+                continue;
+            }
+
+            if(Buf->Policy == STDIO_POLICY_OVERWRITE)
+            {
+                space = STDIO_MIN(remain, Buf->Size);
+                StdioBuf_Discard(Buf, space);
+                Buf->Dropped += space;
+            }
+            else
+            {
+                Buf->Dropped += remain;
+                break;
+            }
+        }
+
+        n = STDIO_MIN(space, remain);
+        if(Buf->Mode == STDIO_BUF_NONE
+                || (Buf->Mode == STDIO_BUF_LINE && memchr(Data + accepted, '\n', n) != NULL))
+        {
+            Buf->Pending = true;
+        }
+        StdioBuf_Push(Buf, Data + accepted, n);
+        accepted += n;
+    }
+
+    /*缓冲满过一次，全缓冲也可以开始发送*/
+    if(Buf->Count == Buf->Size)
+    {
+        Buf->Pending = true;
+    }
+
+    if(Buf->Pending && Buf->Mode != STDIO_BUF_FULL)
+    {
+        StdioBuf_Flush(Buf, Buf->Policy == STDIO_POLICY_BLOCK);
+    }
+
+    return accepted;
+}
+
+/**
+  * @brief  尝试发送缓冲中的数据，不等待
+  * @param  Buf: 输出缓冲
+  * @retval 发送的字节数
+  */
+uint32_t StdioBuf_Drain(StdioBuf_TypeDef* Buf)
+{
+    uint32_t total = 0;
+
+    if(!Buf->Write)
+    {
+        return 0;
+    }
+
+    while(Buf->Count)
+    {
+        uint32_t chunk = STDIO_MIN(Buf->Count, Buf->Size - Buf->Head);
+        uint32_t sent = Buf->Write(Buf->UserData, &Buf->Buffer[Buf->Head], chunk);
+
+        if(sent > chunk)
+        {
+            sent = chunk;
+        }
+
+        StdioBuf_Discard(Buf, sent);
+        total += sent;
+
+        if(sent < chunk)
+        {
+            break;
+        }
+    }
+
+    if(Buf->Count == 0)
+    {
+        Buf->Pending = false;
+    }
+
+    return total;
+}
+
+/**
+  * @brief  发送缓冲中的全部数据
+  * @param  Buf: 输出缓冲
+  * @param  Block: true: 等待发送完成，false: 发送不完的部分由 StdioBuf_Process 继续发送
+  * @retval true: 缓冲已空
+  */
+bool StdioBuf_Flush(StdioBuf_TypeDef* Buf, bool Block)
+{
+    StdioBuf_Drain(Buf);
+
+    while(Block && Buf->Count && Buf->Write)
+    {
+        if(Buf->Wait)
+        {
+            Buf->Wait();
+        }
+        StdioBuf_Drain(Buf);
+    }
+
+    Buf->Pending = (Buf->Count != 0);
+    return Buf->Count == 0;
+}
+
+/**
+  * @brief  后台发送，在主循环中调用，只发送已到发送条件的数据
+  * @param  Buf: 输出缓冲
+  * @retval 发送的字节数
+  */
+uint32_t StdioBuf_Process(StdioBuf_TypeDef* Buf)
+{
+    return Buf->Pending ? StdioBuf_Drain(Buf) : 0;
+}
+
+/**
+  * @brief  从缓冲中读出数据(没有输出端时作为RAM日志使用)
+  * @param  Buf: 输出缓冲
+  * @param  Data: 数据
+  * @param  Length: 最大长度
+  * @retval 读出的字节数
+  */
+uint32_t StdioBuf_Read(StdioBuf_TypeDef* Buf, uint8_t* Data, uint32_t Length)
+{
+    uint32_t n = STDIO_MIN(Length, Buf->Count);
+    uint32_t first = STDIO_MIN(n, Buf->Size - Buf->Head);
+
+    memcpy(Data, &Buf->Buffer[Buf->Head], first);
+    memcpy(Data + first, Buf->Buffer, n - first);
+    StdioBuf_Discard(Buf, n);
+
+    if(Buf->Count == 0)
+    {
+        Buf->Pending = false;
+    }
+
+    return n;
+}
+
+/**
+  * @brief  获取缓冲中的字节数
+  * @param  Buf: 输出缓冲
+  * @retval 字节数
+  */
+uint32_t StdioBuf_GetCount(const StdioBuf_TypeDef* Buf)
+{
+    return Buf->Count;
+}
+
+/**
+  * @brief  获取丢弃的字节数
+  * @param  Buf: 输出缓冲
+  * @param  Clear: 读取后清零
+  * @retval 字节数
+  */
+uint32_t StdioBuf_GetDropped(StdioBuf_TypeDef* Buf, bool Clear)
+{
+    uint32_t dropped = Buf->Dropped;
+    if(Clear)
+    {
+        Buf->Dropped = 0;
+    }
+    return dropped;
+}
+
+/**
+  * @brief  行编辑器初始化
+  * @param  Line: 行编辑器
+  * @param  Buffer: 行缓冲，最长一行为 Size - 1 个字符(不含换行)
+  * @param  Size: 缓冲大小
+  * @param  Echo: 是否回显
+  * @retval 无
+  */
+void StdioLine_Init(StdioLine_TypeDef* Line, char* Buffer, uint16_t Size, bool Echo)
+{
+    Line->Buffer = Buffer;
+    Line->Size = Size;
+    Line->Length = 0;
+    Line->ReadPos = 0;
+    Line->Ready = false;
+    Line->Echo = Echo;
+    Line->LastCR = false;
+}
+
+static void StdioLine_Echo(StdioLine_TypeDef* Line, StdioBuf_TypeDef* EchoOut, const char* str, uint32_t length)
+{
+    if(Line->Echo && EchoOut)
+    {
+        StdioBuf_Write(EchoOut, (const uint8_t*)str, length);
+    }
+}
+
+/**
+  * @brief  输入一个字符
+  * @param  Line: 行编辑器
+  * @param  c: 字符
+  * @param  EchoOut: 回显输出，可为NULL
+  * @retval true: 一行已完成，读完之前不再接收字符
+  */
+bool StdioLine_Input(StdioLine_TypeDef* Line, char c, StdioBuf_TypeDef* EchoOut)
+{
+    if(Line->Ready)
+    {
+        return true;
+    }
+
+    /*"\r\n"只结束一行*/
+    if(c == '\n' && Line->LastCR)
+    {
+        Line->LastCR = false;
+        return false;
+    }
+    Line->LastCR = (c == '\r');
+
+    switch(c)
+    {
+    case '\r':
+    case '\n':
+        Line->Buffer[Line->Length++] = '\n';
+        Line->ReadPos = 0;
+        Line->Ready = true;
+        StdioLine_Echo(Line, EchoOut, "\r\n", 2);
+        return true;
+
+    case '\b':
+    case 0x7F:
+        if(Line->Length)
+        {
+            Line->Length--;
+            StdioLine_Echo(Line, EchoOut, "\b \b", 3);
+        }
+        return false;
+
+    case 0x15: /*Ctrl+U*/
+        while(Line->Length)
+        {
+            Line->Length--;
+            StdioLine_Echo(Line, EchoOut, "\b \b", 3);
+        }
+        return false;
+
+    default:
+        break;
+    }
+
+    if((uint8_t)c < 0x20 && c != '\t')
+    {
+        return false;
+    }
+
+    if(Line->Length + 1 < Line->Size)
+    {
+        Line->Buffer[Line->Length++] = c;
+        StdioLine_Echo(Line, EchoOut, &c, 1);
+    }
+
+    return false;
+}
+
+/**
+  * @brief  读取已完成的一行(包含'\n')，读完后开始接收下一行
+  * @param  Line: 行编辑器
+  * @param  Data: 数据
+  * @param  Length: 最大长度
+  * @retval 读取的字节数，0表示一行还未完成
+  */
+uint32_t StdioLine_Read(StdioLine_TypeDef* Line, uint8_t* Data, uint32_t Length)
+{
+    uint32_t n;
+
+    if(!Line->Ready)
+    {
+        return 0;
+    }
+
+    n = STDIO_MIN(Length, (uint32_t)(Line->Length - Line->ReadPos));
+    memcpy(Data, &Line->Buffer[Line->ReadPos], n);
+    Line->ReadPos += n;
+
+    if(Line->ReadPos >= Line->Length)
+    {
+        Line->Length = 0;
+        Line->ReadPos = 0;
+        Line->Ready = false;
+    }
+
+    return n;
+}
@@ -0,0 +1,101 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __STDIO_BUFFER_H
+#define __STDIO_BUFFER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 标准输入输出缓冲：
+ * 输出为字节环形缓冲，按缓冲模式决定何时交给输出端(sink)，输出端不阻塞，返回本次接受的字节数；
+ * 缓冲满且输出端忙时按策略等待、丢弃新数据或覆盖最旧的数据。没有输出端时缓冲即为RAM日志，用 StdioBuf_Read 读取。
+ * 输入为行编辑器，支持回显、退格、Ctrl+U 删除整行，回车/换行结束一行。
+ * 本文件不访问寄存器，可在PC上编译验证；不可在中断中调用。
+ */
+typedef enum
+{
+    STDIO_BUF_NONE,     // 无缓冲：每次写入后立即发送
+    STDIO_BUF_LINE,     // 行缓冲：写入换行或缓冲满时发送
+    STDIO_BUF_FULL      // 全缓冲：缓冲满或 flush 时发送
+} StdioBuf_Mode_t;
+
+typedef enum
+{
+    STDIO_POLICY_BLOCK,     // 等待输出端发送
+    STDIO_POLICY_DROP,      // 丢弃放不下的新数据
+    STDIO_POLICY_OVERWRITE  // 丢弃最旧的数据
+} StdioBuf_Policy_t;
+
+typedef uint32_t(*StdioBuf_Write_t)(void* UserData, const uint8_t* Data, uint32_t Length);
+typedef void(*StdioBuf_Wait_t)(void);
+
+typedef struct
+{
+    uint8_t* Buffer;
+    uint32_t Size;
+    uint32_t Head;          // 最旧数据的位置
+    uint32_t Count;         // 缓冲中的字节数
+    uint32_t Dropped;       // 丢弃的字节数
+    StdioBuf_Mode_t Mode;
+    StdioBuf_Policy_t Policy;
+    StdioBuf_Write_t Write; // 输出端，NULL为只保存在RAM
+    StdioBuf_Wait_t Wait;   // 阻塞等待时调用，可为NULL
+    void* UserData;
+    bool Pending;           // 行缓冲已写入换行，等待发送
+} StdioBuf_TypeDef;
+
+typedef struct
+{
+    char* Buffer;
+    uint16_t Size;
+    uint16_t Length;        // 行长度(完成后包含'\n')
+    uint16_t ReadPos;       // 已读取的位置
+    bool Ready;             // 一行已完成
+    bool Echo;              // 回显
+    bool LastCR;            // 上一个字符是'\r'，忽略紧随的'\n'
+} StdioLine_TypeDef;
+
+void     StdioBuf_Init(StdioBuf_TypeDef* Buf, uint8_t* Buffer, uint32_t Size, StdioBuf_Mode_t Mode, StdioBuf_Policy_t Policy);
+void     StdioBuf_SetSink(StdioBuf_TypeDef* Buf, StdioBuf_Write_t Write, void* UserData, StdioBuf_Wait_t Wait);
+uint32_t StdioBuf_Write(StdioBuf_TypeDef* Buf, const uint8_t* Data, uint32_t Length);
+uint32_t StdioBuf_Drain(StdioBuf_TypeDef* Buf);
+bool     StdioBuf_Flush(StdioBuf_TypeDef* Buf, bool Block);
+uint32_t StdioBuf_Process(StdioBuf_TypeDef* Buf);
+uint32_t StdioBuf_Read(StdioBuf_TypeDef* Buf, uint8_t* Data, uint32_t Length);
+uint32_t StdioBuf_GetCount(const StdioBuf_TypeDef* Buf);
+uint32_t StdioBuf_GetDropped(StdioBuf_TypeDef* Buf, bool Clear);
+
+void     StdioLine_Init(StdioLine_TypeDef* Line, char* Buffer, uint16_t Size, bool Echo);
+bool     StdioLine_Input(StdioLine_TypeDef* Line, char c, StdioBuf_TypeDef* EchoOut);
+uint32_t StdioLine_Read(StdioLine_TypeDef* Line, uint8_t* Data, uint32_t Length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __STDIO_BUFFER_H */
@@ -0,0 +1,63 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __STDIO_PORT_H
+#define __STDIO_PORT_H
+
+#include "stdio_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * printf/scanf 重定向(rt_sys.cpp)的配置接口。
+ * 默认 stdout/stderr 无缓冲、阻塞写入Serial，与原来行为一致；
+ * 改为 STDIO_BUF_LINE + STDIO_POLICY_DROP 并选择不阻塞的输出端后，printf只复制到缓冲，
+ * 由 Stdio_Process() 在主循环中发送。stdin 为带回显的行编辑输入。
+ */
+typedef enum
+{
+    STDIO_IN,
+    STDIO_OUT,
+    STDIO_ERR
+} Stdio_Handle_t;
+
+void     Stdio_SetMode(Stdio_Handle_t Handle, StdioBuf_Mode_t Mode, StdioBuf_Policy_t Policy);
+void     Stdio_SetSink(Stdio_Handle_t Handle, StdioBuf_Write_t Write, void* UserData);
+void     Stdio_SetEcho(bool Echo);
+bool     Stdio_Flush(Stdio_Handle_t Handle, bool Block);
+void     Stdio_Process(void);
+uint32_t Stdio_ReadRing(Stdio_Handle_t Handle, uint8_t* Data, uint32_t Length);
+uint32_t Stdio_GetDropped(Stdio_Handle_t Handle, bool Clear);
+
+#ifdef __cplusplus
+}
+
+class Print;
+class Stream;
+void Stdio_SetOutput(Stdio_Handle_t Handle, Print* p, bool Blocking = true);
+void Stdio_SetInput(Stream* s);
+
+#endif
+
+#endif /* __STDIO_PORT_H */
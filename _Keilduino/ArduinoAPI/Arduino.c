@@ -291,6 +291,14 @@ float fmap(float x, float in_min, float in_max, float out_min, float out_max)
     return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
 }
 
+/**
+  * @brief  让出CPU，已创建协程时运行其他协程
+  * @param  无
+  * @retval 无
+  */
 void yield(void)
 {
+#if COROUTINE_ENABLE
+    Coroutine_Yield();
+#endif
 }
@@ -36,6 +36,7 @@ int Stream::timedRead()
     {
         c = read();
         if (c >= 0) return c;
+        yield();
     }
     while(millis() - _startMillis < _timeout);
     return -1;     // -1 indicates timeout
@@ -50,6 +51,7 @@ int Stream::timedPeek()
     {
         c = peek();
         if (c >= 0) return c;
+        yield();
     }
     while(millis() - _startMillis < _timeout);
     return -1;     // -1 indicates timeout
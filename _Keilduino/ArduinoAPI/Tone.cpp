@@ -25,6 +25,13 @@
 
 #define TONE_FREQ_MAX 500000U
 
+/* 平台支持时，定时器通道引脚由硬件直接输出方波，不进入中断 */
+#if defined(TONE_HARDWARE_ENABLE) && TONE_HARDWARE_ENABLE
+#  define TONE_USE_HARDWARE 1
+#else
+#  define TONE_USE_HARDWARE 0
+#endif
+
 static TIM_TypeDef* Tone_Timer = NULL;
 static bool Tone_IsContinuousModeEnable = false;
 static uint8_t Tone_Pin = NOT_A_PIN;
@@ -85,6 +92,21 @@ void tone(uint8_t pin, uint32_t freq, uint32_t duration)
         return;
     }
 
+#if TONE_USE_HARDWARE
+    /*软件音调占用的定时器不能再用于硬件输出*/
+    if(PIN_MAP[pin].TIMx != Tone_Timer
+            && PWM_ToneStart(pin, freq, (duration == TONE_DURATION_INFINITE) ? 0 : duration))
+    {
+        return;
+    }
+#endif
+
+    /*软件音调同时只能有一个*/
+    if(Tone_Pin != NOT_A_PIN)
+    {
+        noTone(Tone_Pin);
+    }
+
     Tone_Pin = pin;
     Tone_IsContinuousModeEnable = (duration == TONE_DURATION_INFINITE) ? true : false;
 
@@ -116,13 +138,26 @@ void tone(uint8_t pin, uint32_t freq, uint32_t duration)
   */
 void noTone(uint8_t pin)
 {
-    if(Tone_Timer)
+#if TONE_USE_HARDWARE
+    if(PWM_ToneStop(pin))
     {
-        Timer_SetEnable(Tone_Timer, false);
+        pinMode(pin, OUTPUT);
+        digitalWrite(pin, LOW);
+        return;
+    }
+#endif
+
+    if(pin == Tone_Pin)
+    {
+        if(Tone_Timer)
+        {
+            Timer_SetEnable(Tone_Timer, false);
+        }
+
+        Tone_IsContinuousModeEnable = false;
+        Tone_Pin = NOT_A_PIN;
+        Tone_ToggleCounter = 0;
     }
 
     digitalWrite(pin, LOW);
-    Tone_IsContinuousModeEnable = false;
-    Tone_Pin = NOT_A_PIN;
-    Tone_ToggleCounter = 0;
 }
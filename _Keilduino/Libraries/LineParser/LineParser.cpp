@@ -0,0 +1,548 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "LineParser.h"
+#include "Stream.h"
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#define LINE_PARSER_FLOAT_EXACT_MAX     (1UL << 24)
+#define LINE_PARSER_DOUBLE_EXACT_MAX    (1ULL << 53)
+#define LINE_PARSER_FALLBACK_MAX        64
+
+/* 可精确表示的10的幂 */
+static const float pow10f[] =
+{
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+
+static const double pow10d[] =
+{
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+LineParser::LineParser()
+    : buffer(NULL)
+    , size(0)
+    , length(0)
+    , cursor(0)
+    , isReady(false)
+    , isOverflow(false)
+    , tokenEnd(false)
+    , mergeDelimiters(false)
+    , delimiters(",")
+    , overflowCount(0)
+{
+}
+
+LineParser::LineParser(char* buffer, uint16_t size)
+    : buffer(NULL)
+    , size(0)
+    , length(0)
+    , cursor(0)
+    , isReady(false)
+    , isOverflow(false)
+    , tokenEnd(false)
+    , mergeDelimiters(false)
+    , delimiters(",")
+    , overflowCount(0)
+{
+    begin(buffer, size);
+}
+
+/**
+  * @brief  设置行缓冲
+  * @param  buffer: 行缓冲，最长一行为 size - 1 个字符
+  * @param  size: 缓冲大小
+  * @retval 无
+  */
+void LineParser::begin(char* buffer, uint16_t size)
+{
+    this->buffer = buffer;
+    this->size = size;
+    overflowCount = 0;
+    isOverflow = false;
+    next();
+}
+
+/**
+  * @brief  设置字段分隔符
+  * @param  delimiters: 分隔符集合，字符串需一直有效，默认","
+  * @param  merge: true: 连续的分隔符视为一个(如G代码的空格)，false: 保留空字段(如NMEA)
+  * @retval 无
+  */
+void LineParser::setDelimiters(const char* delimiters, bool merge)
+{
+    this->delimiters = delimiters;
+    mergeDelimiters = merge;
+}
+
+/**
+  * @brief  丢弃当前行，开始接收下一行
+  * @param  无
+  * @retval 无
+  */
+void LineParser::next()
+{
+    length = 0;
+    isReady = false;
+    if(buffer && size)
+    {
+        buffer[0] = '\0';
+    }
+    rewind();
+}
+
+bool LineParser::put(char c)
+{
+    if(c == '\r')
+    {
+        return false;
+    }
+
+    if(c == '\n')
+    {
+        /*超长的行整行丢弃，空行忽略*/
+        if(isOverflow)
+        {
+            isOverflow = false;
+            overflowCount++;
+            next();
+            return false;
+        }
+
+        if(length == 0)
+        {
+            return false;
+        }
+
+        buffer[length] = '\0';
+        isReady = true;
+        return true;
+    }
+
+    if(isOverflow)
+    {
+        return false;
+    }
+
+    if(length + 1 >= size)
+    {
+        isOverflow = true;
+        return false;
+    }
+
+    buffer[length++] = c;
+    return false;
+}
+
+/**
+  * @brief  从数据块接收，得到完整一行后停止
+  * @param  data: 数据
+  * @param  length: 数据长度
+  * @param  used: 输出实际使用的字节数，可为NULL
+  * @retval true: 有完整的一行
+  */
+bool LineParser::feed(const char* data, uint16_t length, uint16_t* used)
+{
+    uint16_t i = 0;
+
+    if(!buffer || size < 2)
+    {
+        length = 0;
+    }
+
+    while(!isReady && i < length)
+    {
+        put(data[i++]);
+    }
+
+    if(used)
+    {
+        *used = i;
+    }
+
+    return isReady;
+}
+
+/**
+  * @brief  从串口接收缓冲读取已收到的数据，不等待，得到完整一行后停止读取
+  * @param  stream: 数据流
+  * @retval true: 有完整的一行
+  */
+bool LineParser::feed(Stream& stream)
+{
+    int n;
+
+    if(!buffer || size < 2)
+    {
+        return false;
+    }
+
+    n = stream.available();
+    while(!isReady && n-- > 0)
+    {
+        int c = stream.read();
+        if(c < 0)
+        {
+            break;
+        }
+        put((char)c);
+    }
+
+    return isReady;
+}
+
+bool LineParser::isDelimiter(char c)
+{
+    return strchr(delimiters, c) != NULL && c != '\0';
+}
+
+/**
+  * @brief  取出当前行的下一个字段
+  * @param  token: 输出字段
+  * @retval true: 成功，false: 已没有字段
+  */
+bool LineParser::nextToken(Token_t* token)
+{
+    uint16_t i;
+
+    if(!isReady || tokenEnd)
+    {
+        return false;
+    }
+
+    i = cursor;
+    if(mergeDelimiters)
+    {
+        while(i < length && isDelimiter(buffer[i]))
+        {
+            i++;
+        }
+        if(i >= length)
+        {
+            tokenEnd = true;
+            return false;
+        }
+    }
+
+    token->str = &buffer[i];
+    while(i < length && !isDelimiter(buffer[i]))
+    {
+        i++;
+    }
+    token->length = (uint16_t)(&buffer[i] - token->str);
+
+    if(i < length)
+    {
+        cursor = i + 1;
+    }
+    else
+    {
+        cursor = length;
+        tokenEnd = true;
+    }
+
+    return true;
+}
+
+/**
+  * @brief  取出下一个字段并转换为整数
+  * @param  value: 输出值
+  * @retval true: 成功，false: 没有字段或格式错误(字段仍被取出)
+  */
+bool LineParser::nextInt(long* value)
+{
+    Token_t token;
+    return nextToken(&token) && parseInt(token.str, token.length, value);
+}
+
+/**
+  * @brief  取出下一个字段并转换为浮点数
+  * @param  value: 输出值
+  * @retval true: 成功，false: 没有字段或格式错误(字段仍被取出)
+  */
+bool LineParser::nextFloat(float* value)
+{
+    Token_t token;
+    return nextToken(&token) && parseFloat(token.str, token.length, value);
+}
+
+/**
+  * @brief  十进制整数转换，格式 [+-]digits
+  * @param  str: 字符串
+  * @param  length: 长度
+  * @param  value: 输出值
+  * @retval true: 成功，false: 格式错误或溢出
+  */
+bool LineParser::parseInt(const char* str, uint16_t length, long* value)
+{
+    unsigned long result = 0;
+    unsigned long limit = LONG_MAX;
+    bool negative = false;
+    uint16_t i = 0;
+
+    if(length && (str[0] == '-' || str[0] == '+'))
+    {
+        negative = (str[0] == '-');
+        limit += negative;
+        i++;
+    }
+
+    if(i >= length)
+    {
+        return false;
+    }
+
+    for(; i < length; i++)
+    {
+        unsigned long digit = (unsigned long)(str[i] - '0');
+        if(digit > 9 || result > (limit - digit) / 10)
+        {
+            return false;
+        }
+        result = result * 10 + digit;
+    }
+
+    *value = negative ? (long)(0 - result) : (long)result;
+    return true;
+}
+
+/**
+  * @brief  十进制浮点数转换，格式 [+-]digits[.digits][(e|E)[+-]digits]，结果为最接近的float
+  * @param  str: 字符串
+  * @param  length: 长度
+  * @param  value: 输出值
+  * @retval true: 成功，false: 格式错误
+  */
+bool LineParser::parseFloat(const char* str, uint16_t length, float* value)
+{
+    uint64_t mantissa = 0;
+    int32_t exp10 = 0;
+    uint8_t digits = 0;
+    bool truncated = false;
+    bool negative = false;
+    bool hasDigit = false;
+    uint16_t i = 0;
+
+    if(length && (str[0] == '-' || str[0] == '+'))
+    {
+        negative = (str[0] == '-');
+        i++;
+    }
+
+    /*整数部分，最多保留19位有效数字*/
+    for(; i < length && str[i] >= '0' && str[i] <= '9'; i++)
+    {
+        uint8_t d = str[i] - '0';
+        hasDigit = true;
+        if(mantissa == 0 && d == 0)
+        {
+            continue;
+        }
+        if(digits < 19)
+        {
+            mantissa = mantissa * 10 + d;
+            digits++;
+        }
+        else
+        {
+            exp10++;
+            truncated |= (d != 0);
+        }
+    }
+
+    /*小数部分*/
+    if(i < length && str[i] == '.')
+    {
+        for(i++; i < length && str[i] >= '0' && str[i] <= '9'; i++)
+        {
+            uint8_t d = str[i] - '0';
+            hasDigit = true;
+            if(mantissa == 0 && d == 0)
+            {
+                exp10--;
+                continue;
+            }
+            if(digits < 19)
+            {
+                mantissa = mantissa * 10 + d;
+                digits++;
+                exp10--;
+            }
+            else
+            {
+                truncated |= (d != 0);
+            }
+        }
+    }
+
+    if(!hasDigit)
+    {
+        return false;
+    }
+
+    /*指数部分*/
+    if(i < length && (str[i] == 'e' || str[i] == 'E'))
+    {
+        int32_t e = 0;
+        bool eNegative = false;
+
+        i++;
+        if(i < length && (str[i] == '-' || str[i] == '+'))
+        {
+            eNegative = (str[i] == '-');
+            i++;
+        }
+        if(i >= length)
+        {
+            return false;
+        }
+        for(; i < length && str[i] >= '0' && str[i] <= '9'; i++)
+        {
+            if(e < 100000)
+            {
+                e = e * 10 + (str[i] - '0');
+            }
+        }
+        exp10 += eNegative ? -e : e;
+    }
+
+    if(i != length)
+    {
+        return false;
+    }
+
+    if(mantissa == 0)
+    {
+        *value = negative ? -0.0f : 0.0f;
+        return true;
+    }
+
+    if(!truncated)
+    {
+        /*尾数和10的幂都能被float精确表示，一次运算即为正确舍入*/
+        if(mantissa <= LINE_PARSER_FLOAT_EXACT_MAX && exp10 >= -10 && exp10 <= 10)
+        {
+            float f = (float)mantissa;
+            f = (exp10 < 0) ? f / pow10f[-exp10] : f * pow10f[exp10];
+            *value = negative ? -f : f;
+            return true;
+        }
+
+        /*double运算正确舍入，再转为float；恰好落在两个float中点时二次舍入可能出错*/
+        if(mantissa <= LINE_PARSER_DOUBLE_EXACT_MAX && exp10 >= -22 && exp10 <= 22)
+        {
+            double d = (double)mantissa;
+            uint64_t bits;
+
+            d = (exp10 < 0) ? d / pow10d[-exp10] : d * pow10d[exp10];
+            memcpy(&bits, &d, sizeof(bits));
+
+            if(d >= 1.17549435e-38 && d <= 3.40282347e+38
+                    && (bits & 0x1FFFFFFFULL) != 0x10000000ULL)
+            {
+                float f = (float)d;
+                *value = negative ? -f : f;
+                return true;
+            }
+        }
+    }
+
+    /*其余情况交给标准库*/
+    {
+        char temp[LINE_PARSER_FALLBACK_MAX];
+
+        if(length >= sizeof(temp))
+        {
+            return false;
+        }
+
+        memcpy(temp, str, length);
+        temp[length] = '\0';
+        *value = strtof(temp, NULL);
+        return true;
+    }
+}
+
+/**
+  * @brief  计算NMEA校验和(异或)
+  * @param  str: 参与校验的字符('$'与'*'之间)
+  * @param  length: 长度
+  * @retval 校验和
+  */
+uint8_t LineParser::nmeaChecksum(const char* str, uint16_t length)
+{
+    uint8_t sum = 0;
+
+    while(length--)
+    {
+        sum ^= (uint8_t)*str++;
+    }
+
+    return sum;
+}
+
+/**
+  * @brief  检查NMEA语句的校验和，格式 $...*HH
+  * @param  line: 语句(不含行尾)
+  * @param  length: 长度
+  * @retval true: 校验正确
+  */
+bool LineParser::nmeaCheck(const char* line, uint16_t length)
+{
+    const char* star;
+    uint8_t expected = 0;
+    uint8_t i;
+
+    if(length < 4 || (line[0] != '$' && line[0] != '!'))
+    {
+        return false;
+    }
+
+    star = (const char*)memchr(line, '*', length);
+    if(!star || star + 3 != line + length)
+    {
+        return false;
+    }
+
+    for(i = 1; i <= 2; i++)
+    {
+        char c = star[i];
+        uint8_t v;
+
+        if(c >= '0' && c <= '9')
+            v = c - '0';
+        else if(c >= 'A' && c <= 'F')
+            v = c - 'A' + 10;
+        else if(c >= 'a' && c <= 'f')
+            v = c - 'a' + 10;
+        else
+            return false;
+
+        expected = (expected << 4) | v;
+    }
+
+    return nmeaChecksum(line + 1, (uint16_t)(star - line - 1)) == expected;
+}
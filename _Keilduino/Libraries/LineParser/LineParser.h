@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __LINE_PARSER_H
+#define __LINE_PARSER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+class Stream;
+
+/*
+ * 非阻塞行解析：
+ * feed() 只读取已经收到的数据，不等待超时；没有凑满一行时保留已收到的部分并立即返回，
+ * 凑满一行('\n'结束，忽略'\r')后停止读取，直到调用 next()。
+ * 行内按分隔符切分字段(NMEA的空字段保留)，字段可直接转换为整数/浮点数。
+ * 数值转换为静态函数，可单独使用。
+ */
+class LineParser
+{
+public:
+    typedef struct
+    {
+        const char* str;    // 字段起始，不以'\0'结尾
+        uint16_t length;    // 字段长度
+    } Token_t;
+
+public:
+    LineParser();
+    LineParser(char* buffer, uint16_t size);
+
+    void begin(char* buffer, uint16_t size);
+    void setDelimiters(const char* delimiters, bool merge = false);
+
+    bool feed(Stream& stream);
+    bool feed(const char* data, uint16_t length, uint16_t* used = NULL);
+
+    bool available()
+    {
+        return isReady;
+    }
+    const char* getLine()
+    {
+        return buffer;
+    }
+    uint16_t getLength()
+    {
+        return length;
+    }
+    uint32_t getOverflowCount()
+    {
+        return overflowCount;
+    }
+    void next();
+
+    bool nextToken(Token_t* token);
+    bool nextInt(long* value);
+    bool nextFloat(float* value);
+    void rewind()
+    {
+        cursor = 0;
+        tokenEnd = false;
+    }
+
+    static bool parseInt(const char* str, uint16_t length, long* value);
+    static bool parseFloat(const char* str, uint16_t length, float* value);
+    static uint8_t nmeaChecksum(const char* str, uint16_t length);
+    static bool nmeaCheck(const char* line, uint16_t length);
+
+private:
+    char* buffer;
+    uint16_t size;
+    uint16_t length;
+    uint16_t cursor;
+    bool isReady;
+    bool isOverflow;
+    bool tokenEnd;
+    bool mergeDelimiters;
+    const char* delimiters;
+    uint32_t overflowCount;
+
+    bool isDelimiter(char c);
+    bool put(char c);
+};
+
+#endif
@@ -0,0 +1,518 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "Spectrum.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifndef M_PI
+#  define M_PI 3.14159265358979323846
+#endif
+
+Spectrum::Spectrum()
+    : fftSize(0)
+    , hopSize(0)
+    , frameFill(0)
+    , sampleRate(0)
+    , binWidth(0)
+    , magnitudeScale(0)
+    , powerScale(0)
+    , removeDC(true)
+    , isReady(false)
+    , frameCount(0)
+    , frame(NULL)
+    , work(NULL)
+    , magnitude(NULL)
+    , window(NULL)
+    , callback(NULL)
+    , userData(NULL)
+#if SPECTRUM_USE_CMSIS_DSP
+    , output(NULL)
+#else
+    , twiddle(NULL)
+#endif
+{
+}
+
+Spectrum::~Spectrum()
+{
+    end();
+}
+
+/**
+  * @brief  初始化频谱分析
+  * @param  fftSize: FFT点数，2的幂，范围 32 ~ 4096
+  * @param  sampleRate: 采样率(Hz)
+  * @param  window: 窗函数
+  * @param  overlap: 相邻帧重叠点数，须小于fftSize
+  * @retval true: 成功，false: 参数错误或内存不足
+  */
+bool Spectrum::begin(uint16_t fftSize, float sampleRate, Window_t window, uint16_t overlap)
+{
+    end();
+
+    if(fftSize < SPECTRUM_FFT_SIZE_MIN || fftSize > SPECTRUM_FFT_SIZE_MAX
+            || (fftSize & (fftSize - 1)) != 0
+            || overlap >= fftSize
+            || sampleRate <= 0)
+    {
+        return false;
+    }
+
+    const uint16_t half = fftSize / 2;
+
+    this->frame = (float*)malloc(fftSize * sizeof(float));
+    this->work = (float*)malloc(fftSize * sizeof(float));
+    this->magnitude = (float*)malloc(half * sizeof(float));
+    this->window = (float*)malloc((half + 1) * sizeof(float));
+#if SPECTRUM_USE_CMSIS_DSP
+    this->output = (float*)malloc(fftSize * sizeof(float));
+    bool success = (this->output != NULL)
+                   && (arm_rfft_fast_init_f32(&rfftInstance, fftSize) == ARM_MATH_SUCCESS);
+#else
+    this->twiddle = (float*)malloc(fftSize * sizeof(float));
+    bool success = (this->twiddle != NULL);
+#endif
+
+    if(!success || !this->frame || !this->work || !this->magnitude || !this->window)
+    {
+        end();
+        return false;
+    }
+
+    this->fftSize = fftSize;
+    this->hopSize = fftSize - overlap;
+    this->sampleRate = sampleRate;
+    this->binWidth = sampleRate / fftSize;
+    memset(this->magnitude, 0, half * sizeof(float));
+
+    /* 周期窗，w[n] = w[fftSize - n]，只保存 0 ~ fftSize/2 */
+    for(uint16_t i = 0; i <= half; i++)
+    {
+        double x = 2.0 * M_PI * i / fftSize;
+        double w;
+        switch(window)
+        {
+        case WINDOW_HANN:
+            w = 0.5 - 0.5 * cos(x);
+            break;
+        case WINDOW_HAMMING:
+            w = 0.54 - 0.46 * cos(x);
+            break;
+        case WINDOW_BLACKMAN:
+            w = 0.42 - 0.5 * cos(x) + 0.08 * cos(2 * x);
+            break;
+        default:
+            w = 1.0;
+            break;
+        }
+        this->window[i] = (float)w;
+    }
+
+    /* 相干增益S1与能量增益S2，用于幅值和功率归一化 */
+    double s1 = 0, s2 = 0;
+    for(uint16_t i = 0; i < fftSize; i++)
+    {
+        float w = this->window[i <= half ? i : fftSize - i];
+        s1 += w;
+        s2 += (double)w * w;
+    }
+    magnitudeScale = (float)(2.0 / s1);
+    powerScale = (float)((s1 * s1) / (2.0 * fftSize * s2));
+
+#if !SPECTRUM_USE_CMSIS_DSP
+    for(uint16_t k = 0; k < half; k++)
+    {
+        double x = 2.0 * M_PI * k / fftSize;
+        twiddle[2 * k] = (float)cos(x);
+        twiddle[2 * k + 1] = (float)sin(x);
+    }
+#endif
+
+    return true;
+}
+
+/**
+  * @brief  释放频谱分析占用的内存
+  * @param  无
+  * @retval 无
+  */
+void Spectrum::end()
+{
+    free(frame);
+    free(work);
+    free(magnitude);
+    free(window);
+    frame = work = magnitude = window = NULL;
+#if SPECTRUM_USE_CMSIS_DSP
+    free(output);
+    output = NULL;
+#else
+    free(twiddle);
+    twiddle = NULL;
+#endif
+    fftSize = 0;
+    frameFill = 0;
+    frameCount = 0;
+    isReady = false;
+}
+
+/**
+  * @brief  设置帧完成回调，在push()中调用
+  * @param  callback: 回调函数
+  * @param  userData: 用户数据
+  * @retval 无
+  */
+void Spectrum::setCallback(Callback_t callback, void* userData)
+{
+    this->callback = callback;
+    this->userData = userData;
+}
+
+/**
+  * @brief  写入ADC采样块
+  * @param  samples: 采样数据
+  * @param  length: 采样点数
+  * @retval 本次完成的帧数
+  */
+uint16_t Spectrum::push(const uint16_t* samples, uint16_t length)
+{
+    uint16_t frames = 0;
+
+    if(!fftSize)
+    {
+        return 0;
+    }
+
+    while(length--)
+    {
+        frame[frameFill++] = *samples++;
+        if(frameFill == fftSize)
+        {
+            process();
+            frames++;
+        }
+    }
+    return frames;
+}
+
+/**
+  * @brief  写入浮点采样块
+  * @param  samples: 采样数据
+  * @param  length: 采样点数
+  * @retval 本次完成的帧数
+  */
+uint16_t Spectrum::push(const float* samples, uint16_t length)
+{
+    uint16_t frames = 0;
+
+    if(!fftSize)
+    {
+        return 0;
+    }
+
+    while(length--)
+    {
+        frame[frameFill++] = *samples++;
+        if(frameFill == fftSize)
+        {
+            process();
+            frames++;
+        }
+    }
+    return frames;
+}
+
+/**
+  * @brief  是否有新的频谱，读取后清除
+  * @param  无
+  * @retval true: 有新的频谱
+  */
+bool Spectrum::available()
+{
+    bool ready = isReady;
+    isReady = false;
+    return ready;
+}
+
+/**
+  * @brief  查找幅值最大的若干个局部峰值，按幅值降序排列
+  * @param  peaks: 输出数组
+  * @param  maxPeaks: 数组长度
+  * @param  threshold: 幅值门限
+  * @retval 找到的峰值个数
+  */
+uint16_t Spectrum::findPeaks(Peak_t* peaks, uint16_t maxPeaks, float threshold)
+{
+    uint16_t count = 0;
+    const uint16_t bins = fftSize / 2;
+
+    if(!fftSize || !maxPeaks)
+    {
+        return 0;
+    }
+
+    for(uint16_t k = 1; k + 1 < bins; k++)
+    {
+        float a = magnitude[k - 1];
+        float b = magnitude[k];
+        float c = magnitude[k + 1];
+
+        if(b <= threshold || b <= a || b < c)
+        {
+            continue;
+        }
+
+        /* 插入排序，丢弃最小的 */
+        uint16_t pos = count;
+        while(pos > 0 && peaks[pos - 1].magnitude < b)
+        {
+            if(pos < maxPeaks)
+            {
+                peaks[pos] = peaks[pos - 1];
+            }
+            pos--;
+        }
+        if(pos >= maxPeaks)
+        {
+            continue;
+        }
+
+        /* 抛物线插值修正频率 */
+        float denom = a - 2 * b + c;
+        float delta = (denom != 0.0f) ? 0.5f * (a - c) / denom : 0.0f;
+
+        peaks[pos].bin = k;
+        peaks[pos].frequency = (k + delta) * binWidth;
+        peaks[pos].magnitude = b;
+
+        if(count < maxPeaks)
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+  * @brief  计算频带内信号的均方值(含窗函数等效噪声带宽修正)
+  * @param  freqLow: 频带下限(Hz)，包含
+  * @param  freqHigh: 频带上限(Hz)，不包含
+  * @retval 均方值，单位为输入单位的平方
+  */
+float Spectrum::getBandEnergy(float freqLow, float freqHigh)
+{
+    const uint16_t bins = fftSize / 2;
+    float energy = 0;
+
+    if(!fftSize || freqHigh <= freqLow)
+    {
+        return 0;
+    }
+
+    int32_t kStart = (int32_t)ceilf(freqLow / binWidth);
+    int32_t kEnd = (int32_t)ceilf(freqHigh / binWidth);
+
+    if(kStart < 0)
+    {
+        kStart = 0;
+    }
+    if(kEnd > bins)
+    {
+        kEnd = bins;
+    }
+
+    for(int32_t k = kStart; k < kEnd; k++)
+    {
+        float m = magnitude[k];
+        energy += (k == 0) ? 2 * m * m : m * m;
+    }
+
+    return energy * powerScale;
+}
+
+void Spectrum::process()
+{
+    const uint16_t half = fftSize / 2;
+    float mean = 0;
+
+    if(removeDC)
+    {
+        for(uint16_t i = 0; i < fftSize; i++)
+        {
+            mean += frame[i];
+        }
+        mean /= fftSize;
+    }
+
+    for(uint16_t i = 0; i < fftSize; i++)
+    {
+        work[i] = (frame[i] - mean) * window[i <= half ? i : fftSize - i];
+    }
+
+    const float* spec = realFFT(work);
+
+    /* 打包格式：spec[0]=直流，spec[1]=奈奎斯特，其余为实部/虚部对 */
+    magnitude[0] = fabsf(spec[0]) * magnitudeScale * 0.5f;
+#if SPECTRUM_USE_CMSIS_DSP
+    arm_cmplx_mag_f32((float32_t*)spec + 2, magnitude + 1, half - 1);
+    arm_scale_f32(magnitude + 1, magnitudeScale, magnitude + 1, half - 1);
+#else
+    for(uint16_t k = 1; k < half; k++)
+    {
+        float re = spec[2 * k];
+        float im = spec[2 * k + 1];
+        magnitude[k] = sqrtf(re * re + im * im) * magnitudeScale;
+    }
+#endif
+
+    /* 保留重叠部分 */
+    frameFill = fftSize - hopSize;
+    if(frameFill)
+    {
+        memmove(frame, frame + hopSize, frameFill * sizeof(float));
+    }
+
+    frameCount++;
+    isReady = true;
+
+    if(callback)
+    {
+        callback(this, userData);
+    }
+}
+
+#if SPECTRUM_USE_CMSIS_DSP
+
+const float* Spectrum::realFFT(float* data)
+{
+    /* arm_rfft_fast_f32 不支持原地计算，且会破坏输入 */
+    arm_rfft_fast_f32(&rfftInstance, data, output, 0);
+    return output;
+}
+
+#else
+
+/**
+  * @brief  原地基2复数FFT
+  * @param  data: 交错存放的复数数组(re, im)
+  * @param  n: 复数点数，fftSize/2
+  * @retval 无
+  */
+void Spectrum::complexFFT(float* data, uint16_t n)
+{
+    /* 位反转重排 */
+    for(uint16_t i = 1, j = 0; i < n; i++)
+    {
+        uint16_t bit = n >> 1;
+        for(; j & bit; bit >>= 1)
+        {
+            j ^= bit;
+        }
+        j ^= bit;
+
+        if(i < j)
+        {
+            float t;
+            t = data[2 * i];
+            data[2 * i] = data[2 * j];
+            data[2 * j] = t;
+            t = data[2 * i + 1];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j + 1] = t;
+        }
+    }
+
+    /* n点FFT的旋转因子 W_n^k = W_fftSize^(k*fftSize/n) */
+    for(uint16_t len = 2; len <= n; len <<= 1)
+    {
+        const uint16_t halfLen = len >> 1;
+        const uint16_t step = fftSize / len;
+
+        for(uint16_t i = 0; i < n; i += len)
+        {
+            for(uint16_t k = 0; k < halfLen; k++)
+            {
+                float wr = twiddle[2 * k * step];
+                float wi = -twiddle[2 * k * step + 1];
+
+                float* p = data + 2 * (i + k);
+                float* q = p + 2 * halfLen;
+
+                float tr = q[0] * wr - q[1] * wi;
+                float ti = q[0] * wi + q[1] * wr;
+
+                q[0] = p[0] - tr;
+                q[1] = p[1] - ti;
+                p[0] += tr;
+                p[1] += ti;
+            }
+        }
+    }
+}
+
+/**
+  * @brief  实数FFT，fftSize个实数视为fftSize/2个复数做复数FFT后拆分，
+  *         输出格式与 arm_rfft_fast_f32 一致
+  * @param  data: 输入实数，原地输出打包后的频谱
+  * @retval 频谱地址
+  */
+const float* Spectrum::realFFT(float* data)
+{
+    const uint16_t n = fftSize / 2;
+
+    complexFFT(data, n);
+
+    float z0r = data[0];
+    float z0i = data[1];
+    data[0] = z0r + z0i;
+    data[1] = z0r - z0i;
+
+    for(uint16_t k = 1; k <= n / 2; k++)
+    {
+        float* zk = data + 2 * k;
+        float* zm = data + 2 * (n - k);
+
+        /* E = (Z[k] + conj(Z[n-k])) / 2, O = (Z[k] - conj(Z[n-k])) / 2j */
+        float er = 0.5f * (zk[0] + zm[0]);
+        float ei = 0.5f * (zk[1] - zm[1]);
+        float or_ = 0.5f * (zk[1] + zm[1]);
+        float oi = -0.5f * (zk[0] - zm[0]);
+
+        /* T = W^k * O，X[k] = E + T，X[n-k] = conj(E - T) */
+        float wr = twiddle[2 * k];
+        float wi = -twiddle[2 * k + 1];
+        float tr = or_ * wr - oi * wi;
+        float ti = or_ * wi + oi * wr;
+
+        zk[0] = er + tr;
+        zk[1] = ei + ti;
+        zm[0] = er - tr;
+        zm[1] = -(ei - ti);
+    }
+
+    return data;
+}
+
+#endif
@@ -0,0 +1,146 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __SPECTRUM_H
+#define __SPECTRUM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * 定义 ARM_MATH_CM4/ARM_MATH_CM7 时使用 CMSIS-DSP 的 arm_rfft_fast_f32，否则使用可移植实现。
+ * AT32F43x 工程已定义 ARM_MATH_CM4 并加入 CMSIS:DSP 组件；其他工程需同时加入DSP库，
+ * 也可定义 SPECTRUM_USE_CMSIS_DSP 为 0/1 强制选择。
+ */
+#ifndef SPECTRUM_USE_CMSIS_DSP
+#  if defined(ARM_MATH_CM4) || defined(ARM_MATH_CM7)
+#    define SPECTRUM_USE_CMSIS_DSP 1
+#  else
+#    define SPECTRUM_USE_CMSIS_DSP 0
+#  endif
+#endif
+
+#if SPECTRUM_USE_CMSIS_DSP
+#  include "arm_math.h"
+#endif
+
+#define SPECTRUM_FFT_SIZE_MIN   32
+#define SPECTRUM_FFT_SIZE_MAX   4096
+
+/*
+ * 分块频谱分析：
+ * 采样块(例如 ADC_Stream 的半缓冲)经 push() 写入帧缓冲，
+ * 每凑满一帧(fftSize点)执行 去直流 -> 加窗 -> 实数FFT -> 幅值谱，
+ * 之后保留 overlap 点作为下一帧的开头。
+ * FFT 计算量较大，push() 应在主循环中调用，不要放在中断里。
+ */
+class Spectrum
+{
+public:
+    typedef enum
+    {
+        WINDOW_RECTANGLE,
+        WINDOW_HANN,
+        WINDOW_HAMMING,
+        WINDOW_BLACKMAN
+    } Window_t;
+
+    typedef struct
+    {
+        uint16_t bin;       // 峰值所在频点
+        float frequency;    // 插值后的频率(Hz)
+        float magnitude;    // 幅值(与输入同单位的正弦幅度)
+    } Peak_t;
+
+    typedef void(*Callback_t)(Spectrum* spectrum, void* userData);
+
+public:
+    Spectrum();
+    ~Spectrum();
+
+    bool begin(uint16_t fftSize, float sampleRate, Window_t window = WINDOW_HANN, uint16_t overlap = 0);
+    void end();
+
+    void setCallback(Callback_t callback, void* userData = NULL);
+    void setRemoveDC(bool enable)
+    {
+        removeDC = enable;
+    }
+
+    uint16_t push(const uint16_t* samples, uint16_t length);
+    uint16_t push(const float* samples, uint16_t length);
+
+    bool available();
+
+    const float* getMagnitude()
+    {
+        return magnitude;
+    }
+    uint16_t getBinCount()
+    {
+        return fftSize / 2;
+    }
+    float getBinFrequency(uint16_t bin)
+    {
+        return bin * binWidth;
+    }
+    uint32_t getFrameCount()
+    {
+        return frameCount;
+    }
+
+    uint16_t findPeaks(Peak_t* peaks, uint16_t maxPeaks, float threshold = 0.0f);
+    float getBandEnergy(float freqLow, float freqHigh);
+
+private:
+    uint16_t fftSize;
+    uint16_t hopSize;
+    uint16_t frameFill;
+    float sampleRate;
+    float binWidth;
+    float magnitudeScale;
+    float powerScale;
+    bool removeDC;
+    volatile bool isReady;
+    uint32_t frameCount;
+
+    float* frame;       // 帧缓冲 fftSize
+    float* work;        // FFT工作区 fftSize
+    float* magnitude;   // 幅值谱 fftSize/2
+    float* window;      // 窗函数(对称，仅存前半) fftSize/2+1
+
+    Callback_t callback;
+    void* userData;
+
+#if SPECTRUM_USE_CMSIS_DSP
+    arm_rfft_fast_instance_f32 rfftInstance;
+    float* output;      // FFT输出 fftSize
+#else
+    float* twiddle;     // cos/sin(2*pi*k/fftSize), k < fftSize/2
+    void complexFFT(float* data, uint16_t n);
+#endif
+
+    const float* realFFT(float* data);
+    void process();
+};
+
+#endif
@@ -93,6 +93,7 @@ public:
     virtual int peek(void);
     virtual int read(void);
     virtual void flush(void);
+    virtual int availableForWrite(void);
 
     virtual size_t write(uint8_t n);
     inline size_t write(unsigned long n)
@@ -33,6 +33,7 @@
 
 /* Hardware Serial */
 #define SERIAL_RX_BUFFER_SIZE               128
+#define SERIAL_TX_BUFFER_SIZE               128
 #define SERIAL_PREEMPTIONPRIORITY_DEFAULT   1
 #define SERIAL_SUBPRIORITY_DEFAULT          3
 #define SERIAL_CONFIG_DEFAULT               SERIAL_8N1
@@ -108,18 +109,155 @@
 /* External Interrupt  */
 #define EXTI_PREEMPTIONPRIORITY_DEFAULT     2
 #define EXTI_SUBPRIORITY_DEFAULT            1
+#define EXTI_QUEUE_ENABLE                   0
+#define EXTI_QUEUE_SIZE                     64
 
 /* Timer Interrupt */
 #define TIMER_PREEMPTIONPRIORITY_DEFAULT    0
 #define TIMER_SUBPRIORITY_DEFAULT           3
 
 /* Tone */
-#define TONE_TIMER_DEFAULT                  TIM1
+#define TONE_TIMER_DEFAULT                  TIM6
 #define TONE_PREEMPTIONPRIORITY_DEFAULT     0
 #define TONE_SUBPRIORITY_DEFAULT            1
+#define TONE_HARDWARE_ENABLE                1
+#define TONE_HARDWARE_MAX                   4
 
 /* PWM */
 #define PWM_RESOLUTION_DEFAULT              1000
 #define PWM_FREQUENCY_DEFAULT               10000
 
+/* ADC Stream (Timer triggered, DMA double buffer) */
+#define ADC_STREAM_ENABLE                   0
+#if ADC_STREAM_ENABLE
+#  define ADC_STREAM_ADC                    ADC2
+#  define ADC_STREAM_SAMPLETIME             ADC_SAMPLETIME_47_5
+#  define ADC_STREAM_TIMER                  TIM2
+#  define ADC_STREAM_TRIGGER                ADC_ORDINARY_TRIG_TMR2TRGOUT
+#  define ADC_STREAM_DMA                    DMA1
+#  define ADC_STREAM_DMA_CHANNEL            DMA1_CHANNEL2
+#  define ADC_STREAM_DMAMUX_CHANNEL         DMA1MUX_CHANNEL2
+#  define ADC_STREAM_DMAREQ_ID              DMAMUX_DMAREQ_ID_ADC2
+#  define ADC_STREAM_DMA_HDT_FLAG           DMA1_HDT2_FLAG
+#  define ADC_STREAM_DMA_FDT_FLAG           DMA1_FDT2_FLAG
+#  define ADC_STREAM_DMA_IRQn               DMA1_Channel2_IRQn
+#  define ADC_STREAM_IRQ_HANDLER_DEF()      void DMA1_Channel2_IRQHandler(void)
+#  define ADC_STREAM_PREEMPTIONPRIORITY     1
+#  define ADC_STREAM_SUBPRIORITY            0
+#endif
+
+/* GPIO Wave (Timer triggered DMA to GPIO scr) */
+#define GPIO_WAVE_ENABLE                    0
+#if GPIO_WAVE_ENABLE
+#  define GPIO_WAVE_TIMER                   TIM7
+#  define GPIO_WAVE_DMA                     DMA1
+#  define GPIO_WAVE_DMA_CHANNEL             DMA1_CHANNEL3
+#  define GPIO_WAVE_DMAMUX_CHANNEL          DMA1MUX_CHANNEL3
+#  define GPIO_WAVE_DMAREQ_ID               DMAMUX_DMAREQ_ID_TMR7_OVERFLOW
+#  define GPIO_WAVE_DMA_HDT_FLAG            DMA1_HDT3_FLAG
+#  define GPIO_WAVE_DMA_FDT_FLAG            DMA1_FDT3_FLAG
+#  define GPIO_WAVE_DMA_IRQn                DMA1_Channel3_IRQn
+#  define GPIO_WAVE_IRQ_HANDLER_DEF()       void DMA1_Channel3_IRQHandler(void)
+#  define GPIO_WAVE_PREEMPTIONPRIORITY      1
+#  define GPIO_WAVE_SUBPRIORITY             1
+#endif
+
+/* Input Capture (PWM input mode, CH1/CH2 pins) */
+#define CAPTURE_ENABLE                      0
+#if CAPTURE_ENABLE
+#  define CAPTURE_MAX                       8
+#  define CAPTURE_PREEMPTIONPRIORITY        1
+#  define CAPTURE_SUBPRIORITY               2
+#endif
+
+/* Quadrature Encoder */
+#define ENCODER_ENABLE                      0
+#if ENCODER_ENABLE
+#  define ENCODER_MAX                       4
+#  define ENCODER_PREEMPTIONPRIORITY        1
+#  define ENCODER_SUBPRIORITY               3
+#endif
+
+/* PWM Wave (Timer DMA burst to CxDT) */
+#define PWM_WAVE_ENABLE                     0
+#if PWM_WAVE_ENABLE
+#  define PWM_WAVE_DMA                      DMA1
+#  define PWM_WAVE_DMA_CHANNEL              DMA1_CHANNEL4
+#  define PWM_WAVE_DMAMUX_CHANNEL           DMA1MUX_CHANNEL4
+#  define PWM_WAVE_DMA_HDT_FLAG             DMA1_HDT4_FLAG
+#  define PWM_WAVE_DMA_FDT_FLAG             DMA1_FDT4_FLAG
+#  define PWM_WAVE_DMA_IRQn                 DMA1_Channel4_IRQn
+#  define PWM_WAVE_IRQ_HANDLER_DEF()        void DMA1_Channel4_IRQHandler(void)
+#  define PWM_WAVE_PREEMPTIONPRIORITY       1
+#  define PWM_WAVE_SUBPRIORITY              1
+#endif
+
+/* Soft Timer (timing wheel on one 32-bit timer, 1us tick) */
+#define SOFT_TIMER_ENABLE                   0
+#if SOFT_TIMER_ENABLE
+#  define SOFT_TIMER_TIMER                  TIM5
+#  define SOFT_TIMER_PREEMPTIONPRIORITY     0
+#  define SOFT_TIMER_SUBPRIORITY            2
+#endif
+
+/* Servo Sequencer (compare-match, any GPIO, 4 lanes per timer) */
+#define SERVO_SEQ_ENABLE                    0
+#if SERVO_SEQ_ENABLE
+#  define SERVO_SEQ_TIMER                   TIM4
+#  define SERVO_SEQ_MAX                     24
+#  define SERVO_SEQ_FRAME_TIME              20000
+#  define SERVO_SEQ_PULSE_MIN               500
+#  define SERVO_SEQ_PULSE_MAX               2500
+#  define SERVO_SEQ_GUARD                   100
+#  define SERVO_SEQ_PREEMPTIONPRIORITY      0
+#  define SERVO_SEQ_SUBPRIORITY             1
+#endif
+
+/* Debounce (EXTI wake + soft timer scan, vertical counter) */
+#define DEBOUNCE_ENABLE                     0
+#if DEBOUNCE_ENABLE
+#  define DEBOUNCE_SCAN_TIME                5000
+#  define DEBOUNCE_PREEMPTIONPRIORITY       SOFT_TIMER_PREEMPTIONPRIORITY
+#  define DEBOUNCE_SUBPRIORITY              3
+#endif
+
+/* Coroutine (cooperative, PendSV context switch) */
+#define COROUTINE_ENABLE                    0
+
+/* Deferred work (ISR posts, main loop or lowest-priority SWI executes) */
+#define DEFER_ENABLE                        0
+#if DEFER_ENABLE
+#  define DEFER_PRIORITY_NUM                3
+#  define DEFER_QUEUE_SIZE                  32
+#  define DEFER_SWI_ENABLE                  0
+#  define DEFER_SWI_IRQn                    ACC_IRQn
+#  define DEFER_SWI_IRQ_HANDLER_DEF()       void ACC_IRQHandler(void)
+#  define DEFER_SWI_PREEMPTIONPRIORITY      3
+#  define DEFER_SWI_SUBPRIORITY             3
+#endif
+
+/* Binary log (format ID + raw arguments, decoded on PC) */
+#define BINLOG_ENABLE                       0
+#if BINLOG_ENABLE
+#  define BINLOG_BUFFER_SIZE                256 // words, power of 2
+#  define BINLOG_TIMESTAMP()                (DWT->CYCCNT)
+#endif
+
+/* Memory diagnostics (stack/heap painting, malloc accounting, stack guard) */
+#define MEM_DIAG_ENABLE                     0
+#if MEM_DIAG_ENABLE
+#  define MEM_DIAG_HEAP_WRAP                1
+#  define MEM_DIAG_STACK_GUARD              1 // 0: none, 1: canary, 2: MPU no-access region
+#  define MEM_DIAG_MPU_REGION               7
+#endif
+
+/* RAM functions (hot ISRs run from SRAM, needs MDK-ARM/proj.sct) */
+#define RAMFUNC_ISR_ENABLE                  0
+
+/* SRAM/ZW flash split programmed in EOPB0[2:0], sizes RW_IRAM1 in MDK-ARM/proj.sct (see Core/sram.h) */
+#define SRAM_EOPB0                          0x02 // 384KB SRAM / 256KB ZW, factory default
+
+/* Profiling probes (DWT cycle statistics and log2 histograms) */
+#define PROF_ENABLE                         0
+
 #endif
@@ -81,8 +81,11 @@ HardwareSerial::HardwareSerial(usart_type* usart)
     , _callbackFunction(NULL)
     , _rxBufferHead(0)
     , _rxBufferTail(0)
+    , _txBufferHead(0)
+    , _txBufferTail(0)
 {
     memset(_rxBuffer, 0, sizeof(_rxBuffer));
+    memset(_txBuffer, 0, sizeof(_txBuffer));
 }
 
 /**
@@ -90,11 +93,12 @@ HardwareSerial::HardwareSerial(usart_type* usart)
   * @param  无
   * @retval 无
   */
-void HardwareSerial::IRQHandler()
+RAMFUNC_ISR void HardwareSerial::IRQHandler()
 {
-    if(usart_flag_get(_USARTx, USART_RDBF_FLAG) != RESET)
+    /*直接访问寄存器，避免在RAM中执行时调用闪存中的库函数*/
+    if(_USARTx->sts & USART_RDBF_FLAG)
     {
-        uint8_t c = usart_data_receive(_USARTx);
+        uint8_t c = (uint8_t)_USARTx->dt;
         uint16_t i = (uint16_t)(_rxBufferHead + 1) % SERIAL_RX_BUFFER_SIZE;
         if (i != _rxBufferTail)
         {
@@ -102,11 +106,27 @@ void HardwareSerial::IRQHandler()
             _rxBufferHead = i;
         }
 
+        /*用户回调在闪存中执行，除非回调本身加了RAMFUNC*/
         if(_callbackFunction)
         {
             _callbackFunction(this, c, _callbackUserData);
         }
-        usart_flag_clear(_USARTx, USART_RDBF_FLAG);
+        _USARTx->sts = ~USART_RDBF_FLAG;
+    }
+
+    /*发送缓冲：每次发送一个字节，缓冲空时关闭发送中断*/
+    if(_USARTx->ctrl1_bit.tdbeien && (_USARTx->sts & USART_TDBE_FLAG))
+    {
+        if(_txBufferHead != _txBufferTail)
+        {
+            _USARTx->dt = _txBuffer[_txBufferTail];
+            _txBufferTail = (uint16_t)(_txBufferTail + 1) % SERIAL_TX_BUFFER_SIZE;
+        }
+
+        if(_txBufferHead == _txBufferTail)
+        {
+            _USARTx->ctrl1_bit.tdbeien = FALSE;
+        }
     }
 }
 
@@ -230,7 +250,9 @@ void HardwareSerial::begin(
 void HardwareSerial::end(void)
 {
     usart_interrupt_enable(_USARTx, USART_RDBF_INT, FALSE);
+    usart_interrupt_enable(_USARTx, USART_TDBE_INT, FALSE);
     usart_enable(_USARTx, FALSE);
+    _txBufferTail = _txBufferHead;
 }
 
 /**
@@ -293,31 +315,90 @@ int HardwareSerial::peek(void)
 }
 
 /**
-  * @brief  清空串口缓存
+  * @brief  等待发送完成：发送缓冲为空且最后一个字节已移出移位寄存器
   * @param  无
   * @retval 无
+  * @note   与Arduino一致，不清空接收缓冲；关中断时也能完成
   */
 void HardwareSerial::flush(void)
 {
-    _rxBufferHead = _rxBufferTail;
+    if(!_USARTx->ctrl1_bit.uen)
+    {
+        return;
+    }
+
+    while(_txBufferHead != _txBufferTail)
+    {
+        txPoll();
+    }
+
+    while(!(_USARTx->sts & USART_TDC_FLAG));
 }
 
 /**
-  * @brief  串口写入一个字节
+  * @brief  不等待即可写入的字节数
+  * @param  无
+  * @retval 发送缓冲的剩余空间
+  */
+int HardwareSerial::availableForWrite(void)
+{
+    uint16_t head = _txBufferHead;
+    uint16_t tail = _txBufferTail;
+    return SERIAL_TX_BUFFER_SIZE - 1 - ((unsigned int)(SERIAL_TX_BUFFER_SIZE + head - tail)) % SERIAL_TX_BUFFER_SIZE;
+}
+
+/**
+  * @brief  在关中断状态下直接发送缓冲中的一个字节
+  * @param  无
+  * @retval 无
+  * @note   发送缓冲满时调用，关中断或在同级/更高优先级中断中写入时不会死等发送中断
+  */
+void HardwareSerial::txPoll()
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    if(_txBufferHead != _txBufferTail && (_USARTx->sts & USART_TDBE_FLAG))
+    {
+        _USARTx->dt = _txBuffer[_txBufferTail];
+        _txBufferTail = (uint16_t)(_txBufferTail + 1) % SERIAL_TX_BUFFER_SIZE;
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  串口写入一个字节，放入发送缓冲后由中断发送
   * @param  写入的字节
   * @retval 字节
   */
 size_t HardwareSerial::write(uint8_t n)
 {
-    while(usart_flag_get(_USARTx, USART_TDBE_FLAG) == RESET) {};
-    usart_data_transmit(_USARTx, n);
+    uint16_t i;
+
+    /*缓冲为空且发送寄存器空闲时直接发送*/
+    if(_txBufferHead == _txBufferTail && (_USARTx->sts & USART_TDBE_FLAG))
+    {
+        _USARTx->dt = n;
+        return 1;
+    }
+
+    i = (uint16_t)(_txBufferHead + 1) % SERIAL_TX_BUFFER_SIZE;
+    while(i == _txBufferTail)
+    {
+        txPoll();
+    }
+
+    _txBuffer[_txBufferHead] = n;
+    _txBufferHead = i;
+    _USARTx->ctrl1_bit.tdbeien = TRUE;
     return 1;
 }
 
 #if SERIAL_1_ENABLE
 HardwareSerial Serial(SERIAL_1_USART);
 
-extern "C" SERIAL_1_IRQ_HANDLER_DEF()
+extern "C" RAMFUNC_ISR SERIAL_1_IRQ_HANDLER_DEF()
 {
     Serial.IRQHandler();
 }
@@ -326,7 +407,7 @@ extern "C" SERIAL_1_IRQ_HANDLER_DEF()
 #if SERIAL_2_ENABLE
 HardwareSerial Serial2(SERIAL_2_USART);
 
-extern "C" SERIAL_2_IRQ_HANDLER_DEF()
+extern "C" RAMFUNC_ISR SERIAL_2_IRQ_HANDLER_DEF()
 {
     Serial2.IRQHandler();
 }
@@ -335,7 +416,7 @@ extern "C" SERIAL_2_IRQ_HANDLER_DEF()
 #if SERIAL_3_ENABLE
 HardwareSerial Serial3(SERIAL_3_USART);
 
-extern "C" SERIAL_3_IRQ_HANDLER_DEF()
+extern "C" RAMFUNC_ISR SERIAL_3_IRQ_HANDLER_DEF()
 {
     Serial3.IRQHandler();
 }
@@ -344,7 +425,7 @@ extern "C" SERIAL_3_IRQ_HANDLER_DEF()
 #if SERIAL_4_ENABLE
 HardwareSerial Serial4(SERIAL_4_USART);
 
-extern "C" SERIAL_4_IRQ_HANDLER_DEF()
+extern "C" RAMFUNC_ISR SERIAL_4_IRQ_HANDLER_DEF()
 {
     Serial4.IRQHandler();
 }
@@ -353,7 +434,7 @@ extern "C" SERIAL_4_IRQ_HANDLER_DEF()
 #if SERIAL_5_ENABLE
 HardwareSerial Serial5(SERIAL_5_USART);
 
-extern "C" SERIAL_5_IRQ_HANDLER_DEF()
+extern "C" RAMFUNC_ISR SERIAL_5_IRQ_HANDLER_DEF()
 {
     Serial5.IRQHandler();
 }
@@ -93,6 +93,7 @@ public:
     virtual int peek(void);
     virtual int read(void);
     virtual void flush(void);
+    virtual int availableForWrite(void);
 
     virtual size_t write(uint8_t n);
     inline size_t write(unsigned long n)
@@ -126,6 +127,11 @@ private:
     volatile uint16_t _rxBufferHead;
     volatile uint16_t _rxBufferTail;
     uint8_t _rxBuffer[SERIAL_RX_BUFFER_SIZE];
+    volatile uint16_t _txBufferHead;
+    volatile uint16_t _txBufferTail;
+    uint8_t _txBuffer[SERIAL_TX_BUFFER_SIZE];
+
+    void txPoll();
 };
 
 #if SERIAL_1_ENABLE
@@ -21,7 +21,7 @@
  * SOFTWARE.
  */
 #include "adc.h"
-#include <stdbool.h>
+#include "timer.h"
 
 #define ADC_DMA_REGMAX 18
 
@@ -282,3 +282,210 @@ uint16_t ADC_DMA_GetValue(uint8_t ADC_Channel)
 
     return ADC_DMA_ConvertedValue[index];
 }
+
+#if ADC_STREAM_ENABLE
+
+/*ADC Stream 双缓冲(长度为块长度的两倍)*/
+static uint16_t* ADC_Stream_Buffer = NULL;
+
+/*ADC Stream 块长度*/
+static uint16_t ADC_Stream_BlockSize = 0;
+
+/*块就绪回调(在DMA中断中执行)*/
+static ADC_Stream_CallbackFunction_t ADC_Stream_Callback = NULL;
+static void* ADC_Stream_UserData = NULL;
+
+/*未设置回调时，最新就绪的数据块，由ADC_Stream_GetBlock取走*/
+static const uint16_t* volatile ADC_Stream_ReadyBlock = NULL;
+
+/*数据块未被及时取走的次数*/
+static volatile uint32_t ADC_Stream_OverrunCount = 0;
+
+/**
+  * @brief  ADC Stream 配置：定时器溢出触发单通道采样，DMA循环搬运到双缓冲
+  * @param  ADC_Channel: ADC通道号
+  * @param  SampleRate: 采样率(Hz)
+  * @param  Buffer: 采样缓冲区，长度必须为 BlockSize * 2
+  * @param  BlockSize: 数据块长度(采样点)
+  * @retval true: 配置成功
+  */
+bool ADC_Stream_Init(uint8_t ADC_Channel, uint32_t SampleRate, uint16_t* Buffer, uint16_t BlockSize)
+{
+    dma_init_type dma_init_structure;
+
+    if(!IS_ADC_CHANNEL(ADC_Channel) || Buffer == NULL || BlockSize == 0 || BlockSize > 0x7FFF)
+        return false;
+
+    /*采样定时器，溢出事件作为TRGOUT*/
+    Timer_ClockCmd(ADC_STREAM_TIMER, true);
+    Timer_SetEnable(ADC_STREAM_TIMER, false);
+    if(!Timer_SetInterruptFreqUpdate(ADC_STREAM_TIMER, SampleRate))
+        return false;
+    tmr_primary_mode_select(ADC_STREAM_TIMER, TMR_PRIMARY_SEL_OVERFLOW);
+
+    ADC_Stream_Buffer = Buffer;
+    ADC_Stream_BlockSize = BlockSize;
+    ADC_Stream_ReadyBlock = NULL;
+    ADC_Stream_OverrunCount = 0;
+
+    /*DMA循环模式，半满和全满各产生一次中断*/
+    crm_periph_clock_enable(
+        (ADC_STREAM_DMA == DMA1) ? CRM_DMA1_PERIPH_CLOCK : CRM_DMA2_PERIPH_CLOCK,
+        TRUE
+    );
+
+    dma_reset(ADC_STREAM_DMA_CHANNEL);
+
+    dma_default_para_init(&dma_init_structure);
+    dma_init_structure.buffer_size = BlockSize * 2;
+    dma_init_structure.direction = DMA_DIR_PERIPHERAL_TO_MEMORY;
+    dma_init_structure.memory_base_addr = (uint32_t)Buffer;
+    dma_init_structure.memory_data_width = DMA_MEMORY_DATA_WIDTH_HALFWORD;
+    dma_init_structure.memory_inc_enable = TRUE;
+    dma_init_structure.peripheral_base_addr = (uint32_t) (&(ADC_STREAM_ADC->odt));
+    dma_init_structure.peripheral_data_width = DMA_PERIPHERAL_DATA_WIDTH_HALFWORD;
+    dma_init_structure.peripheral_inc_enable = FALSE;
+    dma_init_structure.priority = DMA_PRIORITY_HIGH;
+    dma_init_structure.loop_mode_enable = TRUE;
+    dma_init(ADC_STREAM_DMA_CHANNEL, &dma_init_structure);
+
+    dmamux_enable(ADC_STREAM_DMA, TRUE);
+    dmamux_init(ADC_STREAM_DMAMUX_CHANNEL, ADC_STREAM_DMAREQ_ID);
+
+    dma_interrupt_enable(ADC_STREAM_DMA_CHANNEL, DMA_HDT_INT | DMA_FDT_INT, TRUE);
+    nvic_irq_enable(ADC_STREAM_DMA_IRQn, ADC_STREAM_PREEMPTIONPRIORITY, ADC_STREAM_SUBPRIORITY);
+
+    /*单通道，定时器上升沿触发*/
+    ADCx_Init(ADC_STREAM_ADC);
+    adc_ordinary_channel_set(
+        ADC_STREAM_ADC,
+        (adc_channel_select_type)ADC_Channel,
+        1,
+        ADC_STREAM_SAMPLETIME
+    );
+    adc_ordinary_conversion_trigger_set(ADC_STREAM_ADC, ADC_STREAM_TRIGGER, ADC_ORDINARY_TRIG_EDGE_RISING);
+    adc_dma_mode_enable(ADC_STREAM_ADC, TRUE);
+    adc_dma_request_repeat_enable(ADC_STREAM_ADC, TRUE);
+
+    return true;
+}
+
+/**
+  * @brief  设置数据块就绪回调
+  * @param  Function: 回调函数，在DMA中断中执行，NULL则改为轮询ADC_Stream_GetBlock
+  * @param  UserData: 用户数据
+  * @retval 无
+  */
+void ADC_Stream_SetCallback(ADC_Stream_CallbackFunction_t Function, void* UserData)
+{
+    ADC_Stream_UserData = UserData;
+    ADC_Stream_Callback = Function;
+}
+
+/**
+  * @brief  启动采样
+  * @param  无
+  * @retval 无
+  */
+void ADC_Stream_Start(void)
+{
+    if(ADC_Stream_Buffer == NULL)
+        return;
+
+    ADC_Stream_ReadyBlock = NULL;
+
+    dma_channel_enable(ADC_STREAM_DMA_CHANNEL, FALSE);
+    dma_data_number_set(ADC_STREAM_DMA_CHANNEL, ADC_Stream_BlockSize * 2);
+    dma_channel_enable(ADC_STREAM_DMA_CHANNEL, TRUE);
+
+    adc_flag_clear(ADC_STREAM_ADC, ADC_OCCO_FLAG);
+
+    ADC_STREAM_TIMER->cval = 0;
+    Timer_SetEnable(ADC_STREAM_TIMER, true);
+}
+
+/**
+  * @brief  停止采样
+  * @param  无
+  * @retval 无
+  */
+void ADC_Stream_Stop(void)
+{
+    Timer_SetEnable(ADC_STREAM_TIMER, false);
+    dma_channel_enable(ADC_STREAM_DMA_CHANNEL, FALSE);
+}
+
+/**
+  * @brief  取走最新就绪的数据块(未设置回调时使用)
+  * @param  无
+  * @retval 数据块地址，长度为BlockSize，须在下一个块就绪前处理完；NULL:无新数据
+  */
+const uint16_t* ADC_Stream_GetBlock(void)
+{
+    const uint16_t* block;
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    block = ADC_Stream_ReadyBlock;
+    ADC_Stream_ReadyBlock = NULL;
+    __set_PRIMASK(primask);
+
+    return block;
+}
+
+/**
+  * @brief  获取数据块溢出(未被及时取走)次数
+  * @param  无
+  * @retval 溢出次数
+  */
+uint32_t ADC_Stream_GetOverrunCount(void)
+{
+    return ADC_Stream_OverrunCount;
+}
+
+/**
+  * @brief  获取实际采样率
+  * @param  无
+  * @retval 采样率(Hz)
+  */
+uint32_t ADC_Stream_GetSampleRate(void)
+{
+    return Timer_GetClockOut(ADC_STREAM_TIMER);
+}
+
+static void ADC_Stream_BlockReady(const uint16_t* block)
+{
+    if(ADC_Stream_Callback)
+    {
+        ADC_Stream_Callback(block, ADC_Stream_BlockSize, ADC_Stream_UserData);
+        return;
+    }
+
+    if(ADC_Stream_ReadyBlock != NULL)
+    {
+        ADC_Stream_OverrunCount++;
+    }
+    ADC_Stream_ReadyBlock = block;
+}
+
+/**
+  * @brief  ADC Stream DMA中断入口
+  * @param  无
+  * @retval 无
+  */
+ADC_STREAM_IRQ_HANDLER_DEF()
+{
+    if(dma_flag_get(ADC_STREAM_DMA_HDT_FLAG) != RESET)
+    {
+        dma_flag_clear(ADC_STREAM_DMA_HDT_FLAG);
+        ADC_Stream_BlockReady(ADC_Stream_Buffer);
+    }
+
+    if(dma_flag_get(ADC_STREAM_DMA_FDT_FLAG) != RESET)
+    {
+        dma_flag_clear(ADC_STREAM_DMA_FDT_FLAG);
+        ADC_Stream_BlockReady(ADC_Stream_Buffer + ADC_Stream_BlockSize);
+    }
+}
+
+#endif /* ADC_STREAM_ENABLE */
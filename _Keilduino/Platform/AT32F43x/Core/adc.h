@@ -23,6 +23,7 @@
 #ifndef __ADC_H
 #define __ADC_H
 
+#include <stdbool.h>
 #include "mcu_type.h"
 
 #ifdef __cplusplus
@@ -37,6 +38,8 @@ typedef enum
     ADC_DMA_RES_MAX_NUM_OF_REGISTRATIONS_EXCEEDED = -3,
 } ADC_DMA_Res_Type;
 
+typedef void(*ADC_Stream_CallbackFunction_t)(const uint16_t* Block, uint16_t Length, void* UserData);
+
 void             ADCx_Init(adc_type* ADCx);
 uint16_t         ADCx_GetValue(adc_type* ADCx, uint16_t ADC_Channel);
 void             ADC_DMA_Init(void);
@@ -44,6 +47,16 @@ ADC_DMA_Res_Type ADC_DMA_Register(uint8_t ADC_Channel);
 uint16_t         ADC_DMA_GetValue(uint8_t ADC_Channel);
 uint8_t          ADC_DMA_GetRegisterCount(void);
 
+#if ADC_STREAM_ENABLE
+bool             ADC_Stream_Init(uint8_t ADC_Channel, uint32_t SampleRate, uint16_t* Buffer, uint16_t BlockSize);
+void             ADC_Stream_SetCallback(ADC_Stream_CallbackFunction_t Function, void* UserData);
+void             ADC_Stream_Start(void);
+void             ADC_Stream_Stop(void);
+const uint16_t*  ADC_Stream_GetBlock(void);
+uint32_t         ADC_Stream_GetOverrunCount(void);
+uint32_t         ADC_Stream_GetSampleRate(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,125 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "binlog.h"
+#include <string.h>
+
+#if BINLOG_ENABLE
+
+#if (BINLOG_BUFFER_SIZE < 16) || (BINLOG_BUFFER_SIZE & (BINLOG_BUFFER_SIZE - 1))
+#  error "BINLOG_BUFFER_SIZE must be a power of 2 and at least 16"
+#endif
+
+static uint32_t BinLog_Buffer[BINLOG_BUFFER_SIZE];
+
+/*静态初始化，Core_Init之前或任意中断中都可以直接写入*/
+static BinLog_Ring_TypeDef BinLog_Ring =
+{
+    BinLog_Buffer,
+    BINLOG_BUFFER_SIZE - 1,
+    0,
+    0,
+    0,
+    0,
+    0
+};
+
+static BinLog_Output_t BinLog_Output = NULL;
+static void* BinLog_UserData = NULL;
+
+/**
+  * @brief  写入一条日志，一般通过 BINLOG() 调用
+  * @param  Format: 格式串(字符串常量)
+  * @param  Args: 参数
+  * @param  NArgs: 参数个数
+  * @retval 无
+  */
+void BinLog_Write(const char* Format, const uint32_t* Args, uint8_t NArgs)
+{
+    uint32_t timestamp = BINLOG_TIMESTAMP();
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    BinLog_RingWrite(&BinLog_Ring, (uint32_t)(uintptr_t)Format, timestamp, Args, NArgs);
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  取浮点数的二进制表示，用于 %f/%e/%g 参数
+  * @param  Value: 浮点数
+  * @retval 二进制表示
+  */
+uint32_t BinLog_FloatBits(float Value)
+{
+    uint32_t bits;
+    memcpy(&bits, &Value, sizeof(bits));
+    return bits;
+}
+
+/**
+  * @brief  设置日志输出
+  * @param  Output: 输出函数，返回实际发送的字节数，可以只发送一部分
+  * @param  UserData: 用户数据
+  * @retval 无
+  */
+void BinLog_SetOutput(BinLog_Output_t Output, void* UserData)
+{
+    BinLog_Output = Output;
+    BinLog_UserData = UserData;
+}
+
+/**
+  * @brief  把缓冲中的日志发送到输出，在主循环中调用
+  * @param  MaxBytes: 本次最多发送的字节数，0为全部
+  * @retval 实际发送的字节数
+  */
+uint32_t BinLog_Process(uint32_t MaxBytes)
+{
+    if(!BinLog_Output)
+    {
+        return 0;
+    }
+
+    return BinLog_RingDrain(&BinLog_Ring, BinLog_Output, BinLog_UserData, MaxBytes);
+}
+
+/**
+  * @brief  获取缓冲中等待发送的字节数
+  * @param  无
+  * @retval 字节数
+  */
+uint32_t BinLog_GetUsed(void)
+{
+    return BinLog_RingGetUsed(&BinLog_Ring) * sizeof(uint32_t);
+}
+
+/**
+  * @brief  获取缓冲满丢弃的日志条数
+  * @param  无
+  * @retval 条数
+  */
+uint32_t BinLog_GetDropped(void)
+{
+    return BinLog_Ring.Dropped;
+}
+
+#endif /* BINLOG_ENABLE */
@@ -0,0 +1,102 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __BINLOG_H
+#define __BINLOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "mcu_type.h"
+#include "binlog_ring.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 二进制日志：
+ * BINLOG("adc=%d t=%f", value, BINLOG_F(temp)) 只把格式串地址、时间戳和参数原样写入RAM环形缓冲，
+ * 不在目标板上格式化；主循环调用 BinLog_Process() 把缓冲发送到串口等输出，
+ * PC端 Tools/BinLog/binlog_decode.py 读取固件(.axf/.elf)中的格式串还原文本。
+ * 格式串必须是字符串常量，最多8个参数，每个参数按32位传递：
+ * 整数/字符/指针直接传入，浮点数用 BINLOG_F() 包装，%s 只支持固件中的常量字符串。
+ * 可在中断中调用，写入时短暂关中断。
+ */
+#if BINLOG_ENABLE
+
+#define BINLOG(...)                         BINLOG_DISPATCH(BINLOG_NARGS(__VA_ARGS__), __VA_ARGS__)
+#define BINLOG_F(x)                         BinLog_FloatBits(x)
+
+#define BINLOG_NARGS(...)                   BINLOG_NARGS_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0, ~)
+#define BINLOG_NARGS_(f, a, b, c, d, e, g, h, i, n, ...) n
+#define BINLOG_DISPATCH(n, ...)             BINLOG_DISPATCH_(n, __VA_ARGS__)
+#define BINLOG_DISPATCH_(n, ...)            BINLOG_##n(__VA_ARGS__)
+
+#define BINLOG_ARG(x)                       ((uint32_t)(uintptr_t)(x))
+#define BINLOG_WRITE(fmt, n, ...) \
+do { \
+    const uint32_t _binlog_args[n] = { __VA_ARGS__ }; \
+    BinLog_Write("" fmt, _binlog_args, n); \
+} while(0)
+
+#define BINLOG_0(fmt)                       BinLog_Write("" fmt, NULL, 0)
+#define BINLOG_1(fmt, a)                    BINLOG_WRITE(fmt, 1, BINLOG_ARG(a))
+#define BINLOG_2(fmt, a, b)                 BINLOG_WRITE(fmt, 2, BINLOG_ARG(a), BINLOG_ARG(b))
+#define BINLOG_3(fmt, a, b, c)              BINLOG_WRITE(fmt, 3, BINLOG_ARG(a), BINLOG_ARG(b), BINLOG_ARG(c))
+#define BINLOG_4(fmt, a, b, c, d)           BINLOG_WRITE(fmt, 4, BINLOG_ARG(a), BINLOG_ARG(b), BINLOG_ARG(c), BINLOG_ARG(d))
+#define BINLOG_5(fmt, a, b, c, d, e) \
+    BINLOG_WRITE(fmt, 5, BINLOG_ARG(a), BINLOG_ARG(b), BINLOG_ARG(c), BINLOG_ARG(d), BINLOG_ARG(e))
+#define BINLOG_6(fmt, a, b, c, d, e, g) \
+    BINLOG_WRITE(fmt, 6, BINLOG_ARG(a), BINLOG_ARG(b), BINLOG_ARG(c), BINLOG_ARG(d), BINLOG_ARG(e), BINLOG_ARG(g))
+#define BINLOG_7(fmt, a, b, c, d, e, g, h) \
+    BINLOG_WRITE(fmt, 7, BINLOG_ARG(a), BINLOG_ARG(b), BINLOG_ARG(c), BINLOG_ARG(d), BINLOG_ARG(e), BINLOG_ARG(g), \
+                 BINLOG_ARG(h))
+#define BINLOG_8(fmt, a, b, c, d, e, g, h, i) \
+    BINLOG_WRITE(fmt, 8, BINLOG_ARG(a), BINLOG_ARG(b), BINLOG_ARG(c), BINLOG_ARG(d), BINLOG_ARG(e), BINLOG_ARG(g), \
+                 BINLOG_ARG(h), BINLOG_ARG(i))
+
+void     BinLog_Write(const char* Format, const uint32_t* Args, uint8_t NArgs);
+uint32_t BinLog_FloatBits(float Value);
+void     BinLog_SetOutput(BinLog_Output_t Output, void* UserData);
+uint32_t BinLog_Process(uint32_t MaxBytes);
+uint32_t BinLog_GetUsed(void);
+uint32_t BinLog_GetDropped(void);
+
+#else
+
+#define BINLOG(...)                         ((void)0)
+#define BINLOG_F(x)                         0
+
+#endif
+
+#ifdef __cplusplus
+}
+
+#if BINLOG_ENABLE
+class Print;
+void BinLog_SetOutput(Print* p);
+#endif
+
+#endif
+
+#endif /* __BINLOG_H */
@@ -0,0 +1,57 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "binlog.h"
+#include "Print.h"
+
+#if BINLOG_ENABLE
+
+/*只写入发送缓冲能立即接收的部分，不在主循环中等待串口逐字节发送*/
+static uint32_t BinLog_PrintOutput(void* UserData, const uint8_t* Data, uint32_t Length)
+{
+    Print* p = (Print*)UserData;
+    int space = p->availableForWrite();
+
+    if(space <= 0)
+    {
+        return 0;
+    }
+
+    if(Length > (uint32_t)space)
+    {
+        Length = space;
+    }
+
+    return p->write(Data, Length);
+}
+
+/**
+  * @brief  设置日志输出到 Print(如Serial)
+  * @param  p: 输出对象，NULL为关闭输出；按availableForWrite()发送，输出对象需报告发送缓冲剩余空间
+  * @retval 无
+  */
+void BinLog_SetOutput(Print* p)
+{
+    BinLog_SetOutput(p ? BinLog_PrintOutput : NULL, p);
+}
+
+#endif
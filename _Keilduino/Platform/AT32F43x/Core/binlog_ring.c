@@ -0,0 +1,192 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "binlog_ring.h"
+#include <stddef.h>
+
+/*编译器屏障：记录内容必须在更新Tail之前写完(单核无需DMB)*/
+#if defined(__CC_ARM)
+#  define BINLOG_RING_BARRIER()  __schedule_barrier()
+#elif defined(__GNUC__)
+#  define BINLOG_RING_BARRIER()  __asm volatile("" ::: "memory")
+#else
+#  define BINLOG_RING_BARRIER()
+#endif
+
+/**
+  * @brief  环形缓冲初始化
+  * @param  Ring: 环形缓冲
+  * @param  Buffer: 缓冲区
+  * @param  Size: 缓冲区字数，必须为2的幂
+  * @retval true: 成功
+  */
+bool BinLog_RingInit(BinLog_Ring_TypeDef* Ring, uint32_t* Buffer, uint32_t Size)
+{
+    if(Buffer == NULL || Size < 16 || (Size & (Size - 1)) != 0)
+    {
+        return false;
+    }
+
+    Ring->Buffer = Buffer;
+    Ring->Mask = Size - 1;
+    Ring->Head = 0;
+    Ring->Tail = 0;
+    Ring->Dropped = 0;
+    Ring->Pending = 0;
+    Ring->HeadByte = 0;
+    return true;
+}
+
+/**
+  * @brief  写入一条记录，调用者需保证互斥
+  * @param  Ring: 环形缓冲
+  * @param  Id: 格式串ID
+  * @param  Timestamp: 时间戳
+  * @param  Args: 参数
+  * @param  NArgs: 参数个数
+  * @retval true: 成功，false: 缓冲已满，记录被丢弃
+  */
+bool BinLog_RingWrite(BinLog_Ring_TypeDef* Ring, uint32_t Id, uint32_t Timestamp, const uint32_t* Args, uint8_t NArgs)
+{
+    uint32_t* buffer = Ring->Buffer;
+    uint32_t mask = Ring->Mask;
+    uint32_t tail = Ring->Tail;
+    uint32_t words = BINLOG_HEADER_WORDS + NArgs;
+    uint32_t pending;
+    uint8_t i;
+
+    if(words > mask + 1 - (tail - Ring->Head))
+    {
+        Ring->Dropped++;
+        Ring->Pending++;
+        return false;
+    }
+
+    pending = (Ring->Pending > 0xFFFF) ? 0xFFFF : Ring->Pending;
+    buffer[tail++ & mask] = BINLOG_SYNC | ((uint32_t)NArgs << 8) | (pending << 16);
+    buffer[tail++ & mask] = Id;
+    buffer[tail++ & mask] = Timestamp;
+    for(i = 0; i < NArgs; i++)
+    {
+        buffer[tail++ & mask] = Args[i];
+    }
+
+    BINLOG_RING_BARRIER();
+    Ring->Tail = tail;
+    Ring->Pending = 0;
+    return true;
+}
+
+/**
+  * @brief  获取可连续读取的数据
+  * @param  Ring: 环形缓冲
+  * @param  Data: 输出数据起始地址
+  * @retval 可读取的字节数，在缓冲末尾处会分两次返回
+  */
+uint32_t BinLog_RingPeek(const BinLog_Ring_TypeDef* Ring, const uint8_t** Data)
+{
+    uint32_t head = Ring->Head;
+    uint32_t used = Ring->Tail - head;
+    uint32_t index = head & Ring->Mask;
+    uint32_t contiguous = Ring->Mask + 1 - index;
+
+    BINLOG_RING_BARRIER();
+
+    if(used == 0)
+    {
+        return 0;
+    }
+
+    *Data = (const uint8_t*)&Ring->Buffer[index] + Ring->HeadByte;
+    return ((used < contiguous) ? used : contiguous) * sizeof(uint32_t) - Ring->HeadByte;
+}
+
+/**
+  * @brief  释放已读取的数据，不足一个字时记录字内偏移
+  * @param  Ring: 环形缓冲
+  * @param  Length: 字节数，不能超过 BinLog_RingPeek 返回值
+  * @retval 无
+  */
+void BinLog_RingConsume(BinLog_Ring_TypeDef* Ring, uint32_t Length)
+{
+    uint32_t offset = Ring->HeadByte + Length;
+
+    Ring->HeadByte = offset % sizeof(uint32_t);
+    BINLOG_RING_BARRIER();
+    Ring->Head += offset / sizeof(uint32_t);
+}
+
+/**
+  * @brief  获取缓冲中的字数
+  * @param  Ring: 环形缓冲
+  * @retval 字数
+  */
+uint32_t BinLog_RingGetUsed(const BinLog_Ring_TypeDef* Ring)
+{
+    return Ring->Tail - Ring->Head;
+}
+
+/**
+  * @brief  把缓冲中的数据发送到输出，输出未全部接收时停止
+  * @param  Ring: 环形缓冲
+  * @param  Output: 输出函数
+  * @param  UserData: 用户数据
+  * @param  MaxBytes: 本次最多发送的字节数，0为全部
+  * @retval 实际发送的字节数
+  */
+uint32_t BinLog_RingDrain(BinLog_Ring_TypeDef* Ring, BinLog_Output_t Output, void* UserData, uint32_t MaxBytes)
+{
+    uint32_t total = 0;
+
+    while(MaxBytes == 0 || total < MaxBytes)
+    {
+        const uint8_t* data;
+        uint32_t length = BinLog_RingPeek(Ring, &data);
+        uint32_t sent;
+
+        if(length == 0)
+        {
+            break;
+        }
+
+        if(MaxBytes && length > MaxBytes - total)
+        {
+            length = MaxBytes - total;
+        }
+
+        sent = Output(UserData, data, length);
+        if(sent > length)
+        {
+            sent = length;
+        }
+
+        BinLog_RingConsume(Ring, sent);
+        total += sent;
+
+        if(sent < length)
+        {
+            break;
+        }
+    }
+
+    return total;
+}
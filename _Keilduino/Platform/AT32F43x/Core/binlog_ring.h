@@ -0,0 +1,72 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __BINLOG_RING_H
+#define __BINLOG_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 二进制日志记录格式(32位小端字)：
+ *   字0: [7:0]同步字节0xA5 [15:8]参数个数 [31:16]本条之前丢弃的记录数(饱和)
+ *   字1: 格式串ID(格式串在固件中的地址)
+ *   字2: 时间戳
+ *   字3~: 参数，每个参数一个字
+ * 环形缓冲以字为单位，读取端按字节原样发送，由PC端解码器对照固件还原文本；
+ * 输出只发送了一个字的一部分时记录字内偏移，下次从断开处继续，不重复发送。
+ * 写入需要调用者保证互斥(关中断)，读取只能在单一上下文。
+ * 本文件不访问寄存器，可在PC上编译验证。
+ */
+#define BINLOG_SYNC             0xA5
+#define BINLOG_HEADER_WORDS     3
+
+typedef struct
+{
+    uint32_t* Buffer;
+    uint32_t Mask;
+    volatile uint32_t Head;     // 读取位置(字)，只由读取者修改
+    volatile uint32_t Tail;     // 写入位置(字)，只由写入者修改
+    volatile uint32_t Dropped;  // 缓冲满丢弃的记录总数
+    uint32_t Pending;           // 尚未报告给解码器的丢弃数
+    uint32_t HeadByte;          // Head所在字中已发送的字节数(0~3)
+} BinLog_Ring_TypeDef;
+
+/*输出函数，返回实际发送的字节数(可以少于Length，包括0)*/
+typedef uint32_t(*BinLog_Output_t)(void* UserData, const uint8_t* Data, uint32_t Length);
+
+bool     BinLog_RingInit(BinLog_Ring_TypeDef* Ring, uint32_t* Buffer, uint32_t Size);
+bool     BinLog_RingWrite(BinLog_Ring_TypeDef* Ring, uint32_t Id, uint32_t Timestamp, const uint32_t* Args, uint8_t NArgs);
+uint32_t BinLog_RingPeek(const BinLog_Ring_TypeDef* Ring, const uint8_t** Data);
+void     BinLog_RingConsume(BinLog_Ring_TypeDef* Ring, uint32_t Length);
+uint32_t BinLog_RingGetUsed(const BinLog_Ring_TypeDef* Ring);
+uint32_t BinLog_RingDrain(BinLog_Ring_TypeDef* Ring, BinLog_Output_t Output, void* UserData, uint32_t MaxBytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BINLOG_RING_H */
@@ -0,0 +1,488 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "capture.h"
+#include "timer.h"
+#include "Arduino.h"
+
+#if CAPTURE_ENABLE
+
+/*
+ * PWM输入模式：引脚对应的通道(CH1或CH2)直接映射，上升沿捕获周期并复位计数器，
+ * 另一个通道间接映射到同一引脚，下降沿捕获高电平时间。
+ * 连续模式下只有计数器溢出(无信号)时进入中断，读取周期和高电平时间不占用CPU。
+ */
+
+typedef struct
+{
+    tmr_type* TIMx;
+    uint8_t Pin;
+    uint8_t Channel;
+    uint32_t TickFreq;
+
+    /*溢出后第一次捕获的值无效*/
+    volatile bool Stale;
+    volatile uint32_t OverflowCount;
+
+    /*单次测量*/
+    volatile bool Busy;
+    volatile uint8_t Edges;
+    uint32_t OverflowStart;
+    uint32_t OverflowLimit;
+    Capture_CallbackFunction_t Callback;
+    void* UserData;
+} Capture_TypeDef;
+
+static Capture_TypeDef Capture_Group[CAPTURE_MAX] = {0};
+
+#define CAPTURE_PERIOD_CHANNEL(cap)     ((cap)->Channel)
+#define CAPTURE_HIGH_CHANNEL(cap)       ((cap)->Channel == 1 ? 2 : 1)
+#define CAPTURE_PERIOD_FLAG(cap)        ((cap)->Channel == 1 ? TMR_C1_FLAG : TMR_C2_FLAG)
+#define CAPTURE_HIGH_FLAG(cap)          ((cap)->Channel == 1 ? TMR_C2_FLAG : TMR_C1_FLAG)
+#define CAPTURE_RECAPTURE_FLAG(cap)     ((cap)->Channel == 1 ? TMR_C1_RECAPTURE_FLAG : TMR_C2_RECAPTURE_FLAG)
+#define CAPTURE_PERIOD_INT(cap)         ((cap)->Channel == 1 ? TMR_C1_INT : TMR_C2_INT)
+
+/**
+  * @brief  查找引脚对应的捕获通道
+  * @param  Pin: 引脚编号
+  * @retval 捕获通道，NULL:未初始化
+  */
+static Capture_TypeDef* Capture_Find(uint8_t Pin)
+{
+    int i;
+    for(i = 0; i < CAPTURE_MAX; i++)
+    {
+        if(Capture_Group[i].TIMx != NULL && Capture_Group[i].Pin == Pin)
+        {
+            return &Capture_Group[i];
+        }
+    }
+    return NULL;
+}
+
+static void Capture_SetPolarity(Capture_TypeDef* cap, bool PeriodRising)
+{
+    uint8_t periodEdge = PeriodRising ? TMR_INPUT_RISING_EDGE : TMR_INPUT_FALLING_EDGE;
+    uint8_t highEdge = PeriodRising ? TMR_INPUT_FALLING_EDGE : TMR_INPUT_RISING_EDGE;
+
+    if(cap->Channel == 1)
+    {
+        cap->TIMx->cctrl_bit.c1p = periodEdge;
+        cap->TIMx->cctrl_bit.c2p = highEdge;
+    }
+    else
+    {
+        cap->TIMx->cctrl_bit.c2p = periodEdge;
+        cap->TIMx->cctrl_bit.c1p = highEdge;
+    }
+}
+
+static void Capture_Finish(Capture_TypeDef* cap, uint32_t Period, uint32_t HighTime)
+{
+    tmr_interrupt_enable(cap->TIMx, CAPTURE_PERIOD_INT(cap), FALSE);
+    cap->Busy = false;
+
+    if(cap->Callback)
+    {
+        cap->Callback(cap->Pin, Period, HighTime, cap->UserData);
+    }
+}
+
+/**
+  * @brief  定时器事件处理
+  * @param  TIMx: 定时器地址
+  * @param  Flags: 中断标志
+  * @param  UserData: 捕获通道
+  * @retval 无
+  */
+static void Capture_EventHandler(tmr_type* TIMx, uint32_t Flags, void* UserData)
+{
+    Capture_TypeDef* cap = (Capture_TypeDef*)UserData;
+
+    if(Flags & TMR_OVF_FLAG)
+    {
+        /*一个完整计数周期内没有边沿，读取捕获值清除标志，丢弃旧数据*/
+        Timer_GetCompare(TIMx, CAPTURE_PERIOD_CHANNEL(cap));
+        TIMx->ists = ~(uint32_t)CAPTURE_RECAPTURE_FLAG(cap);
+        cap->Stale = true;
+        cap->OverflowCount++;
+
+        if(cap->Busy)
+        {
+            cap->Edges = 0;
+            if(cap->OverflowLimit && cap->OverflowCount - cap->OverflowStart >= cap->OverflowLimit)
+            {
+                Capture_Finish(cap, 0, 0);
+            }
+        }
+    }
+
+    if((Flags & CAPTURE_PERIOD_FLAG(cap)) && cap->Busy)
+    {
+        uint32_t period = Timer_GetCompare(TIMx, CAPTURE_PERIOD_CHANNEL(cap));
+        uint32_t high = Timer_GetCompare(TIMx, CAPTURE_HIGH_CHANNEL(cap));
+
+        /*第一个边沿之前计数器未被复位，第二个边沿才是完整周期*/
+        if(++cap->Edges >= 2)
+        {
+            Capture_Finish(cap, period, high);
+        }
+    }
+}
+
+/**
+  * @brief  输入捕获初始化，引脚须对应定时器CH1或CH2，独占该定时器
+  * @param  Pin: 引脚编号
+  * @param  MinFrequency: 可测量的最低频率(Hz)，决定计数分辨率
+  * @param  PullUp: 是否使能内部上拉(集电极开路的转速信号)
+  * @retval true: 成功
+  */
+bool Capture_Init(uint8_t Pin, uint32_t MinFrequency, bool PullUp)
+{
+    tmr_input_config_type input_struct;
+    Capture_TypeDef* cap;
+    tmr_type* TIMx;
+    uint8_t channel;
+    uint32_t clock;
+    uint32_t prescaler;
+    int i;
+
+    if(!IS_PWM_PIN(Pin) || MinFrequency == 0)
+    {
+        return false;
+    }
+
+    TIMx = PIN_MAP[Pin].TIMx;
+    channel = PIN_MAP[Pin].TimerChannel;
+
+    /*PWM输入模式需要CH1/CH2和从模式控制器*/
+    if((channel != 1 && channel != 2)
+            || TIMx == TIM10 || TIMx == TIM11 || TIMx == TIM13 || TIMx == TIM14)
+    {
+        return false;
+    }
+
+    cap = Capture_Find(Pin);
+    if(cap == NULL)
+    {
+        for(i = 0; i < CAPTURE_MAX; i++)
+        {
+            /*同一个定时器只能测量一路*/
+            if(Capture_Group[i].TIMx == TIMx)
+            {
+                return false;
+            }
+        }
+
+        for(i = 0; i < CAPTURE_MAX; i++)
+        {
+            if(Capture_Group[i].TIMx == NULL)
+            {
+                cap = &Capture_Group[i];
+                break;
+            }
+        }
+
+        if(cap == NULL)
+        {
+            return false;
+        }
+    }
+
+    clock = Timer_GetClockMax(TIMx);
+    prescaler = (uint32_t)(clock / ((uint64_t)MinFrequency * 0x10000U)) + 1;
+    if(prescaler > 0x10000U)
+    {
+        return false;
+    }
+
+    pinMode(Pin, OUTPUT_AF_PP);
+    gpio_pin_mux_config(PIN_MAP[Pin].GPIOx, GPIO_GetPinSource(PIN_MAP[Pin].GPIO_Pin_x), Timer_GetGPIO_MUX(Pin));
+    if(PullUp)
+    {
+        uint8_t pinNum = GPIO_GetPinNum(Pin);
+        gpio_type* GPIOx = PIN_MAP[Pin].GPIOx;
+        GPIOx->pull = (GPIOx->pull & ~(0x03U << (pinNum * 2))) | ((uint32_t)GPIO_PULL_UP << (pinNum * 2));
+    }
+
+    tmr_reset(TIMx);
+    Timer_ClockCmd(TIMx, true);
+
+    tmr_base_init(TIMx, 0xFFFF, prescaler - 1);
+    tmr_cnt_dir_set(TIMx, TMR_COUNT_UP);
+
+    /*从模式复位不产生溢出中断，只有计数器真正溢出才产生*/
+    tmr_overflow_request_source_set(TIMx, TRUE);
+
+    tmr_input_default_para_init(&input_struct);
+    input_struct.input_channel_select = (channel == 1) ? TMR_SELECT_CHANNEL_1 : TMR_SELECT_CHANNEL_2;
+    input_struct.input_mapped_select = TMR_CC_CHANNEL_MAPPED_DIRECT;
+    input_struct.input_polarity_select = TMR_INPUT_RISING_EDGE;
+    input_struct.input_filter_value = 0;
+    tmr_pwm_input_config(TIMx, &input_struct, TMR_CHANNEL_INPUT_DIV_1);
+
+    tmr_trigger_input_select(TIMx, (channel == 1) ? TMR_SUB_INPUT_SEL_C1DF1 : TMR_SUB_INPUT_SEL_C2DF2);
+    tmr_sub_mode_select(TIMx, TMR_SUB_RESET_MODE);
+
+    cap->TIMx = TIMx;
+    cap->Pin = Pin;
+    cap->Channel = channel;
+    cap->TickFreq = clock / prescaler;
+    cap->Stale = true;
+    cap->OverflowCount = 0;
+    cap->Busy = false;
+    cap->Callback = NULL;
+    cap->UserData = NULL;
+
+    Timer_SetEventCallback(TIMx, Capture_EventHandler, cap, CAPTURE_PREEMPTIONPRIORITY, CAPTURE_SUBPRIORITY);
+    tmr_flag_clear(TIMx, TMR_OVF_FLAG);
+    tmr_interrupt_enable(TIMx, TMR_OVF_INT, TRUE);
+    tmr_counter_enable(TIMx, TRUE);
+
+    return true;
+}
+
+/**
+  * @brief  关闭输入捕获，释放定时器
+  * @param  Pin: 引脚编号
+  * @retval 无
+  */
+void Capture_DeInit(uint8_t Pin)
+{
+    Capture_TypeDef* cap = Capture_Find(Pin);
+    if(cap == NULL)
+    {
+        return;
+    }
+
+    tmr_counter_enable(cap->TIMx, FALSE);
+    tmr_interrupt_enable(cap->TIMx, TMR_OVF_INT | CAPTURE_PERIOD_INT(cap), FALSE);
+    Timer_SetEventCallback(cap->TIMx, NULL, NULL, 0, 0);
+    cap->TIMx = NULL;
+}
+
+/**
+  * @brief  启动测量
+  * @param  Pin: 引脚编号
+  * @param  Mode: CAPTURE_MODE_CONTINUOUS 持续测量，用Capture_Read读取；
+  *               CAPTURE_MODE_ONESHOT 测量一个完整周期后回调
+  * @param  Timeout: 单次测量超时(微秒)，0为不超时
+  * @param  Function: 单次测量完成回调
+  * @param  UserData: 用户数据
+  * @retval true: 成功
+  */
+bool Capture_Start(
+    uint8_t Pin, Capture_Mode_Type Mode,
+    uint32_t Timeout,
+    Capture_CallbackFunction_t Function, void* UserData
+)
+{
+    Capture_TypeDef* cap = Capture_Find(Pin);
+    if(cap == NULL)
+    {
+        return false;
+    }
+
+    tmr_interrupt_enable(cap->TIMx, CAPTURE_PERIOD_INT(cap), FALSE);
+    cap->Busy = false;
+
+    if(Mode == CAPTURE_MODE_CONTINUOUS)
+    {
+        return true;
+    }
+
+    cap->Callback = Function;
+    cap->UserData = UserData;
+    cap->Edges = 0;
+    cap->OverflowStart = cap->OverflowCount;
+    cap->OverflowLimit = (uint32_t)(((uint64_t)Timeout * cap->TickFreq + 0x10000ULL * 1000000U - 1)
+                                    / (0x10000ULL * 1000000U));
+    cap->Busy = true;
+
+    Timer_GetCompare(cap->TIMx, CAPTURE_PERIOD_CHANNEL(cap));
+    tmr_flag_clear(cap->TIMx, CAPTURE_PERIOD_FLAG(cap));
+    tmr_interrupt_enable(cap->TIMx, CAPTURE_PERIOD_INT(cap), TRUE);
+    return true;
+}
+
+/**
+  * @brief  读取最近一个周期的测量值(计数值，频率见Capture_GetTickFreq)
+  * @param  Pin: 引脚编号
+  * @param  Period: 周期
+  * @param  HighTime: 高电平时间
+  * @retval true: 有效，false: 无信号或超出量程
+  */
+bool Capture_Read(uint8_t Pin, uint32_t* Period, uint32_t* HighTime)
+{
+    Capture_TypeDef* cap = Capture_Find(Pin);
+    uint32_t period = 0;
+    uint32_t high = 0;
+    uint32_t primask;
+    uint32_t ists;
+
+    if(cap != NULL)
+    {
+        primask = __get_PRIMASK();
+        __disable_irq();
+
+        ists = cap->TIMx->ists;
+        if(cap->Stale)
+        {
+            /*溢出后需要捕获两次(重复捕获标志置位)才有完整周期*/
+            if((ists & CAPTURE_PERIOD_FLAG(cap)) && (ists & CAPTURE_RECAPTURE_FLAG(cap)))
+            {
+                cap->Stale = false;
+            }
+        }
+
+        if(!cap->Stale)
+        {
+            cap->TIMx->ists = ~(uint32_t)CAPTURE_RECAPTURE_FLAG(cap);
+            period = Timer_GetCompare(cap->TIMx, CAPTURE_PERIOD_CHANNEL(cap));
+            high = Timer_GetCompare(cap->TIMx, CAPTURE_HIGH_CHANNEL(cap));
+        }
+
+        __set_PRIMASK(primask);
+    }
+
+    if(Period)
+    {
+        *Period = period;
+    }
+    if(HighTime)
+    {
+        *HighTime = high;
+    }
+
+    return (period != 0);
+}
+
+/**
+  * @brief  获取捕获计数频率
+  * @param  Pin: 引脚编号
+  * @retval 计数频率(Hz)
+  */
+uint32_t Capture_GetTickFreq(uint8_t Pin)
+{
+    Capture_TypeDef* cap = Capture_Find(Pin);
+    return cap ? cap->TickFreq : 0;
+}
+
+/**
+  * @brief  获取信号频率
+  * @param  Pin: 引脚编号
+  * @retval 频率(Hz)，0:无信号
+  */
+float Capture_GetFrequency(uint8_t Pin)
+{
+    uint32_t period;
+    if(!Capture_Read(Pin, &period, NULL))
+    {
+        return 0.0f;
+    }
+    return (float)Capture_GetTickFreq(Pin) / period;
+}
+
+/**
+  * @brief  获取信号占空比
+  * @param  Pin: 引脚编号
+  * @retval 占空比 0.0 ~ 1.0
+  */
+float Capture_GetDuty(uint8_t Pin)
+{
+    uint32_t period, high;
+    if(!Capture_Read(Pin, &period, &high))
+    {
+        return 0.0f;
+    }
+    return (float)high / period;
+}
+
+/**
+  * @brief  用硬件捕获测量单个脉冲宽度，用法同pulseIn
+  * @param  Pin: 引脚编号，未初始化时按超时时间自动初始化
+  * @param  State: 脉冲电平 HIGH/LOW
+  * @param  Timeout: 超时(微秒)
+  * @retval 脉冲宽度(微秒)，0:超时或超出量程
+  */
+uint32_t Capture_PulseIn(uint8_t Pin, uint8_t State, uint32_t Timeout)
+{
+    Capture_TypeDef* cap = Capture_Find(Pin);
+    uint32_t start = micros();
+    uint32_t overflow;
+    uint32_t width = 0;
+
+    if(cap == NULL)
+    {
+        uint32_t minFreq = (Timeout >= 1000000U) ? 1 : 1000000U / (Timeout ? Timeout : 1);
+        if(!Capture_Init(Pin, minFreq, false))
+        {
+            return 0;
+        }
+        cap = Capture_Find(Pin);
+    }
+
+    if(cap->Busy)
+    {
+        return 0;
+    }
+
+    /*直接通道在脉冲起始沿复位计数器，间接通道在结束沿捕获宽度*/
+    Capture_SetPolarity(cap, State != LOW);
+    Timer_GetCompare(cap->TIMx, CAPTURE_PERIOD_CHANNEL(cap));
+    Timer_GetCompare(cap->TIMx, CAPTURE_HIGH_CHANNEL(cap));
+
+    while(!(cap->TIMx->ists & CAPTURE_PERIOD_FLAG(cap)))
+    {
+        if(micros() - start >= Timeout)
+        {
+            goto exit;
+        }
+    }
+    overflow = cap->OverflowCount;
+    Timer_GetCompare(cap->TIMx, CAPTURE_HIGH_CHANNEL(cap));
+
+    while(!(cap->TIMx->ists & CAPTURE_HIGH_FLAG(cap)))
+    {
+        if(micros() - start >= Timeout)
+        {
+            goto exit;
+        }
+    }
+
+    width = Timer_GetCompare(cap->TIMx, CAPTURE_HIGH_CHANNEL(cap));
+    if(cap->OverflowCount != overflow)
+    {
+        width = 0;
+    }
+    else
+    {
+        width = (uint32_t)((uint64_t)width * 1000000U / cap->TickFreq);
+    }
+
+exit:
+    Capture_SetPolarity(cap, true);
+    cap->Stale = true;
+    return width;
+}
+
+#endif /* CAPTURE_ENABLE */
@@ -0,0 +1,61 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __CAPTURE_H
+#define __CAPTURE_H
+
+#include <stdbool.h>
+#include "mcu_type.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+    CAPTURE_MODE_CONTINUOUS,
+    CAPTURE_MODE_ONESHOT
+} Capture_Mode_Type;
+
+/* 单次测量完成回调(在定时器中断中执行)，超时则Period和HighTime为0 */
+typedef void(*Capture_CallbackFunction_t)(uint8_t Pin, uint32_t Period, uint32_t HighTime, void* UserData);
+
+#if CAPTURE_ENABLE
+bool     Capture_Init(uint8_t Pin, uint32_t MinFrequency, bool PullUp);
+void     Capture_DeInit(uint8_t Pin);
+bool     Capture_Start(
+    uint8_t Pin, Capture_Mode_Type Mode,
+    uint32_t Timeout,
+    Capture_CallbackFunction_t Function, void* UserData
+);
+bool     Capture_Read(uint8_t Pin, uint32_t* Period, uint32_t* HighTime);
+uint32_t Capture_GetTickFreq(uint8_t Pin);
+float    Capture_GetFrequency(uint8_t Pin);
+float    Capture_GetDuty(uint8_t Pin);
+uint32_t Capture_PulseIn(uint8_t Pin, uint8_t State, uint32_t Timeout);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CAPTURE_H */
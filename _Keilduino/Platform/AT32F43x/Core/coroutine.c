@@ -0,0 +1,272 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "coroutine.h"
+
+#define COROUTINE_STACK_MAGIC   0xDEADBEEFUL
+
+static Coroutine_TypeDef Coroutine_Main;
+static Coroutine_TypeDef* Coroutine_Current = NULL;
+
+static void Coroutine_Init(void)
+{
+    Coroutine_Main.SP = 0;
+    Coroutine_Main.Next = &Coroutine_Main;
+    Coroutine_Main.WakeTime = 0;
+    Coroutine_Main.State = COROUTINE_STATE_READY;
+    Coroutine_Main.Function = NULL;
+    Coroutine_Main.UserData = NULL;
+    Coroutine_Main.Stack = NULL;
+    Coroutine_Main.StackSize = 0;
+
+    Coroutine_PortInit();
+    Coroutine_Current = &Coroutine_Main;
+}
+
+static bool Coroutine_IsRunnable(Coroutine_TypeDef* Co, uint32_t Now)
+{
+    if(Co->State == COROUTINE_STATE_SLEEP && (int32_t)(Now - Co->WakeTime) >= 0)
+    {
+        Co->State = COROUTINE_STATE_READY;
+    }
+
+    return Co->State == COROUTINE_STATE_READY;
+}
+
+/*从当前协程的下一个开始轮询，当前协程最后检查；都不可运行时空闲等待*/
+static void Coroutine_Schedule(void)
+{
+    Coroutine_TypeDef* cur = Coroutine_Current;
+
+    for(;;)
+    {
+        uint32_t now = Coroutine_PortGetTick();
+        Coroutine_TypeDef* first = cur->Next;
+        Coroutine_TypeDef* co = first;
+
+        /*已结束的协程不在环中，从它的Next开始也能遍历整个环*/
+        do
+        {
+            if(co != cur && Coroutine_IsRunnable(co, now))
+            {
+                Coroutine_Current = co;
+                Coroutine_PortSwitch(cur, co);
+                return;
+            }
+            co = co->Next;
+        }
+        while(co != first);
+
+        if(cur->State != COROUTINE_STATE_DONE && Coroutine_IsRunnable(cur, now))
+        {
+            return;
+        }
+
+        Coroutine_PortIdle();
+    }
+}
+
+static void Coroutine_Unlink(Coroutine_TypeDef* Co)
+{
+    Coroutine_TypeDef* prev = Co;
+
+    while(prev->Next != Co)
+    {
+        prev = prev->Next;
+    }
+
+    prev->Next = Co->Next;
+}
+
+/*是否在调度环中(包括当前运行的协程)*/
+static bool Coroutine_IsLinked(const Coroutine_TypeDef* Co)
+{
+    const Coroutine_TypeDef* co = Coroutine_Current;
+
+    do
+    {
+        if(co == Co)
+        {
+            return true;
+        }
+        co = co->Next;
+    }
+    while(co != Coroutine_Current);
+
+    return false;
+}
+
+/**
+  * @brief  协程入口，由移植层在协程第一次运行时调用，不返回
+  * @param  Co: 协程
+  * @retval 无
+  */
+void Coroutine_Entry(Coroutine_TypeDef* Co)
+{
+    Co->Function(Co->UserData);
+
+    /*协程结束后从调度环移除，Next保持有效以便继续调度*/
+    Co->State = COROUTINE_STATE_DONE;
+    Coroutine_Unlink(Co);
+    Coroutine_Schedule();
+
+    for(;;)
+    {
+    }
+}
+
+/**
+  * @brief  创建协程，创建后在下一个切换点开始运行
+  * @param  Co: 协程对象，由调用者分配，运行期间不能释放
+  * @param  Stack: 栈空间，由调用者静态分配
+  * @param  StackSize: 栈大小(字节)
+  * @param  Function: 协程函数，返回后协程结束
+  * @param  UserData: 用户数据
+  * @retval true: 成功，false: 参数错误、不能切换或协程仍在运行
+  */
+bool Coroutine_Create(
+    Coroutine_TypeDef* Co,
+    uint32_t* Stack,
+    uint32_t StackSize,
+    Coroutine_Function_t Function,
+    void* UserData
+)
+{
+    uint32_t i;
+
+    if(!Coroutine_PortCanSwitch() || !Co || !Stack || !Function || StackSize < 256)
+    {
+        return false;
+    }
+
+    if(!Coroutine_Current)
+    {
+        Coroutine_Init();
+    }
+
+    /*未结束的协程不能重新创建，否则调度环会被破坏*/
+    if(Coroutine_IsLinked(Co))
+    {
+        return false;
+    }
+
+    /*填充栈用于统计剩余空间*/
+    for(i = 0; i < StackSize / sizeof(uint32_t); i++)
+    {
+        Stack[i] = COROUTINE_STACK_MAGIC;
+    }
+
+    Co->WakeTime = 0;
+    Co->State = COROUTINE_STATE_READY;
+    Co->Function = Function;
+    Co->UserData = UserData;
+    Co->Stack = Stack;
+    Co->StackSize = StackSize;
+    Coroutine_PortStackInit(Co);
+
+    /*插入到当前协程之前，即本轮最后运行*/
+    Co->Next = Coroutine_Current;
+    {
+        Coroutine_TypeDef* prev = Coroutine_Current;
+        while(prev->Next != Coroutine_Current)
+        {
+            prev = prev->Next;
+        }
+        prev->Next = Co;
+    }
+
+    return true;
+}
+
+/**
+  * @brief  让出CPU，运行其他就绪协程后返回
+  * @param  无
+  * @retval true: 已调度，false: 在中断中、中断被关闭或未创建协程
+  */
+bool Coroutine_Yield(void)
+{
+    if(!Coroutine_Current || !Coroutine_PortCanSwitch())
+    {
+        return false;
+    }
+
+    Coroutine_Schedule();
+    return true;
+}
+
+/**
+  * @brief  协程睡眠，期间运行其他协程
+  * @param  Ms: 毫秒数
+  * @retval true: 已睡眠，false: 在中断中、中断被关闭或未创建协程，调用者应自行延时
+  */
+bool Coroutine_Delay(uint32_t Ms)
+{
+    Coroutine_TypeDef* cur = Coroutine_Current;
+
+    if(!cur || !Coroutine_PortCanSwitch())
+    {
+        return false;
+    }
+
+    cur->WakeTime = Coroutine_PortGetTick() + Ms;
+    cur->State = COROUTINE_STATE_SLEEP;
+    Coroutine_Schedule();
+    return true;
+}
+
+/**
+  * @brief  协程是否已结束
+  * @param  Co: 协程
+  * @retval true: 已结束
+  */
+bool Coroutine_IsDone(const Coroutine_TypeDef* Co)
+{
+    return Co->State == COROUTINE_STATE_DONE;
+}
+
+/**
+  * @brief  获取当前协程
+  * @param  无
+  * @retval 当前协程，未创建协程时返回NULL
+  */
+Coroutine_TypeDef* Coroutine_GetCurrent(void)
+{
+    return Coroutine_Current;
+}
+
+/**
+  * @brief  统计协程栈从未使用过的空间
+  * @param  Co: 协程
+  * @retval 剩余字节数
+  */
+uint32_t Coroutine_GetStackFree(const Coroutine_TypeDef* Co)
+{
+    uint32_t i = 0;
+    uint32_t words = Co->StackSize / sizeof(uint32_t);
+
+    while(i < words && Co->Stack[i] == COROUTINE_STACK_MAGIC)
+    {
+        i++;
+    }
+
+    return i * sizeof(uint32_t);
+}
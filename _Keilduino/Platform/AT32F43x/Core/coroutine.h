@@ -0,0 +1,87 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __COROUTINE_H
+#define __COROUTINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 有栈协作式协程：每个协程有独立的静态栈，只在 Coroutine_Yield/Coroutine_Delay
+ * (以及调用它们的 yield()/delay()/Stream超时读取) 处切换，不会被抢占。
+ * 主循环本身作为第一个协程。调度核心不访问寄存器，上下文切换由移植层实现。
+ */
+
+typedef void(*Coroutine_Function_t)(void* UserData);
+
+typedef enum
+{
+    COROUTINE_STATE_READY,
+    COROUTINE_STATE_SLEEP,
+    COROUTINE_STATE_DONE
+} Coroutine_State_Type;
+
+typedef struct Coroutine_s
+{
+    uintptr_t SP;               // 保存的栈指针(移植层使用)
+    struct Coroutine_s* Next;   // 调度环
+    uint32_t WakeTime;          // 睡眠结束时间(毫秒)
+    uint8_t State;
+    Coroutine_Function_t Function;
+    void* UserData;
+    uint32_t* Stack;
+    uint32_t StackSize;         // 栈大小(字节)
+} Coroutine_TypeDef;
+
+bool Coroutine_Create(
+    Coroutine_TypeDef* Co,
+    uint32_t* Stack,
+    uint32_t StackSize,
+    Coroutine_Function_t Function,
+    void* UserData
+);
+bool Coroutine_Yield(void);
+bool Coroutine_Delay(uint32_t Ms);
+bool Coroutine_IsDone(const Coroutine_TypeDef* Co);
+Coroutine_TypeDef* Coroutine_GetCurrent(void);
+uint32_t Coroutine_GetStackFree(const Coroutine_TypeDef* Co);
+
+/* 移植层接口 */
+void     Coroutine_PortInit(void);
+void     Coroutine_PortStackInit(Coroutine_TypeDef* Co);
+void     Coroutine_PortSwitch(Coroutine_TypeDef* From, Coroutine_TypeDef* To);
+uint32_t Coroutine_PortGetTick(void);
+bool     Coroutine_PortCanSwitch(void);
+void     Coroutine_PortIdle(void);
+void     Coroutine_Entry(Coroutine_TypeDef* Co);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __COROUTINE_H */
@@ -0,0 +1,213 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "coroutine.h"
+#include "delay.h"
+
+#if COROUTINE_ENABLE
+
+/*
+ * Cortex-M4F移植：PendSV(最低优先级)中保存r4-r11、EXC_RETURN，浮点帧时再保存s16-s31，
+ * s0-s15由硬件惰性压栈。主循环使用MSP，协程使用PSP，按EXC_RETURN选择栈。
+ */
+#define COROUTINE_EXC_RETURN    0xFFFFFFFDUL    // 返回线程模式，使用PSP，无浮点帧
+#define COROUTINE_XPSR          0x01000000UL    // Thumb状态
+
+/*PendSV中使用：保存当前栈指针的位置、读取下一个栈指针的位置*/
+uintptr_t* Coroutine_PortFromSP;
+uintptr_t* Coroutine_PortToSP;
+
+/**
+  * @brief  移植层初始化，PendSV设为最低优先级
+  * @param  无
+  * @retval 无
+  */
+void Coroutine_PortInit(void)
+{
+    NVIC_SetPriority(PendSV_IRQn, (1UL << __NVIC_PRIO_BITS) - 1);
+}
+
+/**
+  * @brief  构造协程初始栈帧，第一次切换时从Coroutine_Entry(Co)开始运行
+  * @param  Co: 协程
+  * @retval 无
+  */
+void Coroutine_PortStackInit(Coroutine_TypeDef* Co)
+{
+    uint32_t* sp = (uint32_t*)(((uintptr_t)Co->Stack + Co->StackSize) & ~(uintptr_t)7);
+    uint8_t i;
+
+    /*硬件出栈帧：r0-r3、r12、lr、pc、xpsr*/
+    *(--sp) = COROUTINE_XPSR;
+    *(--sp) = (uint32_t)Coroutine_Entry & ~1UL;
+    *(--sp) = 0;
+    for(i = 0; i < 4; i++)
+    {
+        *(--sp) = 0;
+    }
+    *(--sp) = (uint32_t)Co;
+
+    /*软件保存：r4-r11、EXC_RETURN*/
+    *(--sp) = COROUTINE_EXC_RETURN;
+    for(i = 0; i < 8; i++)
+    {
+        *(--sp) = 0;
+    }
+
+    Co->SP = (uintptr_t)sp;
+}
+
+/**
+  * @brief  切换协程，触发PendSV，返回时已切换回From
+  * @param  From: 当前协程
+  * @param  To: 目标协程
+  * @retval 无
+  */
+void Coroutine_PortSwitch(Coroutine_TypeDef* From, Coroutine_TypeDef* To)
+{
+    Coroutine_PortFromSP = &From->SP;
+    Coroutine_PortToSP = &To->SP;
+    SCB->ICSR = SCB_ICSR_PENDSVSET_Msk;
+    __DSB();
+    __ISB();
+}
+
+/**
+  * @brief  获取协程时基
+  * @param  无
+  * @retval 毫秒数
+  */
+uint32_t Coroutine_PortGetTick(void)
+{
+    return millis();
+}
+
+/**
+  * @brief  当前是否可以切换协程(线程模式且PendSV未被屏蔽)
+  * @param  无
+  * @retval true: 可以切换
+  */
+bool Coroutine_PortCanSwitch(void)
+{
+    return __get_IPSR() == 0 && __get_PRIMASK() == 0 && __get_BASEPRI() == 0;
+}
+
+/**
+  * @brief  所有协程都在睡眠，等待下一个中断(SysTick)
+  * @param  无
+  * @retval 无
+  */
+void Coroutine_PortIdle(void)
+{
+    __WFI();
+}
+
+/*
+ * 保存和恢复期间关中断：从主循环切出时保存区位于MSP之下，需要先下移MSP，
+ * 否则更高优先级中断会覆盖它。
+ */
+#if defined(__CC_ARM)
+__asm void PendSV_Handler(void)
+{
+    PRESERVE8
+
+    CPSID   I
+    TST     lr, #4
+    ITE     EQ
+    MRSEQ   r0, MSP
+    MRSNE   r0, PSP
+#if (__FPU_USED == 1)
+    TST     lr, #0x10
+    IT      EQ
+    VSTMDBEQ r0!, {s16-s31}
+#endif
+    STMDB   r0!, {r4-r11, lr}
+    TST     lr, #4
+    IT      EQ
+    MSREQ   MSP, r0
+
+    LDR     r1, =__cpp(&Coroutine_PortFromSP)
+    LDR     r1, [r1]
+    STR     r0, [r1]
+
+    LDR     r1, =__cpp(&Coroutine_PortToSP)
+    LDR     r1, [r1]
+    LDR     r0, [r1]
+    LDMIA   r0!, {r4-r11, lr}
+#if (__FPU_USED == 1)
+    TST     lr, #0x10
+    IT      EQ
+    VLDMIAEQ r0!, {s16-s31}
+#endif
+    TST     lr, #4
+    ITE     EQ
+    MSREQ   MSP, r0
+    MSRNE   PSP, r0
+    CPSIE   I
+    BX      lr
+
+    ALIGN
+}
+#elif defined(__GNUC__)
+__attribute__((naked)) void PendSV_Handler(void)
+{
+    __asm volatile(
+        "cpsid   i                      \n"
+        "tst     lr, #4                 \n"
+        "ite     eq                     \n"
+        "mrseq   r0, msp                \n"
+        "mrsne   r0, psp                \n"
+#if (__FPU_USED == 1)
+        "tst     lr, #0x10              \n"
+        "it      eq                     \n"
+        "vstmdbeq r0!, {s16-s31}        \n"
+#endif
+        "stmdb   r0!, {r4-r11, lr}      \n"
+        "tst     lr, #4                 \n"
+        "it      eq                     \n"
+        "msreq   msp, r0                \n"
+
+        "ldr     r1, =Coroutine_PortFromSP \n"
+        "ldr     r1, [r1]               \n"
+        "str     r0, [r1]               \n"
+
+        "ldr     r1, =Coroutine_PortToSP \n"
+        "ldr     r1, [r1]               \n"
+        "ldr     r0, [r1]               \n"
+        "ldmia   r0!, {r4-r11, lr}      \n"
+#if (__FPU_USED == 1)
+        "tst     lr, #0x10              \n"
+        "it      eq                     \n"
+        "vldmiaeq r0!, {s16-s31}        \n"
+#endif
+        "tst     lr, #4                 \n"
+        "ite     eq                     \n"
+        "msreq   msp, r0                \n"
+        "msrne   psp, r0                \n"
+        "cpsie   i                      \n"
+        "bx      lr                     \n"
+        ".ltorg                         \n"
+    );
+}
+#endif
+
+#endif /* COROUTINE_ENABLE */
@@ -0,0 +1,307 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "debounce.h"
+#include "exti.h"
+#include "gpio.h"
+#include "soft_timer.h"
+
+#if DEBOUNCE_ENABLE
+
+#if !SOFT_TIMER_ENABLE
+#  error "Debounce requires SOFT_TIMER_ENABLE"
+#endif
+
+/*
+ * 空闲时所有按键的外部中断(双边沿)处于使能状态，任一边沿唤醒后关闭这些中断线，
+ * 由软件定时器周期采样，全部稳定且无长按计时后停止采样、重新使能中断线。
+ * 抖动期间不会反复进入外部中断。
+ * 两个按键使用相同编号的中断线时无法同时用于唤醒，退化为持续采样。
+ */
+
+static Debounce_Filter_TypeDef Debounce_Filter;
+static SoftTimer_TypeDef Debounce_ScanTimer;
+
+static gpio_type* Debounce_GPIOx[DEBOUNCE_FILTER_INPUTS] = {0};
+static uint16_t Debounce_GPIO_Pin[DEBOUNCE_FILTER_INPUTS] = {0};
+static uint32_t Debounce_Inverted = 0;
+static uint8_t Debounce_Count = 0;
+
+static uint32_t Debounce_LineMask = 0;
+static bool Debounce_PollOnly = false;
+static volatile bool Debounce_IsScanning = false;
+static bool Debounce_IsInit = false;
+
+static Debounce_CallbackFunction_t Debounce_Function = NULL;
+static void* Debounce_UserData = NULL;
+
+static uint32_t Debounce_Sample(void)
+{
+    uint32_t sample = 0;
+    uint8_t i;
+
+    for(i = 0; i < Debounce_Count; i++)
+    {
+        if(Debounce_GPIOx[i]->idt & Debounce_GPIO_Pin[i])
+        {
+            sample |= 1UL << i;
+        }
+    }
+
+    return sample ^ Debounce_Inverted;
+}
+
+/*调用时需关中断或处于软件定时器中断中*/
+static void Debounce_StartScan(void)
+{
+    if(Debounce_IsScanning)
+    {
+        return;
+    }
+
+    exint_interrupt_enable(Debounce_LineMask, FALSE);
+    Debounce_IsScanning = true;
+    SoftTimer_Start(&Debounce_ScanTimer, DEBOUNCE_SCAN_TIME, DEBOUNCE_SCAN_TIME);
+}
+
+static void Debounce_WakeHandler(void)
+{
+    Debounce_StartScan();
+}
+
+static void Debounce_ScanHandler(void* UserData)
+{
+    if(Debounce_FilterUpdate(&Debounce_Filter, Debounce_Sample()) || Debounce_PollOnly)
+    {
+        return;
+    }
+
+    SoftTimer_Stop(&Debounce_ScanTimer);
+    Debounce_IsScanning = false;
+
+    exint_flag_clear(Debounce_LineMask);
+    exint_interrupt_enable(Debounce_LineMask, TRUE);
+
+    /*停止采样与重新使能之间出现的边沿不会触发中断，再检查一次*/
+    if(Debounce_Sample() != Debounce_Filter.State)
+    {
+        Debounce_StartScan();
+    }
+}
+
+/**
+  * @brief  按键消抖服务初始化
+  * @param  LongTime: 长按时间(毫秒)，0为不产生长按事件
+  * @param  RepeatTime: 长按后连发间隔(毫秒)，0为不连发
+  * @retval true: 成功
+  */
+bool Debounce_Init(uint32_t LongTime, uint32_t RepeatTime)
+{
+    uint32_t longTicks = LongTime * 1000 / DEBOUNCE_SCAN_TIME;
+    uint32_t repeatTicks = RepeatTime * 1000 / DEBOUNCE_SCAN_TIME;
+
+    if(Debounce_IsInit)
+    {
+        return true;
+    }
+
+    if(!SoftTimer_Init())
+    {
+        return false;
+    }
+
+    if(LongTime && !longTicks)
+    {
+        longTicks = 1;
+    }
+
+    if(RepeatTime && !repeatTicks)
+    {
+        repeatTicks = 1;
+    }
+
+    Debounce_FilterInit(
+        &Debounce_Filter,
+        0,
+        longTicks > 0xFFFF ? 0xFFFF : longTicks,
+        repeatTicks > 0xFFFF ? 0xFFFF : repeatTicks
+    );
+    SoftTimer_Create(&Debounce_ScanTimer, Debounce_ScanHandler, NULL);
+
+    Debounce_IsInit = true;
+    return true;
+}
+
+/**
+  * @brief  添加按键
+  * @param  Pin: 引脚编号
+  * @param  ActiveLow: true: 按下为低电平(上拉输入)，false: 按下为高电平(下拉输入)
+  * @retval 按键编号(事件中的Index)，失败返回DEBOUNCE_INVALID，
+  *         包括中断线已被attachInterrupt等其他模块占用
+  */
+uint8_t Debounce_Attach(uint8_t Pin, bool ActiveLow)
+{
+    uint32_t primask;
+    uint32_t line;
+    uint32_t bit;
+    uint8_t index;
+
+    if(!Debounce_IsInit || !IS_PIN(Pin) || Debounce_Count >= DEBOUNCE_FILTER_INPUTS)
+    {
+        return DEBOUNCE_INVALID;
+    }
+
+    line = 1UL << GPIO_GetPinNum(Pin);
+
+    /*中断线由其他模块使用时不覆盖其回调*/
+    if(!(Debounce_LineMask & line) && EXTI_IsLineBusy(Pin))
+    {
+        return DEBOUNCE_INVALID;
+    }
+
+    GPIOx_Init(
+        PIN_MAP[Pin].GPIOx,
+        PIN_MAP[Pin].GPIO_Pin_x,
+        ActiveLow ? INPUT_PULLUP : INPUT_PULLDOWN,
+        GPIO_DRIVE_DEFAULT
+    );
+
+    index = Debounce_Count;
+    bit = 1UL << index;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    Debounce_GPIOx[index] = PIN_MAP[Pin].GPIOx;
+    Debounce_GPIO_Pin[index] = PIN_MAP[Pin].GPIO_Pin_x;
+    if(ActiveLow)
+    {
+        Debounce_Inverted |= bit;
+    }
+    Debounce_Count++;
+
+    /*以当前电平作为初始状态，不产生事件*/
+    Debounce_Filter.State = (Debounce_Filter.State & ~bit) | (Debounce_Sample() & bit);
+    Debounce_Filter.Cnt0 &= ~bit;
+    Debounce_Filter.Cnt1 &= ~bit;
+
+    __set_PRIMASK(primask);
+
+    if(Debounce_LineMask & line)
+    {
+        Debounce_PollOnly = true;
+    }
+    else
+    {
+        EXTIx_Init(Pin, Debounce_WakeHandler, CHANGE, DEBOUNCE_PREEMPTIONPRIORITY, DEBOUNCE_SUBPRIORITY);
+
+        primask = __get_PRIMASK();
+        __disable_irq();
+        Debounce_LineMask |= line;
+        if(Debounce_IsScanning)
+        {
+            exint_interrupt_enable(line, FALSE);
+        }
+        __set_PRIMASK(primask);
+    }
+
+    if(Debounce_PollOnly)
+    {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        Debounce_StartScan();
+        __set_PRIMASK(primask);
+    }
+
+    return index;
+}
+
+/**
+  * @brief  设置事件回调，由Debounce_Process在调用者上下文中执行
+  * @param  Function: 回调函数
+  * @param  UserData: 用户数据
+  * @retval 无
+  */
+void Debounce_SetCallback(Debounce_CallbackFunction_t Function, void* UserData)
+{
+    Debounce_Function = Function;
+    Debounce_UserData = UserData;
+}
+
+/**
+  * @brief  处理按键事件，在主循环中调用
+  * @param  MaxCount: 最多处理的事件数，0为不限制
+  * @retval 处理的事件数
+  */
+uint32_t Debounce_Process(uint32_t MaxCount)
+{
+    Debounce_Event_TypeDef event;
+    uint32_t count = 0;
+
+    while((MaxCount == 0 || count < MaxCount) && Debounce_GetEvent(&event))
+    {
+        if(Debounce_Function)
+        {
+            Debounce_Function(&event, Debounce_UserData);
+        }
+        count++;
+    }
+
+    return count;
+}
+
+/**
+  * @brief  读取一个按键事件
+  * @param  Event: 输出事件
+  * @retval true: 读到事件
+  */
+bool Debounce_GetEvent(Debounce_Event_TypeDef* Event)
+{
+    return Debounce_FilterGetEvent(&Debounce_Filter, Event);
+}
+
+/**
+  * @brief  按键是否按下(消抖后)
+  * @param  Index: 按键编号
+  * @retval true: 按下
+  */
+bool Debounce_IsPressed(uint8_t Index)
+{
+    if(Index >= Debounce_Count)
+    {
+        return false;
+    }
+
+    return (Debounce_Filter.State >> Index) & 1;
+}
+
+/**
+  * @brief  获取所有按键状态(消抖后)
+  * @param  无
+  * @retval 第n位为按键n的状态，1为按下
+  */
+uint32_t Debounce_GetState(void)
+{
+    return Debounce_Filter.State;
+}
+
+#endif /* DEBOUNCE_ENABLE */
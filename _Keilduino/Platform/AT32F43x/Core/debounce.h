@@ -0,0 +1,52 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __DEBOUNCE_H
+#define __DEBOUNCE_H
+
+#include <stdbool.h>
+#include "mcu_type.h"
+#include "debounce_filter.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DEBOUNCE_INVALID    0xFF
+
+typedef void(*Debounce_CallbackFunction_t)(const Debounce_Event_TypeDef* Event, void* UserData);
+
+#if DEBOUNCE_ENABLE
+bool     Debounce_Init(uint32_t LongTime, uint32_t RepeatTime);
+uint8_t  Debounce_Attach(uint8_t Pin, bool ActiveLow);
+void     Debounce_SetCallback(Debounce_CallbackFunction_t Function, void* UserData);
+uint32_t Debounce_Process(uint32_t MaxCount);
+bool     Debounce_GetEvent(Debounce_Event_TypeDef* Event);
+bool     Debounce_IsPressed(uint8_t Index);
+uint32_t Debounce_GetState(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DEBOUNCE_H */
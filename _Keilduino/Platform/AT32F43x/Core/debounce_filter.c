@@ -0,0 +1,195 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "debounce_filter.h"
+
+#define DEBOUNCE_EVENT_MASK     (DEBOUNCE_FILTER_EVENT_SIZE - 1)
+
+/*阻止编译器把事件内容的读写移到EventHead/EventTail更新之后*/
+#if defined(__CC_ARM)
+#  define DEBOUNCE_BARRIER()    __schedule_barrier()
+#elif defined(__GNUC__)
+#  define DEBOUNCE_BARRIER()    __asm volatile("" ::: "memory")
+#else
+#  define DEBOUNCE_BARRIER()
+#endif
+
+static uint8_t Debounce_Ctz(uint32_t value)
+{
+#if defined(__CC_ARM)
+    return __clz(__rbit(value));
+#elif defined(__GNUC__)
+    return __builtin_ctz(value);
+#else
+    uint8_t n = 0;
+    while(!(value & 1))
+    {
+        value >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static void Debounce_PushEvent(Debounce_Filter_TypeDef* Filter, uint8_t Index, Debounce_Event_Type Event)
+{
+    uint8_t head = Filter->EventHead;
+    uint8_t next = (head + 1) & DEBOUNCE_EVENT_MASK;
+
+    if(next == Filter->EventTail)
+    {
+        Filter->EventDropped++;
+        return;
+    }
+
+    Filter->Events[head].Index = Index;
+    Filter->Events[head].Event = (uint8_t)Event;
+    DEBOUNCE_BARRIER();
+    Filter->EventHead = next;
+}
+
+/**
+  * @brief  消抖器初始化
+  * @param  Filter: 消抖器
+  * @param  State: 初始状态(通常为第一次采样值)
+  * @param  LongTicks: 长按时间(采样次数)，0为不产生长按
+  * @param  RepeatTicks: 长按后连发间隔(采样次数)，0为不连发
+  * @retval 无
+  */
+void Debounce_FilterInit(Debounce_Filter_TypeDef* Filter, uint32_t State, uint16_t LongTicks, uint16_t RepeatTicks)
+{
+    uint8_t i;
+
+    Filter->State = State;
+    Filter->Cnt0 = 0;
+    Filter->Cnt1 = 0;
+    Filter->LongReported = 0;
+    Filter->LongTicks = LongTicks;
+    Filter->RepeatTicks = RepeatTicks;
+    for(i = 0; i < DEBOUNCE_FILTER_INPUTS; i++)
+    {
+        Filter->Hold[i] = 0;
+    }
+    Filter->EventHead = 0;
+    Filter->EventTail = 0;
+    Filter->EventDropped = 0;
+}
+
+/**
+  * @brief  垂直计数器积分，与状态不同的输入计数加1，相同的清零，
+  *         计满4次翻转状态
+  * @param  Filter: 消抖器
+  * @param  Sample: 采样值
+  * @retval 本次翻转的输入掩码
+  */
+uint32_t Debounce_FilterIntegrate(Debounce_Filter_TypeDef* Filter, uint32_t Sample)
+{
+    uint32_t delta = Sample ^ Filter->State;
+    uint32_t toggle = delta & Filter->Cnt0 & Filter->Cnt1;
+
+    Filter->Cnt1 = (Filter->Cnt1 ^ Filter->Cnt0) & delta;
+    Filter->Cnt0 = ~Filter->Cnt0 & delta;
+    Filter->State ^= toggle;
+
+    return toggle;
+}
+
+/**
+  * @brief  采样一次，产生按键事件
+  * @param  Filter: 消抖器
+  * @param  Sample: 采样值
+  * @retval true: 仍需继续采样(有输入未稳定或需要计时)，false: 可以停止采样等待外部中断
+  */
+bool Debounce_FilterUpdate(Debounce_Filter_TypeDef* Filter, uint32_t Sample)
+{
+    uint32_t toggle = Debounce_FilterIntegrate(Filter, Sample);
+    uint32_t pressed = Filter->State;
+    uint32_t timing;
+    uint32_t mask;
+
+    mask = toggle;
+    while(mask)
+    {
+        uint8_t i = Debounce_Ctz(mask);
+        mask &= mask - 1;
+
+        Filter->Hold[i] = 0;
+        Filter->LongReported &= ~(1UL << i);
+        Debounce_PushEvent(Filter, i, (pressed & (1UL << i)) ? DEBOUNCE_EVENT_PRESS : DEBOUNCE_EVENT_RELEASE);
+    }
+
+    /*只对按住且还需要长按/连发计时的输入计数*/
+    timing = 0;
+    if(Filter->LongTicks)
+    {
+        timing = Filter->RepeatTicks ? pressed : (pressed & ~Filter->LongReported);
+    }
+
+    mask = timing & ~toggle;
+    while(mask)
+    {
+        uint8_t i = Debounce_Ctz(mask);
+        uint32_t bit = 1UL << i;
+        mask &= mask - 1;
+
+        Filter->Hold[i]++;
+
+        if(!(Filter->LongReported & bit))
+        {
+            if(Filter->Hold[i] >= Filter->LongTicks)
+            {
+                Filter->LongReported |= bit;
+                Filter->Hold[i] = 0;
+                Debounce_PushEvent(Filter, i, DEBOUNCE_EVENT_LONG_PRESS);
+            }
+        }
+        else if(Filter->Hold[i] >= Filter->RepeatTicks)
+        {
+            Filter->Hold[i] = 0;
+            Debounce_PushEvent(Filter, i, DEBOUNCE_EVENT_REPEAT);
+        }
+    }
+
+    return (Filter->Cnt0 | Filter->Cnt1 | (Sample ^ Filter->State) | timing) != 0;
+}
+
+/**
+  * @brief  读取一个事件
+  * @param  Filter: 消抖器
+  * @param  Event: 输出事件
+  * @retval true: 读到事件
+  */
+bool Debounce_FilterGetEvent(Debounce_Filter_TypeDef* Filter, Debounce_Event_TypeDef* Event)
+{
+    uint8_t tail = Filter->EventTail;
+
+    if(tail == Filter->EventHead)
+    {
+        return false;
+    }
+
+    DEBOUNCE_BARRIER();
+    *Event = Filter->Events[tail];
+    DEBOUNCE_BARRIER();
+    Filter->EventTail = (tail + 1) & DEBOUNCE_EVENT_MASK;
+    return true;
+}
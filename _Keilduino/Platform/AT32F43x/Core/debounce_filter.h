@@ -0,0 +1,80 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __DEBOUNCE_FILTER_H
+#define __DEBOUNCE_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 按键消抖：32路输入共用2位垂直计数器，每次采样用几条位运算同时处理所有输入，
+ * 连续4次采样与当前状态不同才翻转。在此基础上产生按下/释放/长按/连发事件。
+ * 采样值中1表示按下。本文件不访问寄存器，可在PC上编译验证。
+ */
+#define DEBOUNCE_FILTER_INPUTS      32
+#define DEBOUNCE_FILTER_EVENT_SIZE  16
+
+typedef enum
+{
+    DEBOUNCE_EVENT_PRESS,
+    DEBOUNCE_EVENT_RELEASE,
+    DEBOUNCE_EVENT_LONG_PRESS,
+    DEBOUNCE_EVENT_REPEAT
+} Debounce_Event_Type;
+
+typedef struct
+{
+    uint8_t Index;
+    uint8_t Event;
+} Debounce_Event_TypeDef;
+
+typedef struct
+{
+    uint32_t State;         // 消抖后的状态
+    uint32_t Cnt0;          // 垂直计数器低位
+    uint32_t Cnt1;          // 垂直计数器高位
+    uint32_t LongReported;  // 已产生长按事件
+    uint16_t Hold[DEBOUNCE_FILTER_INPUTS];
+    uint16_t LongTicks;     // 长按时间(采样次数)，0为不产生长按
+    uint16_t RepeatTicks;   // 长按后连发间隔(采样次数)，0为不连发
+
+    Debounce_Event_TypeDef Events[DEBOUNCE_FILTER_EVENT_SIZE];
+    volatile uint8_t EventHead;
+    volatile uint8_t EventTail;
+    uint32_t EventDropped;
+} Debounce_Filter_TypeDef;
+
+void     Debounce_FilterInit(Debounce_Filter_TypeDef* Filter, uint32_t State, uint16_t LongTicks, uint16_t RepeatTicks);
+uint32_t Debounce_FilterIntegrate(Debounce_Filter_TypeDef* Filter, uint32_t Sample);
+bool     Debounce_FilterUpdate(Debounce_Filter_TypeDef* Filter, uint32_t Sample);
+bool     Debounce_FilterGetEvent(Debounce_Filter_TypeDef* Filter, Debounce_Event_TypeDef* Event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DEBOUNCE_FILTER_H */
@@ -0,0 +1,194 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "defer.h"
+
+#if DEFER_ENABLE
+
+/*
+ * 中断中只提交(函数, 参数)，在主循环(Defer_Process)或最低优先级的软件中断中执行，
+ * 缩短中断占用时间。优先级0最高，每执行完一项都从最高优先级重新检查。
+ * 同一时间只能有一个执行者：使能DEFER_SWI时由软件中断执行，Defer_Process不起作用。
+ */
+
+static Work_QueueCell_TypeDef Defer_Cells[DEFER_PRIORITY_NUM][DEFER_QUEUE_SIZE];
+static Work_Queue_TypeDef Defer_Queue[DEFER_PRIORITY_NUM];
+static bool Defer_IsInit = false;
+
+static uint32_t Defer_Drain(uint32_t MaxCount)
+{
+    Work_Item_TypeDef item;
+    uint32_t count = 0;
+    uint8_t prio = 0;
+
+    while(prio < DEFER_PRIORITY_NUM && (MaxCount == 0 || count < MaxCount))
+    {
+        if(!Work_QueuePop(&Defer_Queue[prio], &item))
+        {
+            prio++;
+            continue;
+        }
+
+        item.Function(item.Argument);
+        count++;
+        prio = 0;
+    }
+
+    return count;
+}
+
+/**
+  * @brief  延迟执行服务初始化
+  * @param  无
+  * @retval true: 成功
+  */
+bool Defer_Init(void)
+{
+    uint8_t i;
+
+    if(Defer_IsInit)
+    {
+        return true;
+    }
+
+    for(i = 0; i < DEFER_PRIORITY_NUM; i++)
+    {
+        if(!Work_QueueInit(&Defer_Queue[i], Defer_Cells[i], DEFER_QUEUE_SIZE))
+        {
+            return false;
+        }
+    }
+
+#if DEFER_SWI_ENABLE
+    NVIC_ClearPendingIRQ(DEFER_SWI_IRQn);
+    nvic_irq_enable(DEFER_SWI_IRQn, DEFER_SWI_PREEMPTIONPRIORITY, DEFER_SWI_SUBPRIORITY);
+#endif
+
+    Defer_IsInit = true;
+    return true;
+}
+
+/**
+  * @brief  提交延迟执行的工作，可在任意中断中调用(可嵌套)
+  * @param  Function: 工作函数
+  * @param  Argument: 参数
+  * @param  Priority: 优先级，0最高，小于DEFER_PRIORITY_NUM
+  * @retval true: 成功，false: 未初始化或队列已满
+  */
+bool Defer_Post(Defer_Function_t Function, void* Argument, uint8_t Priority)
+{
+    if(!Defer_IsInit || !Function || Priority >= DEFER_PRIORITY_NUM)
+    {
+        return false;
+    }
+
+    if(!Work_QueuePost(&Defer_Queue[Priority], Function, Argument))
+    {
+        return false;
+    }
+
+#if DEFER_SWI_ENABLE
+    NVIC_SetPendingIRQ(DEFER_SWI_IRQn);
+#endif
+    return true;
+}
+
+/**
+  * @brief  执行已提交的工作，在主循环中调用
+  * @param  MaxCount: 最多执行的工作数，0为不限制
+  * @retval 执行的工作数
+  */
+uint32_t Defer_Process(uint32_t MaxCount)
+{
+#if DEFER_SWI_ENABLE
+    (void)MaxCount;
+    return 0;
+#else
+    if(!Defer_IsInit)
+    {
+        return 0;
+    }
+
+    return Defer_Drain(MaxCount);
+#endif
+}
+
+/**
+  * @brief  获取等待执行的工作数
+  * @param  Priority: 优先级
+  * @retval 工作数
+  */
+uint32_t Defer_GetCount(uint8_t Priority)
+{
+    if(!Defer_IsInit || Priority >= DEFER_PRIORITY_NUM)
+    {
+        return 0;
+    }
+
+    return Work_QueueGetCount(&Defer_Queue[Priority]);
+}
+
+/**
+  * @brief  获取队列深度的最大值，用于确定DEFER_QUEUE_SIZE
+  * @param  Priority: 优先级
+  * @param  Clear: 读取后清零
+  * @retval 最大工作数
+  */
+uint32_t Defer_GetHighWater(uint8_t Priority, bool Clear)
+{
+    if(!Defer_IsInit || Priority >= DEFER_PRIORITY_NUM)
+    {
+        return 0;
+    }
+
+    return Work_QueueGetHighWater(&Defer_Queue[Priority], Clear);
+}
+
+/**
+  * @brief  获取因队列满而丢弃的工作数
+  * @param  Priority: 优先级
+  * @param  Clear: 读取后清零
+  * @retval 丢弃数
+  */
+uint32_t Defer_GetDropped(uint8_t Priority, bool Clear)
+{
+    if(!Defer_IsInit || Priority >= DEFER_PRIORITY_NUM)
+    {
+        return 0;
+    }
+
+    return Work_QueueGetDropped(&Defer_Queue[Priority], Clear);
+}
+
+#if DEFER_SWI_ENABLE
+/**
+  * @brief  软件中断入口，执行所有已提交的工作
+  * @param  无
+  * @retval 无
+  */
+DEFER_SWI_IRQ_HANDLER_DEF()
+{
+    Defer_Drain(0);
+}
+#endif
+
+#endif /* DEFER_ENABLE */
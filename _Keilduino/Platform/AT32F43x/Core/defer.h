@@ -0,0 +1,49 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __DEFER_H
+#define __DEFER_H
+
+#include <stdbool.h>
+#include "mcu_type.h"
+#include "work_queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef Work_Function_t Defer_Function_t;
+
+#if DEFER_ENABLE
+bool     Defer_Init(void);
+bool     Defer_Post(Defer_Function_t Function, void* Argument, uint8_t Priority);
+uint32_t Defer_Process(uint32_t MaxCount);
+uint32_t Defer_GetCount(uint8_t Priority);
+uint32_t Defer_GetHighWater(uint8_t Priority, bool Clear);
+uint32_t Defer_GetDropped(uint8_t Priority, bool Clear);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DEFER_H */
@@ -21,6 +21,9 @@
  * SOFTWARE.
  */
 #include "delay.h"
+#include "dwt.h"
+#include "coroutine.h"
+#include "delay_clock.h"
 
 #ifndef SYSTICK_TICK_FREQ
 #  define SYSTICK_TICK_FREQ     1000 // Hz
@@ -32,6 +35,24 @@
 
 static volatile uint32_t SystemTickCount = 0;
 
+/*
+ * 64位时钟：DWT周期计数器(32位，288MHz约14.9秒回绕)由SysTick中断定期做快照扩展，
+ * 见delay_clock.c。要求两次SysTick中断间隔小于DWT回绕周期。
+ */
+static DelayClock_TypeDef Delay_Clock;
+
+/*周期相关的参数在Delay_Init中按实际主频填写*/
+static DelayClock_SysTick_TypeDef Delay_SysTick =
+{
+    &SystemTickCount,
+    &SysTick->VAL,
+    &SCB->ICSR,
+    SCB_ICSR_PENDSTSET_Msk,
+    0,
+    1,
+    SYSTICK_TICK_INTERVAL * 1000
+};
+
 /**
   * @brief  系统滴答定时器初始化，定时1ms
   * @param  无
@@ -40,6 +61,12 @@ static volatile uint32_t SystemTickCount = 0;
 void Delay_Init(void)
 {
     system_core_clock_update();
+
+    DelayClock_Init(&Delay_Clock, CYCLES_PER_MICROSECOND, DWT_CYCLE_CNT);
+
+    Delay_SysTick.Load = SYSTICK_LOAD_VALUE;
+    Delay_SysTick.CyclesPerMicros = CYCLES_PER_MICROSECOND;
+
     SysTick_Config(SYSTICK_LOAD_VALUE);
     NVIC_SetPriority(SysTick_IRQn, SYSTICK_PRIORITY);
 }
@@ -49,9 +76,11 @@ void Delay_Init(void)
   * @param  无
   * @retval 无
   */
-void SysTick_Handler(void)
+RAMFUNC_ISR void SysTick_Handler(void)
 {
     SystemTickCount++;
+    /*DelayClock_Update在闪存中执行(delay_clock.c不区分平台)*/
+    DelayClock_Update(&Delay_Clock, DWT_CYCLE_CNT);
 }
 
 /**
@@ -71,7 +100,43 @@ uint32_t millis(void)
   */
 uint32_t micros(void)
 {
-    return (SYSTICK_MILLIS * 1000 + (SYSTICK_LOAD_VALUE - SysTick->VAL) / CYCLES_PER_MICROSECOND);
+    return DelayClock_SysTickMicros(&Delay_SysTick);
+}
+
+/**
+  * @brief  获取64位周期计数
+  * @param  无
+  * @retval 自DWT启动以来的CPU周期数
+  */
+uint64_t cycles64(void)
+{
+    DelayClock_Snapshot_TypeDef snapshot;
+    DelayClock_Read(&Delay_Clock, &snapshot);
+    return DelayClock_ToCycles(&snapshot, DWT_CYCLE_CNT);
+}
+
+/**
+  * @brief  获取64位微秒数，不回绕
+  * @param  无
+  * @retval 自DWT启动以来的微秒数
+  */
+uint64_t micros64(void)
+{
+    DelayClock_Snapshot_TypeDef snapshot;
+    DelayClock_Read(&Delay_Clock, &snapshot);
+    return DelayClock_ToMicros(&Delay_Clock, &snapshot, DWT_CYCLE_CNT);
+}
+
+/**
+  * @brief  获取64位纳秒数，分辨率为一个CPU周期
+  * @param  无
+  * @retval 自DWT启动以来的纳秒数
+  */
+uint64_t nanos64(void)
+{
+    DelayClock_Snapshot_TypeDef snapshot;
+    DelayClock_Read(&Delay_Clock, &snapshot);
+    return DelayClock_ToNanos(&Delay_Clock, &snapshot, DWT_CYCLE_CNT);
 }
 
 /**
@@ -81,8 +146,19 @@ uint32_t micros(void)
   */
 void delay_ms(uint32_t ms)
 {
-    uint32_t tickstart = SystemTickCount;
-    uint32_t wait = ms / SYSTICK_TICK_INTERVAL;
+    uint32_t tickstart;
+    uint32_t wait;
+
+#if COROUTINE_ENABLE
+    /*已创建协程时睡眠并运行其他协程*/
+    if(Coroutine_Delay(ms))
+    {
+        return;
+    }
+#endif
+
+    tickstart = SystemTickCount;
+    wait = ms / SYSTICK_TICK_INTERVAL;
 
     while((SystemTickCount - tickstart) < wait)
     {
@@ -32,6 +32,9 @@ extern "C" {
 void Delay_Init(void);
 uint32_t millis(void);
 uint32_t micros(void);
+uint64_t cycles64(void);
+uint64_t micros64(void);
+uint64_t nanos64(void);
 void delay_ms(uint32_t ms);
 void delay_us(uint32_t us);
 
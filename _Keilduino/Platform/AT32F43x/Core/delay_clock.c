@@ -0,0 +1,146 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "delay_clock.h"
+
+/**
+  * @brief  64位时钟初始化，以当前周期数向下取整到整微秒作为起点
+  * @param  Clock: 时钟
+  * @param  CyclesPerMicros: 每微秒的周期数
+  * @param  Cycles: 当前周期计数值
+  * @retval 无
+  */
+void DelayClock_Init(DelayClock_TypeDef* Clock, uint32_t CyclesPerMicros, uint32_t Cycles)
+{
+    uint64_t us = Cycles / CyclesPerMicros;
+
+    Clock->CyclesPerMicros = CyclesPerMicros;
+    Clock->Slot[0].Micros = us;
+    Clock->Slot[0].Cycles = us * CyclesPerMicros;
+    Clock->Seq = 0;
+}
+
+/**
+  * @brief  更新快照，在周期性中断中调用，写入另一个缓冲后再递增序号
+  * @param  Clock: 时钟
+  * @param  Cycles: 当前周期计数值
+  * @retval 无
+  */
+void DelayClock_Update(DelayClock_TypeDef* Clock, uint32_t Cycles)
+{
+    uint32_t seq = Clock->Seq;
+    volatile DelayClock_Snapshot_TypeDef* cur = &Clock->Slot[seq & 1];
+    volatile DelayClock_Snapshot_TypeDef* next = &Clock->Slot[(seq + 1) & 1];
+    uint32_t us = (Cycles - (uint32_t)cur->Cycles) / Clock->CyclesPerMicros;
+
+    next->Cycles = cur->Cycles + (uint64_t)us * Clock->CyclesPerMicros;
+    next->Micros = cur->Micros + us;
+    Clock->Seq = seq + 1;
+}
+
+/**
+  * @brief  读取一致的快照，读取期间快照被更新则重读；
+  *         之后读取的周期计数值与快照之差即为经过的周期数
+  * @param  Clock: 时钟
+  * @param  Snapshot: 输出快照
+  * @retval 无
+  */
+void DelayClock_Read(const DelayClock_TypeDef* Clock, DelayClock_Snapshot_TypeDef* Snapshot)
+{
+    uint32_t seq;
+
+    do
+    {
+        seq = Clock->Seq;
+        *Snapshot = Clock->Slot[seq & 1];
+    }
+    while(seq != Clock->Seq);
+}
+
+/**
+  * @brief  快照加上经过的周期数得到64位周期数
+  * @param  Snapshot: 快照
+  * @param  Cycles: 读取快照之后的周期计数值
+  * @retval 64位周期数
+  */
+uint64_t DelayClock_ToCycles(const DelayClock_Snapshot_TypeDef* Snapshot, uint32_t Cycles)
+{
+    return Snapshot->Cycles + (uint32_t)(Cycles - (uint32_t)Snapshot->Cycles);
+}
+
+/**
+  * @brief  快照加上经过的周期数得到64位微秒数
+  * @param  Clock: 时钟
+  * @param  Snapshot: 快照
+  * @param  Cycles: 读取快照之后的周期计数值
+  * @retval 64位微秒数
+  */
+uint64_t DelayClock_ToMicros(const DelayClock_TypeDef* Clock, const DelayClock_Snapshot_TypeDef* Snapshot, uint32_t Cycles)
+{
+    uint32_t elapsed = Cycles - (uint32_t)Snapshot->Cycles;
+    return Snapshot->Micros + elapsed / Clock->CyclesPerMicros;
+}
+
+/**
+  * @brief  快照加上经过的周期数得到64位纳秒数，分辨率为一个周期
+  * @param  Clock: 时钟
+  * @param  Snapshot: 快照
+  * @param  Cycles: 读取快照之后的周期计数值
+  * @retval 64位纳秒数
+  */
+uint64_t DelayClock_ToNanos(const DelayClock_TypeDef* Clock, const DelayClock_Snapshot_TypeDef* Snapshot, uint32_t Cycles)
+{
+    uint32_t elapsed = Cycles - (uint32_t)Snapshot->Cycles;
+    uint32_t us = elapsed / Clock->CyclesPerMicros;
+    uint32_t rem = elapsed - us * Clock->CyclesPerMicros;
+    return (Snapshot->Micros + us) * 1000 + rem * 1000 / Clock->CyclesPerMicros;
+}
+
+/**
+  * @brief  由SysTick节拍计数和VAL计算32位微秒数
+  * @param  Tick: SysTick描述
+  * @retval 微秒数
+  */
+uint32_t DelayClock_SysTickMicros(const DelayClock_SysTick_TypeDef* Tick)
+{
+    uint32_t tick;
+    uint32_t count;
+    uint32_t val;
+
+    /*读取期间发生节拍中断则重读；VAL已重装但中断尚未执行(关中断或更高优先级中断中)时，
+     *挂起位已置位，重读VAL并补上一个节拍
+     */
+    do
+    {
+        tick = *Tick->TickCount;
+        val = *Tick->Val;
+        count = tick;
+        if(*Tick->Icsr & Tick->PendMask)
+        {
+            val = *Tick->Val;
+            count++;
+        }
+    }
+    while(tick != *Tick->TickCount);
+
+    return count * Tick->TickMicros + (Tick->Load - val) / Tick->CyclesPerMicros;
+}
@@ -0,0 +1,76 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __DELAY_CLOCK_H
+#define __DELAY_CLOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 64位时钟：32位周期计数器由周期性中断做快照扩展，快照双缓冲，
+ * 读取方检查序号变化后重读，不关中断也不会在中断中自旋等待。
+ * 要求两次快照的间隔小于周期计数器的回绕周期。
+ * 本文件不访问寄存器，计数值和寄存器地址由调用者传入，可在PC上验证。
+ */
+typedef struct
+{
+    uint64_t Cycles;    // 快照时的周期数，低32位与周期计数器对应
+    uint64_t Micros;    // 快照时的微秒数，Cycles恰好为整微秒
+} DelayClock_Snapshot_TypeDef;
+
+typedef struct
+{
+    volatile DelayClock_Snapshot_TypeDef Slot[2];
+    volatile uint32_t Seq;
+    uint32_t CyclesPerMicros;
+} DelayClock_TypeDef;
+
+/* SysTick节拍计数加上VAL得到32位微秒数，读取期间的节拍中断与关中断时的挂起节拍都会被处理 */
+typedef struct
+{
+    const volatile uint32_t* TickCount; // 节拍中断计数
+    const volatile uint32_t* Val;       // SysTick->VAL
+    const volatile uint32_t* Icsr;      // SCB->ICSR
+    uint32_t PendMask;                  // SCB_ICSR_PENDSTSET_Msk
+    uint32_t Load;                      // 每个节拍的周期数
+    uint32_t CyclesPerMicros;           // 每微秒的周期数
+    uint32_t TickMicros;                // 每个节拍的微秒数
+} DelayClock_SysTick_TypeDef;
+
+void     DelayClock_Init(DelayClock_TypeDef* Clock, uint32_t CyclesPerMicros, uint32_t Cycles);
+void     DelayClock_Update(DelayClock_TypeDef* Clock, uint32_t Cycles);
+void     DelayClock_Read(const DelayClock_TypeDef* Clock, DelayClock_Snapshot_TypeDef* Snapshot);
+uint64_t DelayClock_ToCycles(const DelayClock_Snapshot_TypeDef* Snapshot, uint32_t Cycles);
+uint64_t DelayClock_ToMicros(const DelayClock_TypeDef* Clock, const DelayClock_Snapshot_TypeDef* Snapshot, uint32_t Cycles);
+uint64_t DelayClock_ToNanos(const DelayClock_TypeDef* Clock, const DelayClock_Snapshot_TypeDef* Snapshot, uint32_t Cycles);
+uint32_t DelayClock_SysTickMicros(const DelayClock_SysTick_TypeDef* Tick);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DELAY_CLOCK_H */
@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "dma_stream.h"
+
+static void DMA_Stream_Refill(DMA_Stream_TypeDef* Stream, uint8_t* half, uint8_t queued)
+{
+    uint16_t filled = 0;
+
+    if(!Stream->Ending)
+    {
+        filled = Stream->Fill(half, Stream->HalfLength, Stream->UserData);
+        if(filled > Stream->HalfLength)
+        {
+            filled = Stream->HalfLength;
+        }
+        if(filled < Stream->HalfLength)
+        {
+            Stream->Ending = queued;
+        }
+    }
+
+    Stream->Pad(half, filled, Stream->HalfLength, Stream->UserData);
+}
+
+/**
+  * @brief  初始化流并预填两个半缓冲，第一个半缓冲最先播放
+  * @param  Stream: 流
+  * @param  Buffer: 双缓冲，长度为 HalfLength * 2 个单元
+  * @param  HalfLength: 半缓冲单元数
+  * @param  UnitSize: 每单元字节数
+  * @param  Fill: 填充函数
+  * @param  Pad: 补齐函数
+  * @param  UserData: 用户数据
+  * @retval 无
+  */
+void DMA_Stream_Start(
+    DMA_Stream_TypeDef* Stream,
+    void* Buffer, uint16_t HalfLength, uint16_t UnitSize,
+    DMA_Stream_FillFunction_t Fill, DMA_Stream_PadFunction_t Pad, void* UserData
+)
+{
+    Stream->Buffer = (uint8_t*)Buffer;
+    Stream->HalfLength = HalfLength;
+    Stream->UnitSize = UnitSize;
+    Stream->Fill = Fill;
+    Stream->Pad = Pad;
+    Stream->UserData = UserData;
+    Stream->Ending = 0;
+
+    DMA_Stream_Refill(Stream, Stream->Buffer, 1);
+    DMA_Stream_Refill(Stream, Stream->Buffer + (uint32_t)HalfLength * UnitSize, 2);
+}
+
+/**
+  * @brief  半缓冲播放完毕，在DMA半传输/全传输中断中调用
+  * @param  Stream: 流
+  * @param  SecondHalf: false: 半传输(前半缓冲空闲)，true: 全传输(后半缓冲空闲)
+  * @retval true: 数据已全部播放，调用者应停止DMA
+  */
+bool DMA_Stream_Event(DMA_Stream_TypeDef* Stream, bool SecondHalf)
+{
+    uint8_t* half = Stream->Buffer;
+
+    if(Stream->Ending)
+    {
+        if(--Stream->Ending == 0)
+        {
+            return true;
+        }
+    }
+
+    if(SecondHalf)
+    {
+        half += (uint32_t)Stream->HalfLength * Stream->UnitSize;
+    }
+
+    DMA_Stream_Refill(Stream, half, 2);
+    return false;
+}
@@ -0,0 +1,70 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __DMA_STREAM_H
+#define __DMA_STREAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * DMA循环模式双缓冲的填充逻辑，供PWM_Wave、GPIO_Wave等流模式共用。
+ * 半传输/全传输中断通知一个半缓冲已播放完毕，在其中填入新数据；
+ * 数据结束后剩余部分由Pad补齐，已排队的半缓冲播放完后报告结束。
+ * 本文件不访问寄存器，可在PC上编译验证；DMA配置和中断由调用者负责。
+ */
+
+/* 填充函数，返回写入的单元数，小于Length表示数据结束 */
+typedef uint16_t(*DMA_Stream_FillFunction_t)(void* Half, uint16_t Length, void* UserData);
+
+/* 补齐函数，Half中[Filled, Length)的单元需要填入保持值 */
+typedef void(*DMA_Stream_PadFunction_t)(void* Half, uint16_t Filled, uint16_t Length, void* UserData);
+
+typedef struct
+{
+    uint8_t* Buffer;                    // 双缓冲起始地址
+    uint16_t HalfLength;                // 半缓冲单元数
+    uint16_t UnitSize;                  // 每单元字节数
+    DMA_Stream_FillFunction_t Fill;     // 填充函数
+    DMA_Stream_PadFunction_t Pad;       // 补齐函数
+    void* UserData;                     // 传给Fill/Pad
+
+    /*数据结束后还需播放的半缓冲个数，0表示未结束*/
+    uint8_t Ending;
+} DMA_Stream_TypeDef;
+
+void DMA_Stream_Start(
+    DMA_Stream_TypeDef* Stream,
+    void* Buffer, uint16_t HalfLength, uint16_t UnitSize,
+    DMA_Stream_FillFunction_t Fill, DMA_Stream_PadFunction_t Pad, void* UserData
+);
+bool DMA_Stream_Event(DMA_Stream_TypeDef* Stream, bool SecondHalf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DMA_STREAM_H */
@@ -0,0 +1,487 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "encoder.h"
+#include "timer.h"
+#include "exti.h"
+#include "Arduino.h"
+
+/**
+  * @brief  获取引脚的定时器信息
+  * @param  Pin: 引脚编号
+  * @param  Info: 定时器信息
+  * @retval 无
+  */
+static void Encoder_GetPinInfo(uint8_t Pin, Encoder_PinInfo_TypeDef* Info)
+{
+    tmr_type* TIMx;
+
+    if(!IS_PWM_PIN(Pin))
+    {
+        Info->Timer = NULL;
+        Info->Channel = 0;
+        Info->EncoderCapable = false;
+        return;
+    }
+
+    TIMx = PIN_MAP[Pin].TIMx;
+    Info->Timer = TIMx;
+    Info->Channel = PIN_MAP[Pin].TimerChannel;
+    Info->EncoderCapable = (TIMx == TIM1 || TIMx == TIM2 || TIMx == TIM3 || TIMx == TIM4
+                            || TIMx == TIM5 || TIMx == TIM8 || TIMx == TIM20);
+}
+
+/**
+  * @brief  检查A/B相引脚能否组成编码器接口
+  * @param  PinA: A相引脚编号
+  * @param  PinB: B相引脚编号
+  * @retval ENCODER_OK: 可用
+  */
+Encoder_Error_Type Encoder_CheckPins(uint8_t PinA, uint8_t PinB)
+{
+    Encoder_PinInfo_TypeDef infoA, infoB;
+
+    Encoder_GetPinInfo(PinA, &infoA);
+    Encoder_GetPinInfo(PinB, &infoB);
+    return Encoder_CheckPinInfo(PinA, &infoA, PinB, &infoB);
+}
+
+#if ENCODER_ENABLE
+
+#if ENCODER_MAX < 1 || ENCODER_MAX > 4
+#  error "ENCODER_MAX must be 1~4"
+#endif
+
+typedef struct
+{
+    tmr_type* TIMx;
+    uint8_t PinA;
+    uint8_t IndexPin;
+    bool IndexOnce;
+    volatile bool IndexReached;
+    uint64_t Range;
+
+    /*计数器溢出部分，为Range的整数倍*/
+    volatile int64_t High;
+
+    int64_t LastCount;
+    uint32_t LastTime;
+} Encoder_TypeDef;
+
+static Encoder_TypeDef Encoder_Group[ENCODER_MAX] = {0};
+
+static Encoder_TypeDef* Encoder_Find(uint8_t PinA)
+{
+    int i;
+    for(i = 0; i < ENCODER_MAX; i++)
+    {
+        if(Encoder_Group[i].TIMx != NULL && Encoder_Group[i].PinA == PinA)
+        {
+            return &Encoder_Group[i];
+        }
+    }
+    return NULL;
+}
+
+static void Encoder_PinInit(uint8_t Pin, bool PullUp)
+{
+    pinMode(Pin, OUTPUT_AF_PP);
+    gpio_pin_mux_config(PIN_MAP[Pin].GPIOx, GPIO_GetPinSource(PIN_MAP[Pin].GPIO_Pin_x), Timer_GetGPIO_MUX(Pin));
+
+    if(PullUp)
+    {
+        uint8_t pinNum = GPIO_GetPinNum(Pin);
+        gpio_type* GPIOx = PIN_MAP[Pin].GPIOx;
+        GPIOx->pull = (GPIOx->pull & ~(0x03U << (pinNum * 2))) | ((uint32_t)GPIO_PULL_UP << (pinNum * 2));
+    }
+}
+
+/**
+  * @brief  计数器溢出，扩展计数位数
+  * @param  TIMx: 定时器地址
+  * @param  Flags: 中断标志
+  * @param  UserData: 编码器
+  * @retval 无
+  */
+static void Encoder_EventHandler(tmr_type* TIMx, uint32_t Flags, void* UserData)
+{
+    Encoder_TypeDef* enc = (Encoder_TypeDef*)UserData;
+
+    if(!(Flags & TMR_OVF_FLAG))
+    {
+        return;
+    }
+
+    /*按计数器所在的半区判断上溢还是下溢，方向位在回绕点附近抖动时不可靠*/
+    enc->High += Encoder_OverflowStep(tmr_counter_value_get(TIMx), enc->Range);
+}
+
+/**
+  * @brief  编码器接口初始化，独占引脚对应的定时器
+  * @param  PinA: A相引脚编号(CH1或CH2)
+  * @param  PinB: B相引脚编号(同一定时器的另一个通道)
+  * @param  Mode: 计数方式
+  * @param  Filter: 输入滤波(0~15)
+  * @param  PullUp: 是否使能内部上拉
+  * @retval ENCODER_OK: 成功
+  */
+Encoder_Error_Type Encoder_Init(uint8_t PinA, uint8_t PinB, Encoder_Mode_Type Mode, uint8_t Filter, bool PullUp)
+{
+    static const tmr_encoder_mode_type mode_map[] =
+    {
+        TMR_ENCODER_MODE_A,
+        TMR_ENCODER_MODE_B,
+        TMR_ENCODER_MODE_C
+    };
+    Encoder_Error_Type error = Encoder_CheckPins(PinA, PinB);
+    Encoder_TypeDef* enc = NULL;
+    tmr_type* TIMx;
+    int i;
+
+    if(error != ENCODER_OK)
+    {
+        return error;
+    }
+
+    if((uint32_t)Mode >= sizeof(mode_map) / sizeof(mode_map[0]))
+    {
+        return ENCODER_ERR_PIN;
+    }
+
+    TIMx = PIN_MAP[PinA].TIMx;
+
+    for(i = 0; i < ENCODER_MAX; i++)
+    {
+        if(Encoder_Group[i].TIMx == TIMx && Encoder_Group[i].PinA != PinA)
+        {
+            return ENCODER_ERR_BUSY;
+        }
+    }
+
+    enc = Encoder_Find(PinA);
+    for(i = 0; enc == NULL && i < ENCODER_MAX; i++)
+    {
+        if(Encoder_Group[i].TIMx == NULL)
+        {
+            enc = &Encoder_Group[i];
+        }
+    }
+
+    if(enc == NULL)
+    {
+        return ENCODER_ERR_BUSY;
+    }
+
+    Encoder_PinInit(PinA, PullUp);
+    Encoder_PinInit(PinB, PullUp);
+
+    tmr_reset(TIMx);
+    Timer_ClockCmd(TIMx, true);
+
+    /*TMR2/TMR5支持32位计数*/
+    if(TIMx == TIM2 || TIMx == TIM5)
+    {
+        tmr_32_bit_function_enable(TIMx, TRUE);
+        enc->Range = 0x100000000ULL;
+        tmr_base_init(TIMx, 0xFFFFFFFF, 0);
+    }
+    else
+    {
+        enc->Range = 0x10000;
+        tmr_base_init(TIMx, 0xFFFF, 0);
+    }
+
+    /*A相在CH2时交换极性，使A超前B时计数增加*/
+    if(PIN_MAP[PinA].TimerChannel == 1)
+    {
+        tmr_encoder_mode_config(TIMx, mode_map[Mode], TMR_INPUT_RISING_EDGE, TMR_INPUT_RISING_EDGE);
+    }
+    else
+    {
+        tmr_encoder_mode_config(TIMx, mode_map[Mode], TMR_INPUT_FALLING_EDGE, TMR_INPUT_RISING_EDGE);
+    }
+
+    tmr_input_channel_filter_set(TIMx, TMR_SELECT_CHANNEL_1, Filter & 0x0F);
+    tmr_input_channel_filter_set(TIMx, TMR_SELECT_CHANNEL_2, Filter & 0x0F);
+
+    /*计数器清零，软件溢出事件不进入中断*/
+    tmr_counter_value_set(TIMx, 0);
+    tmr_flag_clear(TIMx, TMR_OVF_FLAG);
+
+    enc->TIMx = TIMx;
+    enc->PinA = PinA;
+    enc->IndexPin = NOT_A_PIN;
+    enc->IndexReached = false;
+    enc->High = 0;
+    enc->LastCount = 0;
+    enc->LastTime = micros();
+
+    Timer_SetEventCallback(TIMx, Encoder_EventHandler, enc, ENCODER_PREEMPTIONPRIORITY, ENCODER_SUBPRIORITY);
+    tmr_interrupt_enable(TIMx, TMR_OVF_INT, TRUE);
+    tmr_counter_enable(TIMx, TRUE);
+
+    return ENCODER_OK;
+}
+
+/**
+  * @brief  关闭编码器接口，释放定时器
+  * @param  PinA: A相引脚编号
+  * @retval 无
+  */
+void Encoder_DeInit(uint8_t PinA)
+{
+    Encoder_TypeDef* enc = Encoder_Find(PinA);
+
+    if(enc == NULL)
+    {
+        return;
+    }
+
+    if(enc->IndexPin != NOT_A_PIN)
+    {
+        detachInterrupt(enc->IndexPin);
+    }
+
+    tmr_counter_enable(enc->TIMx, FALSE);
+    tmr_interrupt_enable(enc->TIMx, TMR_OVF_INT, FALSE);
+    Timer_SetEventCallback(enc->TIMx, NULL, NULL, 0, 0);
+    tmr_32_bit_function_enable(enc->TIMx, FALSE);
+    enc->TIMx = NULL;
+}
+
+/**
+  * @brief  读取扩展后的计数值
+  * @param  enc: 编码器
+  * @retval 计数值
+  */
+static int64_t Encoder_ReadCount(Encoder_TypeDef* enc)
+{
+    uint32_t primask = __get_PRIMASK();
+    int64_t count;
+    uint32_t cnt;
+    bool pending;
+
+    __disable_irq();
+
+    cnt = tmr_counter_value_get(enc->TIMx);
+
+    /*溢出已发生但中断尚未处理，在这里补上；标志在读取计数值之后置位时重读*/
+    pending = (tmr_flag_get(enc->TIMx, TMR_OVF_FLAG) == SET);
+    if(pending)
+    {
+        cnt = tmr_counter_value_get(enc->TIMx);
+    }
+    count = Encoder_ExtendCount(enc->High, cnt, pending, enc->Range);
+
+    __set_PRIMASK(primask);
+
+    return count;
+}
+
+/**
+  * @brief  获取编码器计数值
+  * @param  PinA: A相引脚编号
+  * @retval 计数值(64位)
+  */
+int64_t Encoder_GetCount(uint8_t PinA)
+{
+    Encoder_TypeDef* enc = Encoder_Find(PinA);
+    return enc ? Encoder_ReadCount(enc) : 0;
+}
+
+/**
+  * @brief  设置编码器计数值
+  * @param  PinA: A相引脚编号
+  * @param  Count: 计数值
+  * @retval 无
+  */
+void Encoder_SetCount(uint8_t PinA, int64_t Count)
+{
+    Encoder_TypeDef* enc = Encoder_Find(PinA);
+    uint32_t primask;
+    uint32_t cnt;
+
+    if(enc == NULL)
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    /*Range为2的幂，取低位即为计数器的值*/
+    cnt = (uint32_t)((uint64_t)Count & (enc->Range - 1));
+    enc->High = Count - cnt;
+
+    tmr_counter_value_set(enc->TIMx, cnt);
+    tmr_flag_clear(enc->TIMx, TMR_OVF_FLAG);
+
+    /*速度计算从新的计数值开始*/
+    enc->LastCount = Count;
+    enc->LastTime = micros();
+
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  获取编码器速度，为距上次调用期间的平均值
+  * @param  PinA: A相引脚编号
+  * @retval 速度(计数/秒)
+  */
+float Encoder_GetSpeed(uint8_t PinA)
+{
+    Encoder_TypeDef* enc = Encoder_Find(PinA);
+    int64_t count;
+    uint32_t time;
+    uint32_t elapsed;
+    float speed;
+
+    if(enc == NULL)
+    {
+        return 0.0f;
+    }
+
+    count = Encoder_ReadCount(enc);
+    time = micros();
+    elapsed = time - enc->LastTime;
+
+    if(elapsed == 0)
+    {
+        return 0.0f;
+    }
+
+    speed = (float)(count - enc->LastCount) * 1000000.0f / elapsed;
+    enc->LastCount = count;
+    enc->LastTime = time;
+    return speed;
+}
+
+/**
+  * @brief  索引脉冲处理，计数值清零
+  * @param  enc: 编码器
+  * @retval 无
+  */
+static void Encoder_IndexProcess(Encoder_TypeDef* enc)
+{
+    if(enc->TIMx == NULL || (enc->IndexOnce && enc->IndexReached))
+    {
+        return;
+    }
+
+    tmr_counter_value_set(enc->TIMx, 0);
+    tmr_flag_clear(enc->TIMx, TMR_OVF_FLAG);
+    enc->High = 0;
+    enc->IndexReached = true;
+}
+
+/* EXTI回调没有参数，每个编码器一个入口，只为存在的编码器生成 */
+#define ENCODER_INDEX_HANDLER_DEF(n)\
+static void Encoder_IndexHandler##n(void)\
+{\
+    Encoder_IndexProcess(&Encoder_Group[n]);\
+}
+
+ENCODER_INDEX_HANDLER_DEF(0)
+#if ENCODER_MAX > 1
+ENCODER_INDEX_HANDLER_DEF(1)
+#endif
+#if ENCODER_MAX > 2
+ENCODER_INDEX_HANDLER_DEF(2)
+#endif
+#if ENCODER_MAX > 3
+ENCODER_INDEX_HANDLER_DEF(3)
+#endif
+
+static const EXTI_CallbackFunction_t Encoder_IndexHandler[ENCODER_MAX] =
+{
+    Encoder_IndexHandler0,
+#if ENCODER_MAX > 1
+    Encoder_IndexHandler1,
+#endif
+#if ENCODER_MAX > 2
+    Encoder_IndexHandler2,
+#endif
+#if ENCODER_MAX > 3
+    Encoder_IndexHandler3
+#endif
+};
+
+/**
+  * @brief  设置索引(Z相)引脚，上升沿时计数值清零
+  * @param  PinA: A相引脚编号
+  * @param  IndexPin: 索引引脚编号，NOT_A_PIN为关闭
+  * @param  Once: true: 只在第一次索引时清零(回零)，false: 每圈清零
+  * @retval true: 成功
+  */
+bool Encoder_SetIndex(uint8_t PinA, uint8_t IndexPin, bool Once)
+{
+    Encoder_TypeDef* enc = Encoder_Find(PinA);
+
+    if(enc == NULL)
+    {
+        return false;
+    }
+
+    if(enc->IndexPin != NOT_A_PIN)
+    {
+        detachInterrupt(enc->IndexPin);
+        enc->IndexPin = NOT_A_PIN;
+    }
+
+    if(IndexPin == NOT_A_PIN)
+    {
+        return true;
+    }
+
+    if(!IS_PIN(IndexPin))
+    {
+        return false;
+    }
+
+    enc->IndexOnce = Once;
+    enc->IndexReached = false;
+    enc->IndexPin = IndexPin;
+
+    pinMode(IndexPin, INPUT);
+    EXTIx_Init(
+        IndexPin,
+        Encoder_IndexHandler[enc - Encoder_Group],
+        RISING,
+        ENCODER_PREEMPTIONPRIORITY,
+        ENCODER_SUBPRIORITY
+    );
+
+    return true;
+}
+
+/**
+  * @brief  查询是否已经过索引位置
+  * @param  PinA: A相引脚编号
+  * @retval true: 已经过
+  */
+bool Encoder_IndexReached(uint8_t PinA)
+{
+    Encoder_TypeDef* enc = Encoder_Find(PinA);
+    return enc ? enc->IndexReached : false;
+}
+
+#endif /* ENCODER_ENABLE */
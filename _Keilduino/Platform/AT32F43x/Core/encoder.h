@@ -0,0 +1,57 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __ENCODER_H
+#define __ENCODER_H
+
+#include <stdbool.h>
+#include "mcu_type.h"
+#include "encoder_count.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+    ENCODER_MODE_X2_A = 0,  /* 只在A相边沿计数 */
+    ENCODER_MODE_X2_B,      /* 只在B相边沿计数 */
+    ENCODER_MODE_X4         /* A/B相边沿都计数 */
+} Encoder_Mode_Type;
+
+Encoder_Error_Type Encoder_CheckPins(uint8_t PinA, uint8_t PinB);
+
+#if ENCODER_ENABLE
+Encoder_Error_Type Encoder_Init(uint8_t PinA, uint8_t PinB, Encoder_Mode_Type Mode, uint8_t Filter, bool PullUp);
+void     Encoder_DeInit(uint8_t PinA);
+int64_t  Encoder_GetCount(uint8_t PinA);
+void     Encoder_SetCount(uint8_t PinA, int64_t Count);
+bool     Encoder_SetIndex(uint8_t PinA, uint8_t IndexPin, bool Once);
+bool     Encoder_IndexReached(uint8_t PinA);
+float    Encoder_GetSpeed(uint8_t PinA);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ENCODER_H */
@@ -0,0 +1,96 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "encoder_count.h"
+
+/**
+  * @brief  检查A/B相引脚能否组成编码器接口
+  * @param  PinA: A相引脚编号
+  * @param  InfoA: A相引脚的定时器信息
+  * @param  PinB: B相引脚编号
+  * @param  InfoB: B相引脚的定时器信息
+  * @retval ENCODER_OK: 可用
+  */
+Encoder_Error_Type Encoder_CheckPinInfo(
+    uint8_t PinA, const Encoder_PinInfo_TypeDef* InfoA,
+    uint8_t PinB, const Encoder_PinInfo_TypeDef* InfoB
+)
+{
+    if(InfoA->Timer == 0 || InfoA->Channel == 0
+            || InfoB->Timer == 0 || InfoB->Channel == 0
+            || PinA == PinB)
+    {
+        return ENCODER_ERR_PIN;
+    }
+
+    if(InfoA->Timer != InfoB->Timer)
+    {
+        return ENCODER_ERR_TIMER_MISMATCH;
+    }
+
+    /*A/B相交换只改变计数方向*/
+    if(!((InfoA->Channel == 1 && InfoB->Channel == 2) || (InfoA->Channel == 2 && InfoB->Channel == 1)))
+    {
+        return ENCODER_ERR_CHANNEL;
+    }
+
+    /*编码器模式需要从模式控制器*/
+    if(!InfoA->EncoderCapable)
+    {
+        return ENCODER_ERR_TIMER_TYPE;
+    }
+
+    return ENCODER_OK;
+}
+
+/**
+  * @brief  判断一次溢出是上溢还是下溢
+  * @param  Cnt: 处理溢出时的计数值
+  * @param  Range: 计数范围(重装载值+1)
+  * @retval 计数扩展部分的增量，+Range或-Range
+  * @note   上溢后计数器从0开始增加，下溢后从Range-1开始减少，
+  *         只要溢出到处理之间移动不到半个范围，所在的半区就能区分两者。
+  *         不能用处理时的方向位判断：在回绕点附近来回抖动时，
+  *         上溢后再倒退一步，方向位已变为向下，计数器却仍在下半区。
+  */
+int64_t Encoder_OverflowStep(uint32_t Cnt, uint64_t Range)
+{
+    return (Cnt < Range / 2) ? (int64_t)Range : -(int64_t)Range;
+}
+
+/**
+  * @brief  由溢出部分和计数器的值得到64位计数值
+  * @param  High: 已处理的溢出部分，为Range的整数倍
+  * @param  Cnt: 计数器的值
+  * @param  OverflowPending: 溢出已发生但中断尚未处理
+  * @param  Range: 计数范围
+  * @retval 计数值
+  */
+int64_t Encoder_ExtendCount(int64_t High, uint32_t Cnt, bool OverflowPending, uint64_t Range)
+{
+    if(OverflowPending)
+    {
+        High += Encoder_OverflowStep(Cnt, Range);
+    }
+
+    return High + Cnt;
+}
@@ -0,0 +1,67 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __ENCODER_COUNT_H
+#define __ENCODER_COUNT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 编码器中与寄存器无关的部分：A/B相引脚组合检查，计数器溢出的方向判断与64位计数扩展。
+ * 本文件不访问寄存器，引脚的定时器信息和计数值由调用者传入，可在PC上编译验证。
+ */
+
+typedef enum
+{
+    ENCODER_OK,
+    ENCODER_ERR_PIN,            /* 引脚无效或没有定时器通道 */
+    ENCODER_ERR_TIMER_MISMATCH, /* A/B相不在同一个定时器上 */
+    ENCODER_ERR_CHANNEL,        /* A/B相须分别为CH1和CH2 */
+    ENCODER_ERR_TIMER_TYPE,     /* 该定时器不支持编码器模式 */
+    ENCODER_ERR_BUSY            /* 定时器已被占用或通道已用完 */
+} Encoder_Error_Type;
+
+/* 引脚的定时器信息，Timer为NULL或Channel为0表示没有定时器通道 */
+typedef struct
+{
+    const void* Timer;
+    uint8_t Channel;
+    bool EncoderCapable;    /* 定时器带从模式控制器，支持编码器模式 */
+} Encoder_PinInfo_TypeDef;
+
+Encoder_Error_Type Encoder_CheckPinInfo(
+    uint8_t PinA, const Encoder_PinInfo_TypeDef* InfoA,
+    uint8_t PinB, const Encoder_PinInfo_TypeDef* InfoB
+);
+int64_t Encoder_OverflowStep(uint32_t Cnt, uint64_t Range);
+int64_t Encoder_ExtendCount(int64_t High, uint32_t Cnt, bool OverflowPending, uint64_t Range);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ENCODER_COUNT_H */
@@ -22,12 +22,24 @@
  */
 #include "exti.h"
 #include "gpio.h"
+#include "dwt.h"
 
 #define EXTI_GetPortSourceGPIOx(Pin) GPIO_GetPortNum(Pin)
 #define EXTI_GetPinSourcex(Pin)      GPIO_GetPinNum(Pin)
 
 static EXTI_CallbackFunction_t EXTI_Function[16] = {0};
 
+#if EXTI_QUEUE_ENABLE
+static EXTI_EventCallbackFunction_t EXTI_EventFunction[16] = {0};
+static void* EXTI_EventUserData[16] = {0};
+static gpio_type* EXTI_EventGPIOx[16] = {0};
+static uint16_t EXTI_EventGPIO_Pin[16] = {0};
+
+static EXTI_QueueCell_TypeDef EXTI_QueueCells[EXTI_QUEUE_SIZE];
+static EXTI_Queue_TypeDef EXTI_Queue;
+static bool EXTI_QueueIsInit = false;
+#endif
+
 /**
   * @brief  获取外部中断的中断通道
   * @param  Pin: 引脚编号
@@ -71,6 +83,37 @@ static IRQn_Type EXTI_GetIRQn(uint8_t Pin)
     return EXINTx_IRQn;
 }
 
+/**
+  * @brief  配置外部中断线
+  * @param  Pin: 引脚编号
+  * @param  line_polarity: 触发方式
+  * @param  PreemptionPriority: 抢占优先级
+  * @param  SubPriority: 子优先级
+  * @retval 无
+  */
+static void EXTIx_LineConfig(
+    uint8_t Pin,
+    exint_polarity_config_type line_polarity,
+    uint8_t PreemptionPriority,
+    uint8_t SubPriority
+)
+{
+    exint_init_type exint_init_struct;
+    uint8_t Pinx = GPIO_GetPinNum(Pin);
+
+    crm_periph_clock_enable(CRM_SCFG_PERIPH_CLOCK, TRUE);
+    scfg_exint_line_config(GPIO_GetPortNum(Pin), (scfg_pins_source_type)Pinx);
+
+    exint_default_para_init(&exint_init_struct);
+    exint_init_struct.line_select = 1 << Pinx;
+    exint_init_struct.line_mode = EXINT_LINE_INTERRUPUT;
+    exint_init_struct.line_polarity = line_polarity;
+    exint_init_struct.line_enable = TRUE;
+    exint_init(&exint_init_struct);
+
+    nvic_irq_enable(EXTI_GetIRQn(Pin), PreemptionPriority, SubPriority);
+}
+
 /**
   * @brief  外部中断初始化
   * @param  Pin: 引脚编号
@@ -88,7 +131,6 @@ void EXTIx_Init(
     uint8_t SubPriority
 )
 {
-    exint_init_type exint_init_struct;
     uint8_t Pinx;
 
     if(!IS_PIN(Pin))
@@ -99,21 +141,138 @@ void EXTIx_Init(
     if(Pinx > 15)
         return;
 
+#if EXTI_QUEUE_ENABLE
+    EXTI_EventFunction[Pinx] = NULL;
+#endif
     EXTI_Function[Pinx] = Function;
 
-    crm_periph_clock_enable(CRM_SCFG_PERIPH_CLOCK, TRUE);
-    scfg_exint_line_config(GPIO_GetPortNum(Pin), (scfg_pins_source_type)Pinx);
+    EXTIx_LineConfig(Pin, line_polarity, PreemptionPriority, SubPriority);
+}
 
-    exint_default_para_init(&exint_init_struct);
-    exint_init_struct.line_select = 1 << Pinx;
-    exint_init_struct.line_mode = EXINT_LINE_INTERRUPUT;
-    exint_init_struct.line_polarity = line_polarity;
-    exint_init_struct.line_enable = TRUE;
-    exint_init(&exint_init_struct);
+#if EXTI_QUEUE_ENABLE
+/**
+  * @brief  外部中断初始化(事件队列模式)，中断中只记录事件，
+  *         回调在EXTI_ProcessEvents中执行
+  * @param  Pin: 引脚编号
+  * @param  Function: 事件回调函数
+  * @param  UserData: 用户数据
+  * @param  line_polarity: 触发方式
+  * @param  PreemptionPriority: 抢占优先级
+  * @param  SubPriority: 子优先级
+  * @retval 无
+  */
+void EXTIx_InitQueue(
+    uint8_t Pin,
+    EXTI_EventCallbackFunction_t Function,
+    void* UserData,
+    exint_polarity_config_type line_polarity,
+    uint8_t PreemptionPriority,
+    uint8_t SubPriority
+)
+{
+    uint8_t Pinx;
 
-    nvic_irq_enable(EXTI_GetIRQn(Pin), PreemptionPriority, SubPriority);
+    if(!IS_PIN(Pin) || Function == NULL)
+        return;
+
+    Pinx = GPIO_GetPinNum(Pin);
+
+    if(Pinx > 15)
+        return;
+
+    if(!EXTI_QueueIsInit)
+    {
+        EXTI_QueueInit(&EXTI_Queue, EXTI_QueueCells, EXTI_QUEUE_SIZE);
+        EXTI_QueueIsInit = true;
+    }
+
+    EXTI_Function[Pinx] = NULL;
+    EXTI_EventGPIOx[Pinx] = PIN_MAP[Pin].GPIOx;
+    EXTI_EventGPIO_Pin[Pinx] = PIN_MAP[Pin].GPIO_Pin_x;
+    EXTI_EventUserData[Pinx] = UserData;
+    EXTI_EventFunction[Pinx] = Function;
+
+    EXTIx_LineConfig(Pin, line_polarity, PreemptionPriority, SubPriority);
 }
 
+/**
+  * @brief  外部中断初始化(事件队列模式) (Arduino)
+  * @param  Pin: 引脚编号
+  * @param  Function: 事件回调函数
+  * @param  UserData: 用户数据
+  * @param  line_polarity: 触发方式
+  * @retval 无
+  */
+void attachInterruptEvent(
+    uint8_t Pin,
+    EXTI_EventCallbackFunction_t Function,
+    void* UserData,
+    exint_polarity_config_type line_polarity
+)
+{
+    EXTIx_InitQueue(
+        Pin,
+        Function,
+        UserData,
+        line_polarity,
+        EXTI_PREEMPTIONPRIORITY_DEFAULT,
+        EXTI_SUBPRIORITY_DEFAULT
+    );
+}
+
+/**
+  * @brief  处理队列中的事件，在主循环中调用
+  * @param  MaxCount: 最多处理的事件数，0为处理全部
+  * @retval 处理的事件数
+  */
+uint32_t EXTI_ProcessEvents(uint32_t MaxCount)
+{
+    EXTI_Event_TypeDef event;
+    uint32_t count = 0;
+
+    if(!EXTI_QueueIsInit)
+        return 0;
+
+    while((MaxCount == 0 || count < MaxCount) && EXTI_QueuePop(&EXTI_Queue, &event))
+    {
+        EXTI_EventCallbackFunction_t function = EXTI_EventFunction[event.Line];
+        if(function)
+        {
+            function(&event, EXTI_EventUserData[event.Line]);
+        }
+        count++;
+    }
+
+    return count;
+}
+
+/**
+  * @brief  直接读取一个事件，不调用回调，用于自行解码的场合
+  * @param  Event: 输出事件
+  * @retval true: 读到事件
+  */
+bool EXTI_GetEvent(EXTI_Event_TypeDef* Event)
+{
+    if(!EXTI_QueueIsInit)
+        return false;
+
+    return EXTI_QueuePop(&EXTI_Queue, Event);
+}
+
+/**
+  * @brief  获取队列满时丢弃的事件数
+  * @param  Clear: 读取后清零
+  * @retval 丢弃的事件数
+  */
+uint32_t EXTI_GetDroppedEvents(bool Clear)
+{
+    if(!EXTI_QueueIsInit)
+        return 0;
+
+    return EXTI_QueueGetDropped(&EXTI_Queue, Clear);
+}
+#endif
+
 /**
   * @brief  外部中断初始化 (Arduino)
   * @param  Pin: 引脚编号
@@ -139,18 +298,85 @@ void attachInterrupt(uint8_t Pin, EXTI_CallbackFunction_t Function, exint_polari
   */
 void detachInterrupt(uint8_t Pin)
 {
+    uint8_t Pinx;
+
+    if(!IS_PIN(Pin))
+        return;
+
+    Pinx = GPIO_GetPinNum(Pin);
+
+    if(Pinx > 15)
+        return;
+
+    /*只屏蔽该中断线，EXTI5~9/10~15共用的NVIC中断不受影响*/
+    exint_interrupt_enable(1 << Pinx, FALSE);
+    exint_flag_clear(1 << Pinx);
+
+    EXTI_Function[Pinx] = NULL;
+#if EXTI_QUEUE_ENABLE
+    /*队列中尚未处理的事件在EXTI_ProcessEvents中丢弃*/
+    EXTI_EventFunction[Pinx] = NULL;
+#endif
+}
+
+/**
+  * @brief  查询引脚对应的中断线是否已注册回调，同编号的中断线在所有端口间共用
+  * @param  Pin: 引脚编号
+  * @retval true: 已被占用
+  */
+bool EXTI_IsLineBusy(uint8_t Pin)
+{
+    uint8_t Pinx;
+
     if(!IS_PIN(Pin))
+        return false;
+
+    Pinx = GPIO_GetPinNum(Pin);
+
+    if(Pinx > 15)
+        return false;
+
+#if EXTI_QUEUE_ENABLE
+    if(EXTI_EventFunction[Pinx])
+        return true;
+#endif
+
+    return (EXTI_Function[Pinx] != NULL);
+}
+
+/**
+  * @brief  外部中断线处理
+  * @param  Line: 中断线
+  * @param  Timestamp: 进入中断时的DWT周期计数
+  * @retval 无
+  */
+RAMFUNC_ISR static void EXTI_LineHandler(uint8_t Line, uint32_t Timestamp)
+{
+#if EXTI_QUEUE_ENABLE
+    if(EXTI_EventFunction[Line])
+    {
+        EXTI_Event_TypeDef event;
+        event.Timestamp = Timestamp;
+        event.Line = Line;
+        event.Level = (EXTI_EventGPIOx[Line]->idt & EXTI_EventGPIO_Pin[Line]) ? 1 : 0;
+        EXTI_QueuePush(&EXTI_Queue, &event); // 在闪存中执行
         return;
+    }
+#endif
 
-    nvic_irq_disable(EXTI_GetIRQn(Pin));
+    /*用户回调在闪存中执行，除非回调本身加了RAMFUNC*/
+    if(EXTI_Function[Line])
+    {
+        EXTI_Function[Line]();
+    }
 }
 
 #define EXTIx_IRQHANDLER(n) \
 do{\
-    if(exint_flag_get(EXINT_LINE_##n) != RESET)\
+    if(EXINT->intsts & EXINT_LINE_##n)\
     {\
-        if(EXTI_Function[n]) EXTI_Function[n]();\
-        exint_flag_clear(EXINT_LINE_##n);\
+        EXTI_LineHandler(n, timestamp);\
+        EXINT->intsts = EXINT_LINE_##n;\
     }\
 }while(0)
 
@@ -159,8 +385,10 @@ do{\
   * @param  无
   * @retval 无
   */
-void EXINT0_IRQHandler(void)
+RAMFUNC_ISR void EXINT0_IRQHandler(void)
 {
+    uint32_t timestamp = DWT_CYCLE_CNT;
+
     EXTIx_IRQHANDLER(0);
 }
 
@@ -169,8 +397,10 @@ void EXINT0_IRQHandler(void)
   * @param  无
   * @retval 无
   */
-void EXINT1_IRQHandler(void)
+RAMFUNC_ISR void EXINT1_IRQHandler(void)
 {
+    uint32_t timestamp = DWT_CYCLE_CNT;
+
     EXTIx_IRQHANDLER(1);
 }
 
@@ -179,8 +409,10 @@ void EXINT1_IRQHandler(void)
   * @param  无
   * @retval 无
   */
-void EXINT2_IRQHandler(void)
+RAMFUNC_ISR void EXINT2_IRQHandler(void)
 {
+    uint32_t timestamp = DWT_CYCLE_CNT;
+
     EXTIx_IRQHANDLER(2);
 }
 
@@ -189,8 +421,10 @@ void EXINT2_IRQHandler(void)
   * @param  无
   * @retval 无
   */
-void EXINT3_IRQHandler(void)
+RAMFUNC_ISR void EXINT3_IRQHandler(void)
 {
+    uint32_t timestamp = DWT_CYCLE_CNT;
+
     EXTIx_IRQHANDLER(3);
 }
 
@@ -199,8 +433,10 @@ void EXINT3_IRQHandler(void)
   * @param  无
   * @retval 无
   */
-void EXINT4_IRQHandler(void)
+RAMFUNC_ISR void EXINT4_IRQHandler(void)
 {
+    uint32_t timestamp = DWT_CYCLE_CNT;
+
     EXTIx_IRQHANDLER(4);
 }
 
@@ -209,8 +445,10 @@ void EXINT4_IRQHandler(void)
   * @param  无
   * @retval 无
   */
-void EXINT9_5_IRQHandler(void)
+RAMFUNC_ISR void EXINT9_5_IRQHandler(void)
 {
+    uint32_t timestamp = DWT_CYCLE_CNT;
+
     EXTIx_IRQHANDLER(5);
     EXTIx_IRQHANDLER(6);
     EXTIx_IRQHANDLER(7);
@@ -223,8 +461,10 @@ void EXINT9_5_IRQHandler(void)
   * @param  无
   * @retval 无
   */
-void EXINT15_10_IRQHandler(void)
+RAMFUNC_ISR void EXINT15_10_IRQHandler(void)
 {
+    uint32_t timestamp = DWT_CYCLE_CNT;
+
     EXTIx_IRQHANDLER(10);
     EXTIx_IRQHANDLER(11);
     EXTIx_IRQHANDLER(12);
@@ -23,7 +23,9 @@
 #ifndef __EXTI_H
 #define __EXTI_H
 
+#include <stdbool.h>
 #include "mcu_type.h"
+#include "exti_queue.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -34,6 +36,7 @@ extern "C" {
 #define RISING  EXINT_TRIGGER_RISING_EDGE
 
 typedef void(*EXTI_CallbackFunction_t)(void);
+typedef void(*EXTI_EventCallbackFunction_t)(const EXTI_Event_TypeDef* Event, void* UserData);
 
 void EXTIx_Init(
     uint8_t Pin,
@@ -48,6 +51,27 @@ void attachInterrupt(
     exint_polarity_config_type polarity_config
 );
 void detachInterrupt(uint8_t Pin);
+bool EXTI_IsLineBusy(uint8_t Pin);
+
+#if EXTI_QUEUE_ENABLE
+void EXTIx_InitQueue(
+    uint8_t Pin,
+    EXTI_EventCallbackFunction_t Function,
+    void* UserData,
+    exint_polarity_config_type line_polarity,
+    uint8_t PreemptionPriority,
+    uint8_t SubPriority
+);
+void attachInterruptEvent(
+    uint8_t Pin,
+    EXTI_EventCallbackFunction_t Function,
+    void* UserData,
+    exint_polarity_config_type line_polarity
+);
+uint32_t EXTI_ProcessEvents(uint32_t MaxCount);
+bool     EXTI_GetEvent(EXTI_Event_TypeDef* Event);
+uint32_t EXTI_GetDroppedEvents(bool Clear);
+#endif
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,79 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "exti_queue.h"
+#include <stddef.h>
+
+/**
+  * @brief  队列初始化
+  * @param  Queue: 队列
+  * @param  Cells: 存储单元
+  * @param  Size: 单元个数，必须为2的幂
+  * @retval true: 成功
+  */
+bool EXTI_QueueInit(EXTI_Queue_TypeDef* Queue, EXTI_QueueCell_TypeDef* Cells, uint32_t Size)
+{
+    return Cells != NULL && MPSC_RING_INIT(&Queue->Ring, Cells, Size);
+}
+
+/**
+  * @brief  写入事件，可在任意优先级的中断中调用
+  * @param  Queue: 队列
+  * @param  Event: 事件
+  * @retval true: 成功，false: 队列已满，事件被丢弃
+  */
+bool EXTI_QueuePush(EXTI_Queue_TypeDef* Queue, const EXTI_Event_TypeDef* Event)
+{
+    return MPSC_RingPush(&Queue->Ring, Event);
+}
+
+/**
+  * @brief  读取事件，只能在一个上下文中调用(通常为主循环)
+  * @param  Queue: 队列
+  * @param  Event: 输出事件
+  * @retval true: 读到事件，false: 队列为空或最早的事件还在写入
+  */
+bool EXTI_QueuePop(EXTI_Queue_TypeDef* Queue, EXTI_Event_TypeDef* Event)
+{
+    return MPSC_RingPop(&Queue->Ring, Event);
+}
+
+/**
+  * @brief  获取队列中的事件数(包括正在写入的)
+  * @param  Queue: 队列
+  * @retval 事件数
+  */
+uint32_t EXTI_QueueGetCount(const EXTI_Queue_TypeDef* Queue)
+{
+    return MPSC_RingGetCount(&Queue->Ring);
+}
+
+/**
+  * @brief  获取丢弃的事件数
+  * @param  Queue: 队列
+  * @param  Clear: 读取后清零
+  * @retval 丢弃的事件数
+  */
+uint32_t EXTI_QueueGetDropped(EXTI_Queue_TypeDef* Queue, bool Clear)
+{
+    return MPSC_RingGetDropped(&Queue->Ring, Clear);
+}
@@ -0,0 +1,65 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __EXTI_QUEUE_H
+#define __EXTI_QUEUE_H
+
+#include "mpsc_ring.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 外部中断事件队列：在MPSC_Ring上存放事件，
+ * 多个中断(可相互嵌套)写入，主循环单线程读取，不需要关中断。
+ * 本文件不访问寄存器，可在PC上编译验证。
+ */
+typedef struct
+{
+    uint32_t Timestamp;     // DWT周期计数
+    uint8_t  Line;          // 中断线 0~15
+    uint8_t  Level;         // 进入中断时的引脚电平
+} EXTI_Event_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t Seq;
+    EXTI_Event_TypeDef Item;
+} EXTI_QueueCell_TypeDef;
+
+typedef struct
+{
+    MPSC_Ring_TypeDef Ring;
+} EXTI_Queue_TypeDef;
+
+bool     EXTI_QueueInit(EXTI_Queue_TypeDef* Queue, EXTI_QueueCell_TypeDef* Cells, uint32_t Size);
+bool     EXTI_QueuePush(EXTI_Queue_TypeDef* Queue, const EXTI_Event_TypeDef* Event);
+bool     EXTI_QueuePop(EXTI_Queue_TypeDef* Queue, EXTI_Event_TypeDef* Event);
+uint32_t EXTI_QueueGetCount(const EXTI_Queue_TypeDef* Queue);
+uint32_t EXTI_QueueGetDropped(EXTI_Queue_TypeDef* Queue, bool Clear);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __EXTI_QUEUE_H */
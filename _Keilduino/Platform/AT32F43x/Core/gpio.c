@@ -168,6 +168,54 @@ const PinInfo_TypeDef PIN_MAP[PIN_MAX] =
     {GPIOH, NULL, NULL, GPIO_Pin_15, 0, ADC_CHANNEL_X}, /* PH15 */
 };
 
+typedef struct
+{
+    gpio_type* GPIOx;
+    crm_periph_clock_type CRM_GPIOx_PERIPH_CLOCK;
+} GPIO_PortInfo_TypeDef;
+
+static const GPIO_PortInfo_TypeDef GPIO_Port_Map[] =
+{
+    {GPIOA, CRM_GPIOA_PERIPH_CLOCK},
+    {GPIOB, CRM_GPIOB_PERIPH_CLOCK},
+    {GPIOC, CRM_GPIOC_PERIPH_CLOCK},
+    {GPIOD, CRM_GPIOD_PERIPH_CLOCK},
+    {GPIOE, CRM_GPIOE_PERIPH_CLOCK},
+    {GPIOF, CRM_GPIOF_PERIPH_CLOCK},
+    {GPIOG, CRM_GPIOG_PERIPH_CLOCK},
+    {GPIOH, CRM_GPIOH_PERIPH_CLOCK}
+};
+
+#define GPIO_PORT_MAX   (sizeof(GPIO_Port_Map) / sizeof(GPIO_Port_Map[0]))
+
+/**
+  * @brief  获取GPIO端口序号，端口地址等间隔排列，直接计算
+  * @param  GPIOx: GPIO地址
+  * @retval 端口序号，GPIO_PORT_MAX: 无效
+  */
+static uint32_t GPIO_GetPortIndex(gpio_type* GPIOx)
+{
+    uint32_t index = ((uint32_t)GPIOx - (uint32_t)GPIOA) / ((uint32_t)GPIOB - (uint32_t)GPIOA);
+
+    if(index >= GPIO_PORT_MAX || GPIO_Port_Map[index].GPIOx != GPIOx)
+    {
+        return GPIO_PORT_MAX;
+    }
+
+    return index;
+}
+
+/**
+  * @brief  写入端口配置
+  * @param  GPIOx: GPIO地址
+  * @param  config: 端口配置
+  * @retval 无
+  */
+static void GPIO_PortConfigApply(gpio_type* GPIOx, const GPIO_PortConfig_TypeDef* config)
+{
+    GPIO_Batch_Apply(config, &GPIOx->cfgr, &GPIOx->omode, &GPIOx->odrvr, &GPIOx->pull);
+}
+
 /**
   * @brief  GPIO初始化
   * @param  GPIOx: GPIO地址
@@ -183,110 +231,58 @@ void GPIOx_Init(
     gpio_drive_type GPIO_Drive_x
 )
 {
-    gpio_init_type gpio_init_struct;
-    crm_periph_clock_type CRM_GPIOx_PERIPH_CLOCK;
-
-    if(GPIOx == GPIOA)     CRM_GPIOx_PERIPH_CLOCK = CRM_GPIOA_PERIPH_CLOCK;
-    else if(GPIOx == GPIOB)CRM_GPIOx_PERIPH_CLOCK = CRM_GPIOB_PERIPH_CLOCK;
-    else if(GPIOx == GPIOC)CRM_GPIOx_PERIPH_CLOCK = CRM_GPIOC_PERIPH_CLOCK;
-    else if(GPIOx == GPIOD)CRM_GPIOx_PERIPH_CLOCK = CRM_GPIOD_PERIPH_CLOCK;
-    else if(GPIOx == GPIOE)CRM_GPIOx_PERIPH_CLOCK = CRM_GPIOE_PERIPH_CLOCK;
-    else if(GPIOx == GPIOF)CRM_GPIOx_PERIPH_CLOCK = CRM_GPIOF_PERIPH_CLOCK;
-    else if(GPIOx == GPIOG)CRM_GPIOx_PERIPH_CLOCK = CRM_GPIOG_PERIPH_CLOCK;
-    else if(GPIOx == GPIOH)CRM_GPIOx_PERIPH_CLOCK = CRM_GPIOH_PERIPH_CLOCK;
-    else return;
-
-    gpio_default_para_init(&gpio_init_struct);
-    gpio_init_struct.gpio_pins = GPIO_Pin_x;
-    gpio_init_struct.gpio_drive_strength = GPIO_Drive_x;
+    GPIO_PortConfig_TypeDef config = {0};
+    uint32_t index = GPIO_GetPortIndex(GPIOx);
+    const GPIO_ModeInfo_TypeDef* modeInfo = GPIO_Batch_GetModeInfo((uint32_t)Mode);
 
-    if(Mode == INPUT)
-    {
-        gpio_init_struct.gpio_mode = GPIO_MODE_INPUT;
-        gpio_init_struct.gpio_pull = GPIO_PULL_NONE;
-    }
-    else if(Mode == INPUT_PULLUP)
-    {
-        gpio_init_struct.gpio_mode = GPIO_MODE_INPUT;
-        gpio_init_struct.gpio_pull = GPIO_PULL_UP;
-    }
-    else if(Mode == INPUT_PULLDOWN)
-    {
-        gpio_init_struct.gpio_mode = GPIO_MODE_INPUT;
-        gpio_init_struct.gpio_pull = GPIO_PULL_DOWN;
-    }
-    else if(Mode == INPUT_ANALOG)
-    {
-        gpio_init_struct.gpio_mode = GPIO_MODE_ANALOG;
-        gpio_init_struct.gpio_pull = GPIO_PULL_NONE;
-    }
-    else if(Mode == OUTPUT)
-    {
-        gpio_init_struct.gpio_mode = GPIO_MODE_OUTPUT;
-        gpio_init_struct.gpio_pull = GPIO_PULL_NONE;
-        gpio_init_struct.gpio_out_type = GPIO_OUTPUT_PUSH_PULL;
-    }
-    else if(Mode == OUTPUT_OPEN_DRAIN)
-    {
-        gpio_init_struct.gpio_mode = GPIO_MODE_OUTPUT;
-        gpio_init_struct.gpio_pull = GPIO_PULL_NONE;
-        gpio_init_struct.gpio_out_type = GPIO_OUTPUT_OPEN_DRAIN;
-    }
-    else if(Mode == OUTPUT_AF_PP)
-    {
-        gpio_init_struct.gpio_mode = GPIO_MODE_MUX;
-        gpio_init_struct.gpio_pull = GPIO_PULL_NONE;
-        gpio_init_struct.gpio_out_type = GPIO_OUTPUT_PUSH_PULL;
-    }
-    else if(Mode == OUTPUT_AF_OD)
-    {
-        gpio_init_struct.gpio_mode = GPIO_MODE_MUX;
-        gpio_init_struct.gpio_pull = GPIO_PULL_NONE;
-        gpio_init_struct.gpio_out_type = GPIO_OUTPUT_OPEN_DRAIN;
-    }
-    else
+    if(index >= GPIO_PORT_MAX || modeInfo == NULL)
     {
         return;
     }
 
-    crm_periph_clock_enable(CRM_GPIOx_PERIPH_CLOCK, TRUE);
-    gpio_init(GPIOx, &gpio_init_struct);
-}
+    GPIO_Batch_Add(&config, GPIO_Pin_x, modeInfo, (uint32_t)GPIO_Drive_x);
 
+    crm_periph_clock_enable(GPIO_Port_Map[index].CRM_GPIOx_PERIPH_CLOCK, TRUE);
+    GPIO_PortConfigApply(GPIOx, &config);
+}
 
 /**
-  * @brief  获取当前引脚对应的GPIOx编号
-  * @param  Pin: 引脚编号
-  * @retval 无
+  * @brief  批量配置引脚模式，按端口合并后每个端口只写一次寄存器
+  * @param  Config: 引脚配置表
+  * @param  Count: 配置表长度
+  * @param  GPIO_Drive_x: GPIO驱动能力
+  * @retval 成功配置的引脚数，INPUT_ANALOG_DMA和PWM模式需单独用pinMode配置
   */
-scfg_port_source_type GPIO_GetPortNum(uint8_t Pin)
+uint16_t GPIO_InitBatch(const PinConfig_TypeDef* Config, uint16_t Count, gpio_drive_type GPIO_Drive_x)
 {
-    uint8_t retval = 0xFF;
-    uint8_t index;
-    gpio_type* GPIOx = PIN_MAP[Pin].GPIOx;
+    GPIO_PortConfig_TypeDef config[GPIO_PORT_MAX] = {0};
+    uint16_t success;
+    uint32_t index;
 
-    static const gpio_type* GPIO_Map[] =
-    {
-        GPIOA,
-        GPIOB,
-        GPIOC,
-        GPIOD,
-        GPIOE,
-        GPIOF,
-        GPIOG,
-        GPIOH
-    };
+    /*同一引脚重复出现时以后面的为准*/
+    success = GPIO_Batch_Build(config, GPIO_PORT_MAX, Config, Count, (uint32_t)GPIO_Drive_x);
 
-    for(index = 0; index < sizeof(GPIO_Map) / sizeof(GPIO_Map[0]); index++)
+    for(index = 0; index < GPIO_PORT_MAX; index++)
     {
-        if(GPIOx == GPIO_Map[index])
+        if(config[index].Mask1)
         {
-            retval = index;
-            break;
+            crm_periph_clock_enable(GPIO_Port_Map[index].CRM_GPIOx_PERIPH_CLOCK, TRUE);
+            GPIO_PortConfigApply(GPIO_Port_Map[index].GPIOx, &config[index]);
         }
     }
 
-    return (scfg_port_source_type)retval;
+    return success;
+}
+
+/**
+  * @brief  获取当前引脚对应的GPIOx编号
+  * @param  Pin: 引脚编号
+  * @retval 无
+  */
+scfg_port_source_type GPIO_GetPortNum(uint8_t Pin)
+{
+    uint32_t index = GPIO_GetPortIndex(PIN_MAP[Pin].GPIOx);
+    return (scfg_port_source_type)((index < GPIO_PORT_MAX) ? index : 0xFF);
 }
 
 /**
@@ -24,6 +24,7 @@
 #define __GPIO_H
 
 #include "mcu_type.h"
+#include "gpio_batch.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -80,19 +81,7 @@ typedef struct
     uint8_t ADC_Channel;
 } PinInfo_TypeDef;
 
-typedef enum
-{
-    INPUT,
-    INPUT_PULLUP,
-    INPUT_PULLDOWN,
-    INPUT_ANALOG,
-    INPUT_ANALOG_DMA,
-    OUTPUT,
-    OUTPUT_OPEN_DRAIN,
-    OUTPUT_AF_OD,
-    OUTPUT_AF_PP,
-    PWM
-} PinMode_TypeDef;
+#define pinModeBatch(config, count) GPIO_InitBatch(config, count, GPIO_DRIVE_DEFAULT)
 
 extern const PinInfo_TypeDef PIN_MAP[PIN_MAX];
 
@@ -102,6 +91,7 @@ void GPIOx_Init(
     PinMode_TypeDef Mode,
     gpio_drive_type GPIO_Driver_x
 );
+uint16_t GPIO_InitBatch(const PinConfig_TypeDef* Config, uint16_t Count, gpio_drive_type GPIO_Drive_x);
 scfg_port_source_type GPIO_GetPortNum(uint8_t Pin);
 uint8_t GPIO_GetPinNum(uint8_t Pin);
 gpio_pins_source_type GPIO_GetPinSource(uint16_t GPIO_Pin_x);
@@ -0,0 +1,158 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "gpio_batch.h"
+
+#define GPIO_MODE_INFO_INVALID  0xFF
+
+/* 按PinMode_TypeDef顺序排列，INPUT_ANALOG_DMA和PWM需要外设配合，不在此处理 */
+static const GPIO_ModeInfo_TypeDef GPIO_Mode_Map[] =
+{
+    {GPIO_BATCH_MODE_INPUT,  GPIO_BATCH_OUTPUT_PUSH_PULL,  GPIO_BATCH_PULL_NONE}, /* INPUT */
+    {GPIO_BATCH_MODE_INPUT,  GPIO_BATCH_OUTPUT_PUSH_PULL,  GPIO_BATCH_PULL_UP},   /* INPUT_PULLUP */
+    {GPIO_BATCH_MODE_INPUT,  GPIO_BATCH_OUTPUT_PUSH_PULL,  GPIO_BATCH_PULL_DOWN}, /* INPUT_PULLDOWN */
+    {GPIO_BATCH_MODE_ANALOG, GPIO_BATCH_OUTPUT_PUSH_PULL,  GPIO_BATCH_PULL_NONE}, /* INPUT_ANALOG */
+    {GPIO_MODE_INFO_INVALID, 0, 0},                                               /* INPUT_ANALOG_DMA */
+    {GPIO_BATCH_MODE_OUTPUT, GPIO_BATCH_OUTPUT_PUSH_PULL,  GPIO_BATCH_PULL_NONE}, /* OUTPUT */
+    {GPIO_BATCH_MODE_OUTPUT, GPIO_BATCH_OUTPUT_OPEN_DRAIN, GPIO_BATCH_PULL_NONE}, /* OUTPUT_OPEN_DRAIN */
+    {GPIO_BATCH_MODE_MUX,    GPIO_BATCH_OUTPUT_OPEN_DRAIN, GPIO_BATCH_PULL_NONE}, /* OUTPUT_AF_OD */
+    {GPIO_BATCH_MODE_MUX,    GPIO_BATCH_OUTPUT_PUSH_PULL,  GPIO_BATCH_PULL_NONE}, /* OUTPUT_AF_PP */
+    {GPIO_MODE_INFO_INVALID, 0, 0}                                                /* PWM */
+};
+
+#define GPIO_MODE_MAX   (sizeof(GPIO_Mode_Map) / sizeof(GPIO_Mode_Map[0]))
+
+/**
+  * @brief  查询引脚模式对应的寄存器字段
+  * @param  Mode: 引脚模式
+  * @retval 寄存器字段，NULL: 该模式不能直接配置GPIO
+  */
+const GPIO_ModeInfo_TypeDef* GPIO_Batch_GetModeInfo(uint32_t Mode)
+{
+    if(Mode >= GPIO_MODE_MAX || GPIO_Mode_Map[Mode].Mode == GPIO_MODE_INFO_INVALID)
+    {
+        return 0;
+    }
+
+    return &GPIO_Mode_Map[Mode];
+}
+
+/**
+  * @brief  将引脚的配置合并到端口配置中，同一引脚以后加入的为准
+  * @param  Config: 端口配置
+  * @param  GPIO_Pin_x: GPIO对应位
+  * @param  ModeInfo: 模式
+  * @param  GPIO_Drive_x: GPIO驱动能力
+  * @retval 无
+  */
+void GPIO_Batch_Add(
+    GPIO_PortConfig_TypeDef* Config,
+    uint16_t GPIO_Pin_x,
+    const GPIO_ModeInfo_TypeDef* ModeInfo,
+    uint32_t GPIO_Drive_x
+)
+{
+    uint32_t pin_index = 0;
+
+    while(GPIO_Pin_x)
+    {
+        if(GPIO_Pin_x & 0x01)
+        {
+            uint32_t shift2 = pin_index * 2;
+
+            Config->Mask1 |= 0x01U << pin_index;
+            Config->Mask2 |= 0x03U << shift2;
+
+            Config->omode = (Config->omode & ~(0x01U << pin_index)) | ((uint32_t)ModeInfo->OutType << pin_index);
+            Config->cfgr  = (Config->cfgr  & ~(0x03U << shift2)) | ((uint32_t)ModeInfo->Mode << shift2);
+            Config->odrvr = (Config->odrvr & ~(0x03U << shift2)) | ((GPIO_Drive_x & 0x03U) << shift2);
+            Config->pull  = (Config->pull  & ~(0x03U << shift2)) | ((uint32_t)ModeInfo->Pull << shift2);
+        }
+        GPIO_Pin_x >>= 1;
+        pin_index++;
+    }
+}
+
+/**
+  * @brief  按端口合并引脚配置表
+  * @param  Port: 各端口的配置，调用前清零
+  * @param  PortCount: 端口数
+  * @param  Config: 引脚配置表
+  * @param  Count: 配置表长度
+  * @param  GPIO_Drive_x: GPIO驱动能力
+  * @retval 合并的引脚数，引脚无效或模式为INPUT_ANALOG_DMA、PWM的条目被跳过
+  */
+uint16_t GPIO_Batch_Build(
+    GPIO_PortConfig_TypeDef* Port, uint32_t PortCount,
+    const PinConfig_TypeDef* Config, uint16_t Count,
+    uint32_t GPIO_Drive_x
+)
+{
+    uint16_t success = 0;
+    uint16_t i;
+
+    for(i = 0; i < Count; i++)
+    {
+        uint32_t index = Config[i].Pin / GPIO_BATCH_PORT_PINS;
+        const GPIO_ModeInfo_TypeDef* modeInfo = GPIO_Batch_GetModeInfo((uint32_t)Config[i].Mode);
+
+        if(index >= PortCount || modeInfo == 0)
+        {
+            continue;
+        }
+
+        GPIO_Batch_Add(
+            &Port[index],
+            (uint16_t)(0x01U << (Config[i].Pin % GPIO_BATCH_PORT_PINS)),
+            modeInfo,
+            GPIO_Drive_x
+        );
+        success++;
+    }
+
+    return success;
+}
+
+/**
+  * @brief  写入端口配置，每个寄存器只读改写一次
+  * @param  Config: 端口配置
+  * @param  cfgr/omode/odrvr/pull: 端口的对应寄存器地址
+  * @retval 无
+  */
+void GPIO_Batch_Apply(
+    const GPIO_PortConfig_TypeDef* Config,
+    volatile uint32_t* cfgr,
+    volatile uint32_t* omode,
+    volatile uint32_t* odrvr,
+    volatile uint32_t* pull
+)
+{
+    if(!Config->Mask1)
+    {
+        return;
+    }
+
+    *omode = (*omode & ~Config->Mask1) | Config->omode;
+    *odrvr = (*odrvr & ~Config->Mask2) | Config->odrvr;
+    *pull  = (*pull  & ~Config->Mask2) | Config->pull;
+    *cfgr  = (*cfgr  & ~Config->Mask2) | Config->cfgr;
+}
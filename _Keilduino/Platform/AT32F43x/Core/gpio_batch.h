@@ -0,0 +1,117 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __GPIO_BATCH_H
+#define __GPIO_BATCH_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * GPIO批量配置：按端口合并引脚的模式、输出类型、驱动能力和上下拉，
+ * 每个端口的每个寄存器只读改写一次。
+ * 引脚编号按端口顺序排列(PA0~PA15, PB0~PB15...)，端口序号为Pin/16。
+ * 本文件不访问寄存器，寄存器地址由调用者传入，可在PC上编译验证。
+ */
+
+/* 每端口引脚数 */
+#define GPIO_BATCH_PORT_PINS        16
+
+/* 寄存器字段编码，与AT32F43x的gpio_mode_type/gpio_output_type/gpio_pull_type一致 */
+#define GPIO_BATCH_MODE_INPUT       0x00
+#define GPIO_BATCH_MODE_OUTPUT      0x01
+#define GPIO_BATCH_MODE_MUX         0x02
+#define GPIO_BATCH_MODE_ANALOG      0x03
+
+#define GPIO_BATCH_OUTPUT_PUSH_PULL 0x00
+#define GPIO_BATCH_OUTPUT_OPEN_DRAIN 0x01
+
+#define GPIO_BATCH_PULL_NONE        0x00
+#define GPIO_BATCH_PULL_UP          0x01
+#define GPIO_BATCH_PULL_DOWN        0x02
+
+typedef enum
+{
+    INPUT,
+    INPUT_PULLUP,
+    INPUT_PULLDOWN,
+    INPUT_ANALOG,
+    INPUT_ANALOG_DMA,
+    OUTPUT,
+    OUTPUT_OPEN_DRAIN,
+    OUTPUT_AF_OD,
+    OUTPUT_AF_PP,
+    PWM
+} PinMode_TypeDef;
+
+typedef struct
+{
+    uint8_t Pin;
+    PinMode_TypeDef Mode;
+} PinConfig_TypeDef;
+
+typedef struct
+{
+    uint8_t Mode;
+    uint8_t OutType;
+    uint8_t Pull;
+} GPIO_ModeInfo_TypeDef;
+
+/*同一端口多个引脚的寄存器值与掩码，一次写入*/
+typedef struct
+{
+    uint32_t Mask1;     /* 1位/引脚的寄存器掩码 */
+    uint32_t Mask2;     /* 2位/引脚的寄存器掩码 */
+    uint32_t cfgr;
+    uint32_t omode;
+    uint32_t odrvr;
+    uint32_t pull;
+} GPIO_PortConfig_TypeDef;
+
+const GPIO_ModeInfo_TypeDef* GPIO_Batch_GetModeInfo(uint32_t Mode);
+void GPIO_Batch_Add(
+    GPIO_PortConfig_TypeDef* Config,
+    uint16_t GPIO_Pin_x,
+    const GPIO_ModeInfo_TypeDef* ModeInfo,
+    uint32_t GPIO_Drive_x
+);
+uint16_t GPIO_Batch_Build(
+    GPIO_PortConfig_TypeDef* Port, uint32_t PortCount,
+    const PinConfig_TypeDef* Config, uint16_t Count,
+    uint32_t GPIO_Drive_x
+);
+void GPIO_Batch_Apply(
+    const GPIO_PortConfig_TypeDef* Config,
+    volatile uint32_t* cfgr,
+    volatile uint32_t* omode,
+    volatile uint32_t* odrvr,
+    volatile uint32_t* pull
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GPIO_BATCH_H */
@@ -0,0 +1,273 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "gpio_wave.h"
+#include "dma_stream.h"
+#include "timer.h"
+
+#if GPIO_WAVE_ENABLE
+
+/*
+ * 定时器每次溢出产生一个DMA请求，把缓冲中的一个字写入GPIOx->scr，
+ * 所有边沿由硬件定时，不受中断和CPU负载影响。
+ */
+
+typedef enum
+{
+    GPIO_WAVE_MODE_ONCE,
+    GPIO_WAVE_MODE_LOOP,
+    GPIO_WAVE_MODE_STREAM
+} GPIO_Wave_Mode_Type;
+
+static volatile bool GPIO_Wave_Busy = false;
+static GPIO_Wave_Mode_Type GPIO_Wave_Mode = GPIO_WAVE_MODE_ONCE;
+
+static GPIO_Wave_CallbackFunction_t GPIO_Wave_Callback = NULL;
+static void* GPIO_Wave_CallbackUserData = NULL;
+
+/*流模式*/
+static DMA_Stream_TypeDef GPIO_Wave_Stream;
+static GPIO_Wave_FillFunction_t GPIO_Wave_StreamFill = NULL;
+static void* GPIO_Wave_StreamUserData = NULL;
+
+/**
+  * @brief  GPIO波形发生器初始化
+  * @param  SlotFreq: 时隙频率(Hz)，即每秒写入scr的次数
+  * @retval true: 成功
+  */
+bool GPIO_Wave_Init(uint32_t SlotFreq)
+{
+    GPIO_Wave_Stop();
+
+    Timer_ClockCmd(GPIO_WAVE_TIMER, true);
+    Timer_SetEnable(GPIO_WAVE_TIMER, false);
+    if(!Timer_SetInterruptFreqUpdate(GPIO_WAVE_TIMER, SlotFreq))
+        return false;
+
+    tmr_dma_request_enable(GPIO_WAVE_TIMER, TMR_OVERFLOW_DMA_REQUEST, TRUE);
+
+    crm_periph_clock_enable(
+        (GPIO_WAVE_DMA == DMA1) ? CRM_DMA1_PERIPH_CLOCK : CRM_DMA2_PERIPH_CLOCK,
+        TRUE
+    );
+    dmamux_enable(GPIO_WAVE_DMA, TRUE);
+    dmamux_init(GPIO_WAVE_DMAMUX_CHANNEL, GPIO_WAVE_DMAREQ_ID);
+
+    nvic_irq_enable(GPIO_WAVE_DMA_IRQn, GPIO_WAVE_PREEMPTIONPRIORITY, GPIO_WAVE_SUBPRIORITY);
+
+    return true;
+}
+
+/**
+  * @brief  设置波形结束回调(在DMA中断中执行)
+  * @param  Function: 回调函数
+  * @param  UserData: 用户数据
+  * @retval 无
+  */
+void GPIO_Wave_SetCallback(GPIO_Wave_CallbackFunction_t Function, void* UserData)
+{
+    GPIO_Wave_CallbackUserData = UserData;
+    GPIO_Wave_Callback = Function;
+}
+
+static void GPIO_Wave_DMA_Config(gpio_type* GPIOx, const uint32_t* Buffer, uint16_t Length, bool Loop, uint32_t Interrupt)
+{
+    dma_init_type dma_init_structure;
+
+    dma_reset(GPIO_WAVE_DMA_CHANNEL);
+
+    dma_default_para_init(&dma_init_structure);
+    dma_init_structure.buffer_size = Length;
+    dma_init_structure.direction = DMA_DIR_MEMORY_TO_PERIPHERAL;
+    dma_init_structure.memory_base_addr = (uint32_t)Buffer;
+    dma_init_structure.memory_data_width = DMA_MEMORY_DATA_WIDTH_WORD;
+    dma_init_structure.memory_inc_enable = TRUE;
+    dma_init_structure.peripheral_base_addr = (uint32_t)(&(GPIOx->scr));
+    dma_init_structure.peripheral_data_width = DMA_PERIPHERAL_DATA_WIDTH_WORD;
+    dma_init_structure.peripheral_inc_enable = FALSE;
+    dma_init_structure.priority = DMA_PRIORITY_VERY_HIGH;
+    dma_init_structure.loop_mode_enable = Loop ? TRUE : FALSE;
+    dma_init(GPIO_WAVE_DMA_CHANNEL, &dma_init_structure);
+
+    dma_flag_clear(GPIO_WAVE_DMA_HDT_FLAG);
+    dma_flag_clear(GPIO_WAVE_DMA_FDT_FLAG);
+    dma_interrupt_enable(GPIO_WAVE_DMA_CHANNEL, Interrupt, TRUE);
+}
+
+static void GPIO_Wave_Launch(void)
+{
+    GPIO_Wave_Busy = true;
+
+    GPIO_WAVE_TIMER->cval = 0;
+    tmr_flag_clear(GPIO_WAVE_TIMER, TMR_OVF_FLAG);
+    dma_channel_enable(GPIO_WAVE_DMA_CHANNEL, TRUE);
+    Timer_SetEnable(GPIO_WAVE_TIMER, true);
+}
+
+/**
+  * @brief  输出一段预先编码的波形
+  * @param  GPIOx: 目标GPIO端口，引脚需先配置为输出
+  * @param  Buffer: scr字缓冲，输出期间不能修改
+  * @param  Length: 字数，不超过GPIO_WAVE_LENGTH_MAX(编码函数的返回值可直接传入)
+  * @param  Loop: true循环输出直到GPIO_Wave_Stop
+  * @retval true: 成功，false: 正在输出或参数错误(包括长度超出DMA计数范围)
+  */
+bool GPIO_Wave_Start(gpio_type* GPIOx, const uint32_t* Buffer, uint32_t Length, bool Loop)
+{
+    if(GPIO_Wave_Busy || Buffer == NULL || Length == 0 || Length > GPIO_WAVE_LENGTH_MAX)
+        return false;
+
+    GPIO_Wave_Mode = Loop ? GPIO_WAVE_MODE_LOOP : GPIO_WAVE_MODE_ONCE;
+    GPIO_Wave_DMA_Config(GPIOx, Buffer, (uint16_t)Length, Loop, Loop ? 0 : DMA_FDT_INT);
+    GPIO_Wave_Launch();
+    return true;
+}
+
+static uint16_t GPIO_Wave_StreamFillWords(void* Half, uint16_t Length, void* UserData)
+{
+    (void)UserData;
+    return GPIO_Wave_StreamFill((uint32_t*)Half, Length, GPIO_Wave_StreamUserData);
+}
+
+static void GPIO_Wave_StreamPad(void* Half, uint16_t Filled, uint16_t Length, void* UserData)
+{
+    uint32_t* half = (uint32_t*)Half;
+    uint16_t i;
+    (void)UserData;
+
+    /*空闲字写入scr不改变引脚*/
+    for(i = Filled; i < Length; i++)
+    {
+        half[i] = GPIO_WAVE_IDLE;
+    }
+}
+
+/**
+  * @brief  流模式输出，边输出边编码，适合长波形
+  * @param  GPIOx: 目标GPIO端口，引脚需先配置为输出
+  * @param  Buffer: 双缓冲，长度为 HalfLength * 2
+  * @param  HalfLength: 半缓冲长度(字)
+  * @param  Fill: 填充函数，在DMA中断中调用
+  * @param  UserData: 用户数据
+  * @retval true: 成功，false: 正在输出或参数错误
+  */
+bool GPIO_Wave_StartStream(
+    gpio_type* GPIOx,
+    uint32_t* Buffer, uint16_t HalfLength,
+    GPIO_Wave_FillFunction_t Fill, void* UserData
+)
+{
+    if(GPIO_Wave_Busy || Buffer == NULL || HalfLength == 0 || HalfLength > 0x7FFF || Fill == NULL)
+        return false;
+
+    GPIO_Wave_Mode = GPIO_WAVE_MODE_STREAM;
+    GPIO_Wave_StreamFill = Fill;
+    GPIO_Wave_StreamUserData = UserData;
+
+    DMA_Stream_Start(
+        &GPIO_Wave_Stream,
+        Buffer, HalfLength, sizeof(uint32_t),
+        GPIO_Wave_StreamFillWords, GPIO_Wave_StreamPad, NULL
+    );
+
+    GPIO_Wave_DMA_Config(GPIOx, Buffer, HalfLength * 2, true, DMA_HDT_INT | DMA_FDT_INT);
+    GPIO_Wave_Launch();
+    return true;
+}
+
+/**
+  * @brief  停止输出，引脚保持当前电平
+  * @param  无
+  * @retval 无
+  */
+void GPIO_Wave_Stop(void)
+{
+    Timer_SetEnable(GPIO_WAVE_TIMER, false);
+    dma_channel_enable(GPIO_WAVE_DMA_CHANNEL, FALSE);
+    dma_interrupt_enable(GPIO_WAVE_DMA_CHANNEL, DMA_HDT_INT | DMA_FDT_INT, FALSE);
+    GPIO_Wave_Busy = false;
+}
+
+/**
+  * @brief  是否正在输出
+  * @param  无
+  * @retval true: 正在输出
+  */
+bool GPIO_Wave_IsBusy(void)
+{
+    return GPIO_Wave_Busy;
+}
+
+/**
+  * @brief  获取实际时隙频率
+  * @param  无
+  * @retval 时隙频率(Hz)
+  */
+uint32_t GPIO_Wave_GetSlotFreq(void)
+{
+    return Timer_GetClockOut(GPIO_WAVE_TIMER);
+}
+
+static void GPIO_Wave_Finish(void)
+{
+    GPIO_Wave_Stop();
+    if(GPIO_Wave_Callback)
+    {
+        GPIO_Wave_Callback(GPIO_Wave_CallbackUserData);
+    }
+}
+
+/**
+  * @brief  GPIO波形DMA中断入口
+  * @param  无
+  * @retval 无
+  */
+GPIO_WAVE_IRQ_HANDLER_DEF()
+{
+    if(dma_flag_get(GPIO_WAVE_DMA_HDT_FLAG) != RESET)
+    {
+        dma_flag_clear(GPIO_WAVE_DMA_HDT_FLAG);
+        if(GPIO_Wave_Mode == GPIO_WAVE_MODE_STREAM && GPIO_Wave_Busy
+                && DMA_Stream_Event(&GPIO_Wave_Stream, false))
+        {
+            GPIO_Wave_Finish();
+        }
+    }
+
+    if(dma_flag_get(GPIO_WAVE_DMA_FDT_FLAG) != RESET)
+    {
+        dma_flag_clear(GPIO_WAVE_DMA_FDT_FLAG);
+        if(GPIO_Wave_Mode == GPIO_WAVE_MODE_STREAM)
+        {
+            if(GPIO_Wave_Busy && DMA_Stream_Event(&GPIO_Wave_Stream, true))
+            {
+                GPIO_Wave_Finish();
+            }
+        }
+        else
+        {
+            GPIO_Wave_Finish();
+        }
+    }
+}
+
+#endif /* GPIO_WAVE_ENABLE */
@@ -0,0 +1,60 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __GPIO_WAVE_H
+#define __GPIO_WAVE_H
+
+#include <stdbool.h>
+#include "mcu_type.h"
+#include "gpio_wave_encoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* DMA单次传输的最大字数，更长的波形用流模式分段输出 */
+#define GPIO_WAVE_LENGTH_MAX    0xFFFFU
+
+typedef void(*GPIO_Wave_CallbackFunction_t)(void* UserData);
+
+/* 流模式填充函数，返回写入的字数，小于Length表示数据结束 */
+typedef uint16_t(*GPIO_Wave_FillFunction_t)(uint32_t* Buffer, uint16_t Length, void* UserData);
+
+#if GPIO_WAVE_ENABLE
+bool     GPIO_Wave_Init(uint32_t SlotFreq);
+void     GPIO_Wave_SetCallback(GPIO_Wave_CallbackFunction_t Function, void* UserData);
+bool     GPIO_Wave_Start(gpio_type* GPIOx, const uint32_t* Buffer, uint32_t Length, bool Loop);
+bool     GPIO_Wave_StartStream(
+    gpio_type* GPIOx,
+    uint32_t* Buffer, uint16_t HalfLength,
+    GPIO_Wave_FillFunction_t Fill, void* UserData
+);
+void     GPIO_Wave_Stop(void);
+bool     GPIO_Wave_IsBusy(void);
+uint32_t GPIO_Wave_GetSlotFreq(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GPIO_WAVE_H */
@@ -0,0 +1,166 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "gpio_wave_encoder.h"
+
+/**
+  * @brief  WS2812单通道编码
+  * @param  Buffer: 输出缓冲
+  * @param  BufferSize: 缓冲长度(字)
+  * @param  PinMask: 数据引脚掩码
+  * @param  Data: 按发送顺序排列的字节(通常为GRB)
+  * @param  Bytes: 字节数
+  * @retval 写入的字数，0:缓冲不足
+  */
+uint32_t GPIO_Wave_EncodeWS2812(
+    uint32_t* Buffer, uint32_t BufferSize,
+    uint16_t PinMask,
+    const uint8_t* Data, uint32_t Bytes
+)
+{
+    return GPIO_Wave_EncodeWS2812Parallel(Buffer, BufferSize, &PinMask, &Data, 1, Bytes);
+}
+
+/**
+  * @brief  WS2812多通道并行编码，同一GPIO端口的多个引脚同时输出
+  * @param  Buffer: 输出缓冲
+  * @param  BufferSize: 缓冲长度(字)
+  * @param  PinMask: 各通道引脚掩码
+  * @param  Data: 各通道数据
+  * @param  Lanes: 通道数
+  * @param  Bytes: 每个通道的字节数
+  * @retval 写入的字数，0:缓冲不足
+  */
+uint32_t GPIO_Wave_EncodeWS2812Parallel(
+    uint32_t* Buffer, uint32_t BufferSize,
+    const uint16_t* PinMask, const uint8_t* const* Data, uint8_t Lanes,
+    uint32_t Bytes
+)
+{
+    uint32_t words = GPIO_WAVE_WS2812_WORDS(Bytes);
+    uint16_t allMask = 0;
+    uint32_t i;
+    uint8_t lane;
+
+    if(words > BufferSize || Lanes == 0)
+    {
+        return 0;
+    }
+
+    for(lane = 0; lane < Lanes; lane++)
+    {
+        allMask |= PinMask[lane];
+    }
+
+    for(i = 0; i < Bytes; i++)
+    {
+        uint8_t bit;
+        for(bit = 0x80; bit; bit >>= 1)
+        {
+            uint16_t zeroMask = 0;
+            for(lane = 0; lane < Lanes; lane++)
+            {
+                if(!(Data[lane][i] & bit))
+                {
+                    zeroMask |= PinMask[lane];
+                }
+            }
+
+            *Buffer++ = GPIO_WAVE_SET(allMask);
+            *Buffer++ = GPIO_WAVE_RESET(zeroMask);
+            *Buffer++ = GPIO_WAVE_RESET(allMask);
+        }
+    }
+
+    return words;
+}
+
+/**
+  * @brief  步进电机STEP/DIR脉冲序列编码
+  * @param  Buffer: 输出缓冲
+  * @param  BufferSize: 缓冲长度(字)
+  * @param  Config: 引脚与时序配置
+  * @param  Intervals: 相邻两个STEP上升沿的间隔(时隙)，须大于PulseSlots，可用于加减速
+  * @param  Steps: 步数
+  * @retval 写入的字数，0:参数错误或缓冲不足
+  */
+uint32_t GPIO_Wave_EncodeStepDir(
+    uint32_t* Buffer, uint32_t BufferSize,
+    const GPIO_Wave_StepDir_TypeDef* Config,
+    const uint16_t* Intervals, uint32_t Steps
+)
+{
+    uint32_t words = 0;
+    uint32_t i;
+
+    if(Config->PulseSlots == 0)
+    {
+        return 0;
+    }
+
+    /* 先计算总长度，避免写到一半才发现缓冲不足 */
+    if(Config->DirMask)
+    {
+        words += 1 + Config->DirSetupSlots;
+    }
+    for(i = 0; i < Steps; i++)
+    {
+        if(Intervals[i] <= Config->PulseSlots)
+        {
+            return 0;
+        }
+        words += Intervals[i];
+    }
+    if(words > BufferSize)
+    {
+        return 0;
+    }
+
+    if(Config->DirMask)
+    {
+        uint16_t n;
+        *Buffer++ = Config->Dir ? GPIO_WAVE_SET(Config->DirMask) : GPIO_WAVE_RESET(Config->DirMask);
+        for(n = 0; n < Config->DirSetupSlots; n++)
+        {
+            *Buffer++ = GPIO_WAVE_IDLE;
+        }
+    }
+
+    for(i = 0; i < Steps; i++)
+    {
+        uint16_t n;
+
+        *Buffer++ = GPIO_WAVE_SET(Config->StepMask);
+        for(n = 1; n < Config->PulseSlots; n++)
+        {
+            *Buffer++ = GPIO_WAVE_IDLE;
+        }
+
+        *Buffer++ = GPIO_WAVE_RESET(Config->StepMask);
+        for(n = Config->PulseSlots + 1; n < Intervals[i]; n++)
+        {
+            *Buffer++ = GPIO_WAVE_IDLE;
+        }
+    }
+
+    return words;
+}
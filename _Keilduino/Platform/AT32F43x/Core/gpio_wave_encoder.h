@@ -0,0 +1,77 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __GPIO_WAVE_ENCODER_H
+#define __GPIO_WAVE_ENCODER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * GPIO波形编码：每个时隙一个32位scr字，
+ * 低16位为置位掩码，高16位为清零掩码，0表示该时隙引脚保持不变。
+ * 本文件不访问寄存器，可在PC上编译验证生成的字序列。
+ */
+#define GPIO_WAVE_SET(MASK)                 ((uint32_t)(uint16_t)(MASK))
+#define GPIO_WAVE_RESET(MASK)               ((uint32_t)(uint16_t)(MASK) << 16)
+#define GPIO_WAVE_IDLE                      ((uint32_t)0)
+
+/* WS2812: 每bit 3个时隙，2.4MHz时隙频率对应800kHz数据率
+ * 0: H L L (417ns/833ns)  1: H H L (833ns/417ns)
+ */
+#define GPIO_WAVE_WS2812_SLOTS_PER_BIT      3
+#define GPIO_WAVE_WS2812_SLOT_FREQ          2400000
+#define GPIO_WAVE_WS2812_WORDS(BYTES)       ((BYTES) * 8 * GPIO_WAVE_WS2812_SLOTS_PER_BIT)
+
+typedef struct
+{
+    uint16_t StepMask;      // STEP引脚掩码
+    uint16_t DirMask;       // DIR引脚掩码，0表示不输出方向
+    uint8_t  Dir;           // 方向电平
+    uint16_t PulseSlots;    // STEP高电平宽度(时隙)
+    uint16_t DirSetupSlots; // DIR建立时间(时隙)，第一个脉冲前插入
+} GPIO_Wave_StepDir_TypeDef;
+
+uint32_t GPIO_Wave_EncodeWS2812(
+    uint32_t* Buffer, uint32_t BufferSize,
+    uint16_t PinMask,
+    const uint8_t* Data, uint32_t Bytes
+);
+uint32_t GPIO_Wave_EncodeWS2812Parallel(
+    uint32_t* Buffer, uint32_t BufferSize,
+    const uint16_t* PinMask, const uint8_t* const* Data, uint8_t Lanes,
+    uint32_t Bytes
+);
+uint32_t GPIO_Wave_EncodeStepDir(
+    uint32_t* Buffer, uint32_t BufferSize,
+    const GPIO_Wave_StepDir_TypeDef* Config,
+    const uint16_t* Intervals, uint32_t Steps
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __GPIO_WAVE_ENCODER_H */
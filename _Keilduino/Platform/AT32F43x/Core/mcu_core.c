@@ -25,9 +25,15 @@
 
 void Core_Init(void)
 {
+#if MEM_DIAG_ENABLE
+    MemDiag_Init();
+#endif
     system_clock_config();
     nvic_priority_group_config(NVIC_PRIORITY_GROUP_2);
     DWT_Init();
+#if PROF_ENABLE
+    Prof_Init();
+#endif
     Delay_Init();
     ADCx_Init(ADC1);
 }
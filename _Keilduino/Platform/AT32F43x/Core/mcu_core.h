@@ -26,11 +26,24 @@
 #include "at32f435_437_clock.h"
 
 #include "adc.h"
+#include "binlog.h"
+#include "capture.h"
+#include "coroutine.h"
+#include "defer.h"
+#include "debounce.h"
 #include "delay.h"
 #include "dwt.h"
+#include "encoder.h"
 #include "exti.h"
 #include "gpio.h"
+#include "gpio_wave.h"
+#include "mem_diag.h"
+#include "prof.h"
 #include "pwm.h"
+#include "pwm_wave.h"
+#include "servo_seq.h"
+#include "soft_timer.h"
+#include "sram.h"
 #include "timer.h"
 #include "wdg.h"
 
@@ -36,6 +36,21 @@
 #endif
 #define CYCLES_PER_MICROSECOND      (F_CPU / 1000000U)
 
+/*
+ * 放入SRAM执行的函数，分散加载文件(MDK-ARM/proj.sct)把.ramfunc段放在RAM执行域，
+ * 启动时由__main与已初始化变量一起复制；未使用该分散加载文件时仍在闪存中执行。
+ * RAMFUNC_ISR只把中断入口和分发放入SRAM，其中调用的函数仍在闪存中执行：
+ * 用户回调(attachInterrupt/Timer_SetInterruptBase/串口_callbackFunction)、
+ * EXTI事件队列写入(MPSC_Ring_Push)、SysTick中的DelayClock_Update；
+ * 需要完全零等待时，回调函数本身也要加RAMFUNC。
+ */
+#define RAMFUNC                     __attribute__((section(".ramfunc")))
+#if RAMFUNC_ISR_ENABLE
+#  define RAMFUNC_ISR               RAMFUNC
+#else
+#  define RAMFUNC_ISR
+#endif
+
 typedef gpio_type                   GPIO_TypeDef;
 typedef spi_type                    SPI_TypeDef;
 typedef tmr_type                    TIM_TypeDef;
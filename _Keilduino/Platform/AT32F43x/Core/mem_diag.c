@@ -0,0 +1,440 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "mem_diag.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if MEM_DIAG_ENABLE
+
+/*
+ * 内存诊断：
+ * Core_Init 时把主栈未用部分和堆的空闲部分填充为固定值，之后扫描填充值得到高水位；
+ * 包装 malloc/free/calloc/realloc(C++ new/delete 也经过malloc)统计分配并检查块尾越界；
+ * 栈底可放金丝雀(MemDiag_Check检查)或MPU禁止访问区(越界立即进入MemManage异常)。
+ * ARMCC使用 $Sub$$/$Super$$ 替换库函数；GCC需要链接选项
+ * -Wl,--wrap=malloc,--wrap=free,--wrap=calloc,--wrap=realloc
+ */
+
+/*
+ * 栈和堆的范围，由启动文件定义；
+ * ARMCC使用启动文件STACK/HEAP段的链接器符号，__heap_base/__heap_limit只在MicroLIB时导出
+ */
+#ifndef MEM_DIAG_STACK_BEGIN
+#  if defined(__CC_ARM)
+extern uint32_t STACK$$Base;
+extern uint32_t STACK$$Limit;
+extern uint32_t HEAP$$Base;
+extern uint32_t HEAP$$Limit;
+#    define MEM_DIAG_STACK_BEGIN    (&STACK$$Base)
+#    define MEM_DIAG_STACK_END      (&STACK$$Limit)
+#    define MEM_DIAG_HEAP_BEGIN     (&HEAP$$Base)
+#    define MEM_DIAG_HEAP_END       (&HEAP$$Limit)
+#  elif defined(__GNUC__)
+extern uint32_t __StackLimit;
+extern uint32_t __StackTop;
+extern uint32_t end;
+extern uint32_t __HeapLimit;
+#    define MEM_DIAG_STACK_BEGIN    (&__StackLimit)
+#    define MEM_DIAG_STACK_END      (&__StackTop)
+#    define MEM_DIAG_HEAP_BEGIN     (&end)
+#    define MEM_DIAG_HEAP_END       (&__HeapLimit)
+#  endif
+#endif
+
+#if MEM_DIAG_HEAP_WRAP
+#  if defined(__CC_ARM)
+#    define MEM_DIAG_REAL_MALLOC    $Super$$malloc
+#    define MEM_DIAG_REAL_FREE      $Super$$free
+#    define MEM_DIAG_WRAP_MALLOC    $Sub$$malloc
+#    define MEM_DIAG_WRAP_FREE      $Sub$$free
+#    define MEM_DIAG_WRAP_CALLOC    $Sub$$calloc
+#    define MEM_DIAG_WRAP_REALLOC   $Sub$$realloc
+#  elif defined(__GNUC__)
+#    define MEM_DIAG_REAL_MALLOC    __real_malloc
+#    define MEM_DIAG_REAL_FREE      __real_free
+#    define MEM_DIAG_WRAP_MALLOC    __wrap_malloc
+#    define MEM_DIAG_WRAP_FREE      __wrap_free
+#    define MEM_DIAG_WRAP_CALLOC    __wrap_calloc
+#    define MEM_DIAG_WRAP_REALLOC   __wrap_realloc
+#  endif
+void* MEM_DIAG_REAL_MALLOC(size_t size);
+void  MEM_DIAG_REAL_FREE(void* ptr);
+#else
+#  define MEM_DIAG_REAL_MALLOC      malloc
+#  define MEM_DIAG_REAL_FREE        free
+#endif
+
+#define MEM_DIAG_CANARY             0x5AA5C33CUL
+#define MEM_DIAG_CANARY_WORDS       4
+#define MEM_DIAG_MPU_GUARD_SIZE     32
+#define MEM_DIAG_STACK_MARGIN       64  // 填充时为当前栈帧保留的字节数
+#define MEM_DIAG_PROBE_MAX          16  // 探测堆时最多占用的块数
+
+static MemStat_Heap_TypeDef MemDiag_Heap;
+static uint32_t* MemDiag_StackScan = MEM_DIAG_STACK_BEGIN; // 栈扫描起点(栈保护区之上)
+
+static uint32_t MemDiag_Lock(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+static void MemDiag_Unlock(uint32_t primask)
+{
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  二分查找当前能分配的最大块
+  * @param  Limit: 上限
+  * @retval 字节数
+  */
+static uint32_t MemDiag_ProbeLargest(uint32_t Limit)
+{
+    uint32_t low = 0;
+    uint32_t high = Limit;
+
+    while(low < high)
+    {
+        uint32_t mid = (low + high + 1) / 2;
+        void* p = MEM_DIAG_REAL_MALLOC(mid);
+        if(p)
+        {
+            MEM_DIAG_REAL_FREE(p);
+            low = mid;
+        }
+        else
+        {
+            high = mid - 1;
+        }
+    }
+
+    return low;
+}
+
+/**
+  * @brief  依次占用最大的空闲块，统计(并可填充)后全部释放
+  * @param  Largest: 输出最大空闲块
+  * @param  Paint: 是否填充
+  * @retval 空闲总量
+  */
+static uint32_t MemDiag_ProbeHeap(uint32_t* Largest, bool Paint)
+{
+    uint32_t heapSize = (uint32_t)((uint8_t*)MEM_DIAG_HEAP_END - (uint8_t*)MEM_DIAG_HEAP_BEGIN);
+    void* chain = NULL;
+    uint32_t total = 0;
+    uint8_t count;
+
+    *Largest = 0;
+
+    for(count = 0; count < MEM_DIAG_PROBE_MAX; count++)
+    {
+        uint32_t size = MemDiag_ProbeLargest(heapSize);
+        void** block;
+
+        if(size < sizeof(void*))
+        {
+            break;
+        }
+
+        block = (void**)MEM_DIAG_REAL_MALLOC(size);
+        if(!block)
+        {
+            break;
+        }
+
+        if(Paint)
+        {
+            MemStat_Paint((uint32_t*)block, (uint32_t*)block + size / sizeof(uint32_t));
+        }
+
+        /*空闲块串成链表，不需要额外内存*/
+        *block = chain;
+        chain = block;
+
+        if(count == 0)
+        {
+            *Largest = size;
+        }
+        total += size;
+    }
+
+    while(chain)
+    {
+        void* next = *(void**)chain;
+        MEM_DIAG_REAL_FREE(chain);
+        chain = next;
+    }
+
+    return total;
+}
+
+static void MemDiag_StackGuardInit(void)
+{
+    uint32_t* begin = MEM_DIAG_STACK_BEGIN;
+
+#if MEM_DIAG_STACK_GUARD == 1
+    uint8_t i;
+    for(i = 0; i < MEM_DIAG_CANARY_WORDS; i++)
+    {
+        begin[i] = MEM_DIAG_CANARY;
+    }
+    MemDiag_StackScan = begin + MEM_DIAG_CANARY_WORDS;
+#elif MEM_DIAG_STACK_GUARD == 2
+#  if !defined(__MPU_PRESENT) || !__MPU_PRESENT
+#    error "MEM_DIAG_STACK_GUARD 2 requires an MPU"
+#  endif
+    /*栈底之上第一个32字节对齐的区域设为禁止访问*/
+    uint32_t guard = ((uint32_t)begin + MEM_DIAG_MPU_GUARD_SIZE - 1) & ~(MEM_DIAG_MPU_GUARD_SIZE - 1UL);
+
+    MPU->RNR = MEM_DIAG_MPU_REGION;
+    MPU->RBAR = guard;
+    MPU->RASR = MPU_RASR_XN_Msk
+                | (0UL << MPU_RASR_AP_Pos)
+                | (4UL << MPU_RASR_SIZE_Pos) /*2^(4+1) = 32字节*/
+                | MPU_RASR_ENABLE_Msk;
+    MPU->CTRL = MPU_CTRL_PRIVDEFENA_Msk | MPU_CTRL_ENABLE_Msk;
+    SCB->SHCSR |= SCB_SHCSR_MEMFAULTENA_Msk;
+    __DSB();
+    __ISB();
+    MemDiag_StackScan = (uint32_t*)(guard + MEM_DIAG_MPU_GUARD_SIZE);
+#else
+    MemDiag_StackScan = begin;
+#endif
+}
+
+/**
+  * @brief  内存诊断初始化，填充主栈和堆，设置栈保护，在Core_Init开头调用
+  * @param  无
+  * @retval 无
+  */
+void MemDiag_Init(void)
+{
+    uint32_t* sp = (uint32_t*)(__get_MSP() - MEM_DIAG_STACK_MARGIN);
+    uint32_t largest;
+
+    /*只在主栈上调用时填充；全局构造函数可能已经分配过内存，统计不清零*/
+    if(sp > MEM_DIAG_STACK_BEGIN && sp < MEM_DIAG_STACK_END)
+    {
+        MemStat_Paint(MEM_DIAG_STACK_BEGIN, sp);
+    }
+    MemDiag_StackGuardInit();
+
+    MemDiag_ProbeHeap(&largest, true);
+}
+
+/**
+  * @brief  检查栈金丝雀
+  * @param  无
+  * @retval true: 完好(未使用金丝雀时总为true)
+  */
+bool MemDiag_Check(void)
+{
+#if MEM_DIAG_STACK_GUARD == 1
+    const uint32_t* begin = MEM_DIAG_STACK_BEGIN;
+    uint8_t i;
+    for(i = 0; i < MEM_DIAG_CANARY_WORDS; i++)
+    {
+        if(begin[i] != MEM_DIAG_CANARY)
+        {
+            return false;
+        }
+    }
+#endif
+    return true;
+}
+
+/**
+  * @brief  获取内存使用情况
+  * @param  Info: 输出
+  * @param  Probe: 是否探测堆空闲块(会临时占满堆，只能在主循环中调用)
+  * @retval 无
+  */
+void MemDiag_GetInfo(MemDiag_Info_TypeDef* Info, bool Probe)
+{
+    uint32_t* stackEnd = MEM_DIAG_STACK_END;
+    uint32_t* heapBegin = MEM_DIAG_HEAP_BEGIN;
+    uint32_t* heapEnd = MEM_DIAG_HEAP_END;
+    uint32_t primask;
+
+    Info->StackSize = (uint32_t)((uint8_t*)stackEnd - (uint8_t*)MEM_DIAG_STACK_BEGIN);
+    Info->StackPeak = (uint32_t)((uint8_t*)stackEnd - (uint8_t*)MemDiag_StackScan)
+                      - MemStat_UnusedFromBottom(MemDiag_StackScan, stackEnd);
+    Info->HeapSize = (uint32_t)((uint8_t*)heapEnd - (uint8_t*)heapBegin);
+    Info->HeapTouched = Info->HeapSize - MemStat_UnusedFromTop(heapBegin, heapEnd);
+    Info->StackGuardOK = MemDiag_Check();
+
+    Info->HeapLargestFree = 0;
+    Info->HeapTotalFree = 0;
+    Info->HeapFragmentation = 0;
+    if(Probe)
+    {
+        Info->HeapTotalFree = MemDiag_ProbeHeap(&Info->HeapLargestFree, false);
+        Info->HeapFragmentation = MemStat_Fragmentation(Info->HeapLargestFree, Info->HeapTotalFree);
+    }
+
+    primask = MemDiag_Lock();
+    Info->Heap = MemDiag_Heap;
+    MemDiag_Unlock(primask);
+}
+
+/**
+  * @brief  用printf输出一行内存使用报告，便于自动测试解析
+  * @param  无
+  * @retval 无
+  */
+void MemDiag_Report(void)
+{
+    MemDiag_Info_TypeDef info;
+    MemDiag_GetInfo(&info, true);
+
+    printf(
+        "MEM stack=%u/%u guard=%s heap_touched=%u/%u heap_peak=%u blocks=%u/%u alloc=%u free=%u fail=%u corrupt=%u largest_free=%u total_free=%u frag=%u%%\r\n",
+        (unsigned)info.StackPeak, (unsigned)info.StackSize,
+        info.StackGuardOK ? "ok" : "broken",
+        (unsigned)info.HeapTouched, (unsigned)info.HeapSize,
+        (unsigned)info.Heap.PeakBytes,
+        (unsigned)info.Heap.LiveBlocks, (unsigned)info.Heap.PeakBlocks,
+        (unsigned)info.Heap.AllocCount, (unsigned)info.Heap.FreeCount,
+        (unsigned)info.Heap.FailCount, (unsigned)info.Heap.CorruptCount,
+        (unsigned)info.HeapLargestFree, (unsigned)info.HeapTotalFree,
+        (unsigned)info.HeapFragmentation
+    );
+}
+
+/**
+  * @brief  填充一段栈(如协程栈)，用于之后测量高水位
+  * @param  Base: 栈底(低地址)
+  * @param  Size: 大小
+  * @retval 无
+  */
+void MemDiag_Paint(void* Base, uint32_t Size)
+{
+    MemStat_Paint((uint32_t*)Base, (uint32_t*)Base + Size / sizeof(uint32_t));
+}
+
+/**
+  * @brief  获取已填充的栈的最大用量
+  * @param  Base: 栈底(低地址)
+  * @param  Size: 大小
+  * @retval 字节数
+  */
+uint32_t MemDiag_GetStackPeak(const void* Base, uint32_t Size)
+{
+    const uint32_t* begin = (const uint32_t*)Base;
+    const uint32_t* end = begin + Size / sizeof(uint32_t);
+    return (uint32_t)((end - begin) * sizeof(uint32_t)) - MemStat_UnusedFromBottom(begin, end);
+}
+
+#if MEM_DIAG_HEAP_WRAP
+
+void* MEM_DIAG_WRAP_MALLOC(size_t size)
+{
+    uint32_t rawSize = MemStat_BlockSize(size);
+    void* raw = rawSize ? MEM_DIAG_REAL_MALLOC(rawSize) : NULL;
+    void* ptr = NULL;
+    uint32_t primask = MemDiag_Lock();
+
+    if(raw)
+    {
+        ptr = MemStat_BlockInit(&MemDiag_Heap, raw, size);
+    }
+    else
+    {
+        MemStat_OnFail(&MemDiag_Heap);
+    }
+
+    MemDiag_Unlock(primask);
+    return ptr;
+}
+
+void MEM_DIAG_WRAP_FREE(void* ptr)
+{
+    void* raw;
+    uint32_t primask;
+
+    if(!ptr)
+    {
+        return;
+    }
+
+    primask = MemDiag_Lock();
+    raw = MemStat_BlockRelease(&MemDiag_Heap, ptr);
+    MemDiag_Unlock(primask);
+
+    /*头已损坏时交还底层会破坏堆，宁可泄漏*/
+    if(raw)
+    {
+        MEM_DIAG_REAL_FREE(raw);
+    }
+}
+
+/*calloc/realloc 由包装后的malloc/free实现，避免库内部再调用malloc时重复计数*/
+void* MEM_DIAG_WRAP_CALLOC(size_t count, size_t size)
+{
+    void* ptr;
+
+    if(size && count > (size_t)-1 / size)
+    {
+        return NULL;
+    }
+
+    ptr = MEM_DIAG_WRAP_MALLOC(count * size);
+    if(ptr)
+    {
+        memset(ptr, 0, count * size);
+    }
+    return ptr;
+}
+
+void* MEM_DIAG_WRAP_REALLOC(void* ptr, size_t size)
+{
+    void* newPtr;
+    uint32_t oldSize;
+
+    if(!ptr)
+    {
+        return MEM_DIAG_WRAP_MALLOC(size);
+    }
+
+    if(size == 0)
+    {
+        MEM_DIAG_WRAP_FREE(ptr);
+        return NULL;
+    }
+
+    oldSize = MemStat_BlockGetSize(ptr);
+    newPtr = MEM_DIAG_WRAP_MALLOC(size);
+    if(newPtr)
+    {
+        memcpy(newPtr, ptr, (oldSize < size) ? oldSize : size);
+        MEM_DIAG_WRAP_FREE(ptr);
+    }
+    return newPtr;
+}
+
+#endif /* MEM_DIAG_HEAP_WRAP */
+
+#endif /* MEM_DIAG_ENABLE */
@@ -0,0 +1,59 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __MEM_DIAG_H
+#define __MEM_DIAG_H
+
+#include "mcu_type.h"
+#include "mem_stat.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    uint32_t StackSize;         // 主栈大小
+    uint32_t StackPeak;         // 主栈最大用量(高水位)
+    uint32_t HeapSize;          // 堆大小
+    uint32_t HeapTouched;       // 堆中曾被写过的最高位置(距堆起始)
+    uint32_t HeapLargestFree;   // 最大空闲块(需探测)
+    uint32_t HeapTotalFree;     // 空闲总量(需探测)
+    uint8_t  HeapFragmentation; // 碎片率(%)(需探测)
+    bool     StackGuardOK;      // 栈金丝雀完好
+    MemStat_Heap_TypeDef Heap;  // 分配统计
+} MemDiag_Info_TypeDef;
+
+#if MEM_DIAG_ENABLE
+void     MemDiag_Init(void);
+bool     MemDiag_Check(void);
+void     MemDiag_GetInfo(MemDiag_Info_TypeDef* Info, bool Probe);
+void     MemDiag_Report(void);
+void     MemDiag_Paint(void* Base, uint32_t Size);
+uint32_t MemDiag_GetStackPeak(const void* Base, uint32_t Size);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MEM_DIAG_H */
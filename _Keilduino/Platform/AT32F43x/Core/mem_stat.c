@@ -0,0 +1,226 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "mem_stat.h"
+#include <string.h>
+
+#define MEM_STAT_MAGIC          0x4D454D21UL
+#define MEM_STAT_CANARY         0xA5C3E1F0UL
+
+/*头部：用户大小 + (大小 ^ 魔数)，释放时两者不匹配说明头被改写或重复释放*/
+typedef struct
+{
+    uint32_t Size;
+    uint32_t Check;
+} MemStat_Header_TypeDef;
+
+static MemStat_Header_TypeDef* MemStat_GetHeader(const void* Ptr)
+{
+    return (MemStat_Header_TypeDef*)((uint8_t*)Ptr - MEM_STAT_HEADER_SIZE);
+}
+
+/**
+  * @brief  堆统计初始化
+  * @param  Heap: 统计
+  * @retval 无
+  */
+void MemStat_HeapInit(MemStat_Heap_TypeDef* Heap)
+{
+    memset(Heap, 0, sizeof(MemStat_Heap_TypeDef));
+}
+
+/**
+  * @brief  计算需要向底层分配的大小
+  * @param  Size: 用户大小
+  * @retval 底层大小，溢出时为0
+  */
+uint32_t MemStat_BlockSize(uint32_t Size)
+{
+    return (Size > 0xFFFFFFFFUL - MEM_STAT_OVERHEAD) ? 0 : Size + MEM_STAT_OVERHEAD;
+}
+
+/**
+  * @brief  在底层分配的内存上建立块并计入统计
+  * @param  Heap: 统计
+  * @param  Raw: 底层分配的内存，大小为 MemStat_BlockSize(Size)，8字节对齐
+  * @param  Size: 用户大小
+  * @retval 用户指针
+  */
+void* MemStat_BlockInit(MemStat_Heap_TypeDef* Heap, void* Raw, uint32_t Size)
+{
+    MemStat_Header_TypeDef* header = (MemStat_Header_TypeDef*)Raw;
+    uint8_t* ptr = (uint8_t*)Raw + MEM_STAT_HEADER_SIZE;
+    uint32_t canary = MEM_STAT_CANARY;
+
+    header->Size = Size;
+    header->Check = Size ^ MEM_STAT_MAGIC;
+    memcpy(ptr + Size, &canary, sizeof(canary));
+
+    Heap->AllocCount++;
+    Heap->LiveBlocks++;
+    Heap->LiveBytes += Size;
+    if(Heap->LiveBlocks > Heap->PeakBlocks)
+    {
+        Heap->PeakBlocks = Heap->LiveBlocks;
+    }
+    if(Heap->LiveBytes > Heap->PeakBytes)
+    {
+        Heap->PeakBytes = Heap->LiveBytes;
+    }
+    if(Size > Heap->LargestAlloc)
+    {
+        Heap->LargestAlloc = Size;
+    }
+
+    return ptr;
+}
+
+/**
+  * @brief  检查块的头和金丝雀
+  * @param  Ptr: 用户指针
+  * @retval true: 完好
+  */
+bool MemStat_BlockCheck(const void* Ptr)
+{
+    const MemStat_Header_TypeDef* header = MemStat_GetHeader(Ptr);
+    uint32_t canary;
+
+    if((header->Size ^ MEM_STAT_MAGIC) != header->Check)
+    {
+        return false;
+    }
+
+    memcpy(&canary, (const uint8_t*)Ptr + header->Size, sizeof(canary));
+    return canary == MEM_STAT_CANARY;
+}
+
+/**
+  * @brief  获取块的用户大小
+  * @param  Ptr: 用户指针
+  * @retval 用户大小
+  */
+uint32_t MemStat_BlockGetSize(const void* Ptr)
+{
+    return MemStat_GetHeader(Ptr)->Size;
+}
+
+/**
+  * @brief  释放块并计入统计
+  * @param  Heap: 统计
+  * @param  Ptr: 用户指针
+  * @retval 交还底层的内存，头已损坏时为NULL(不交还，避免破坏底层堆)
+  */
+void* MemStat_BlockRelease(MemStat_Heap_TypeDef* Heap, void* Ptr)
+{
+    MemStat_Header_TypeDef* header = MemStat_GetHeader(Ptr);
+    uint32_t size = header->Size;
+
+    if((size ^ MEM_STAT_MAGIC) != header->Check)
+    {
+        Heap->CorruptCount++;
+        return NULL;
+    }
+
+    if(!MemStat_BlockCheck(Ptr))
+    {
+        Heap->CorruptCount++;
+    }
+
+    /*清除校验字，重复释放可被发现*/
+    header->Check = 0;
+
+    Heap->FreeCount++;
+    Heap->LiveBlocks--;
+    Heap->LiveBytes -= size;
+    return header;
+}
+
+/**
+  * @brief  记录一次分配失败
+  * @param  Heap: 统计
+  * @retval 无
+  */
+void MemStat_OnFail(MemStat_Heap_TypeDef* Heap)
+{
+    Heap->FailCount++;
+}
+
+/**
+  * @brief  用填充字填充内存
+  * @param  Begin: 起始地址
+  * @param  End: 结束地址(不含)
+  * @retval 无
+  */
+void MemStat_Paint(uint32_t* Begin, uint32_t* End)
+{
+    while(Begin < End)
+    {
+        *Begin++ = MEM_STAT_PAINT;
+    }
+}
+
+/**
+  * @brief  从低地址向上统计未被改写的字节数(向下生长的栈)
+  * @param  Begin: 起始地址
+  * @param  End: 结束地址(不含)
+  * @retval 字节数
+  */
+uint32_t MemStat_UnusedFromBottom(const uint32_t* Begin, const uint32_t* End)
+{
+    const uint32_t* p = Begin;
+    while(p < End && *p == MEM_STAT_PAINT)
+    {
+        p++;
+    }
+    return (uint32_t)(p - Begin) * sizeof(uint32_t);
+}
+
+/**
+  * @brief  从高地址向下统计未被改写的字节数(从低地址开始分配的堆)
+  * @param  Begin: 起始地址
+  * @param  End: 结束地址(不含)
+  * @retval 字节数
+  */
+uint32_t MemStat_UnusedFromTop(const uint32_t* Begin, const uint32_t* End)
+{
+    const uint32_t* p = End;
+    while(p > Begin && *(p - 1) == MEM_STAT_PAINT)
+    {
+        p--;
+    }
+    return (uint32_t)(End - p) * sizeof(uint32_t);
+}
+
+/**
+  * @brief  计算碎片率
+  * @param  LargestFree: 最大空闲块
+  * @param  TotalFree: 空闲总量
+  * @retval 碎片率(%)，0表示空闲内存连续
+  */
+uint8_t MemStat_Fragmentation(uint32_t LargestFree, uint32_t TotalFree)
+{
+    if(TotalFree == 0 || LargestFree >= TotalFree)
+    {
+        return 0;
+    }
+    return (uint8_t)(100 - (uint32_t)((uint64_t)LargestFree * 100 / TotalFree));
+}
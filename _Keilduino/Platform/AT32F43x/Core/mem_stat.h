@@ -0,0 +1,76 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __MEM_STAT_H
+#define __MEM_STAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 内存统计：
+ * 每个分配块前加8字节头(大小、校验字)，块尾加4字节金丝雀，释放时检查越界写；
+ * 统计分配/释放/失败次数、当前和峰值用量。
+ * 另提供内存填充/扫描函数，用于栈和堆的高水位测量。
+ * 本文件不访问寄存器，可在PC上编译验证；调用者负责与中断互斥。
+ */
+#define MEM_STAT_PAINT          0xCDCDCDCDUL
+#define MEM_STAT_HEADER_SIZE    8
+#define MEM_STAT_TRAILER_SIZE   4
+#define MEM_STAT_OVERHEAD       (MEM_STAT_HEADER_SIZE + MEM_STAT_TRAILER_SIZE)
+
+typedef struct
+{
+    uint32_t AllocCount;    // 成功分配次数
+    uint32_t FreeCount;     // 释放次数
+    uint32_t FailCount;     // 分配失败次数
+    uint32_t CorruptCount;  // 释放时发现头或金丝雀被破坏的次数
+    uint32_t LiveBlocks;    // 当前块数
+    uint32_t LiveBytes;     // 当前用户字节数
+    uint32_t PeakBlocks;    // 峰值块数
+    uint32_t PeakBytes;     // 峰值用户字节数
+    uint32_t LargestAlloc;  // 单次最大分配
+} MemStat_Heap_TypeDef;
+
+void     MemStat_HeapInit(MemStat_Heap_TypeDef* Heap);
+uint32_t MemStat_BlockSize(uint32_t Size);
+void*    MemStat_BlockInit(MemStat_Heap_TypeDef* Heap, void* Raw, uint32_t Size);
+bool     MemStat_BlockCheck(const void* Ptr);
+uint32_t MemStat_BlockGetSize(const void* Ptr);
+void*    MemStat_BlockRelease(MemStat_Heap_TypeDef* Heap, void* Ptr);
+void     MemStat_OnFail(MemStat_Heap_TypeDef* Heap);
+
+void     MemStat_Paint(uint32_t* Begin, uint32_t* End);
+uint32_t MemStat_UnusedFromBottom(const uint32_t* Begin, const uint32_t* End);
+uint32_t MemStat_UnusedFromTop(const uint32_t* Begin, const uint32_t* End);
+uint8_t  MemStat_Fragmentation(uint32_t LargestFree, uint32_t TotalFree);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MEM_STAT_H */
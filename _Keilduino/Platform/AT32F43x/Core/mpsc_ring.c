@@ -0,0 +1,241 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "mpsc_ring.h"
+#include <stddef.h>
+#include <string.h>
+
+/*编译器屏障：单元数据的读写不能越过序号的读写(单核无需DMB)*/
+#if defined(__CC_ARM)
+#  define MPSC_RING_BARRIER()   __schedule_barrier()
+#elif defined(__GNUC__)
+#  define MPSC_RING_BARRIER()   __asm volatile("" ::: "memory")
+#else
+#  define MPSC_RING_BARRIER()
+#endif
+
+#define MPSC_RING_SEQ(Ring, Pos) \
+    ((volatile uint32_t*)((Ring)->Cells + ((Pos) & (Ring)->Mask) * (Ring)->CellSize))
+
+#define MPSC_RING_ITEM(Ring, Pos) \
+    ((Ring)->Cells + ((Pos) & (Ring)->Mask) * (Ring)->CellSize + (Ring)->ItemOffset)
+
+/**
+  * @brief  比较并交换
+  * @param  Ptr: 目标地址
+  * @param  Expected: 期望值
+  * @param  Desired: 新值
+  * @retval true: 交换成功
+  */
+static bool MPSC_RingCAS(volatile uint32_t* Ptr, uint32_t Expected, uint32_t Desired)
+{
+#if defined(__CC_ARM)
+    if(__ldrex(Ptr) != Expected)
+    {
+        __clrex();
+        return false;
+    }
+    return __strex(Desired, Ptr) == 0;
+#elif defined(__GNUC__)
+    return __sync_bool_compare_and_swap(Ptr, Expected, Desired);
+#else
+#  error "MPSC_RingCAS: unsupported compiler"
+#endif
+}
+
+/**
+  * @brief  队列初始化，通常使用 MPSC_RING_INIT
+  * @param  Ring: 队列
+  * @param  Cells: 存储单元数组
+  * @param  CellSize: 单元大小(字节)
+  * @param  ItemOffset: 数据在单元中的偏移
+  * @param  ItemSize: 数据大小(字节)
+  * @param  Size: 单元个数，必须为2的幂
+  * @retval true: 成功
+  */
+bool MPSC_RingInit(
+    MPSC_Ring_TypeDef* Ring,
+    void* Cells,
+    uint32_t CellSize,
+    uint32_t ItemOffset,
+    uint32_t ItemSize,
+    uint32_t Size
+)
+{
+    uint32_t i;
+
+    if(Cells == NULL || Size < 2 || (Size & (Size - 1)) != 0
+            || ItemOffset < sizeof(uint32_t) || ItemOffset + ItemSize > CellSize)
+    {
+        return false;
+    }
+
+    Ring->Cells = (uint8_t*)Cells;
+    Ring->CellSize = CellSize;
+    Ring->ItemOffset = ItemOffset;
+    Ring->ItemSize = ItemSize;
+    Ring->Mask = Size - 1;
+    Ring->Tail = 0;
+    Ring->Head = 0;
+    Ring->Dropped = 0;
+    Ring->HighWater = 0;
+
+    for(i = 0; i < Size; i++)
+    {
+        *MPSC_RING_SEQ(Ring, i) = i;
+    }
+
+    return true;
+}
+
+/**
+  * @brief  写入数据，可在任意优先级的中断中调用
+  * @param  Ring: 队列
+  * @param  Item: 数据
+  * @retval true: 成功，false: 队列已满，数据被丢弃
+  */
+bool MPSC_RingPush(MPSC_Ring_TypeDef* Ring, const void* Item)
+{
+    volatile uint32_t* seq;
+    uint32_t pos;
+    uint32_t count;
+    uint32_t high;
+
+    for(;;)
+    {
+        pos = Ring->Tail;
+        seq = MPSC_RING_SEQ(Ring, pos);
+
+        /*序号等于写入位置表示空闲，小于表示还未被读取(队列满)*/
+        if(*seq == pos)
+        {
+            if(MPSC_RingCAS(&Ring->Tail, pos, pos + 1))
+            {
+                break;
+            }
+        }
+        else if((int32_t)(*seq - pos) < 0)
+        {
+            uint32_t dropped;
+            do
+            {
+                dropped = Ring->Dropped;
+            }
+            while(!MPSC_RingCAS(&Ring->Dropped, dropped, dropped + 1));
+            return false;
+        }
+    }
+
+    memcpy(MPSC_RING_ITEM(Ring, pos), Item, Ring->ItemSize);
+
+    /*写完数据再提交序号，读取者才能看到*/
+    MPSC_RING_BARRIER();
+    *seq = pos + 1;
+
+    /*记录最大深度，包括本次写入*/
+    count = pos + 1 - Ring->Head;
+    do
+    {
+        high = Ring->HighWater;
+        if(count <= high || count > Ring->Mask + 1)
+        {
+            break;
+        }
+    }
+    while(!MPSC_RingCAS(&Ring->HighWater, high, count));
+
+    return true;
+}
+
+/**
+  * @brief  读取数据，只能在一个上下文中调用
+  * @param  Ring: 队列
+  * @param  Item: 输出数据
+  * @retval true: 读到数据，false: 队列为空或最早的数据还在写入
+  */
+bool MPSC_RingPop(MPSC_Ring_TypeDef* Ring, void* Item)
+{
+    uint32_t pos = Ring->Head;
+    volatile uint32_t* seq = MPSC_RING_SEQ(Ring, pos);
+
+    if(*seq != pos + 1)
+    {
+        return false;
+    }
+    MPSC_RING_BARRIER();
+
+    memcpy(Item, MPSC_RING_ITEM(Ring, pos), Ring->ItemSize);
+
+    MPSC_RING_BARRIER();
+    /*释放单元，下一圈的写入位置为 pos + Size*/
+    *seq = pos + Ring->Mask + 1;
+    Ring->Head = pos + 1;
+    return true;
+}
+
+/**
+  * @brief  获取队列中的数据数(包括正在写入的)
+  * @param  Ring: 队列
+  * @retval 数据数
+  */
+uint32_t MPSC_RingGetCount(const MPSC_Ring_TypeDef* Ring)
+{
+    return Ring->Tail - Ring->Head;
+}
+
+/**
+  * @brief  获取丢弃的数据数
+  * @param  Ring: 队列
+  * @param  Clear: 读取后清零
+  * @retval 丢弃的数据数
+  */
+uint32_t MPSC_RingGetDropped(MPSC_Ring_TypeDef* Ring, bool Clear)
+{
+    uint32_t dropped;
+
+    do
+    {
+        dropped = Ring->Dropped;
+    }
+    while(Clear && !MPSC_RingCAS(&Ring->Dropped, dropped, 0));
+
+    return dropped;
+}
+
+/**
+  * @brief  获取队列深度的最大值
+  * @param  Ring: 队列
+  * @param  Clear: 读取后清零
+  * @retval 最大数据数
+  */
+uint32_t MPSC_RingGetHighWater(MPSC_Ring_TypeDef* Ring, bool Clear)
+{
+    uint32_t high;
+
+    do
+    {
+        high = Ring->HighWater;
+    }
+    while(Clear && !MPSC_RingCAS(&Ring->HighWater, high, 0));
+
+    return high;
+}
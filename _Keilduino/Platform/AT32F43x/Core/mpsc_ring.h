@@ -0,0 +1,81 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __MPSC_RING_H
+#define __MPSC_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 多生产者单消费者环形队列：有界，每个单元带序号，
+ * 多个中断(可相互嵌套)通过比较交换写入，单一上下文读取，不需要关中断。
+ * 单元类型由使用者定义，第一个成员必须为 volatile uint32_t Seq，数据成员名为 Item，
+ * 用 MPSC_RING_INIT 初始化。
+ * 本文件不访问寄存器，可在PC上编译验证。
+ */
+typedef struct
+{
+    uint8_t* Cells;
+    uint32_t CellSize;              // 单元大小(字节)
+    uint32_t ItemOffset;            // 数据在单元中的偏移
+    uint32_t ItemSize;              // 数据大小(字节)
+    uint32_t Mask;
+    volatile uint32_t Tail;         // 写入位置，多个中断共享
+    volatile uint32_t Head;         // 读取位置，只由读取者修改
+    volatile uint32_t Dropped;      // 队列满时丢弃的数据数
+    volatile uint32_t HighWater;    // 队列中数据数的最大值
+} MPSC_Ring_TypeDef;
+
+#define MPSC_RING_INIT(Ring, Cells, Size) \
+    MPSC_RingInit( \
+        (Ring), \
+        (Cells), \
+        sizeof((Cells)[0]), \
+        (uint32_t)((uint8_t*)&(Cells)[0].Item - (uint8_t*)&(Cells)[0]), \
+        sizeof((Cells)[0].Item), \
+        (Size) \
+    )
+
+bool     MPSC_RingInit(
+    MPSC_Ring_TypeDef* Ring,
+    void* Cells,
+    uint32_t CellSize,
+    uint32_t ItemOffset,
+    uint32_t ItemSize,
+    uint32_t Size
+);
+bool     MPSC_RingPush(MPSC_Ring_TypeDef* Ring, const void* Item);
+bool     MPSC_RingPop(MPSC_Ring_TypeDef* Ring, void* Item);
+uint32_t MPSC_RingGetCount(const MPSC_Ring_TypeDef* Ring);
+uint32_t MPSC_RingGetDropped(MPSC_Ring_TypeDef* Ring, bool Clear);
+uint32_t MPSC_RingGetHighWater(MPSC_Ring_TypeDef* Ring, bool Clear);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MPSC_RING_H */
@@ -0,0 +1,137 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "prof.h"
+
+#if PROF_ENABLE
+
+#define PROF_CALIBRATE_TIMES        8
+
+static ProfProbe_List_TypeDef Prof_List = { NULL, NULL, 0 };
+
+static uint32_t Prof_Lock(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+static void Prof_Unlock(uint32_t primask)
+{
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  测量探针自身开销(PROF_BEGIN/PROF_END之间没有代码时的周期数)
+  * @param  无
+  * @retval 无
+  */
+void Prof_Init(void)
+{
+    uint32_t overhead = UINT32_MAX;
+    uint8_t i;
+
+    Prof_List.Overhead = 0;
+
+    for(i = 0; i < PROF_CALIBRATE_TIMES; i++)
+    {
+        uint32_t start = PROF_CYCLE_CNT();
+        uint32_t cycles = Prof_Elapsed(start);
+
+        if(cycles < overhead)
+        {
+            overhead = cycles;
+        }
+    }
+
+    Prof_List.Overhead = overhead;
+}
+
+/**
+  * @brief  计算从Start开始经过的周期数，扣除探针开销
+  * @param  Start: PROF_CYCLE_CNT()的值
+  * @retval 周期数
+  */
+uint32_t Prof_Elapsed(uint32_t Start)
+{
+    return ProfProbe_Elapsed(&Prof_List, Start, PROF_CYCLE_CNT());
+}
+
+/**
+  * @brief  记录一个样本，可在中断中调用
+  * @param  Probe: 探针
+  * @param  Cycles: 周期数
+  * @retval 无
+  */
+void Prof_Record(Prof_Probe_TypeDef* Probe, uint32_t Cycles)
+{
+    uint32_t primask = Prof_Lock();
+    ProfProbe_Record(&Prof_List, Probe, Cycles);
+    Prof_Unlock(primask);
+}
+
+/**
+  * @brief  读取探针统计的一致副本
+  * @param  Probe: 探针
+  * @param  Stat: 输出
+  * @retval 无
+  */
+void Prof_GetStat(const Prof_Probe_TypeDef* Probe, ProfStat_TypeDef* Stat)
+{
+    uint32_t primask = Prof_Lock();
+    *Stat = Probe->Stat;
+    Prof_Unlock(primask);
+}
+
+/**
+  * @brief  清除统计
+  * @param  Probe: 探针，NULL为全部已记录的探针
+  * @retval 无
+  */
+void Prof_Reset(Prof_Probe_TypeDef* Probe)
+{
+    uint32_t primask = Prof_Lock();
+    ProfProbe_Reset(&Prof_List, Probe);
+    Prof_Unlock(primask);
+}
+
+/**
+  * @brief  遍历已记录的探针
+  * @param  Probe: 当前探针，NULL为获取第一个
+  * @retval 下一个探针，NULL为结束
+  */
+Prof_Probe_TypeDef* Prof_GetNext(const Prof_Probe_TypeDef* Probe)
+{
+    return ProfProbe_GetNext(&Prof_List, Probe);
+}
+
+/**
+  * @brief  获取扣除的探针开销
+  * @param  无
+  * @retval 周期数
+  */
+uint32_t Prof_GetOverhead(void)
+{
+    return Prof_List.Overhead;
+}
+
+#endif /* PROF_ENABLE */
@@ -0,0 +1,91 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __PROF_H
+#define __PROF_H
+
+#include "mcu_type.h"
+#include "prof_probe.h"
+
+/*
+ * 性能探针：
+ *   PROF_PROBE_DEF(uart_rx);          // 定义探针(文件作用域)
+ *   PROF_BEGIN(uart_rx);              // 代码段开始
+ *   ...
+ *   PROF_END(uart_rx);                // 记录本次执行周期数(已扣除探针自身开销)
+ * 每个探针统计最小/最大/平均值和按2的幂分桶的直方图，首次记录时加入探针列表，
+ * Prof_Report() 输出到任意Print。可在中断中使用，记录时短暂关中断。
+ * PROF_ENABLE为0时宏展开为空，不占用代码和RAM。
+ * 周期计数默认读取DWT；统计和探针列表在 prof_stat.c/prof_probe.c，不访问寄存器，
+ * 可在PC上用模拟计数器编译验证，本文件只负责读取计数器和关中断。
+ */
+#ifndef PROF_CYCLE_CNT
+#  include "dwt.h"
+#  define PROF_CYCLE_CNT()                  DWT_CYCLE_CNT
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if PROF_ENABLE
+
+#define PROF_PROBE_DEF(name)                Prof_Probe_TypeDef name = PROF_PROBE_INIT(name)
+#define PROF_PROBE_EXTERN(name)             extern Prof_Probe_TypeDef name
+#define PROF_BEGIN(name)                    uint32_t _prof_start_##name = PROF_CYCLE_CNT()
+#define PROF_END(name)                      Prof_Record(&name, Prof_Elapsed(_prof_start_##name))
+
+void     Prof_Init(void);
+uint32_t Prof_Elapsed(uint32_t Start);
+void     Prof_Record(Prof_Probe_TypeDef* Probe, uint32_t Cycles);
+void     Prof_GetStat(const Prof_Probe_TypeDef* Probe, ProfStat_TypeDef* Stat);
+void     Prof_Reset(Prof_Probe_TypeDef* Probe);
+Prof_Probe_TypeDef* Prof_GetNext(const Prof_Probe_TypeDef* Probe);
+uint32_t Prof_GetOverhead(void);
+
+bool     Prof_LatencyStart(
+    Prof_Probe_TypeDef* Probe,
+    tmr_type* TIMx, uint32_t Freq,
+    uint8_t PreemptionPriority, uint8_t SubPriority
+);
+void     Prof_LatencyStop(void);
+
+#else
+
+#define PROF_PROBE_DEF(name)                extern Prof_Probe_TypeDef name
+#define PROF_PROBE_EXTERN(name)             extern Prof_Probe_TypeDef name
+#define PROF_BEGIN(name)                    do{}while(0)
+#define PROF_END(name)                      do{}while(0)
+
+#endif
+
+#ifdef __cplusplus
+}
+
+#if PROF_ENABLE
+class Print;
+void Prof_Report(Print* p, bool Histogram = false);
+#endif
+
+#endif
+
+#endif /* __PROF_H */
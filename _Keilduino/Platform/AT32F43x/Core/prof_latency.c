@@ -0,0 +1,117 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "prof.h"
+#include "timer.h"
+
+#if PROF_ENABLE
+
+/*
+ * 中断响应延迟采样：
+ * 定时器按指定频率产生更新中断，回调中读取计数值，即从更新事件到回调执行经过的时间，
+ * 换算为CPU周期记录到探针。结果包含中断分发的固定开销(以最小值为基线)，
+ * 最大值和直方图尾部反映同级或更高优先级中断、关中断区间造成的延迟。
+ */
+
+static Prof_Probe_TypeDef* Prof_LatencyProbe = NULL;
+static tmr_type* Prof_LatencyTIM = NULL;
+static uint32_t Prof_LatencyScale = 0; // 每个计数值对应的CPU周期数(Q16)
+
+static void Prof_LatencyCallback(void)
+{
+    tmr_type* TIMx = Prof_LatencyTIM;
+    uint32_t count;
+
+    if(!TIMx)
+    {
+        return;
+    }
+
+    count = TIMx->cval;
+    Prof_Record(Prof_LatencyProbe, (uint32_t)(((uint64_t)count * Prof_LatencyScale) >> 16));
+}
+
+/**
+  * @brief  开始中断响应延迟采样
+  * @param  Probe: 记录结果的探针
+  * @param  TIMx: 采样使用的定时器(独占)
+  * @param  Freq: 采样频率(Hz)
+  * @param  PreemptionPriority: 抢占优先级，即被测的中断优先级
+  * @param  SubPriority: 子优先级
+  * @retval true: 成功
+  */
+bool Prof_LatencyStart(
+    Prof_Probe_TypeDef* Probe,
+    tmr_type* TIMx, uint32_t Freq,
+    uint8_t PreemptionPriority, uint8_t SubPriority
+)
+{
+    uint32_t clock = Timer_GetClockMax(TIMx);
+    uint32_t ticks, prescaler;
+
+    if(!Probe || Freq == 0 || Freq > clock / 2)
+    {
+        return false;
+    }
+
+    /*最小分频，保证计数分辨率*/
+    ticks = clock / Freq;
+    prescaler = ticks / 65536U + 1;
+
+    if(prescaler > 0xFFFFU)
+    {
+        return false;
+    }
+
+    Prof_LatencyStop();
+
+    Prof_LatencyProbe = Probe;
+    Prof_LatencyTIM = TIMx;
+    Prof_LatencyScale = (uint32_t)((((uint64_t)prescaler * F_CPU) << 16) / clock);
+
+    Timer_SetInterruptBase(
+        TIMx,
+        (uint16_t)(ticks / prescaler),
+        (uint16_t)prescaler,
+        Prof_LatencyCallback,
+        PreemptionPriority,
+        SubPriority
+    );
+    Timer_SetEnable(TIMx, true);
+    return true;
+}
+
+/**
+  * @brief  停止中断响应延迟采样
+  * @param  无
+  * @retval 无
+  */
+void Prof_LatencyStop(void)
+{
+    if(Prof_LatencyTIM)
+    {
+        Timer_SetEnable(Prof_LatencyTIM, false);
+        Prof_LatencyTIM = NULL;
+    }
+}
+
+#endif /* PROF_ENABLE */
@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "prof.h"
+#include "Print.h"
+
+#if PROF_ENABLE
+
+/**
+  * @brief  输出所有已记录探针的统计
+  * @param  p: 输出对象(如Serial)
+  * @param  Histogram: 同时输出直方图
+  * @retval 无
+  */
+void Prof_Report(Print* p, bool Histogram)
+{
+    const uint32_t cyclesPerUs = CYCLES_PER_MICROSECOND;
+    Prof_Probe_TypeDef* probe;
+
+    p->printf("PROF overhead=%u cyc\r\n", (unsigned)Prof_GetOverhead());
+
+    for(probe = Prof_GetNext(NULL); probe; probe = Prof_GetNext(probe))
+    {
+        ProfStat_TypeDef stat;
+        uint32_t mean;
+        Prof_GetStat(probe, &stat);
+        mean = ProfStat_GetMean(&stat);
+
+        p->printf(
+            "%s n=%u min=%u mean=%u p99=%u max=%u cyc (mean=%u.%03uus max=%u.%03uus)\r\n",
+            probe->Name,
+            (unsigned)stat.Count,
+            (unsigned)stat.Min,
+            (unsigned)mean,
+            (unsigned)ProfStat_GetPercentile(&stat, 99),
+            (unsigned)stat.Max,
+            (unsigned)(mean / cyclesPerUs), (unsigned)(mean % cyclesPerUs * 1000U / cyclesPerUs),
+            (unsigned)(stat.Max / cyclesPerUs), (unsigned)(stat.Max % cyclesPerUs * 1000U / cyclesPerUs)
+        );
+
+        if(!Histogram)
+        {
+            continue;
+        }
+
+        for(uint8_t i = 0; i < PROF_STAT_BUCKETS; i++)
+        {
+            if(stat.Hist[i] == 0)
+            {
+                continue;
+            }
+
+            if(i == PROF_STAT_BUCKETS - 1)
+            {
+                p->printf("  [%u, ~) %u\r\n", (unsigned)ProfStat_BucketLow(i), (unsigned)stat.Hist[i]);
+            }
+            else
+            {
+                p->printf(
+                    "  [%u, %u) %u\r\n",
+                    (unsigned)ProfStat_BucketLow(i),
+                    (unsigned)ProfStat_BucketLow(i + 1),
+                    (unsigned)stat.Hist[i]
+                );
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "prof_probe.h"
+
+/**
+  * @brief  探针列表初始化
+  * @param  List: 探针列表
+  * @retval 无
+  */
+void ProfProbe_ListInit(ProfProbe_List_TypeDef* List)
+{
+    List->Head = NULL;
+    List->Tail = NULL;
+    List->Overhead = 0;
+}
+
+/**
+  * @brief  计算Start到Now经过的周期数，扣除探针开销
+  * @param  List: 探针列表
+  * @param  Start: 开始时的计数值
+  * @param  Now: 结束时的计数值
+  * @retval 周期数，小于开销时为0
+  */
+uint32_t ProfProbe_Elapsed(const ProfProbe_List_TypeDef* List, uint32_t Start, uint32_t Now)
+{
+    uint32_t cycles = Now - Start;
+    return cycles > List->Overhead ? cycles - List->Overhead : 0;
+}
+
+/**
+  * @brief  记录一个样本，首次记录时把探针加入列表
+  * @param  List: 探针列表
+  * @param  Probe: 探针
+  * @param  Cycles: 周期数
+  * @retval 无
+  */
+void ProfProbe_Record(ProfProbe_List_TypeDef* List, Prof_Probe_TypeDef* Probe, uint32_t Cycles)
+{
+    if(!Probe->Registered)
+    {
+        Probe->Next = NULL;
+        Probe->Registered = true;
+
+        if(List->Tail)
+        {
+            List->Tail->Next = Probe;
+        }
+        else
+        {
+            List->Head = Probe;
+        }
+        List->Tail = Probe;
+    }
+
+    ProfStat_Add(&Probe->Stat, Cycles);
+}
+
+/**
+  * @brief  清除统计
+  * @param  List: 探针列表
+  * @param  Probe: 探针，NULL为列表中全部探针
+  * @retval 无
+  */
+void ProfProbe_Reset(ProfProbe_List_TypeDef* List, Prof_Probe_TypeDef* Probe)
+{
+    if(Probe)
+    {
+        ProfStat_Reset(&Probe->Stat);
+        return;
+    }
+
+    for(Probe = List->Head; Probe; Probe = Probe->Next)
+    {
+        ProfStat_Reset(&Probe->Stat);
+    }
+}
+
+/**
+  * @brief  遍历列表中的探针
+  * @param  List: 探针列表
+  * @param  Probe: 当前探针，NULL为获取第一个
+  * @retval 下一个探针，NULL为结束
+  */
+Prof_Probe_TypeDef* ProfProbe_GetNext(const ProfProbe_List_TypeDef* List, const Prof_Probe_TypeDef* Probe)
+{
+    return Probe ? Probe->Next : List->Head;
+}
@@ -0,0 +1,67 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __PROF_PROBE_H
+#define __PROF_PROBE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "prof_stat.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 探针和探针列表：探针首次记录时加入列表尾部，样本扣除探针开销后计入统计。
+ * 周期计数由调用者读取(prof.c读取DWT，PC上可用模拟计数器)，计数回绕按无符号差计算。
+ * 本文件不访问寄存器，可在PC上编译验证；调用者负责与中断互斥。
+ */
+typedef struct Prof_Probe
+{
+    const char* Name;           // 名称
+    struct Prof_Probe* Next;    // 探针列表(private)
+    bool Registered;            // 已加入列表(private)
+    ProfStat_TypeDef Stat;      // 统计
+} Prof_Probe_TypeDef;
+
+typedef struct
+{
+    Prof_Probe_TypeDef* Head;
+    Prof_Probe_TypeDef* Tail;
+    uint32_t Overhead;          // 探针自身开销(周期数)
+} ProfProbe_List_TypeDef;
+
+#define PROF_PROBE_INIT(name)   { #name, NULL, false, {0} }
+
+void     ProfProbe_ListInit(ProfProbe_List_TypeDef* List);
+uint32_t ProfProbe_Elapsed(const ProfProbe_List_TypeDef* List, uint32_t Start, uint32_t Now);
+void     ProfProbe_Record(ProfProbe_List_TypeDef* List, Prof_Probe_TypeDef* Probe, uint32_t Cycles);
+void     ProfProbe_Reset(ProfProbe_List_TypeDef* List, Prof_Probe_TypeDef* Probe);
+Prof_Probe_TypeDef* ProfProbe_GetNext(const ProfProbe_List_TypeDef* List, const Prof_Probe_TypeDef* Probe);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PROF_PROBE_H */
@@ -0,0 +1,135 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "prof_stat.h"
+#include <string.h>
+
+#if defined(__CC_ARM)
+#  define PROF_STAT_CLZ(x)      __clz(x)
+#elif defined(__GNUC__)
+#  define PROF_STAT_CLZ(x)      ((x) ? (uint32_t)__builtin_clz(x) : 32U)
+#endif
+
+/**
+  * @brief  清除统计
+  * @param  Stat: 统计
+  * @retval 无
+  */
+void ProfStat_Reset(ProfStat_TypeDef* Stat)
+{
+    memset(Stat, 0, sizeof(ProfStat_TypeDef));
+}
+
+/**
+  * @brief  计算周期数所在的桶
+  * @param  Cycles: 周期数
+  * @retval 桶序号
+  */
+uint8_t ProfStat_Bucket(uint32_t Cycles)
+{
+    uint32_t bucket = 32U - PROF_STAT_CLZ(Cycles);
+    return (uint8_t)(bucket < PROF_STAT_BUCKETS ? bucket : PROF_STAT_BUCKETS - 1);
+}
+
+/**
+  * @brief  获取桶的下限
+  * @param  Bucket: 桶序号
+  * @retval 周期数
+  */
+uint32_t ProfStat_BucketLow(uint8_t Bucket)
+{
+    return Bucket ? (1UL << (Bucket - 1)) : 0;
+}
+
+/**
+  * @brief  添加一个样本
+  * @param  Stat: 统计
+  * @param  Cycles: 周期数
+  * @retval 无
+  */
+void ProfStat_Add(ProfStat_TypeDef* Stat, uint32_t Cycles)
+{
+    if(Stat->Count == 0 || Cycles < Stat->Min)
+    {
+        Stat->Min = Cycles;
+    }
+
+    if(Cycles > Stat->Max)
+    {
+        Stat->Max = Cycles;
+    }
+
+    /*计数饱和，不回绕*/
+    if(Stat->Count != UINT32_MAX)
+    {
+        Stat->Count++;
+        Stat->Sum += Cycles;
+        Stat->Hist[ProfStat_Bucket(Cycles)]++;
+    }
+}
+
+/**
+  * @brief  获取平均值
+  * @param  Stat: 统计
+  * @retval 周期数
+  */
+uint32_t ProfStat_GetMean(const ProfStat_TypeDef* Stat)
+{
+    return Stat->Count ? (uint32_t)((Stat->Sum + Stat->Count / 2) / Stat->Count) : 0;
+}
+
+/**
+  * @brief  由直方图估计百分位数
+  * @param  Stat: 统计
+  * @param  Percent: 百分比(1~100)
+  * @retval 不小于该百分位数的桶上限，不超过最大值
+  */
+uint32_t ProfStat_GetPercentile(const ProfStat_TypeDef* Stat, uint8_t Percent)
+{
+    uint32_t target;
+    uint32_t sum = 0;
+    uint8_t i;
+
+    if(Stat->Count == 0)
+    {
+        return 0;
+    }
+
+    if(Percent > 100)
+    {
+        Percent = 100;
+    }
+
+    target = (uint32_t)(((uint64_t)Stat->Count * Percent + 99) / 100);
+
+    for(i = 0; i < PROF_STAT_BUCKETS - 1; i++)
+    {
+        sum += Stat->Hist[i];
+        if(sum >= target && sum > 0)
+        {
+            uint32_t high = ProfStat_BucketLow(i + 1) - 1;
+            return high < Stat->Max ? high : Stat->Max;
+        }
+    }
+
+    return Stat->Max;
+}
@@ -0,0 +1,60 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __PROF_STAT_H
+#define __PROF_STAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 周期数统计：次数、最小/最大/平均值和按2的幂分桶的直方图。
+ * 桶k(k>=1)统计 [2^(k-1), 2^k) 个周期，桶0为0周期，最后一个桶包含所有更大的值。
+ * 本文件不访问寄存器，可在PC上编译验证；调用者负责与中断互斥。
+ */
+#define PROF_STAT_BUCKETS       32
+
+typedef struct
+{
+    uint32_t Count;                     // 样本数
+    uint32_t Min;                       // 最小值
+    uint32_t Max;                       // 最大值
+    uint64_t Sum;                       // 总和
+    uint32_t Hist[PROF_STAT_BUCKETS];   // 直方图
+} ProfStat_TypeDef;
+
+void     ProfStat_Reset(ProfStat_TypeDef* Stat);
+void     ProfStat_Add(ProfStat_TypeDef* Stat, uint32_t Cycles);
+uint32_t ProfStat_GetMean(const ProfStat_TypeDef* Stat);
+uint32_t ProfStat_GetPercentile(const ProfStat_TypeDef* Stat, uint8_t Percent);
+uint8_t  ProfStat_Bucket(uint32_t Cycles);
+uint32_t ProfStat_BucketLow(uint8_t Bucket);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PROF_STAT_H */
@@ -22,24 +22,60 @@
  */
 #include "pwm.h"
 #include "timer.h"
+#include "soft_timer.h"
 #include "Arduino.h"
 
 /**
-  * @brief  定时器输出捕获初始化
+  * @brief  定时器通道编号转换为通道选择
+  * @param  TimerChannel: 定时器通道(1~5)
+  * @param  channel_select: 通道选择
+  * @retval true: 通道有效
+  */
+static bool TIMx_GetChannelSelect(uint8_t TimerChannel, tmr_channel_select_type* channel_select)
+{
+    static const tmr_channel_select_type channel_map[] =
+    {
+        TMR_SELECT_CHANNEL_1,
+        TMR_SELECT_CHANNEL_2,
+        TMR_SELECT_CHANNEL_3,
+        TMR_SELECT_CHANNEL_4,
+        TMR_SELECT_CHANNEL_5
+    };
+
+    if(TimerChannel == 0 || TimerChannel > sizeof(channel_map) / sizeof(channel_map[0]))
+    {
+        return false;
+    }
+
+    *channel_select = channel_map[TimerChannel - 1];
+    return true;
+}
+
+/**
+  * @brief  判断是否为高级定时器(带互补输出/刹车)
+  * @param  TIMx: 定时器地址
+  * @retval true: 高级定时器
+  */
+static bool PWM_IsAdvancedTimer(tmr_type* TIMx)
+{
+    return (TIMx == TIM1 || TIMx == TIM8 || TIMx == TIM20);
+}
+
+/**
+  * @brief  定时器输出通道配置
   * @param  TIMx: 定时器地址
-  * @param  arr: 自动重装值
-  * @param  psc: 时钟预分频数
   * @param  TimerChannel: 定时器通道
-  * @retval 无
+  * @retval true: 成功
   */
-static void TIMx_OCxInit(tmr_type* TIMx, uint32_t arr, uint16_t psc, uint8_t TimerChannel)
+static bool TIMx_OCxConfig(tmr_type* TIMx, uint8_t TimerChannel)
 {
     tmr_output_config_type tmr_output_struct;
+    tmr_channel_select_type channel_select;
 
-    Timer_ClockCmd(TIMx, true);
-
-    tmr_base_init(TIMx, arr, psc);
-    tmr_cnt_dir_set(TIMx, TMR_COUNT_UP);
+    if(!TIMx_GetChannelSelect(TimerChannel, &channel_select))
+    {
+        return false;
+    }
 
     tmr_output_default_para_init(&tmr_output_struct);
     tmr_output_struct.oc_mode = TMR_OUTPUT_CONTROL_PWM_MODE_B;
@@ -50,32 +86,39 @@ static void TIMx_OCxInit(tmr_type* TIMx, uint32_t arr, uint16_t psc, uint8_t Tim
     tmr_output_struct.oc_output_state = TRUE;
     tmr_output_struct.occ_output_state = TRUE;
 
-    switch(TimerChannel)
-    {
-    case 1:
-        tmr_output_channel_config(TIMx, TMR_SELECT_CHANNEL_1, &tmr_output_struct);
-        break;
-    case 2:
-        tmr_output_channel_config(TIMx, TMR_SELECT_CHANNEL_2, &tmr_output_struct);
-        break;
-    case 3:
-        tmr_output_channel_config(TIMx, TMR_SELECT_CHANNEL_3, &tmr_output_struct);
-        break;
-    case 4:
-        tmr_output_channel_config(TIMx, TMR_SELECT_CHANNEL_4, &tmr_output_struct);
-        break;
-    case 5:
-        tmr_output_channel_config(TIMx, TMR_SELECT_CHANNEL_5, &tmr_output_struct);
-        break;
-    default:
+    tmr_output_channel_config(TIMx, channel_select, &tmr_output_struct);
+
+    /*比较值和重装值经缓冲在溢出事件时生效，避免在周期中途改变*/
+    tmr_output_channel_buffer_enable(TIMx, channel_select, TRUE);
+    tmr_period_buffer_enable(TIMx, TRUE);
+
+    tmr_output_enable(TIMx, TRUE);
+    return true;
+}
+
+/**
+  * @brief  定时器输出捕获初始化
+  * @param  TIMx: 定时器地址
+  * @param  arr: 自动重装值
+  * @param  psc: 时钟预分频数
+  * @param  TimerChannel: 定时器通道
+  * @retval 无
+  */
+static void TIMx_OCxInit(tmr_type* TIMx, uint32_t arr, uint16_t psc, uint8_t TimerChannel)
+{
+    Timer_ClockCmd(TIMx, true);
+
+    tmr_base_init(TIMx, arr, psc);
+    tmr_cnt_dir_set(TIMx, TMR_COUNT_UP);
+
+    if(!TIMx_OCxConfig(TIMx, TimerChannel))
+    {
         return;
     }
 
-    tmr_output_enable(TIMx, TRUE);
     tmr_counter_enable(TIMx, TRUE);
 }
 
-
 /**
   * @brief  PWM输出初始化
   * @param  Pin:引脚编号
@@ -122,3 +165,655 @@ void PWM_Write(uint8_t Pin, uint32_t Value)
 {
     Timer_SetCompare(PIN_MAP[Pin].TIMx, PIN_MAP[Pin].TimerChannel, Value);
 }
+
+/**
+  * @brief  暂停比较值的装载，之后写入的比较值暂存在缓冲中
+  * @param  TIMx: 定时器地址
+  * @retval 无
+  */
+void PWM_UpdateBegin(tmr_type* TIMx)
+{
+    tmr_overflow_event_disable(TIMx, TRUE);
+}
+
+/**
+  * @brief  恢复比较值的装载，暂存的比较值在下一个溢出事件同时生效
+  * @param  TIMx: 定时器地址
+  * @retval 无
+  */
+void PWM_UpdateEnd(tmr_type* TIMx)
+{
+    tmr_overflow_event_disable(TIMx, FALSE);
+}
+
+/**
+  * @brief  同步写入多个通道，同一定时器上的通道在同一个PWM周期生效
+  * @param  Pins: 引脚编号数组
+  * @param  Values: PWM输出值数组
+  * @param  Count: 数组长度
+  * @retval 无
+  */
+void PWM_WriteMulti(const uint8_t* Pins, const uint32_t* Values, uint8_t Count)
+{
+    uint8_t i, j;
+
+    for(i = 0; i < Count; i++)
+    {
+        if(IS_PWM_PIN(Pins[i]))
+        {
+            PWM_UpdateBegin(PIN_MAP[Pins[i]].TIMx);
+        }
+    }
+
+    for(i = 0; i < Count; i++)
+    {
+        if(IS_PWM_PIN(Pins[i]))
+        {
+            PWM_Write(Pins[i], Values[i]);
+        }
+    }
+
+    for(i = 0; i < Count; i++)
+    {
+        if(!IS_PWM_PIN(Pins[i]))
+        {
+            continue;
+        }
+
+        /*每个定时器只恢复一次*/
+        for(j = 0; j < i; j++)
+        {
+            if(IS_PWM_PIN(Pins[j]) && PIN_MAP[Pins[j]].TIMx == PIN_MAP[Pins[i]].TIMx)
+            {
+                break;
+            }
+        }
+
+        if(j == i)
+        {
+            PWM_UpdateEnd(PIN_MAP[Pins[i]].TIMx);
+        }
+    }
+}
+
+/**
+  * @brief  获取PWM实际频率和分辨率
+  * @param  TIMx: 定时器地址
+  * @param  Info: 输出信息
+  * @retval 无
+  */
+void PWM_GetInfo(tmr_type* TIMx, PWM_Info_TypeDef* Info)
+{
+    uint64_t div = (uint64_t)(TIMx->div + 1) * (TIMx->pr + 1);
+
+    Info->Frequency = (uint32_t)(((uint64_t)Timer_GetClockMax(TIMx) * 1000 + div / 2) / div);
+    Info->Resolution = TIMx->pr + 1;
+}
+
+/**
+  * @brief  高分辨率PWM初始化，按频率自动选择最高分辨率
+  * @param  Pin: 引脚编号
+  * @param  Frequency: PWM频率(mHz)
+  * @param  Info: 输出实际频率和分辨率，可为NULL
+  * @retval PWM通道号，0: 失败
+  */
+uint8_t PWM_InitHR(uint8_t Pin, uint32_t Frequency, PWM_Info_TypeDef* Info)
+{
+    uint32_t period, psc;
+    tmr_type* TIMx;
+
+    if(!IS_PWM_PIN(Pin))
+    {
+        return 0;
+    }
+
+    TIMx = PIN_MAP[Pin].TIMx;
+
+    if(!PWM_CalcPeriod(Timer_GetClockMax(TIMx), Frequency, &period, &psc))
+    {
+        return 0;
+    }
+
+    pinMode(Pin, OUTPUT_AF_PP);
+
+    gpio_pin_mux_config(PIN_MAP[Pin].GPIOx, GPIO_GetPinSource(PIN_MAP[Pin].GPIO_Pin_x), Timer_GetGPIO_MUX(Pin));
+
+    Timer_SetEnable(TIMx, false);
+    TIMx_OCxInit(TIMx, period - 1, psc - 1, PIN_MAP[Pin].TimerChannel);
+
+    if(Info)
+    {
+        PWM_GetInfo(TIMx, Info);
+    }
+
+    return PIN_MAP[Pin].TimerChannel;
+}
+
+/**
+  * @brief  运行中修改PWM频率，新周期在下一个溢出事件生效，
+  *         同一定时器上各通道的比较值按比例换算，占空比保持不变
+  * @param  Pin: 引脚编号
+  * @param  Frequency: PWM频率(mHz)
+  * @param  Info: 输出实际频率和分辨率，可为NULL
+  * @retval true: 成功
+  */
+bool PWM_SetFrequencyHR(uint8_t Pin, uint32_t Frequency, PWM_Info_TypeDef* Info)
+{
+    uint32_t period, psc, oldPeriod;
+    tmr_type* TIMx;
+    uint8_t ch;
+
+    if(!IS_PWM_PIN(Pin))
+    {
+        return false;
+    }
+
+    TIMx = PIN_MAP[Pin].TIMx;
+
+    if(!PWM_CalcPeriod(Timer_GetClockMax(TIMx), Frequency, &period, &psc))
+    {
+        return false;
+    }
+
+    oldPeriod = TIMx->pr + 1;
+
+    /*分频、周期和比较值在同一个溢出事件一起装载*/
+    PWM_UpdateBegin(TIMx);
+
+    tmr_div_value_set(TIMx, psc - 1);
+    tmr_period_value_set(TIMx, period - 1);
+
+    for(ch = 1; ch <= 4; ch++)
+    {
+        tmr_channel_select_type channel_select;
+        uint32_t compare;
+
+        TIMx_GetChannelSelect(ch, &channel_select);
+        compare = tmr_channel_value_get(TIMx, channel_select);
+        compare = (uint32_t)(((uint64_t)compare * period + oldPeriod / 2) / oldPeriod);
+        tmr_channel_value_set(TIMx, channel_select, compare);
+    }
+
+    PWM_UpdateEnd(TIMx);
+
+    if(Info)
+    {
+        PWM_GetInfo(TIMx, Info);
+    }
+
+    return true;
+}
+
+/**
+  * @brief  按比例设置占空比
+  * @param  Pin: 引脚编号
+  * @param  Duty: 占空比，0~65535对应0~100%
+  * @retval 无
+  */
+void PWM_SetDuty(uint8_t Pin, uint16_t Duty)
+{
+    tmr_type* TIMx;
+    uint32_t period;
+
+    if(!IS_PWM_PIN(Pin))
+    {
+        return;
+    }
+
+    TIMx = PIN_MAP[Pin].TIMx;
+    period = TIMx->pr + 1;
+
+    PWM_Write(Pin, (uint32_t)(((uint64_t)Duty * period + 0x7FFF) / 0xFFFF));
+}
+
+/**
+  * @brief  互补PWM输出初始化(仅TMR1/TMR8/TMR20)
+  * @param  Pin: 通道输出引脚编号
+  * @param  PinN: 互补输出引脚编号，须为数据手册中该通道的CHxN引脚
+  * @param  Resolution: PWM分辨率
+  * @param  Frequency: PWM频率
+  * @param  DeadTime: 死区时间(纳秒)，同一定时器的所有通道共用，最长1008个定时器时钟周期
+  * @retval 引脚对应的定时器通道，0:失败(包括死区时间超出范围)
+  */
+uint8_t PWM_InitComplementary(uint8_t Pin, uint8_t PinN, uint32_t Resolution, uint32_t Frequency, uint32_t DeadTime)
+{
+    tmr_output_config_type tmr_output_struct;
+    tmr_brkdt_config_type tmr_brkdt_struct;
+    tmr_channel_select_type channel_select;
+    tmr_type* TIMx;
+    uint32_t clock;
+    uint32_t psc;
+    uint8_t dtc;
+
+    if(!IS_PWM_PIN(Pin) || !IS_PIN(PinN))
+    {
+        return 0;
+    }
+
+    TIMx = PIN_MAP[Pin].TIMx;
+    if(!PWM_IsAdvancedTimer(TIMx) || PIN_MAP[Pin].TimerChannel > 3)
+    {
+        return 0;
+    }
+
+    if(Resolution == 0 || Frequency == 0 || (Resolution * Frequency) > F_CPU)
+    {
+        return 0;
+    }
+
+    /*死区时钟为定时器时钟(不分频)，超出范围时不能截短，直接失败*/
+    clock = Timer_GetClockMax(TIMx);
+    if(!PWM_DeadTimeEncode(clock, DeadTime, &dtc))
+    {
+        return 0;
+    }
+
+    TIMx_GetChannelSelect(PIN_MAP[Pin].TimerChannel, &channel_select);
+
+    pinMode(Pin, OUTPUT_AF_PP);
+    gpio_pin_mux_config(PIN_MAP[Pin].GPIOx, GPIO_GetPinSource(PIN_MAP[Pin].GPIO_Pin_x), Timer_GetGPIO_MUX(Pin));
+    pinMode(PinN, OUTPUT_AF_PP);
+    gpio_pin_mux_config(PIN_MAP[PinN].GPIOx, GPIO_GetPinSource(PIN_MAP[PinN].GPIO_Pin_x), Timer_GetGPIO_MUX(Pin));
+
+    psc = clock / Resolution / Frequency;
+
+    Timer_SetEnable(TIMx, false);
+    Timer_ClockCmd(TIMx, true);
+    tmr_base_init(TIMx, Resolution - 1, psc - 1);
+    tmr_cnt_dir_set(TIMx, TMR_COUNT_UP);
+
+    /*死区插入在极性之前，两路都用高有效才不会在死区内同时导通*/
+    tmr_output_default_para_init(&tmr_output_struct);
+    tmr_output_struct.oc_mode = TMR_OUTPUT_CONTROL_PWM_MODE_A;
+    tmr_output_struct.oc_polarity = TMR_OUTPUT_ACTIVE_HIGH;
+    tmr_output_struct.oc_idle_state = FALSE;
+    tmr_output_struct.occ_polarity = TMR_OUTPUT_ACTIVE_HIGH;
+    tmr_output_struct.occ_idle_state = FALSE;
+    tmr_output_struct.oc_output_state = TRUE;
+    tmr_output_struct.occ_output_state = TRUE;
+    tmr_output_channel_config(TIMx, channel_select, &tmr_output_struct);
+    tmr_output_channel_buffer_enable(TIMx, channel_select, TRUE);
+    tmr_period_buffer_enable(TIMx, TRUE);
+
+    /*保留已配置的刹车设置*/
+    tmr_brkdt_default_para_init(&tmr_brkdt_struct);
+    tmr_brkdt_struct.deadtime = dtc;
+    tmr_brkdt_struct.brk_enable = (confirm_state)TIMx->brk_bit.brken;
+    tmr_brkdt_struct.brk_polarity = (tmr_brk_polarity_type)TIMx->brk_bit.brkv;
+    tmr_brkdt_struct.auto_output_enable = (confirm_state)TIMx->brk_bit.aoen;
+    tmr_brkdt_struct.fcsoen_state = TRUE;
+    tmr_brkdt_struct.fcsodis_state = TRUE;
+    tmr_brkdt_config(TIMx, &tmr_brkdt_struct);
+
+    tmr_output_enable(TIMx, TRUE);
+    tmr_counter_enable(TIMx, TRUE);
+
+    return PIN_MAP[Pin].TimerChannel;
+}
+
+/**
+  * @brief  配置刹车输入，有效时硬件立即关闭该定时器的全部输出(空闲电平)
+  * @param  TIMx: 定时器地址(仅TMR1/TMR8/TMR20)
+  * @param  BreakPin: 刹车输入引脚编号，须为数据手册中该定时器的BRKIN引脚，NOT_A_PIN为关闭
+  * @param  ActiveHigh: true: 高电平刹车
+  * @param  AutoRecover: true: 刹车撤销后在下一个溢出事件自动恢复输出，
+  *                      false: 需调用PWM_BreakRecover恢复
+  * @retval true: 成功
+  */
+bool PWM_SetBreak(tmr_type* TIMx, uint8_t BreakPin, bool ActiveHigh, bool AutoRecover)
+{
+    uint8_t muxPin;
+
+    if(!PWM_IsAdvancedTimer(TIMx))
+    {
+        return false;
+    }
+
+    if(BreakPin == NOT_A_PIN)
+    {
+        TIMx->brk_bit.brken = FALSE;
+        return true;
+    }
+
+    if(!IS_PIN(BreakPin))
+    {
+        return false;
+    }
+
+    /*同一定时器的复用编号相同，借用该定时器任一通道引脚查询*/
+    for(muxPin = 0; muxPin < PIN_MAX; muxPin++)
+    {
+        if(PIN_MAP[muxPin].TIMx == TIMx)
+        {
+            break;
+        }
+    }
+
+    if(muxPin == PIN_MAX)
+    {
+        return false;
+    }
+
+    pinMode(BreakPin, OUTPUT_AF_PP);
+    gpio_pin_mux_config(PIN_MAP[BreakPin].GPIOx, GPIO_GetPinSource(PIN_MAP[BreakPin].GPIO_Pin_x), Timer_GetGPIO_MUX(muxPin));
+
+    /*刹车引脚悬空时保持无效电平*/
+    {
+        uint8_t pinNum = GPIO_GetPinNum(BreakPin);
+        gpio_type* GPIOx = PIN_MAP[BreakPin].GPIOx;
+        uint32_t pull = ActiveHigh ? GPIO_PULL_DOWN : GPIO_PULL_UP;
+        GPIOx->pull = (GPIOx->pull & ~(0x03U << (pinNum * 2))) | (pull << (pinNum * 2));
+    }
+
+    TIMx->brk_bit.brkv = ActiveHigh ? TMR_BRK_INPUT_ACTIVE_HIGH : TMR_BRK_INPUT_ACTIVE_LOW;
+    TIMx->brk_bit.aoen = AutoRecover ? TRUE : FALSE;
+    TIMx->brk_bit.brken = TRUE;
+
+    return true;
+}
+
+/**
+  * @brief  刹车撤销后手动恢复输出
+  * @param  TIMx: 定时器地址(仅TMR1/TMR8/TMR20)
+  * @retval true: 已恢复，false: 刹车输入仍有效
+  */
+bool PWM_BreakRecover(tmr_type* TIMx)
+{
+    tmr_flag_clear(TIMx, TMR_BRK_FLAG);
+    if(tmr_flag_get(TIMx, TMR_BRK_FLAG) == SET)
+    {
+        return false;
+    }
+
+    tmr_output_enable(TIMx, TRUE);
+    return true;
+}
+
+#if TONE_HARDWARE_ENABLE
+
+/*
+ * 硬件音调：定时器输出50%占空比方波，不占用CPU。
+ * 有限时长的音调：
+ * 高级定时器(TMR1/8/20)用溢出中断计数周期，借助重复计数器每256个周期才中断一次；
+ * 通用定时器没有重复计数器，改由软件定时器按毫秒截止时间停止，整个过程不开溢出中断。
+ * 未开启SOFT_TIMER_ENABLE时，通用定时器只支持持续输出(Duration为0)，
+ * 有限时长的请求返回false，由调用者改用软件音调。
+ */
+
+#define PWM_TONE_REPETITION_MAX     256U
+
+#if SOFT_TIMER_ENABLE
+#  define PWM_TONE_USE_DEADLINE     1
+#else
+#  define PWM_TONE_USE_DEADLINE     0
+#endif
+
+typedef struct
+{
+    tmr_type* TIMx;
+    uint8_t Pin;
+    volatile uint32_t Remain;
+    volatile uint32_t Running;
+    volatile uint32_t Pending;
+#if PWM_TONE_USE_DEADLINE
+    SoftTimer_TypeDef Deadline;
+#endif
+} PWM_Tone_TypeDef;
+
+static PWM_Tone_TypeDef PWM_Tone_Group[TONE_HARDWARE_MAX] = {0};
+
+/**
+  * @brief  停止音调输出并拉低引脚
+  * @param  tone: 音调通道
+  * @retval 无
+  */
+static void PWM_ToneRelease(PWM_Tone_TypeDef* tone)
+{
+    tmr_type* TIMx = tone->TIMx;
+    tmr_channel_select_type channel_select;
+
+#if PWM_TONE_USE_DEADLINE
+    SoftTimer_Stop(&tone->Deadline);
+#endif
+    tmr_interrupt_enable(TIMx, TMR_OVF_INT, FALSE);
+    tmr_counter_enable(TIMx, FALSE);
+    Timer_SetEventCallback(TIMx, NULL, NULL, 0, 0);
+
+    /*输出极性为低有效，强制参考电平为高时引脚为低*/
+    if(TIMx_GetChannelSelect(PIN_MAP[tone->Pin].TimerChannel, &channel_select))
+    {
+        tmr_output_channel_mode_select(TIMx, channel_select, TMR_OUTPUT_CONTROL_FORCE_HIGH);
+    }
+
+    tone->TIMx = NULL;
+}
+
+/**
+  * @brief  高级定时器音调周期计数，每(重复计数值+1)个周期进入一次
+  * @param  TIMx: 定时器地址
+  * @param  Flags: 中断标志
+  * @param  UserData: 音调通道
+  * @retval 无
+  */
+static void PWM_ToneEventHandler(tmr_type* TIMx, uint32_t Flags, void* UserData)
+{
+    PWM_Tone_TypeDef* tone = (PWM_Tone_TypeDef*)UserData;
+
+    if(!(Flags & TMR_OVF_FLAG))
+    {
+        return;
+    }
+
+    tone->Remain -= tone->Running;
+    if(tone->Remain == 0)
+    {
+        PWM_ToneRelease(tone);
+        return;
+    }
+
+    /*重复计数值在溢出事件时装载，此时写入的值作用于下一轮*/
+    tone->Running = tone->Pending;
+    tone->Pending = tone->Remain - tone->Running;
+    if(tone->Pending > PWM_TONE_REPETITION_MAX)
+    {
+        tone->Pending = PWM_TONE_REPETITION_MAX;
+    }
+
+    if(tone->Pending)
+    {
+        tmr_repetition_counter_set(TIMx, tone->Pending - 1);
+    }
+}
+
+#if PWM_TONE_USE_DEADLINE
+/**
+  * @brief  通用定时器音调到达截止时间，在软件定时器中断中执行
+  * @param  UserData: 音调通道
+  * @retval 无
+  */
+static void PWM_ToneDeadlineHandler(void* UserData)
+{
+    PWM_Tone_TypeDef* tone = (PWM_Tone_TypeDef*)UserData;
+
+    if(tone->TIMx != NULL)
+    {
+        PWM_ToneRelease(tone);
+    }
+}
+#endif
+
+static PWM_Tone_TypeDef* PWM_ToneFind(uint8_t Pin)
+{
+    int i;
+    for(i = 0; i < TONE_HARDWARE_MAX; i++)
+    {
+        if(PWM_Tone_Group[i].TIMx != NULL && PWM_Tone_Group[i].Pin == Pin)
+        {
+            return &PWM_Tone_Group[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+  * @brief  在定时器通道引脚上输出硬件方波
+  * @param  Pin: 引脚编号
+  * @param  Frequency: 频率(Hz)
+  * @param  Duration: 持续时间(毫秒)，0为持续输出
+  * @note   Duration非0时，高级定时器每256个周期中断一次，
+  *         通用定时器需开启SOFT_TIMER_ENABLE，由软件定时器到时停止
+  * @retval true: 成功，false: 引脚无定时器通道、通道已用完或该定时器不支持定时输出
+  */
+bool PWM_ToneStart(uint8_t Pin, uint32_t Frequency, uint32_t Duration)
+{
+    PWM_Tone_TypeDef* tone = NULL;
+    tmr_type* TIMx;
+    uint32_t periods = 0;
+    bool useDeadline = false;
+    int i;
+
+    if(!IS_PWM_PIN(Pin) || Frequency == 0)
+    {
+        return false;
+    }
+
+    TIMx = PIN_MAP[Pin].TIMx;
+
+    if(Duration && !PWM_IsAdvancedTimer(TIMx))
+    {
+#if PWM_TONE_USE_DEADLINE
+        if(TIMx == SOFT_TIMER_TIMER
+                || Duration > SOFT_TIMER_DELAY_MAX / 1000U
+                || !SoftTimer_Init())
+        {
+            return false;
+        }
+        useDeadline = true;
+#else
+        return false;
+#endif
+    }
+
+    /*同一个定时器同时只能输出一个音调*/
+    for(i = 0; i < TONE_HARDWARE_MAX; i++)
+    {
+        if(PWM_Tone_Group[i].TIMx == TIMx)
+        {
+            PWM_ToneRelease(&PWM_Tone_Group[i]);
+        }
+    }
+
+    for(i = 0; i < TONE_HARDWARE_MAX; i++)
+    {
+        if(PWM_Tone_Group[i].TIMx == NULL)
+        {
+            tone = &PWM_Tone_Group[i];
+            break;
+        }
+    }
+
+    if(tone == NULL)
+    {
+        return false;
+    }
+
+    if(Duration && !useDeadline)
+    {
+        periods = (uint32_t)((uint64_t)Frequency * Duration / 1000U);
+        if(periods == 0)
+        {
+            periods = 1;
+        }
+    }
+
+    pinMode(Pin, OUTPUT_AF_PP);
+    gpio_pin_mux_config(PIN_MAP[Pin].GPIOx, GPIO_GetPinSource(PIN_MAP[Pin].GPIO_Pin_x), Timer_GetGPIO_MUX(Pin));
+
+    Timer_ClockCmd(TIMx, true);
+    Timer_SetEnable(TIMx, false);
+    tmr_interrupt_enable(TIMx, TMR_OVF_INT, FALSE);
+    tmr_cnt_dir_set(TIMx, TMR_COUNT_UP);
+
+    tone->Pin = Pin;
+    tone->Remain = periods;
+    tone->Running = (periods < PWM_TONE_REPETITION_MAX) ? periods : PWM_TONE_REPETITION_MAX;
+    if(periods)
+    {
+        tmr_repetition_counter_set(TIMx, tone->Running - 1);
+    }
+
+    if(!Timer_SetInterruptFreqUpdate(TIMx, Frequency))
+    {
+        return false;
+    }
+
+    if(!TIMx_OCxConfig(TIMx, PIN_MAP[Pin].TimerChannel))
+    {
+        return false;
+    }
+    Timer_SetCompare(TIMx, PIN_MAP[Pin].TimerChannel, (TIMx->pr + 1) / 2);
+
+    /*软件溢出事件装载比较值和第一轮的重复计数值*/
+    Timer_GenerateUpdate(TIMx);
+
+    tone->Pending = periods - tone->Running;
+    if(tone->Pending > PWM_TONE_REPETITION_MAX)
+    {
+        tone->Pending = PWM_TONE_REPETITION_MAX;
+    }
+    if(tone->Pending)
+    {
+        tmr_repetition_counter_set(TIMx, tone->Pending - 1);
+    }
+
+    tone->TIMx = TIMx;
+    tmr_flag_clear(TIMx, TMR_OVF_FLAG);
+
+    if(periods)
+    {
+        Timer_SetEventCallback(TIMx, PWM_ToneEventHandler, tone, TONE_PREEMPTIONPRIORITY_DEFAULT, TONE_SUBPRIORITY_DEFAULT);
+        tmr_interrupt_enable(TIMx, TMR_OVF_INT, TRUE);
+    }
+
+    tmr_counter_enable(TIMx, TRUE);
+
+#if PWM_TONE_USE_DEADLINE
+    if(useDeadline)
+    {
+        SoftTimer_Create(&tone->Deadline, PWM_ToneDeadlineHandler, tone);
+        SoftTimer_Start(&tone->Deadline, Duration * 1000U, 0);
+    }
+#endif
+
+    return true;
+}
+
+/**
+  * @brief  停止硬件方波
+  * @param  Pin: 引脚编号
+  * @retval true: 该引脚正在输出硬件音调
+  */
+bool PWM_ToneStop(uint8_t Pin)
+{
+    PWM_Tone_TypeDef* tone = PWM_ToneFind(Pin);
+
+    if(tone == NULL)
+    {
+        return false;
+    }
+
+    PWM_ToneRelease(tone);
+    return true;
+}
+
+/**
+  * @brief  查询硬件方波是否在输出
+  * @param  Pin: 引脚编号
+  * @retval true: 正在输出
+  */
+bool PWM_ToneIsBusy(uint8_t Pin)
+{
+    return (PWM_ToneFind(Pin) != NULL);
+}
+
+#endif /* TONE_HARDWARE_ENABLE */
@@ -23,7 +23,9 @@
 #ifndef __PWM_H
 #define __PWM_H
 
+#include <stdbool.h>
 #include "mcu_type.h"
+#include "timer_factor.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,9 +33,34 @@ extern "C" {
     
 #define pwmWrite(pin, value) PWM_Write(pin, value)
 
+typedef struct
+{
+    uint32_t Frequency;     // 实际频率(mHz)
+    uint32_t Resolution;    // 占空比分辨率(一个周期的计数值)
+} PWM_Info_TypeDef;
+
 uint8_t PWM_Init(uint8_t Pin, uint32_t Resolution, uint32_t Frequency);
 void PWM_Write(uint8_t Pin, uint32_t Value);
 
+void PWM_UpdateBegin(tmr_type* TIMx);
+void PWM_UpdateEnd(tmr_type* TIMx);
+void PWM_WriteMulti(const uint8_t* Pins, const uint32_t* Values, uint8_t Count);
+
+uint8_t PWM_InitHR(uint8_t Pin, uint32_t Frequency, PWM_Info_TypeDef* Info);
+bool PWM_SetFrequencyHR(uint8_t Pin, uint32_t Frequency, PWM_Info_TypeDef* Info);
+void PWM_SetDuty(uint8_t Pin, uint16_t Duty);
+void PWM_GetInfo(tmr_type* TIMx, PWM_Info_TypeDef* Info);
+
+uint8_t PWM_InitComplementary(uint8_t Pin, uint8_t PinN, uint32_t Resolution, uint32_t Frequency, uint32_t DeadTime);
+bool PWM_SetBreak(tmr_type* TIMx, uint8_t BreakPin, bool ActiveHigh, bool AutoRecover);
+bool PWM_BreakRecover(tmr_type* TIMx);
+
+#if TONE_HARDWARE_ENABLE
+bool PWM_ToneStart(uint8_t Pin, uint32_t Frequency, uint32_t Duration);
+bool PWM_ToneStop(uint8_t Pin);
+bool PWM_ToneIsBusy(uint8_t Pin);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,356 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "pwm_wave.h"
+#include "dma_stream.h"
+#include "timer.h"
+#include "Arduino.h"
+
+#if PWM_WAVE_ENABLE
+
+/*
+ * 定时器每次溢出通过DMA突发(dmactrl/dmadt)把一帧比较值写入
+ * 连续的CxDT寄存器，比较值缓冲在下一个周期生效，
+ * CPU只在半缓冲/全缓冲时进入一次中断。
+ * 引脚需先用PWM_Init以相同的分辨率和频率初始化，PWM频率即采样频率。
+ */
+
+typedef enum
+{
+    PWM_WAVE_MODE_ONCE,
+    PWM_WAVE_MODE_LOOP,
+    PWM_WAVE_MODE_STREAM
+} PWM_Wave_Mode_Type;
+
+typedef struct
+{
+    tmr_type* TIMx;
+    uint8_t DMAReqID;
+} PWM_Wave_DMAReq_TypeDef;
+
+static const PWM_Wave_DMAReq_TypeDef PWM_Wave_DMAReq_Map[] =
+{
+    { TIM1,  DMAMUX_DMAREQ_ID_TMR1_OVERFLOW },
+    { TIM2,  DMAMUX_DMAREQ_ID_TMR2_OVERFLOW },
+    { TIM3,  DMAMUX_DMAREQ_ID_TMR3_OVERFLOW },
+    { TIM4,  DMAMUX_DMAREQ_ID_TMR4_OVERFLOW },
+    { TIM5,  DMAMUX_DMAREQ_ID_TMR5_OVERFLOW },
+    { TIM8,  DMAMUX_DMAREQ_ID_TMR8_UP },
+    { TIM20, DMAMUX_DMAREQ_ID_TMR20_OVERFLOW }
+};
+
+static tmr_type* PWM_Wave_TIMx = NULL;
+static uint8_t PWM_Wave_Channels = 0;
+
+static volatile bool PWM_Wave_Busy = false;
+static PWM_Wave_Mode_Type PWM_Wave_Mode = PWM_WAVE_MODE_ONCE;
+
+static PWM_Wave_CallbackFunction_t PWM_Wave_Callback = NULL;
+static void* PWM_Wave_CallbackUserData = NULL;
+
+/*流模式*/
+static DMA_Stream_TypeDef PWM_Wave_Stream;
+static PWM_Wave_FillFunction_t PWM_Wave_StreamFill = NULL;
+static void* PWM_Wave_StreamUserData = NULL;
+
+/*数据结束后保持的最后一帧*/
+static uint16_t PWM_Wave_HoldFrame[PWM_WAVE_CHANNEL_MAX];
+
+/**
+  * @brief  PWM波形播放器初始化
+  * @param  Pin: 第一个通道的引脚，需已用PWM_Init初始化
+  * @param  Channels: 通道数，从该引脚的定时器通道开始连续的通道(如CH1~CH3)
+  * @retval true: 成功，false: 正在播放或引脚/定时器不支持
+  */
+bool PWM_Wave_Init(uint8_t Pin, uint8_t Channels)
+{
+    tmr_type* TIMx;
+    uint8_t channel;
+    uint8_t dmaReqID = 0;
+    uint8_t i;
+
+    if(PWM_Wave_Busy || !IS_PWM_PIN(Pin))
+        return false;
+
+    TIMx = PIN_MAP[Pin].TIMx;
+    channel = PIN_MAP[Pin].TimerChannel;
+
+    if(Channels == 0 || channel + Channels - 1 > PWM_WAVE_CHANNEL_MAX)
+        return false;
+
+    for(i = 0; i < sizeof(PWM_Wave_DMAReq_Map) / sizeof(PWM_Wave_DMAReq_Map[0]); i++)
+    {
+        if(PWM_Wave_DMAReq_Map[i].TIMx == TIMx)
+        {
+            dmaReqID = PWM_Wave_DMAReq_Map[i].DMAReqID;
+            break;
+        }
+    }
+
+    if(dmaReqID == 0)
+        return false;
+
+    /*每次溢出请求Channels次传输，从C(channel)DT开始*/
+    tmr_dma_control_config(
+        TIMx,
+        (tmr_dma_transfer_length_type)(TMR_DMA_TRANSFER_1BYTE + Channels - 1),
+        (tmr_dma_address_type)(TMR_C1DT_ADDRESS + channel - 1)
+    );
+
+    PWM_Wave_TIMx = TIMx;
+    PWM_Wave_Channels = Channels;
+
+    for(i = 0; i < Channels; i++)
+    {
+        PWM_Wave_HoldFrame[i] = 0;
+    }
+
+    crm_periph_clock_enable(
+        (PWM_WAVE_DMA == DMA1) ? CRM_DMA1_PERIPH_CLOCK : CRM_DMA2_PERIPH_CLOCK,
+        TRUE
+    );
+    dmamux_enable(PWM_WAVE_DMA, TRUE);
+    dmamux_init(PWM_WAVE_DMAMUX_CHANNEL, (dmamux_requst_id_sel_type)dmaReqID);
+
+    nvic_irq_enable(PWM_WAVE_DMA_IRQn, PWM_WAVE_PREEMPTIONPRIORITY, PWM_WAVE_SUBPRIORITY);
+
+    return true;
+}
+
+/**
+  * @brief  设置播放结束回调(在DMA中断中执行)
+  * @param  Function: 回调函数
+  * @param  UserData: 用户数据
+  * @retval 无
+  */
+void PWM_Wave_SetCallback(PWM_Wave_CallbackFunction_t Function, void* UserData)
+{
+    PWM_Wave_CallbackUserData = UserData;
+    PWM_Wave_Callback = Function;
+}
+
+static void PWM_Wave_DMA_Config(const uint16_t* Buffer, uint32_t Length, bool Loop, uint32_t Interrupt)
+{
+    dma_init_type dma_init_structure;
+
+    dma_reset(PWM_WAVE_DMA_CHANNEL);
+
+    /*内存半字，外设字访问dmadt，高16位补0，32位定时器的CxDT不会写入错误的高位*/
+    dma_default_para_init(&dma_init_structure);
+    dma_init_structure.buffer_size = Length;
+    dma_init_structure.direction = DMA_DIR_MEMORY_TO_PERIPHERAL;
+    dma_init_structure.memory_base_addr = (uint32_t)Buffer;
+    dma_init_structure.memory_data_width = DMA_MEMORY_DATA_WIDTH_HALFWORD;
+    dma_init_structure.memory_inc_enable = TRUE;
+    dma_init_structure.peripheral_base_addr = (uint32_t)(&(PWM_Wave_TIMx->dmadt));
+    dma_init_structure.peripheral_data_width = DMA_PERIPHERAL_DATA_WIDTH_WORD;
+    dma_init_structure.peripheral_inc_enable = FALSE;
+    dma_init_structure.priority = DMA_PRIORITY_HIGH;
+    dma_init_structure.loop_mode_enable = Loop ? TRUE : FALSE;
+    dma_init(PWM_WAVE_DMA_CHANNEL, &dma_init_structure);
+
+    dma_flag_clear(PWM_WAVE_DMA_HDT_FLAG);
+    dma_flag_clear(PWM_WAVE_DMA_FDT_FLAG);
+    dma_interrupt_enable(PWM_WAVE_DMA_CHANNEL, Interrupt, TRUE);
+}
+
+static void PWM_Wave_Launch(void)
+{
+    PWM_Wave_Busy = true;
+
+    /*定时器保持运行，从下一次溢出开始传输*/
+    dma_channel_enable(PWM_WAVE_DMA_CHANNEL, TRUE);
+    tmr_dma_request_enable(PWM_Wave_TIMx, TMR_OVERFLOW_DMA_REQUEST, TRUE);
+}
+
+static void PWM_Wave_SaveHoldFrame(const uint16_t* Frame)
+{
+    uint8_t i;
+    for(i = 0; i < PWM_Wave_Channels; i++)
+    {
+        PWM_Wave_HoldFrame[i] = Frame[i];
+    }
+}
+
+/**
+  * @brief  播放一段预先生成的波形
+  * @param  Buffer: 交错排列的比较值，每帧Channels个，播放期间不能修改
+  * @param  Frames: 帧数
+  * @param  Loop: true循环播放直到PWM_Wave_Stop
+  * @retval true: 成功，false: 正在播放、未初始化或参数错误
+  */
+bool PWM_Wave_Start(const uint16_t* Buffer, uint16_t Frames, bool Loop)
+{
+    uint32_t length = (uint32_t)Frames * PWM_Wave_Channels;
+
+    if(PWM_Wave_Busy || PWM_Wave_TIMx == NULL || Buffer == NULL || Frames == 0 || length > 0xFFFF)
+        return false;
+
+    PWM_Wave_Mode = Loop ? PWM_WAVE_MODE_LOOP : PWM_WAVE_MODE_ONCE;
+    PWM_Wave_DMA_Config(Buffer, length, Loop, Loop ? 0 : DMA_FDT_INT);
+    PWM_Wave_Launch();
+    return true;
+}
+
+static uint16_t PWM_Wave_StreamFillFrames(void* Half, uint16_t Length, void* UserData)
+{
+    (void)UserData;
+    return PWM_Wave_StreamFill((uint16_t*)Half, Length, PWM_Wave_StreamUserData);
+}
+
+static void PWM_Wave_StreamPad(void* Half, uint16_t Filled, uint16_t Length, void* UserData)
+{
+    uint16_t* half = (uint16_t*)Half;
+    uint16_t frame;
+    (void)UserData;
+
+    if(Filled > 0)
+    {
+        PWM_Wave_SaveHoldFrame(half + (Filled - 1) * PWM_Wave_Channels);
+    }
+
+    /*数据结束后重复最后一帧，占空比保持不变*/
+    for(frame = Filled; frame < Length; frame++)
+    {
+        uint16_t* dst = half + frame * PWM_Wave_Channels;
+        uint8_t i;
+        for(i = 0; i < PWM_Wave_Channels; i++)
+        {
+            dst[i] = PWM_Wave_HoldFrame[i];
+        }
+    }
+}
+
+/**
+  * @brief  流模式播放，边播放边生成，适合长波形或实时合成
+  * @param  Buffer: 双缓冲，长度为 HalfFrames * 2 * Channels
+  * @param  HalfFrames: 半缓冲帧数
+  * @param  Fill: 填充函数，在DMA中断中调用
+  * @param  UserData: 用户数据
+  * @retval true: 成功，false: 正在播放、未初始化或参数错误
+  */
+bool PWM_Wave_StartStream(
+    uint16_t* Buffer, uint16_t HalfFrames,
+    PWM_Wave_FillFunction_t Fill, void* UserData
+)
+{
+    uint32_t length = (uint32_t)HalfFrames * 2 * PWM_Wave_Channels;
+
+    if(PWM_Wave_Busy || PWM_Wave_TIMx == NULL || Buffer == NULL || HalfFrames == 0 || length > 0xFFFF || Fill == NULL)
+        return false;
+
+    PWM_Wave_Mode = PWM_WAVE_MODE_STREAM;
+    PWM_Wave_StreamFill = Fill;
+    PWM_Wave_StreamUserData = UserData;
+
+    /*每帧Channels个比较值作为一个单元*/
+    DMA_Stream_Start(
+        &PWM_Wave_Stream,
+        Buffer, HalfFrames, PWM_Wave_Channels * sizeof(uint16_t),
+        PWM_Wave_StreamFillFrames, PWM_Wave_StreamPad, NULL
+    );
+
+    PWM_Wave_DMA_Config(Buffer, length, true, DMA_HDT_INT | DMA_FDT_INT);
+    PWM_Wave_Launch();
+    return true;
+}
+
+/**
+  * @brief  停止播放，各通道保持最后写入的比较值
+  * @param  无
+  * @retval 无
+  */
+void PWM_Wave_Stop(void)
+{
+    if(PWM_Wave_TIMx)
+    {
+        tmr_dma_request_enable(PWM_Wave_TIMx, TMR_OVERFLOW_DMA_REQUEST, FALSE);
+    }
+    dma_channel_enable(PWM_WAVE_DMA_CHANNEL, FALSE);
+    dma_interrupt_enable(PWM_WAVE_DMA_CHANNEL, DMA_HDT_INT | DMA_FDT_INT, FALSE);
+    PWM_Wave_Busy = false;
+}
+
+/**
+  * @brief  是否正在播放
+  * @param  无
+  * @retval true: 正在播放
+  */
+bool PWM_Wave_IsBusy(void)
+{
+    return PWM_Wave_Busy;
+}
+
+/**
+  * @brief  获取实际采样频率(PWM频率)
+  * @param  无
+  * @retval 采样频率(Hz)，未初始化返回0
+  */
+uint32_t PWM_Wave_GetSampleFreq(void)
+{
+    return PWM_Wave_TIMx ? Timer_GetClockOut(PWM_Wave_TIMx) : 0;
+}
+
+static void PWM_Wave_Finish(void)
+{
+    PWM_Wave_Stop();
+    if(PWM_Wave_Callback)
+    {
+        PWM_Wave_Callback(PWM_Wave_CallbackUserData);
+    }
+}
+
+/**
+  * @brief  PWM波形DMA中断入口
+  * @param  无
+  * @retval 无
+  */
+PWM_WAVE_IRQ_HANDLER_DEF()
+{
+    if(dma_flag_get(PWM_WAVE_DMA_HDT_FLAG) != RESET)
+    {
+        dma_flag_clear(PWM_WAVE_DMA_HDT_FLAG);
+        if(PWM_Wave_Mode == PWM_WAVE_MODE_STREAM && PWM_Wave_Busy
+                && DMA_Stream_Event(&PWM_Wave_Stream, false))
+        {
+            PWM_Wave_Finish();
+        }
+    }
+
+    if(dma_flag_get(PWM_WAVE_DMA_FDT_FLAG) != RESET)
+    {
+        dma_flag_clear(PWM_WAVE_DMA_FDT_FLAG);
+        if(PWM_Wave_Mode == PWM_WAVE_MODE_STREAM)
+        {
+            if(PWM_Wave_Busy && DMA_Stream_Event(&PWM_Wave_Stream, true))
+            {
+                PWM_Wave_Finish();
+            }
+        }
+        else
+        {
+            PWM_Wave_Finish();
+        }
+    }
+}
+
+#endif /* PWM_WAVE_ENABLE */
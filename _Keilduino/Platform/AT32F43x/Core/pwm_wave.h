@@ -0,0 +1,58 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __PWM_WAVE_H
+#define __PWM_WAVE_H
+
+#include <stdbool.h>
+#include "mcu_type.h"
+#include "pwm_wave_table.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PWM_WAVE_CHANNEL_MAX    4
+
+typedef void(*PWM_Wave_CallbackFunction_t)(void* UserData);
+
+/* 流模式填充函数，返回写入的帧数，小于Frames表示数据结束 */
+typedef uint16_t(*PWM_Wave_FillFunction_t)(uint16_t* Buffer, uint16_t Frames, void* UserData);
+
+#if PWM_WAVE_ENABLE
+bool     PWM_Wave_Init(uint8_t Pin, uint8_t Channels);
+void     PWM_Wave_SetCallback(PWM_Wave_CallbackFunction_t Function, void* UserData);
+bool     PWM_Wave_Start(const uint16_t* Buffer, uint16_t Frames, bool Loop);
+bool     PWM_Wave_StartStream(
+    uint16_t* Buffer, uint16_t HalfFrames,
+    PWM_Wave_FillFunction_t Fill, void* UserData
+);
+void     PWM_Wave_Stop(void);
+bool     PWM_Wave_IsBusy(void);
+uint32_t PWM_Wave_GetSampleFreq(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PWM_WAVE_H */
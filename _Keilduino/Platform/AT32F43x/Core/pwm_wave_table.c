@@ -0,0 +1,168 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "pwm_wave_table.h"
+#include <math.h>
+
+#define PWM_WAVE_PI     3.14159265358979f
+
+/**
+  * @brief  生成一个周期的正弦表
+  * @param  Table: 输出表，长度为 2^TableBits
+  * @param  TableBits: 表长度位数(2~12)
+  * @param  Top: 比较值上限(100%占空比)
+  * @param  Amplitude: 峰值幅度，以Top/2为中心，超过Top/2时限幅为Top/2(Top为奇数时也能到达0和Top)
+  * @retval 无
+  */
+void PWM_Wave_MakeSineTable(uint16_t* Table, uint8_t TableBits, uint16_t Top, uint16_t Amplitude)
+{
+    uint32_t length = 1UL << TableBits;
+    float center = Top / 2.0f;
+    float amp = (Amplitude > center) ? center : (float)Amplitude;
+    uint32_t i;
+
+    for(i = 0; i < length; i++)
+    {
+        float value = center + amp * sinf(2.0f * PWM_WAVE_PI * i / length);
+        if(value < 0.0f)
+        {
+            value = 0.0f;
+        }
+        Table[i] = (uint16_t)(value + 0.5f);
+        if(Table[i] > Top)
+        {
+            Table[i] = Top;
+        }
+    }
+}
+
+/**
+  * @brief  输出频率转换为相位步进
+  * @param  Freq: 输出频率(Hz)
+  * @param  SampleFreq: 采样频率(Hz)，即PWM频率
+  * @retval 相位步进，Freq >= SampleFreq/2 时返回0
+  */
+uint32_t PWM_Wave_FreqToStep(uint32_t Freq, uint32_t SampleFreq)
+{
+    if(SampleFreq == 0 || (uint64_t)Freq * 2 >= SampleFreq)
+    {
+        return 0;
+    }
+
+    /*四舍五入，Step = Freq * 2^32 / SampleFreq*/
+    return (uint32_t)((((uint64_t)Freq << 32) + SampleFreq / 2) / SampleFreq);
+}
+
+/**
+  * @brief  角度转换为相位，用于多相输出(例如三相 0/120/240)
+  * @param  Degree: 角度
+  * @retval 相位
+  */
+uint32_t PWM_Wave_DegreeToPhase(uint16_t Degree)
+{
+    return (uint32_t)((((uint64_t)(Degree % 360) << 32) + 180) / 360);
+}
+
+/**
+  * @brief  振荡器初始化
+  * @param  Osc: 振荡器
+  * @param  Table: 波形表(一个周期)，长度为 2^TableBits
+  * @param  TableBits: 表长度位数
+  * @param  Freq: 输出频率(Hz)
+  * @param  SampleFreq: 采样频率(Hz)
+  * @param  Phase: 初始相位，见PWM_Wave_DegreeToPhase
+  * @retval 无
+  */
+void PWM_Wave_OscInit(
+    PWM_Wave_Osc_TypeDef* Osc,
+    const uint16_t* Table, uint8_t TableBits,
+    uint32_t Freq, uint32_t SampleFreq, uint32_t Phase
+)
+{
+    Osc->Table = Table;
+    Osc->TableBits = TableBits;
+    Osc->Phase = Phase;
+    Osc->Step = PWM_Wave_FreqToStep(Freq, SampleFreq);
+}
+
+/**
+  * @brief  修改振荡器频率，相位连续
+  * @param  Osc: 振荡器
+  * @param  Freq: 输出频率(Hz)
+  * @param  SampleFreq: 采样频率(Hz)
+  * @retval 无
+  */
+void PWM_Wave_OscSetFreq(PWM_Wave_Osc_TypeDef* Osc, uint32_t Freq, uint32_t SampleFreq)
+{
+    Osc->Step = PWM_Wave_FreqToStep(Freq, SampleFreq);
+}
+
+/**
+  * @brief  振荡器输出到交错缓冲的一个通道
+  * @param  Osc: 振荡器
+  * @param  Buffer: 该通道第一个值的地址
+  * @param  Frames: 帧数
+  * @param  Stride: 每帧通道数
+  * @retval 无
+  */
+void PWM_Wave_OscFill(PWM_Wave_Osc_TypeDef* Osc, uint16_t* Buffer, uint16_t Frames, uint8_t Stride)
+{
+    const uint16_t* table = Osc->Table;
+    uint8_t shift = 32 - Osc->TableBits;
+    uint32_t phase = Osc->Phase;
+    uint32_t step = Osc->Step;
+
+    while(Frames--)
+    {
+        *Buffer = table[phase >> shift];
+        Buffer += Stride;
+        phase += step;
+    }
+
+    Osc->Phase = phase;
+}
+
+/**
+  * @brief  将多个通道的数据交错合并为帧
+  * @param  Buffer: 输出缓冲，长度为 Frames * Channels
+  * @param  Lanes: 各通道数据
+  * @param  Channels: 通道数
+  * @param  Frames: 帧数
+  * @retval 无
+  */
+void PWM_Wave_Interleave(
+    uint16_t* Buffer,
+    const uint16_t* const* Lanes, uint8_t Channels,
+    uint16_t Frames
+)
+{
+    uint16_t frame;
+    uint8_t ch;
+
+    for(frame = 0; frame < Frames; frame++)
+    {
+        for(ch = 0; ch < Channels; ch++)
+        {
+            *Buffer++ = Lanes[ch][frame];
+        }
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __PWM_WAVE_TABLE_H
+#define __PWM_WAVE_TABLE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * PWM波形数据生成：缓冲按帧交错排列，每帧依次为各通道的比较值，
+ * 比较值范围 0~Top(Top为PWM_Init的Resolution，对应100%占空比)。
+ * 本文件不访问寄存器，可在PC上编译验证生成的数据。
+ */
+
+/* DDS振荡器：32位相位累加器，查表长度为 2^TableBits */
+typedef struct
+{
+    const uint16_t* Table;
+    uint8_t  TableBits;
+    uint32_t Phase;
+    uint32_t Step;
+} PWM_Wave_Osc_TypeDef;
+
+void PWM_Wave_MakeSineTable(uint16_t* Table, uint8_t TableBits, uint16_t Top, uint16_t Amplitude);
+
+uint32_t PWM_Wave_FreqToStep(uint32_t Freq, uint32_t SampleFreq);
+uint32_t PWM_Wave_DegreeToPhase(uint16_t Degree);
+
+void PWM_Wave_OscInit(
+    PWM_Wave_Osc_TypeDef* Osc,
+    const uint16_t* Table, uint8_t TableBits,
+    uint32_t Freq, uint32_t SampleFreq, uint32_t Phase
+);
+void PWM_Wave_OscSetFreq(PWM_Wave_Osc_TypeDef* Osc, uint32_t Freq, uint32_t SampleFreq);
+void PWM_Wave_OscFill(PWM_Wave_Osc_TypeDef* Osc, uint16_t* Buffer, uint16_t Frames, uint8_t Stride);
+
+void PWM_Wave_Interleave(
+    uint16_t* Buffer,
+    const uint16_t* const* Lanes, uint8_t Channels,
+    uint16_t Frames
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PWM_WAVE_TABLE_H */
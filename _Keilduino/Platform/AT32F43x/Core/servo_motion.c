@@ -0,0 +1,231 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "servo_motion.h"
+
+#define SERVO_MOTION_Q16(us)    ((uint32_t)(us) << 16)
+
+/**
+  * @brief  运动状态初始化
+  * @param  Motion: 运动状态
+  * @param  Pulse: 初始脉宽(微秒)
+  * @retval 无
+  */
+void Servo_MotionInit(Servo_Motion_TypeDef* Motion, uint16_t Pulse)
+{
+    Motion->Position = SERVO_MOTION_Q16(Pulse);
+    Motion->Step = 0;
+    Motion->Target = Pulse;
+    Motion->Remain = 0;
+}
+
+/**
+  * @brief  按指定帧数移动到目标，最后一帧精确到达
+  * @param  Motion: 运动状态
+  * @param  Target: 目标脉宽(微秒)
+  * @param  Frames: 帧数，0为立即到达
+  * @retval 无
+  */
+void Servo_MotionSetTargetFrames(Servo_Motion_TypeDef* Motion, uint16_t Target, uint16_t Frames)
+{
+    uint32_t target = SERVO_MOTION_Q16(Target);
+    uint32_t distance;
+
+    Motion->Target = Target;
+
+    if(Frames == 0 || Motion->Position == target)
+    {
+        Motion->Position = target;
+        Motion->Step = 0;
+        Motion->Remain = 0;
+        return;
+    }
+
+    distance = (target > Motion->Position) ? (target - Motion->Position) : (Motion->Position - target);
+
+    /*向下取整，前Frames-1帧不会越过目标*/
+    Motion->Step = (int32_t)(distance / Frames);
+    if(target < Motion->Position)
+    {
+        Motion->Step = -Motion->Step;
+    }
+    Motion->Remain = Frames;
+}
+
+/**
+  * @brief  按速度移动到目标
+  * @param  Motion: 运动状态
+  * @param  Target: 目标脉宽(微秒)
+  * @param  Speed: 速度(微秒/秒)，0为立即到达
+  * @param  FrameTime: 帧周期(微秒)
+  * @retval 无
+  */
+void Servo_MotionSetTarget(Servo_Motion_TypeDef* Motion, uint16_t Target, uint32_t Speed, uint32_t FrameTime)
+{
+    uint32_t target = SERVO_MOTION_Q16(Target);
+    uint32_t distance;
+    uint64_t step;
+    uint64_t frames;
+
+    if(Speed == 0)
+    {
+        Servo_MotionSetTargetFrames(Motion, Target, 0);
+        return;
+    }
+
+    distance = (target > Motion->Position) ? (target - Motion->Position) : (Motion->Position - target);
+
+    /*每帧步进 = Speed * FrameTime / 1000000，Q16*/
+    step = (((uint64_t)Speed * FrameTime) << 16) / 1000000;
+    if(step == 0)
+    {
+        step = 1;
+    }
+
+    frames = (distance + step - 1) / step;
+    if(frames > 0xFFFF)
+    {
+        frames = 0xFFFF;
+    }
+
+    Servo_MotionSetTargetFrames(Motion, Target, (uint16_t)frames);
+}
+
+/**
+  * @brief  推进一帧
+  * @param  Motion: 运动状态
+  * @retval 本帧脉宽(微秒)
+  */
+uint16_t Servo_MotionUpdate(Servo_Motion_TypeDef* Motion)
+{
+    if(Motion->Remain)
+    {
+        Motion->Remain--;
+        if(Motion->Remain == 0)
+        {
+            Motion->Position = SERVO_MOTION_Q16(Motion->Target);
+            Motion->Step = 0;
+        }
+        else
+        {
+            Motion->Position += (uint32_t)Motion->Step;
+        }
+    }
+
+    return Servo_MotionGetPulse(Motion);
+}
+
+/**
+  * @brief  获取当前脉宽
+  * @param  Motion: 运动状态
+  * @retval 脉宽(微秒，四舍五入)
+  */
+uint16_t Servo_MotionGetPulse(const Servo_Motion_TypeDef* Motion)
+{
+    return (uint16_t)((Motion->Position + 0x8000) >> 16);
+}
+
+/**
+  * @brief  是否已到达目标
+  * @param  Motion: 运动状态
+  * @retval true: 已到达
+  */
+bool Servo_MotionIsDone(const Servo_Motion_TypeDef* Motion)
+{
+    return Motion->Remain == 0;
+}
+
+/**
+  * @brief  时间转换为帧数，向上取整
+  * @param  Duration: 时间(毫秒)
+  * @param  FrameTime: 帧周期(微秒)
+  * @retval 帧数
+  */
+uint16_t Servo_DurationToFrames(uint32_t Duration, uint32_t FrameTime)
+{
+    uint64_t frames;
+
+    if(FrameTime == 0)
+    {
+        return 0;
+    }
+
+    frames = ((uint64_t)Duration * 1000 + FrameTime - 1) / FrameTime;
+    return (frames > 0xFFFF) ? 0xFFFF : (uint16_t)frames;
+}
+
+/**
+  * @brief  角度转换为脉宽，整数运算，四舍五入，超出范围时限幅
+  * @param  Angle: 角度
+  * @param  MinAngle: 最小角度
+  * @param  MaxAngle: 最大角度
+  * @param  MinPulse: 最小角度对应脉宽(微秒)
+  * @param  MaxPulse: 最大角度对应脉宽(微秒)
+  * @retval 脉宽(微秒)
+  */
+uint16_t Servo_AngleToPulse(int32_t Angle, int32_t MinAngle, int32_t MaxAngle, uint16_t MinPulse, uint16_t MaxPulse)
+{
+    int32_t low = (MinAngle < MaxAngle) ? MinAngle : MaxAngle;
+    int32_t high = (MinAngle < MaxAngle) ? MaxAngle : MinAngle;
+    int32_t num, den;
+
+    if(MinAngle == MaxAngle)
+    {
+        return MinPulse;
+    }
+
+    Angle = (Angle < low) ? low : ((Angle > high) ? high : Angle);
+
+    num = (Angle - MinAngle) * ((int32_t)MaxPulse - MinPulse);
+    den = MaxAngle - MinAngle;
+    if(den < 0)
+    {
+        num = -num;
+        den = -den;
+    }
+
+    /*四舍五入(远离0)*/
+    num = (num >= 0) ? (num + den / 2) : (num - den / 2);
+    return (uint16_t)(MinPulse + num / den);
+}
+
+/**
+  * @brief  计算一个通道在一帧内可依次输出的舵机数
+  * @param  FrameTime: 帧周期(微秒)
+  * @param  PulseMax: 最大脉宽(微秒)
+  * @param  Guard: 相邻脉冲间的余量(微秒)，包含中断延迟
+  * @retval 舵机数
+  */
+uint8_t Servo_LaneCapacity(uint32_t FrameTime, uint16_t PulseMax, uint16_t Guard)
+{
+    uint32_t slot = (uint32_t)PulseMax + Guard;
+    uint32_t count;
+
+    if(slot == 0)
+    {
+        return 0;
+    }
+
+    /*留出一个余量给帧起始中断*/
+    count = (FrameTime > Guard) ? (FrameTime - Guard) / slot : 0;
+    return (count > 0xFF) ? 0xFF : (uint8_t)count;
+}
@@ -0,0 +1,61 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __SERVO_MOTION_H
+#define __SERVO_MOTION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 舵机运动计算：脉宽以微秒为单位，位置用Q16定点数，每帧(通常20ms)调用一次Update。
+ * 限速移动按速度计算每帧步进；同步移动按帧数计算，所有舵机在同一帧到达目标。
+ * 本文件不访问寄存器，可在PC上编译验证。
+ */
+typedef struct
+{
+    uint32_t Position;  // 当前位置(Q16微秒)
+    int32_t  Step;      // 每帧步进(Q16微秒)
+    uint16_t Target;    // 目标脉宽(微秒)
+    uint16_t Remain;    // 剩余帧数，0表示已到达
+} Servo_Motion_TypeDef;
+
+void     Servo_MotionInit(Servo_Motion_TypeDef* Motion, uint16_t Pulse);
+void     Servo_MotionSetTarget(Servo_Motion_TypeDef* Motion, uint16_t Target, uint32_t Speed, uint32_t FrameTime);
+void     Servo_MotionSetTargetFrames(Servo_Motion_TypeDef* Motion, uint16_t Target, uint16_t Frames);
+uint16_t Servo_MotionUpdate(Servo_Motion_TypeDef* Motion);
+uint16_t Servo_MotionGetPulse(const Servo_Motion_TypeDef* Motion);
+bool     Servo_MotionIsDone(const Servo_Motion_TypeDef* Motion);
+
+uint16_t Servo_DurationToFrames(uint32_t Duration, uint32_t FrameTime);
+uint16_t Servo_AngleToPulse(int32_t Angle, int32_t MinAngle, int32_t MaxAngle, uint16_t MinPulse, uint16_t MaxPulse);
+uint8_t  Servo_LaneCapacity(uint32_t FrameTime, uint16_t PulseMax, uint16_t Guard);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SERVO_MOTION_H */
@@ -0,0 +1,385 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "servo_seq.h"
+#include "timer.h"
+#include "Arduino.h"
+
+#if SERVO_SEQ_ENABLE
+
+/*
+ * 舵机序列发生器：一个定时器以1MHz计数，溢出周期为一帧(20ms)。
+ * 4个比较通道各为一路，帧起始时每路拉高第一个舵机的引脚，
+ * 比较匹配时拉低当前引脚、拉高下一个并设置新的比较值，
+ * 每路依次输出多个舵机，引脚可为任意GPIO，不占用PWM通道。
+ */
+
+#define SERVO_SEQ_LANES         4
+#define SERVO_SEQ_LANE_SIZE     ((SERVO_SEQ_MAX + SERVO_SEQ_LANES - 1) / SERVO_SEQ_LANES)
+
+typedef struct
+{
+    gpio_type* GPIOx;
+    uint16_t GPIO_Pin_x;
+    uint16_t Pulse;
+    bool Active;
+    Servo_Motion_TypeDef Motion;
+} ServoSeq_TypeDef;
+
+static ServoSeq_TypeDef ServoSeq_Servo[SERVO_SEQ_MAX];
+
+static uint8_t ServoSeq_LaneMember[SERVO_SEQ_LANES][SERVO_SEQ_LANE_SIZE];
+static uint8_t ServoSeq_LaneCount[SERVO_SEQ_LANES];
+static uint8_t ServoSeq_LaneIndex[SERVO_SEQ_LANES];
+
+/*增删舵机后在下一帧起始时重新分配通道*/
+static volatile bool ServoSeq_LayoutDirty = false;
+
+static const uint32_t ServoSeq_LaneFlag[SERVO_SEQ_LANES] =
+{
+    TMR_C1_FLAG, TMR_C2_FLAG, TMR_C3_FLAG, TMR_C4_FLAG
+};
+
+static const uint32_t ServoSeq_LaneInt[SERVO_SEQ_LANES] =
+{
+    TMR_C1_INT, TMR_C2_INT, TMR_C3_INT, TMR_C4_INT
+};
+
+static const tmr_channel_select_type ServoSeq_LaneChannel[SERVO_SEQ_LANES] =
+{
+    TMR_SELECT_CHANNEL_1, TMR_SELECT_CHANNEL_2, TMR_SELECT_CHANNEL_3, TMR_SELECT_CHANNEL_4
+};
+
+static uint16_t ServoSeq_Constrain(uint16_t Pulse)
+{
+    return constrain(Pulse, SERVO_SEQ_PULSE_MIN, SERVO_SEQ_PULSE_MAX);
+}
+
+static void ServoSeq_Relayout(void)
+{
+    uint8_t id;
+    uint8_t lane = 0;
+    uint8_t i;
+
+    for(i = 0; i < SERVO_SEQ_LANES; i++)
+    {
+        ServoSeq_LaneCount[i] = 0;
+    }
+
+    /*轮流分配，各路舵机数最多相差1*/
+    for(id = 0; id < SERVO_SEQ_MAX; id++)
+    {
+        if(ServoSeq_Servo[id].Active)
+        {
+            ServoSeq_LaneMember[lane][ServoSeq_LaneCount[lane]++] = id;
+            lane = (lane + 1) % SERVO_SEQ_LANES;
+        }
+    }
+
+    ServoSeq_LayoutDirty = false;
+}
+
+static void ServoSeq_LaneStart(tmr_type* TIMx, uint8_t lane)
+{
+    ServoSeq_TypeDef* servo = &ServoSeq_Servo[ServoSeq_LaneMember[lane][ServoSeq_LaneIndex[lane]]];
+
+    GPIO_HIGH(servo->GPIOx, servo->GPIO_Pin_x);
+
+    /*以拉高后的计数值为起点，脉宽不受中断延迟影响*/
+    tmr_channel_value_set(TIMx, ServoSeq_LaneChannel[lane], TIMx->cval + servo->Pulse);
+}
+
+static void ServoSeq_FrameStart(tmr_type* TIMx)
+{
+    uint8_t id;
+    uint8_t lane;
+
+    if(ServoSeq_LayoutDirty)
+    {
+        ServoSeq_Relayout();
+    }
+
+    for(id = 0; id < SERVO_SEQ_MAX; id++)
+    {
+        if(ServoSeq_Servo[id].Active)
+        {
+            ServoSeq_Servo[id].Pulse = Servo_MotionUpdate(&ServoSeq_Servo[id].Motion);
+        }
+    }
+
+    for(lane = 0; lane < SERVO_SEQ_LANES; lane++)
+    {
+        tmr_flag_clear(TIMx, ServoSeq_LaneFlag[lane]);
+
+        if(ServoSeq_LaneCount[lane] == 0)
+        {
+            tmr_interrupt_enable(TIMx, ServoSeq_LaneInt[lane], FALSE);
+            continue;
+        }
+
+        ServoSeq_LaneIndex[lane] = 0;
+        ServoSeq_LaneStart(TIMx, lane);
+        tmr_interrupt_enable(TIMx, ServoSeq_LaneInt[lane], TRUE);
+    }
+}
+
+static void ServoSeq_LaneNext(tmr_type* TIMx, uint8_t lane)
+{
+    ServoSeq_TypeDef* servo = &ServoSeq_Servo[ServoSeq_LaneMember[lane][ServoSeq_LaneIndex[lane]]];
+
+    GPIO_LOW(servo->GPIOx, servo->GPIO_Pin_x);
+
+    if(++ServoSeq_LaneIndex[lane] < ServoSeq_LaneCount[lane])
+    {
+        ServoSeq_LaneStart(TIMx, lane);
+    }
+    else
+    {
+        tmr_interrupt_enable(TIMx, ServoSeq_LaneInt[lane], FALSE);
+    }
+}
+
+static void ServoSeq_EventHandler(tmr_type* TIMx, uint32_t Flags, void* UserData)
+{
+    uint8_t lane;
+
+    /*先处理本帧最后的下降沿，再开始新的一帧*/
+    for(lane = 0; lane < SERVO_SEQ_LANES; lane++)
+    {
+        if(Flags & ServoSeq_LaneFlag[lane])
+        {
+            ServoSeq_LaneNext(TIMx, lane);
+        }
+    }
+
+    if(Flags & TMR_OVF_FLAG)
+    {
+        ServoSeq_FrameStart(TIMx);
+    }
+}
+
+/**
+  * @brief  舵机序列发生器初始化
+  * @param  无
+  * @retval true: 成功，false: 每路舵机数超过一帧能容纳的数量
+  */
+bool ServoSeq_Init(void)
+{
+    tmr_type* TIMx = SERVO_SEQ_TIMER;
+    uint8_t lane;
+
+    if(SERVO_SEQ_LANE_SIZE > Servo_LaneCapacity(SERVO_SEQ_FRAME_TIME, SERVO_SEQ_PULSE_MAX, SERVO_SEQ_GUARD))
+    {
+        return false;
+    }
+
+    tmr_reset(TIMx);
+    Timer_ClockCmd(TIMx, true);
+    tmr_base_init(TIMx, SERVO_SEQ_FRAME_TIME - 1, Timer_GetClockMax(TIMx) / 1000000 - 1);
+    tmr_cnt_dir_set(TIMx, TMR_COUNT_UP);
+
+    /*比较通道只产生中断，不输出，比较值立即生效*/
+    for(lane = 0; lane < SERVO_SEQ_LANES; lane++)
+    {
+        tmr_output_channel_mode_select(TIMx, ServoSeq_LaneChannel[lane], TMR_OUTPUT_CONTROL_OFF);
+        tmr_output_channel_buffer_enable(TIMx, ServoSeq_LaneChannel[lane], FALSE);
+        ServoSeq_LaneCount[lane] = 0;
+    }
+
+    Timer_SetEventCallback(
+        TIMx,
+        ServoSeq_EventHandler,
+        NULL,
+        SERVO_SEQ_PREEMPTIONPRIORITY,
+        SERVO_SEQ_SUBPRIORITY
+    );
+
+    tmr_flag_clear(TIMx, TMR_OVF_FLAG);
+    tmr_interrupt_enable(TIMx, TMR_OVF_INT, TRUE);
+    Timer_SetEnable(TIMx, true);
+    return true;
+}
+
+/**
+  * @brief  添加舵机，从下一帧开始输出
+  * @param  Pin: 任意GPIO引脚
+  * @param  Pulse: 初始脉宽(微秒)
+  * @retval 舵机编号，SERVO_SEQ_INVALID: 已满或引脚无效
+  */
+uint8_t ServoSeq_Attach(uint8_t Pin, uint16_t Pulse)
+{
+    uint8_t id;
+    uint32_t primask;
+
+    if(!IS_PIN(Pin))
+    {
+        return SERVO_SEQ_INVALID;
+    }
+
+    for(id = 0; id < SERVO_SEQ_MAX; id++)
+    {
+        if(!ServoSeq_Servo[id].Active)
+        {
+            break;
+        }
+    }
+
+    if(id == SERVO_SEQ_MAX)
+    {
+        return SERVO_SEQ_INVALID;
+    }
+
+    pinMode(Pin, OUTPUT);
+    digitalWrite_LOW(Pin);
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    ServoSeq_Servo[id].GPIOx = PIN_MAP[Pin].GPIOx;
+    ServoSeq_Servo[id].GPIO_Pin_x = PIN_MAP[Pin].GPIO_Pin_x;
+    Servo_MotionInit(&ServoSeq_Servo[id].Motion, ServoSeq_Constrain(Pulse));
+    ServoSeq_Servo[id].Pulse = Servo_MotionGetPulse(&ServoSeq_Servo[id].Motion);
+    ServoSeq_Servo[id].Active = true;
+    ServoSeq_LayoutDirty = true;
+
+    __set_PRIMASK(primask);
+    return id;
+}
+
+/**
+  * @brief  移除舵机，引脚保持低电平
+  * @param  Id: 舵机编号
+  * @retval 无
+  */
+void ServoSeq_Detach(uint8_t Id)
+{
+    uint32_t primask;
+
+    if(Id >= SERVO_SEQ_MAX || !ServoSeq_Servo[Id].Active)
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    ServoSeq_Servo[Id].Active = false;
+    ServoSeq_LayoutDirty = true;
+    GPIO_LOW(ServoSeq_Servo[Id].GPIOx, ServoSeq_Servo[Id].GPIO_Pin_x);
+
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  立即设置脉宽
+  * @param  Id: 舵机编号
+  * @param  Pulse: 脉宽(微秒)
+  * @retval 无
+  */
+void ServoSeq_Write(uint8_t Id, uint16_t Pulse)
+{
+    ServoSeq_MoveTo(Id, Pulse, 0);
+}
+
+/**
+  * @brief  按速度移动到目标脉宽
+  * @param  Id: 舵机编号
+  * @param  Pulse: 目标脉宽(微秒)
+  * @param  Speed: 速度(微秒/秒)，0为立即到达
+  * @retval 无
+  */
+void ServoSeq_MoveTo(uint8_t Id, uint16_t Pulse, uint32_t Speed)
+{
+    uint32_t primask;
+
+    if(Id >= SERVO_SEQ_MAX)
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    Servo_MotionSetTarget(&ServoSeq_Servo[Id].Motion, ServoSeq_Constrain(Pulse), Speed, SERVO_SEQ_FRAME_TIME);
+
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  同步移动，所有舵机同时开始并在同一帧到达
+  * @param  Id: 舵机编号数组
+  * @param  Pulse: 目标脉宽数组(微秒)
+  * @param  Count: 数组长度
+  * @param  Duration: 移动时间(毫秒)
+  * @retval 无
+  */
+void ServoSeq_MoveGroup(const uint8_t* Id, const uint16_t* Pulse, uint8_t Count, uint32_t Duration)
+{
+    uint16_t frames = Servo_DurationToFrames(Duration, SERVO_SEQ_FRAME_TIME);
+    uint32_t primask;
+    uint8_t i;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    for(i = 0; i < Count; i++)
+    {
+        if(Id[i] < SERVO_SEQ_MAX)
+        {
+            Servo_MotionSetTargetFrames(&ServoSeq_Servo[Id[i]].Motion, ServoSeq_Constrain(Pulse[i]), frames);
+        }
+    }
+
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  获取当前输出的脉宽
+  * @param  Id: 舵机编号
+  * @retval 脉宽(微秒)，0: 编号无效
+  */
+uint16_t ServoSeq_Read(uint8_t Id)
+{
+    if(Id >= SERVO_SEQ_MAX || !ServoSeq_Servo[Id].Active)
+    {
+        return 0;
+    }
+
+    return ServoSeq_Servo[Id].Pulse;
+}
+
+/**
+  * @brief  是否正在移动
+  * @param  Id: 舵机编号
+  * @retval true: 未到达目标
+  */
+bool ServoSeq_IsMoving(uint8_t Id)
+{
+    if(Id >= SERVO_SEQ_MAX)
+    {
+        return false;
+    }
+
+    return !Servo_MotionIsDone(&ServoSeq_Servo[Id].Motion);
+}
+
+#endif /* SERVO_SEQ_ENABLE */
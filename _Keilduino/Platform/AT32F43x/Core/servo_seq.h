@@ -0,0 +1,51 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __SERVO_SEQ_H
+#define __SERVO_SEQ_H
+
+#include <stdbool.h>
+#include "mcu_type.h"
+#include "servo_motion.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SERVO_SEQ_INVALID   0xFF
+
+#if SERVO_SEQ_ENABLE
+bool     ServoSeq_Init(void);
+uint8_t  ServoSeq_Attach(uint8_t Pin, uint16_t Pulse);
+void     ServoSeq_Detach(uint8_t Id);
+void     ServoSeq_Write(uint8_t Id, uint16_t Pulse);
+void     ServoSeq_MoveTo(uint8_t Id, uint16_t Pulse, uint32_t Speed);
+void     ServoSeq_MoveGroup(const uint8_t* Id, const uint16_t* Pulse, uint8_t Count, uint32_t Duration);
+uint16_t ServoSeq_Read(uint8_t Id);
+bool     ServoSeq_IsMoving(uint8_t Id);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SERVO_SEQ_H */
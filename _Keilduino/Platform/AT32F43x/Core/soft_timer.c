@@ -0,0 +1,210 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "soft_timer.h"
+#include "timer.h"
+
+#if SOFT_TIMER_ENABLE
+
+/*
+ * 软件定时器：一个32位定时器以1MHz自由计数作为时基，
+ * CH1比较值只设置为时间轮的下一个事件(不产生周期节拍)，
+ * 任意数量的单次/周期定时器共用这一个硬件定时器。
+ * 回调在定时器中断中执行。
+ */
+
+/*空闲时的最长唤醒间隔，保证时间轮与计数器的差值不会回绕*/
+#define SOFT_TIMER_IDLE_MAX     0x40000000UL
+
+/*添加时到期时间相对时间轮当前时间的距离可达 IDLE_MAX + DELAY_MAX，超过2^31会被当作已过期*/
+#if (SOFT_TIMER_IDLE_MAX + SOFT_TIMER_DELAY_MAX) > 0x7FFFFFFFUL
+#  error "SOFT_TIMER_IDLE_MAX + SOFT_TIMER_DELAY_MAX must be less than 2^31"
+#endif
+
+static TimerWheel_TypeDef SoftTimer_Wheel;
+static bool SoftTimer_IsInit = false;
+
+static void SoftTimer_Reschedule(void)
+{
+    tmr_type* TIMx = SOFT_TIMER_TIMER;
+    uint32_t delta;
+    uint32_t target;
+
+    if(!TimerWheel_NextEvent(&SoftTimer_Wheel, &delta) || delta > SOFT_TIMER_IDLE_MAX)
+    {
+        delta = SOFT_TIMER_IDLE_MAX;
+    }
+
+    target = SoftTimer_Wheel.Now + delta;
+
+    tmr_flag_clear(TIMx, TMR_C1_FLAG);
+    tmr_channel_value_set(TIMx, TMR_SELECT_CHANNEL_1, target);
+
+    /*写入前计数器已越过目标，不会再匹配，软件触发比较事件*/
+    if((int32_t)(TIMx->cval - target) >= 0)
+    {
+        tmr_event_sw_trigger(TIMx, TMR_C1_SWTRIG);
+    }
+}
+
+static void SoftTimer_EventHandler(tmr_type* TIMx, uint32_t Flags, void* UserData)
+{
+    if(Flags & TMR_C1_FLAG)
+    {
+        TimerWheel_Advance(&SoftTimer_Wheel, TIMx->cval);
+        SoftTimer_Reschedule();
+    }
+}
+
+/**
+  * @brief  软件定时器服务初始化
+  * @param  无
+  * @retval true: 成功，false: 定时器不支持32位计数
+  */
+bool SoftTimer_Init(void)
+{
+    tmr_type* TIMx = SOFT_TIMER_TIMER;
+
+    if(!(TIMx == TIM2 || TIMx == TIM5))
+    {
+        return false;
+    }
+
+    if(SoftTimer_IsInit)
+    {
+        return true;
+    }
+
+    tmr_reset(TIMx);
+    Timer_ClockCmd(TIMx, true);
+
+    /*32位计数，1MHz时基*/
+    tmr_32_bit_function_enable(TIMx, TRUE);
+    tmr_base_init(TIMx, 0xFFFFFFFF, Timer_GetClockMax(TIMx) / 1000000 - 1);
+    tmr_cnt_dir_set(TIMx, TMR_COUNT_UP);
+
+    /*CH1仅作比较，不输出，比较值立即生效*/
+    tmr_output_channel_mode_select(TIMx, TMR_SELECT_CHANNEL_1, TMR_OUTPUT_CONTROL_OFF);
+    tmr_output_channel_buffer_enable(TIMx, TMR_SELECT_CHANNEL_1, FALSE);
+
+    tmr_counter_value_set(TIMx, 0);
+    TimerWheel_Init(&SoftTimer_Wheel, 0);
+
+    Timer_SetEventCallback(
+        TIMx,
+        SoftTimer_EventHandler,
+        NULL,
+        SOFT_TIMER_PREEMPTIONPRIORITY,
+        SOFT_TIMER_SUBPRIORITY
+    );
+
+    SoftTimer_Reschedule();
+    tmr_flag_clear(TIMx, TMR_OVF_FLAG);
+    tmr_interrupt_enable(TIMx, TMR_C1_INT, TRUE);
+    Timer_SetEnable(TIMx, true);
+
+    SoftTimer_IsInit = true;
+    return true;
+}
+
+/**
+  * @brief  创建软件定时器
+  * @param  Timer: 定时器对象，由调用者分配，运行期间不能释放
+  * @param  Function: 到期回调，在中断中执行
+  * @param  UserData: 用户数据
+  * @retval 无
+  */
+void SoftTimer_Create(SoftTimer_TypeDef* Timer, SoftTimer_CallbackFunction_t Function, void* UserData)
+{
+    TimerWheel_NodeInit(Timer, Function, UserData);
+}
+
+/**
+  * @brief  启动软件定时器，正在运行时重新开始计时
+  * @param  Timer: 定时器对象
+  * @param  Delay: 首次到期延时(微秒)，不超过SOFT_TIMER_DELAY_MAX
+  * @param  Period: 之后的周期(微秒)，0为单次
+  * @retval 无
+  */
+void SoftTimer_Start(SoftTimer_TypeDef* Timer, uint32_t Delay, uint32_t Period)
+{
+    uint32_t primask;
+
+    if(Delay > SOFT_TIMER_DELAY_MAX)
+    {
+        Delay = SOFT_TIMER_DELAY_MAX;
+    }
+
+    if(Period > SOFT_TIMER_DELAY_MAX)
+    {
+        Period = SOFT_TIMER_DELAY_MAX;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    TimerWheel_Add(&SoftTimer_Wheel, Timer, SOFT_TIMER_TIMER->cval + Delay, Period);
+    SoftTimer_Reschedule();
+
+    __set_PRIMASK(primask);
+}
+
+/**
+  * @brief  停止软件定时器
+  * @param  Timer: 定时器对象
+  * @retval true: 停止前正在运行
+  */
+bool SoftTimer_Stop(SoftTimer_TypeDef* Timer)
+{
+    uint32_t primask;
+    bool retval;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    retval = TimerWheel_Remove(&SoftTimer_Wheel, Timer);
+
+    __set_PRIMASK(primask);
+    return retval;
+}
+
+/**
+  * @brief  软件定时器是否正在运行
+  * @param  Timer: 定时器对象
+  * @retval true: 正在运行
+  */
+bool SoftTimer_IsRunning(const SoftTimer_TypeDef* Timer)
+{
+    return TimerWheel_IsPending(Timer);
+}
+
+/**
+  * @brief  获取软件定时器时基
+  * @param  无
+  * @retval 微秒计数，约71.6分钟回绕
+  */
+uint32_t SoftTimer_GetMicros(void)
+{
+    return SOFT_TIMER_TIMER->cval;
+}
+
+#endif /* SOFT_TIMER_ENABLE */
@@ -0,0 +1,55 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __SOFT_TIMER_H
+#define __SOFT_TIMER_H
+
+#include <stdbool.h>
+#include "mcu_type.h"
+#include "timer_wheel.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef TimerWheel_Node_TypeDef SoftTimer_TypeDef;
+typedef TimerWheel_Callback_t SoftTimer_CallbackFunction_t;
+
+/* 最大延时(微秒)，约16.8分钟；
+ * 时间轮的当前时间最多落后计数器SOFT_TIMER_IDLE_MAX，两者之和须小于2^31，并留有中断延迟余量
+ */
+#define SOFT_TIMER_DELAY_MAX    0x3C000000UL
+
+#if SOFT_TIMER_ENABLE
+bool     SoftTimer_Init(void);
+void     SoftTimer_Create(SoftTimer_TypeDef* Timer, SoftTimer_CallbackFunction_t Function, void* UserData);
+void     SoftTimer_Start(SoftTimer_TypeDef* Timer, uint32_t Delay, uint32_t Period);
+bool     SoftTimer_Stop(SoftTimer_TypeDef* Timer);
+bool     SoftTimer_IsRunning(const SoftTimer_TypeDef* Timer);
+uint32_t SoftTimer_GetMicros(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SOFT_TIMER_H */
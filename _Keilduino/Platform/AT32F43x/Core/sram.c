@@ -0,0 +1,155 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "sram.h"
+#include <string.h>
+
+/*用户系统数据区EOPB0(低字节为数据，高字节为反码)和闪存容量寄存器(KB)*/
+#ifndef SRAM_USD_EOPB0_ADDR
+#  define SRAM_USD_EOPB0_ADDR       0x1FFFC010UL
+#endif
+#ifndef SRAM_FLASH_SIZE_ADDR
+#  define SRAM_FLASH_SIZE_ADDR      0x1FFFF7E0UL
+#endif
+
+#define SRAM_FLASH_BASE             0x08000000UL
+#define SRAM_RAM_BASE               0x20000000UL
+#define SRAM_TOTAL_KB               640U
+#define SRAM_EOPB0_DEFAULT          0x02U
+#define SRAM_VECTOR_NUM             256 // 16个内核异常 + 中断，对齐到2的幂
+
+/*链接后RAM使用的结束地址*/
+#if defined(__CC_ARM)
+extern uint32_t Image$$RW_IRAM1$$ZI$$Limit;
+#  define SRAM_LINK_END             ((uint32_t)&Image$$RW_IRAM1$$ZI$$Limit)
+#elif defined(__GNUC__)
+extern uint32_t __StackTop;
+#  define SRAM_LINK_END             ((uint32_t)&__StackTop)
+#endif
+
+/*EOPB0[2:0]对应的ZW闪存容量(KB)，SRAM为其余部分*/
+static const uint16_t SRAM_ZeroWaitTable[8] = { 128, 192, 256, 320, 384, 448, 512, 512 };
+
+/**
+  * @brief  按EOPB0和闪存容量计算SRAM/ZW划分
+  * @param  EOPB0: EOPB0[2:0]
+  * @param  FlashSizeKB: 闪存容量(KB)
+  * @param  Config: 输出
+  * @retval 无
+  */
+void SRAM_DecodeConfig(uint8_t EOPB0, uint32_t FlashSizeKB, SRAM_Config_TypeDef* Config)
+{
+    uint32_t zwKB = SRAM_ZeroWaitTable[EOPB0 & 0x07U];
+
+    if(zwKB > FlashSizeKB)
+    {
+        zwKB = FlashSizeKB;
+    }
+
+    Config->EOPB0 = EOPB0 & 0x07U;
+    Config->FlashSize = FlashSizeKB * 1024U;
+    Config->ZeroWaitSize = zwKB * 1024U;
+    Config->SramSize = (SRAM_TOTAL_KB - zwKB) * 1024U;
+}
+
+/**
+  * @brief  读取当前生效的SRAM/ZW划分
+  * @param  Config: 输出
+  * @retval 无
+  */
+void SRAM_GetConfig(SRAM_Config_TypeDef* Config)
+{
+    uint16_t eopb0 = *(volatile const uint16_t*)SRAM_USD_EOPB0_ADDR;
+    uint16_t flashKB = *(volatile const uint16_t*)SRAM_FLASH_SIZE_ADDR;
+    uint8_t value = (uint8_t)eopb0;
+
+    /*反码校验失败(未编程的系统数据区)按出厂默认处理*/
+    if((uint8_t)(eopb0 >> 8) != (uint8_t)~value)
+    {
+        value = SRAM_EOPB0_DEFAULT;
+    }
+
+    SRAM_DecodeConfig(value, flashKB, Config);
+}
+
+/**
+  * @brief  判断从该地址取指是否为零等待(SRAM或ZW闪存)
+  * @param  Addr: 地址(函数指针可直接传入，Thumb位被忽略)
+  * @retval true: 零等待
+  */
+bool SRAM_IsZeroWait(const void* Addr)
+{
+    SRAM_Config_TypeDef config;
+    uint32_t addr = (uint32_t)Addr & ~1UL;
+
+    SRAM_GetConfig(&config);
+
+    if(addr >= SRAM_RAM_BASE && addr < SRAM_RAM_BASE + config.SramSize)
+    {
+        return true;
+    }
+
+    return (addr >= SRAM_FLASH_BASE && addr < SRAM_FLASH_BASE + config.ZeroWaitSize);
+}
+
+/**
+  * @brief  检查链接时的RAM布局是否在当前SRAM容量内，
+  *         修改EOPB0后需同步修改mcu_config.h的SRAM_EOPB0(分散加载文件按它计算RW_IRAM1大小)
+  * @param  无
+  * @retval true: 布局有效
+  */
+bool SRAM_CheckLayout(void)
+{
+#ifdef SRAM_LINK_END
+    SRAM_Config_TypeDef config;
+    SRAM_GetConfig(&config);
+    return (SRAM_LINK_END <= SRAM_RAM_BASE + config.SramSize);
+#else
+    return true;
+#endif
+}
+
+/**
+  * @brief  把中断向量表复制到SRAM并切换VTOR，
+  *         取向量不再占用闪存带宽，也可在运行中修改中断入口
+  * @param  无
+  * @retval 无
+  */
+void SRAM_RelocateVectors(void)
+{
+    static uint32_t SRAM_VectorTable[SRAM_VECTOR_NUM] __attribute__((aligned(SRAM_VECTOR_NUM * 4)));
+    const uint32_t* src = (const uint32_t*)SCB->VTOR;
+    uint32_t primask;
+
+    if(src == SRAM_VectorTable)
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    memcpy(SRAM_VectorTable, src, sizeof(SRAM_VectorTable));
+    SCB->VTOR = (uint32_t)SRAM_VectorTable;
+    __DSB();
+    __ISB();
+    __set_PRIMASK(primask);
+}
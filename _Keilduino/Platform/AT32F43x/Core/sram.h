@@ -0,0 +1,73 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __SRAM_H
+#define __SRAM_H
+
+#include "mcu_type.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * AT32F435/437 的SRAM和零等待(ZW)闪存共用640KB片内RAM，
+ * 由用户系统数据区EOPB0[2:0]选择划分方式，复位后生效：
+ *
+ *   EOPB0[2:0]   SRAM    ZW闪存
+ *   000          512KB   128KB
+ *   001          448KB   192KB
+ *   010          384KB   256KB (出厂默认)
+ *   011          320KB   320KB
+ *   100          256KB   384KB
+ *   101          192KB   448KB
+ *   11x          128KB   512KB
+ *
+ * ZW区不超过闪存容量(256KB型号最多256KB ZW，其余划为SRAM)。
+ * 从ZW区取指没有等待周期，ZW区之外的闪存按系统时钟插入等待周期并依赖预取/缓存，
+ * 跳转和查表较多的中断处理函数执行时间随地址变化，可用 RAMFUNC/RAMFUNC_ISR 放入SRAM。
+ * 程序小于ZW区时全部代码已是零等待，放入SRAM没有收益，SRAM_IsZeroWait 可检查函数地址。
+ *
+ * 测量方法：在中断入口和出口读取DWT_CYCLE_CNT，分别在RAMFUNC_ISR_ENABLE为0/1
+ * 且函数位于ZW区外时比较最大值和抖动；SRAM中取指与DMA、CPU数据访问共用总线，
+ * 大量DMA传输时需实测。
+ */
+
+typedef struct
+{
+    uint8_t  EOPB0;         // EOPB0[2:0]
+    uint32_t FlashSize;     // 闪存容量(字节)
+    uint32_t SramSize;      // SRAM容量(字节)
+    uint32_t ZeroWaitSize;  // 零等待闪存容量(字节)，从闪存起始地址开始
+} SRAM_Config_TypeDef;
+
+void SRAM_DecodeConfig(uint8_t EOPB0, uint32_t FlashSizeKB, SRAM_Config_TypeDef* Config);
+void SRAM_GetConfig(SRAM_Config_TypeDef* Config);
+bool SRAM_IsZeroWait(const void* Addr);
+bool SRAM_CheckLayout(void);
+void SRAM_RelocateVectors(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SRAM_H */
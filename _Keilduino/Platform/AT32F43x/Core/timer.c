@@ -21,6 +21,7 @@
  * SOFTWARE.
  */
 #include "timer.h"
+#include "timer_factor.h"
 #include "gpio.h"
 
 typedef enum
@@ -32,6 +33,42 @@ typedef enum
 
 static Timer_CallbackFunction_t Timer_CallbackFunction[TIMER_MAX] = { 0 };
 
+static Timer_EventCallbackFunction_t Timer_EventCallback[TIMER_MAX] = { 0 };
+static void* Timer_EventUserData[TIMER_MAX] = { 0 };
+
+/*中断标志位，ists高位为重复捕获标志，不参与分发*/
+#define TIMER_EVENT_FLAG_MASK   0xFFU
+
+/*高级定时器每个中断通道只分发属于该通道的标志*/
+#define TIMER_VECTOR_BRK_MASK   (TMR_BRK_FLAG)
+#define TIMER_VECTOR_OVF_MASK   (TMR_OVF_FLAG)
+#define TIMER_VECTOR_TRG_MASK   (TMR_TRIGGER_FLAG | TMR_HALL_FLAG)
+#define TIMER_VECTOR_CH_MASK    (TMR_C1_FLAG | TMR_C2_FLAG | TMR_C3_FLAG | TMR_C4_FLAG)
+
+/**
+  * @brief  获取定时器编号
+  * @param  TIMx:定时器地址
+  * @retval 定时器编号，TIMER_MAX:无效定时器
+  */
+static TIMER_Type Timer_GetIndex(tmr_type* TIMx)
+{
+    int index;
+    static tmr_type* const TIMER_Map[TIMER_MAX] =
+    {
+        TMR1, TMR2, TMR3, TMR4, TMR5, TMR6, TMR7, TMR8,
+        TMR9, TMR10, TMR11, TMR12, TMR13, TMR14, TMR20
+    };
+
+    for(index = 0; index < TIMER_MAX; index++)
+    {
+        if(TIMx == TIMER_Map[index])
+        {
+            return (TIMER_Type)index;
+        }
+    }
+    return TIMER_MAX;
+}
+
 /**
   * @brief  启动或关闭指定定时器的时钟
   * @param  TIMx:定时器地址
@@ -77,109 +114,6 @@ void Timer_ClockCmd(tmr_type* TIMx, bool Enable)
     }
 }
 
-static int fast_isqrt(int n)
-{
-    int x = n;
-    int cm = 0;
-    int dm = 1 << 30;
-
-    while(dm > n)
-    {
-        dm >>= 2;
-    }
-
-    while (dm)
-    {
-        if (x >= cm + dm)
-        {
-            x -= cm + dm;
-            cm = (cm >> 1) + dm;
-        }
-        else
-        {
-            cm >>= 1;
-        }
-        dm >>= 2;
-    }
-
-    return cm;
-}
-
-/**
-  * @brief  频率因数分解，获取接近的值
-  * @param  freq: 中断频率(Hz)
-  * @param  clock: 定时器时钟
-  * @param  *period: 重装值地址
-  * @param  *prescaler: 时钟分频值地址
-  * @retval 误差值(Hz)
-  */
-static bool Timer_FreqFactorization(
-    uint32_t freq,
-    uint32_t clock,
-    uint16_t* factor1,
-    uint16_t* factor2,
-    int32_t* error
-)
-{
-    uint32_t targetProdect;
-    uint16_t fct1;
-    uint16_t fct2;
-    uint16_t fct1_save = 1;
-    uint16_t fct2_save = 1;
-    uint16_t fct_max;
-    uint16_t max_error = 0xFFFF;
-
-    if(freq == 0 || freq > clock)
-    {
-        return false;
-    }
-
-    /* 获取目标乘积 */
-    targetProdect = clock / freq;
-
-    /* 从targetProdect的平方根开始计算 */
-    fct1 = fast_isqrt(targetProdect);
-
-    /* 计算因数最大值，减少遍历次数 */
-    fct_max = (targetProdect < 0xFFFF) ? targetProdect : 0xFFFF;
-
-    /* 遍历，使两因数的乘积足够接近prodect */
-    for(; fct1 > 1; fct1--)
-    {
-        for(fct2 = fct1; fct2 < fct_max; fct2++)
-        {
-            /* 求误差 */
-            int32_t newerr = fct1 * fct2 - targetProdect;
-
-            if(newerr < 0)
-            {
-                newerr = -newerr;
-            }
-
-            if(newerr < max_error)
-            {
-                /* 保存最小误差 */
-                max_error = (uint16_t)newerr;
-
-                fct1_save = fct1;
-                fct2_save = fct2;
-
-                /* 最佳 */
-                if(max_error == 0)
-                {
-                    break;
-                }
-            }
-        }
-    }
-
-    *factor1 = fct1_save;
-    *factor2 = fct2_save;
-    *error = (freq - clock / (fct1_save * fct2_save));
-
-    return true;
-}
-
 /**
   * @brief  将定时中断时间转换为重装值和时钟分频值
   * @param  time: 中断时间(微秒)
@@ -583,36 +517,166 @@ gpio_mux_sel_type Timer_GetGPIO_MUX(uint8_t Pin)
     return GPIO_MUX_x;
 }
 
-#define TMRx_IRQHANDLER(n) \
-do{\
-    if (tmr_flag_get(TMR##n, TMR_OVF_FLAG) != RESET)\
+/**
+  * @brief  设置定时器事件回调，分发所有已使能的中断标志(溢出、捕获比较、触发、刹车等)，
+  *         并使能该定时器的全部中断通道(高级定时器有4个，每个通道只分发自己的标志)。
+  *         注意TMR1/TMR8的中断通道与TMR9~14共用(如TMR1_BRK_TMR9)，NVIC优先级属于中断通道，
+  *         以最后一次配置为准：共用通道的两个定时器应使用相同的优先级
+  * @param  TIMx:定时器地址
+  * @param  Function: 事件回调函数，NULL为取消
+  * @param  UserData: 用户数据
+  * @param  PreemptionPriority: 抢占优先级
+  * @param  SubPriority: 子优先级
+  * @retval true: 成功
+  */
+bool Timer_SetEventCallback(
+    tmr_type* TIMx,
+    Timer_EventCallbackFunction_t Function,
+    void* UserData,
+    uint8_t PreemptionPriority,
+    uint8_t SubPriority
+)
+{
+    IRQn_Type IRQn_List[4];
+    uint8_t IRQn_Count = 0;
+    uint8_t i;
+    TIMER_Type TIMERx = Timer_GetIndex(TIMx);
+
+    if(TIMERx == TIMER_MAX)
+    {
+        return false;
+    }
+
+#define TMRx_ADVANCED_IRQ_DEF(n, brk, ovf, trg, ch)\
+    else if(TIMx == TIM##n)\
     {\
-        if(Timer_CallbackFunction[TIMER##n])\
-        {\
-            Timer_CallbackFunction[TIMER##n]();\
-        }\
-        tmr_flag_clear(TMR##n, TMR_OVF_FLAG);\
-    }\
-}while(0)
+        IRQn_List[0] = brk;\
+        IRQn_List[1] = ovf;\
+        IRQn_List[2] = trg;\
+        IRQn_List[3] = ch;\
+        IRQn_Count = 4;\
+    }
+#define TMRx_GENERAL_IRQ_DEF(n, x_IRQn)\
+    else if(TIMx == TIM##n)\
+    {\
+        IRQn_List[0] = x_IRQn;\
+        IRQn_Count = 1;\
+    }
+
+    if(0) {}
+    TMRx_ADVANCED_IRQ_DEF(1, TMR1_BRK_TMR9_IRQn, TMR1_OVF_TMR10_IRQn, TMR1_TRG_HALL_TMR11_IRQn, TMR1_CH_IRQn)
+    TMRx_ADVANCED_IRQ_DEF(8, TMR8_BRK_TMR12_IRQn, TMR8_OVF_TMR13_IRQn, TMR8_TRG_HALL_TMR14_IRQn, TMR8_CH_IRQn)
+    TMRx_ADVANCED_IRQ_DEF(20, TMR20_BRK_IRQn, TMR20_OVF_IRQn, TMR20_TRG_HALL_IRQn, TMR20_CH_IRQn)
+    TMRx_GENERAL_IRQ_DEF(2, TMR2_GLOBAL_IRQn)
+    TMRx_GENERAL_IRQ_DEF(3, TMR3_GLOBAL_IRQn)
+    TMRx_GENERAL_IRQ_DEF(4, TMR4_GLOBAL_IRQn)
+    TMRx_GENERAL_IRQ_DEF(5, TMR5_GLOBAL_IRQn)
+    TMRx_GENERAL_IRQ_DEF(6, TMR6_DAC_GLOBAL_IRQn)
+    TMRx_GENERAL_IRQ_DEF(7, TMR7_GLOBAL_IRQn)
+    TMRx_GENERAL_IRQ_DEF(9, TMR1_BRK_TMR9_IRQn)
+    TMRx_GENERAL_IRQ_DEF(10, TMR1_OVF_TMR10_IRQn)
+    TMRx_GENERAL_IRQ_DEF(11, TMR1_TRG_HALL_TMR11_IRQn)
+    TMRx_GENERAL_IRQ_DEF(12, TMR8_BRK_TMR12_IRQn)
+    TMRx_GENERAL_IRQ_DEF(13, TMR8_OVF_TMR13_IRQn)
+    TMRx_GENERAL_IRQ_DEF(14, TMR8_TRG_HALL_TMR14_IRQn)
+
+    Timer_EventUserData[TIMERx] = UserData;
+    Timer_EventCallback[TIMERx] = Function;
+
+    if(Function)
+    {
+        for(i = 0; i < IRQn_Count; i++)
+        {
+            nvic_irq_enable(IRQn_List[i], PreemptionPriority, SubPriority);
+        }
+    }
+
+    return true;
+}
 
 /**
-  * @brief  定时中断入口，定时器1、10
+  * @brief  定时器中断分发
+  * @param  TIMx:定时器地址
+  * @param  TIMERx:定时器编号
+  * @param  Mask:本中断通道负责的标志
+  * @retval 无
+  */
+RAMFUNC_ISR static void Timer_IRQHandler(tmr_type* TIMx, TIMER_Type TIMERx, uint32_t Mask)
+{
+    uint32_t flags = TIMx->ists & TIMx->iden & Mask;
+
+    if(!flags)
+    {
+        return;
+    }
+
+    /*ists写0清除，写1无影响*/
+    TIMx->ists = ~flags;
+
+    /*用户回调在闪存中执行，除非回调本身加了RAMFUNC*/
+    if((flags & TMR_OVF_FLAG) && Timer_CallbackFunction[TIMERx])
+    {
+        Timer_CallbackFunction[TIMERx]();
+    }
+
+    if(Timer_EventCallback[TIMERx])
+    {
+        Timer_EventCallback[TIMERx](TIMx, flags, Timer_EventUserData[TIMERx]);
+    }
+}
+
+#define TMRx_IRQHANDLER(n) Timer_IRQHandler(TMR##n, TIMER##n, TIMER_EVENT_FLAG_MASK)
+#define TMRx_IRQHANDLER_VECTOR(n, vector) Timer_IRQHandler(TMR##n, TIMER##n, TIMER_VECTOR_##vector##_MASK)
+
+/**
+  * @brief  定时中断入口，定时器1刹车、9
   * @param  无
   * @retval 无
   */
-void TMR1_OVF_TMR10_IRQHandler(void)
+RAMFUNC_ISR void TMR1_BRK_TMR9_IRQHandler(void)
 {
+    TMRx_IRQHANDLER_VECTOR(1, BRK);
+    TMRx_IRQHANDLER(9);
+}
 
-    TMRx_IRQHANDLER(1);
+/**
+  * @brief  定时中断入口，定时器1、10
+  * @param  无
+  * @retval 无
+  */
+RAMFUNC_ISR void TMR1_OVF_TMR10_IRQHandler(void)
+{
+    TMRx_IRQHANDLER_VECTOR(1, OVF);
     TMRx_IRQHANDLER(10);
 }
 
+/**
+  * @brief  定时中断入口，定时器1触发、11
+  * @param  无
+  * @retval 无
+  */
+RAMFUNC_ISR void TMR1_TRG_HALL_TMR11_IRQHandler(void)
+{
+    TMRx_IRQHANDLER_VECTOR(1, TRG);
+    TMRx_IRQHANDLER(11);
+}
+
+/**
+  * @brief  定时中断入口，定时器1捕获比较
+  * @param  无
+  * @retval 无
+  */
+RAMFUNC_ISR void TMR1_CH_IRQHandler(void)
+{
+    TMRx_IRQHANDLER_VECTOR(1, CH);
+}
+
 /**
   * @brief  定时中断入口，定时器2
   * @param  无
   * @retval 无
   */
-void TMR2_GLOBAL_IRQHandler(void)
+RAMFUNC_ISR void TMR2_GLOBAL_IRQHandler(void)
 {
     TMRx_IRQHANDLER(2);
 }
@@ -622,7 +686,7 @@ void TMR2_GLOBAL_IRQHandler(void)
   * @param  无
   * @retval 无
   */
-void TMR3_GLOBAL_IRQHandler(void)
+RAMFUNC_ISR void TMR3_GLOBAL_IRQHandler(void)
 {
     TMRx_IRQHANDLER(3);
 }
@@ -632,7 +696,7 @@ void TMR3_GLOBAL_IRQHandler(void)
   * @param  无
   * @retval 无
   */
-void TMR4_GLOBAL_IRQHandler(void)
+RAMFUNC_ISR void TMR4_GLOBAL_IRQHandler(void)
 {
     TMRx_IRQHANDLER(4);
 }
@@ -642,7 +706,7 @@ void TMR4_GLOBAL_IRQHandler(void)
   * @param  无
   * @retval 无
   */
-void TMR5_GLOBAL_IRQHandler(void)
+RAMFUNC_ISR void TMR5_GLOBAL_IRQHandler(void)
 {
     TMRx_IRQHANDLER(5);
 }
@@ -652,7 +716,7 @@ void TMR5_GLOBAL_IRQHandler(void)
   * @param  无
   * @retval 无
   */
-void TMR6_DAC_GLOBAL_IRQHandler(void)
+RAMFUNC_ISR void TMR6_DAC_GLOBAL_IRQHandler(void)
 {
     TMRx_IRQHANDLER(6);
 }
@@ -662,7 +726,7 @@ void TMR6_DAC_GLOBAL_IRQHandler(void)
   * @param  无
   * @retval 无
   */
-void TMR7_GLOBAL_IRQHandler(void)
+RAMFUNC_ISR void TMR7_GLOBAL_IRQHandler(void)
 {
     TMRx_IRQHANDLER(7);
 }
@@ -672,18 +736,80 @@ void TMR7_GLOBAL_IRQHandler(void)
   * @param  无
   * @retval 无
   */
-void TMR8_OVF_TMR13_IRQHandler(void)
+RAMFUNC_ISR void TMR8_OVF_TMR13_IRQHandler(void)
 {
-    TMRx_IRQHANDLER(8);
+    TMRx_IRQHANDLER_VECTOR(8, OVF);
     TMRx_IRQHANDLER(13);
 }
 
 /**
-  * @brief  定时中断入口，定时器15
+  * @brief  定时中断入口，定时器8刹车、12
+  * @param  无
+  * @retval 无
+  */
+RAMFUNC_ISR void TMR8_BRK_TMR12_IRQHandler(void)
+{
+    TMRx_IRQHANDLER_VECTOR(8, BRK);
+    TMRx_IRQHANDLER(12);
+}
+
+/**
+  * @brief  定时中断入口，定时器8触发、14
+  * @param  无
+  * @retval 无
+  */
+RAMFUNC_ISR void TMR8_TRG_HALL_TMR14_IRQHandler(void)
+{
+    TMRx_IRQHANDLER_VECTOR(8, TRG);
+    TMRx_IRQHANDLER(14);
+}
+
+/**
+  * @brief  定时中断入口，定时器8捕获比较
+  * @param  无
+  * @retval 无
+  */
+RAMFUNC_ISR void TMR8_CH_IRQHandler(void)
+{
+    TMRx_IRQHANDLER_VECTOR(8, CH);
+}
+
+/**
+  * @brief  定时中断入口，定时器20刹车
+  * @param  无
+  * @retval 无
+  */
+RAMFUNC_ISR void TMR20_BRK_IRQHandler(void)
+{
+    TMRx_IRQHANDLER_VECTOR(20, BRK);
+}
+
+/**
+  * @brief  定时中断入口，定时器20
+  * @param  无
+  * @retval 无
+  */
+RAMFUNC_ISR void TMR20_OVF_IRQHandler(void)
+{
+    TMRx_IRQHANDLER_VECTOR(20, OVF);
+}
+
+/**
+  * @brief  定时中断入口，定时器20触发
+  * @param  无
+  * @retval 无
+  */
+RAMFUNC_ISR void TMR20_TRG_HALL_IRQHandler(void)
+{
+    TMRx_IRQHANDLER_VECTOR(20, TRG);
+}
+
+/**
+  * @brief  定时中断入口，定时器20捕获比较
   * @param  无
   * @retval 无
   */
-void TMR20_OVF_IRQHandler(void)
+RAMFUNC_ISR void TMR20_CH_IRQHandler(void)
 {
-    TMRx_IRQHANDLER(20);
+    TMRx_IRQHANDLER_VECTOR(20, CH);
 }
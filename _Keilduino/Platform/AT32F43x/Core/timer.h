@@ -31,6 +31,7 @@ extern "C" {
 #endif
    
 typedef void(*Timer_CallbackFunction_t)(void);
+typedef void(*Timer_EventCallbackFunction_t)(tmr_type* TIMx, uint32_t Flags, void* UserData);
 
 void     Timer_SetEnable(tmr_type* TIMx, bool Enable);
 void     Timer_SetInterrupt(tmr_type* TIMx, uint32_t time, Timer_CallbackFunction_t Function);
@@ -42,6 +43,11 @@ void     Timer_SetInterruptBase(
     Timer_CallbackFunction_t Function, 
     uint8_t PreemptionPriority, uint8_t SubPriority
 );
+bool     Timer_SetEventCallback(
+    tmr_type* TIMx,
+    Timer_EventCallbackFunction_t Function, void* UserData,
+    uint8_t PreemptionPriority, uint8_t SubPriority
+);
 void     Timer_SetCompare(tmr_type* TIMx, uint8_t TimerChannel, uint32_t Compare);
 void     Timer_SetPrescaler(tmr_type* TIMx, uint16_t Prescaler);
 void     Timer_SetReload(tmr_type* TIMx, uint16_t Reload);
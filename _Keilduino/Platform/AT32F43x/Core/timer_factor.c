@@ -0,0 +1,263 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "timer_factor.h"
+
+static int fast_isqrt(int n)
+{
+    int x = n;
+    int cm = 0;
+    int dm = 1 << 30;
+
+    while(dm > n)
+    {
+        dm >>= 2;
+    }
+
+    while (dm)
+    {
+        if (x >= cm + dm)
+        {
+            x -= cm + dm;
+            cm = (cm >> 1) + dm;
+        }
+        else
+        {
+            cm >>= 1;
+        }
+        dm >>= 2;
+    }
+
+    return cm;
+}
+
+/**
+  * @brief  比较两个乘积的频率误差
+  * @param  freq: 目标频率(Hz)
+  * @param  clock: 定时器时钟
+  * @param  below: 不大于clock/freq的乘积
+  * @param  above: 大于clock/freq的乘积
+  * @retval true: below的误差不大于above
+  */
+static bool Timer_FreqErrorLessEqual(uint32_t freq, uint32_t clock, uint32_t below, uint32_t above)
+{
+    /* (clock/below - freq) <= (freq - clock/above)，交叉相乘避免除法 */
+    uint64_t errBelow = (uint64_t)(clock - (uint64_t)freq * below) * above;
+    uint64_t errAbove = (uint64_t)((uint64_t)freq * above - clock) * below;
+    return errBelow <= errAbove;
+}
+
+/**
+  * @brief  频率因数分解，获取误差最小的值
+  * @param  freq: 中断频率(Hz)
+  * @param  clock: 定时器时钟
+  * @param  *factor1: 重装值地址
+  * @param  *factor2: 时钟分频值地址
+  * @param  *error: 误差值(Hz)
+  * @retval true: 成功
+  */
+bool Timer_FreqFactorization(
+    uint32_t freq,
+    uint32_t clock,
+    uint16_t* factor1,
+    uint16_t* factor2,
+    int32_t* error
+)
+{
+    uint32_t targetProdect;
+    uint32_t remainder;
+    uint32_t fct;
+    uint32_t fct_min;
+    uint32_t fct_max;
+    uint32_t below = 0, below_fct = 1;
+    uint32_t above = 0xFFFFFFFF, above_fct = 1;
+    uint32_t prodect, prodect_fct;
+    bool below_best;
+    bool above_best;
+
+    if(freq == 0 || freq > clock)
+    {
+        return false;
+    }
+
+    /* 实际目标乘积为 clock/freq，介于 targetProdect 和 targetProdect+1 之间 */
+    targetProdect = clock / freq;
+    remainder = clock % freq;
+
+    /* 误差最小的乘积只可能是不大于目标的最大乘积或大于目标的最小乘积，
+     * 只需遍历较小的因数 fct，较大的因数由除法直接得到，
+     * fct 的下限保证另一个因数不超过0xFFFF
+     */
+    fct_min = (targetProdect + 0xFFFE) / 0xFFFF;
+    if(fct_min > 0xFFFF)
+    {
+        *factor1 = 0xFFFF;
+        *factor2 = 0xFFFF;
+        *error = (int32_t)(freq - clock / (0xFFFFU * 0xFFFFU));
+        return true;
+    }
+
+    fct_max = fast_isqrt((int)targetProdect) + 1;
+    if(fct_max > 0xFFFF)
+    {
+        fct_max = 0xFFFF;
+    }
+
+    /* targetProdect 或 targetProdect+1 可分解时即为最优，提前退出 */
+    below_best = (remainder == 0) || Timer_FreqErrorLessEqual(freq, clock, targetProdect, targetProdect + 1);
+    above_best = !below_best;
+
+    for(fct = fct_min; fct <= fct_max; fct++)
+    {
+        uint32_t fct2 = targetProdect / fct;
+        uint32_t rem = targetProdect - fct2 * fct;
+
+        if(targetProdect - rem > below)
+        {
+            below = targetProdect - rem;
+            below_fct = fct;
+        }
+
+        if(fct2 < 0xFFFF && targetProdect - rem + fct < above)
+        {
+            above = targetProdect - rem + fct;
+            above_fct = fct;
+        }
+
+        if((below == targetProdect && below_best)
+                || (above == targetProdect + 1 && above_best)
+                || (below == targetProdect && above == targetProdect + 1))
+        {
+            break;
+        }
+    }
+
+    if(above == 0xFFFFFFFF || Timer_FreqErrorLessEqual(freq, clock, below, above))
+    {
+        prodect = below;
+        prodect_fct = below_fct;
+    }
+    else
+    {
+        prodect = above;
+        prodect_fct = above_fct;
+    }
+
+    /* 较大的因数作为重装值，保证计数分辨率 */
+    if(prodect / prodect_fct >= prodect_fct)
+    {
+        *factor1 = prodect / prodect_fct;
+        *factor2 = prodect_fct;
+    }
+    else
+    {
+        *factor1 = prodect_fct;
+        *factor2 = prodect / prodect_fct;
+    }
+    *error = (int32_t)(freq - clock / prodect);
+
+    return true;
+}
+
+/**
+  * @brief  按频率计算分频和周期，分辨率最高(分频最小)
+  * @param  Clock: 定时器时钟(Hz)
+  * @param  Frequency: 目标频率(mHz)
+  * @param  Period: 计数周期(pr+1)，即占空比分辨率
+  * @param  Prescaler: 分频系数(div+1)
+  * @retval true: 成功，false: 频率超出范围
+  */
+bool PWM_CalcPeriod(uint32_t Clock, uint32_t Frequency, uint32_t* Period, uint32_t* Prescaler)
+{
+    uint64_t psc;
+    uint64_t period;
+
+    if(Frequency == 0)
+    {
+        return false;
+    }
+
+    /*周期四舍五入后不超过65536的最小分频:
+     *Clock*1000/(psc*Frequency) < 65536.5
+     */
+    psc = (uint64_t)Clock * 2000 / ((uint64_t)131073 * Frequency) + 1;
+    if(psc > 0x10000)
+    {
+        return false;
+    }
+
+    /*四舍五入求周期*/
+    period = ((uint64_t)Clock * 1000 + psc * Frequency / 2) / (psc * Frequency);
+    if(period < 2)
+    {
+        return false;
+    }
+
+    *Period = (uint32_t)period;
+    *Prescaler = (uint32_t)psc;
+    return true;
+}
+
+/**
+  * @brief  死区时间编码(DTC)，向上取整，保证不短于设定值
+  * @param  Clock: 死区时钟(Hz)，即不分频的定时器时钟
+  * @param  DeadTime: 死区时间(纳秒)
+  * @param  Dtc: DTC寄存器值
+  * @retval true: 成功，false: 超过最大死区(1008个时钟周期)
+  */
+bool PWM_DeadTimeEncode(uint32_t Clock, uint32_t DeadTime, uint8_t* Dtc)
+{
+    uint64_t ticks = ((uint64_t)DeadTime * Clock + 999999999U) / 1000000000U;
+    uint32_t value;
+
+    if(ticks <= 127)
+    {
+        *Dtc = (uint8_t)ticks;
+        return true;
+    }
+
+    /* DT = (64 + DTC[5:0]) * 2 */
+    value = (uint32_t)((ticks + 1) / 2);
+    if(value <= 127)
+    {
+        *Dtc = (uint8_t)(0x80 | (value - 64));
+        return true;
+    }
+
+    /* DT = (32 + DTC[4:0]) * 8 */
+    value = (uint32_t)((ticks + 7) / 8);
+    if(value <= 63)
+    {
+        *Dtc = (uint8_t)(0xC0 | (value - 32));
+        return true;
+    }
+
+    /* DT = (32 + DTC[4:0]) * 16 */
+    value = (uint32_t)((ticks + 15) / 16);
+    if(value <= 63)
+    {
+        *Dtc = (uint8_t)(0xE0 | (value - 32));
+        return true;
+    }
+
+    return false;
+}
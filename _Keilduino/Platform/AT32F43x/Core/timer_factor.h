@@ -0,0 +1,60 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __TIMER_FACTOR_H
+#define __TIMER_FACTOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 定时器分频和周期的计算，本文件不访问寄存器，可在PC上编译验证。
+ * Timer_FreqFactorization将 clock/freq 分解为两个不超过0xFFFF的因数(重装值和分频值)，
+ * 使实际频率误差最小。
+ */
+bool Timer_FreqFactorization(
+    uint32_t freq,
+    uint32_t clock,
+    uint16_t* factor1,
+    uint16_t* factor2,
+    int32_t* error
+);
+
+/*
+ * 按PWM频率(mHz)选择最小的分频，使四舍五入后的周期不超过65536，占空比分辨率最高。
+ */
+bool PWM_CalcPeriod(uint32_t Clock, uint32_t Frequency, uint32_t* Period, uint32_t* Prescaler);
+
+/*
+ * 高级定时器死区时间(纳秒)按时钟换算后向上取整编码为DTC，最长1008个时钟周期。
+ */
+bool PWM_DeadTimeEncode(uint32_t Clock, uint32_t DeadTime, uint8_t* Dtc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIMER_FACTOR_H */
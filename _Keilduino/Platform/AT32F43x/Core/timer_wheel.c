@@ -0,0 +1,323 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "timer_wheel.h"
+#include <stddef.h>
+
+#define TIMER_WHEEL_SLOT_MASK       (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_SHIFT(level)    ((level) * TIMER_WHEEL_LEVEL_BITS)
+
+/*
+ * 节点放在第k级的条件: 2^(4k) <= Expire - Now < 2^(4k+4)，槽号为 Expire 的第k个4位。
+ * 当Now的低4k位回零且第k个4位等于槽号时，该槽的节点重新插入，落到更低的级别；
+ * 第0级的节点与Now相差不足16，槽号即为精确的到期时间。
+ * 下一个事件取各级最早的"到期/下移"时间，Advance只在这些时间点停留，不需要逐个计数。
+ */
+
+static uint8_t TimerWheel_Ctz(uint32_t value)
+{
+#if defined(__CC_ARM)
+    return __clz(__rbit(value));
+#elif defined(__GNUC__)
+    return __builtin_ctz(value);
+#else
+    uint8_t n = 0;
+    while(!(value & 1))
+    {
+        value >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static uint8_t TimerWheel_GetLevel(uint32_t delta)
+{
+    uint8_t level = 0;
+    while(delta >= TIMER_WHEEL_SLOTS)
+    {
+        delta >>= TIMER_WHEEL_LEVEL_BITS;
+        level++;
+    }
+    return level;
+}
+
+static void TimerWheel_Link(TimerWheel_TypeDef* Wheel, TimerWheel_Node_TypeDef* Node)
+{
+    uint32_t delta = Node->Expire - Wheel->Now;
+    uint8_t level = TimerWheel_GetLevel(delta);
+    uint8_t slot = (Node->Expire >> TIMER_WHEEL_SHIFT(level)) & TIMER_WHEEL_SLOT_MASK;
+    TimerWheel_Node_TypeDef** head = &Wheel->Slot[level][slot];
+
+    Node->Level = level;
+    Node->Slot = slot;
+    Node->Next = *head;
+    Node->PPrev = head;
+    if(*head)
+    {
+        (*head)->PPrev = &Node->Next;
+    }
+    *head = Node;
+
+    Wheel->Bitmap[level] |= (uint16_t)(1U << slot);
+    Wheel->Count++;
+}
+
+static void TimerWheel_Unlink(TimerWheel_TypeDef* Wheel, TimerWheel_Node_TypeDef* Node)
+{
+    *Node->PPrev = Node->Next;
+    if(Node->Next)
+    {
+        Node->Next->PPrev = Node->PPrev;
+    }
+
+    if(Wheel->Slot[Node->Level][Node->Slot] == NULL)
+    {
+        Wheel->Bitmap[Node->Level] &= (uint16_t)~(1U << Node->Slot);
+    }
+
+    Node->Next = NULL;
+    Node->PPrev = NULL;
+    Wheel->Count--;
+}
+
+/**
+  * @brief  时间轮初始化
+  * @param  Wheel: 时间轮
+  * @param  Now: 当前时间
+  * @retval 无
+  */
+void TimerWheel_Init(TimerWheel_TypeDef* Wheel, uint32_t Now)
+{
+    uint8_t level, slot;
+
+    Wheel->Now = Now;
+    Wheel->Count = 0;
+    for(level = 0; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        Wheel->Bitmap[level] = 0;
+        for(slot = 0; slot < TIMER_WHEEL_SLOTS; slot++)
+        {
+            Wheel->Slot[level][slot] = NULL;
+        }
+    }
+}
+
+/**
+  * @brief  节点初始化
+  * @param  Node: 节点
+  * @param  Callback: 到期回调
+  * @param  UserData: 用户数据
+  * @retval 无
+  */
+void TimerWheel_NodeInit(TimerWheel_Node_TypeDef* Node, TimerWheel_Callback_t Callback, void* UserData)
+{
+    Node->Next = NULL;
+    Node->PPrev = NULL;
+    Node->Expire = 0;
+    Node->Period = 0;
+    Node->Callback = Callback;
+    Node->UserData = UserData;
+    Node->Level = 0;
+    Node->Slot = 0;
+}
+
+/**
+  * @brief  添加节点，节点已在时间轮中时重新设定到期时间
+  * @param  Wheel: 时间轮
+  * @param  Node: 节点
+  * @param  Expire: 到期时间(绝对值)，不晚于时间轮当前时间时推迟到下一个时间单位，
+  *                 回调中以当前时间重新添加自身不会在同一时刻反复执行
+  * @param  Period: 周期，0为单次
+  * @retval 无
+  */
+void TimerWheel_Add(TimerWheel_TypeDef* Wheel, TimerWheel_Node_TypeDef* Node, uint32_t Expire, uint32_t Period)
+{
+    if(Node->PPrev)
+    {
+        TimerWheel_Unlink(Wheel, Node);
+    }
+
+    if((int32_t)(Expire - Wheel->Now) <= 0)
+    {
+        Expire = Wheel->Now + 1;
+    }
+
+    Node->Expire = Expire;
+    Node->Period = Period;
+    TimerWheel_Link(Wheel, Node);
+}
+
+/**
+  * @brief  删除节点
+  * @param  Wheel: 时间轮
+  * @param  Node: 节点
+  * @retval true: 节点在删除前处于等待状态
+  */
+bool TimerWheel_Remove(TimerWheel_TypeDef* Wheel, TimerWheel_Node_TypeDef* Node)
+{
+    if(!Node->PPrev)
+    {
+        return false;
+    }
+
+    TimerWheel_Unlink(Wheel, Node);
+    return true;
+}
+
+/**
+  * @brief  节点是否在等待到期
+  * @param  Node: 节点
+  * @retval true: 等待中
+  */
+bool TimerWheel_IsPending(const TimerWheel_Node_TypeDef* Node)
+{
+    return Node->PPrev != NULL;
+}
+
+/**
+  * @brief  获取下一个需要处理的时间点(到期或下移)
+  * @param  Wheel: 时间轮
+  * @param  Delta: 距时间轮当前时间的间隔
+  * @retval false: 时间轮为空
+  */
+bool TimerWheel_NextEvent(const TimerWheel_TypeDef* Wheel, uint32_t* Delta)
+{
+    uint32_t now = Wheel->Now;
+    uint32_t best = 0xFFFFFFFF;
+    uint8_t level;
+
+    if(Wheel->Count == 0)
+    {
+        return false;
+    }
+
+    for(level = 0; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        uint32_t bitmap = Wheel->Bitmap[level];
+        uint32_t base, rotate, dist, delta;
+
+        if(!bitmap)
+        {
+            continue;
+        }
+
+        base = now >> TIMER_WHEEL_SHIFT(level);
+
+        /*第0级从当前槽开始找，更高级从下一个槽开始，当前槽要转满一圈后才下移*/
+        rotate = (level == 0) ? (base & TIMER_WHEEL_SLOT_MASK) : ((base + 1) & TIMER_WHEEL_SLOT_MASK);
+        bitmap = ((bitmap >> rotate) | (bitmap << (TIMER_WHEEL_SLOTS - rotate))) & 0xFFFF;
+        dist = TimerWheel_Ctz(bitmap) + (level == 0 ? 0 : 1);
+
+        if(level == 0)
+        {
+            delta = dist;
+        }
+        else
+        {
+            delta = ((base + dist) << TIMER_WHEEL_SHIFT(level)) - now;
+        }
+
+        if(delta < best)
+        {
+            best = delta;
+        }
+    }
+
+    *Delta = best;
+    return true;
+}
+
+static void TimerWheel_Cascade(TimerWheel_TypeDef* Wheel, uint8_t level, uint8_t slot)
+{
+    TimerWheel_Node_TypeDef* node;
+
+    while((node = Wheel->Slot[level][slot]) != NULL)
+    {
+        TimerWheel_Unlink(Wheel, node);
+        TimerWheel_Link(Wheel, node);
+    }
+}
+
+static void TimerWheel_Expire(TimerWheel_TypeDef* Wheel, uint8_t slot)
+{
+    TimerWheel_Node_TypeDef* node;
+
+    while((node = Wheel->Slot[0][slot]) != NULL)
+    {
+        TimerWheel_Unlink(Wheel, node);
+
+        /*周期节点按原到期时间累加，不累积误差；回调过慢时跳过错过的周期*/
+        if(node->Period)
+        {
+            uint32_t expire = node->Expire + node->Period;
+            if((int32_t)(expire - Wheel->Now) <= 0)
+            {
+                uint32_t late = Wheel->Now - expire;
+                expire += (late / node->Period + 1) * node->Period;
+            }
+            node->Expire = expire;
+            TimerWheel_Link(Wheel, node);
+        }
+
+        if(node->Callback)
+        {
+            node->Callback(node->UserData);
+        }
+    }
+}
+
+/**
+  * @brief  推进时间轮到指定时间，依次执行到期节点的回调
+  * @param  Wheel: 时间轮
+  * @param  Now: 当前时间，与上次调用的间隔应小于2^31
+  * @retval 无
+  */
+void TimerWheel_Advance(TimerWheel_TypeDef* Wheel, uint32_t Now)
+{
+    uint32_t delta;
+
+    while(TimerWheel_NextEvent(Wheel, &delta) && delta <= Now - Wheel->Now)
+    {
+        if(delta)
+        {
+            int8_t level;
+
+            Wheel->Now += delta;
+
+            /*从高到低下移，高级下移的节点可能在同一时刻继续下移*/
+            for(level = TIMER_WHEEL_LEVELS - 1; level > 0; level--)
+            {
+                uint32_t shift = TIMER_WHEEL_SHIFT(level);
+                if((Wheel->Now & ((1UL << shift) - 1)) == 0)
+                {
+                    TimerWheel_Cascade(Wheel, level, (Wheel->Now >> shift) & TIMER_WHEEL_SLOT_MASK);
+                }
+            }
+        }
+
+        TimerWheel_Expire(Wheel, Wheel->Now & TIMER_WHEEL_SLOT_MASK);
+    }
+
+    /*到Now之间没有事件，直接跳到Now*/
+    Wheel->Now = Now;
+}
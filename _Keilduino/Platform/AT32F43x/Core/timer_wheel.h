@@ -0,0 +1,76 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __TIMER_WHEEL_H
+#define __TIMER_WHEEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 分层时间轮：8级 x 16槽，覆盖完整的32位时间，时间单位由使用者决定(通常为微秒)。
+ * 节点由使用者分配，添加/删除为O(1)，每个节点最多逐级下移7次。
+ * 本文件不访问寄存器，时间由调用者传入，可在PC上用模拟计数器验证。
+ */
+#define TIMER_WHEEL_LEVEL_BITS      4
+#define TIMER_WHEEL_SLOTS           (1 << TIMER_WHEEL_LEVEL_BITS)
+#define TIMER_WHEEL_LEVELS          (32 / TIMER_WHEEL_LEVEL_BITS)
+
+typedef void(*TimerWheel_Callback_t)(void* UserData);
+
+typedef struct TimerWheel_Node_s
+{
+    struct TimerWheel_Node_s* Next;
+    struct TimerWheel_Node_s** PPrev;   // NULL表示未在时间轮中
+    uint32_t Expire;                    // 到期时间(绝对值)
+    uint32_t Period;                    // 周期，0为单次
+    TimerWheel_Callback_t Callback;
+    void* UserData;
+    uint8_t Level;
+    uint8_t Slot;
+} TimerWheel_Node_TypeDef;
+
+typedef struct
+{
+    uint32_t Now;
+    uint32_t Count;
+    uint16_t Bitmap[TIMER_WHEEL_LEVELS];
+    TimerWheel_Node_TypeDef* Slot[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+} TimerWheel_TypeDef;
+
+void TimerWheel_Init(TimerWheel_TypeDef* Wheel, uint32_t Now);
+void TimerWheel_NodeInit(TimerWheel_Node_TypeDef* Node, TimerWheel_Callback_t Callback, void* UserData);
+void TimerWheel_Add(TimerWheel_TypeDef* Wheel, TimerWheel_Node_TypeDef* Node, uint32_t Expire, uint32_t Period);
+bool TimerWheel_Remove(TimerWheel_TypeDef* Wheel, TimerWheel_Node_TypeDef* Node);
+bool TimerWheel_NextEvent(const TimerWheel_TypeDef* Wheel, uint32_t* Delta);
+bool TimerWheel_IsPending(const TimerWheel_Node_TypeDef* Node);
+void TimerWheel_Advance(TimerWheel_TypeDef* Wheel, uint32_t Now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TIMER_WHEEL_H */
@@ -0,0 +1,95 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "work_queue.h"
+#include <stddef.h>
+
+/**
+  * @brief  队列初始化
+  * @param  Queue: 队列
+  * @param  Cells: 存储单元
+  * @param  Size: 单元个数，必须为2的幂
+  * @retval true: 成功
+  */
+bool Work_QueueInit(Work_Queue_TypeDef* Queue, Work_QueueCell_TypeDef* Cells, uint32_t Size)
+{
+    return Cells != NULL && MPSC_RING_INIT(&Queue->Ring, Cells, Size);
+}
+
+/**
+  * @brief  提交工作，可在任意优先级的中断中调用
+  * @param  Queue: 队列
+  * @param  Function: 工作函数
+  * @param  Argument: 参数
+  * @retval true: 成功，false: 队列已满，工作被丢弃
+  */
+bool Work_QueuePost(Work_Queue_TypeDef* Queue, Work_Function_t Function, void* Argument)
+{
+    Work_Item_TypeDef item;
+
+    item.Function = Function;
+    item.Argument = Argument;
+    return MPSC_RingPush(&Queue->Ring, &item);
+}
+
+/**
+  * @brief  取出工作，只能在一个上下文中调用
+  * @param  Queue: 队列
+  * @param  Item: 输出工作
+  * @retval true: 取到工作，false: 队列为空或最早的工作还在写入
+  */
+bool Work_QueuePop(Work_Queue_TypeDef* Queue, Work_Item_TypeDef* Item)
+{
+    return MPSC_RingPop(&Queue->Ring, Item);
+}
+
+/**
+  * @brief  获取队列中的工作数(包括正在写入的)
+  * @param  Queue: 队列
+  * @retval 工作数
+  */
+uint32_t Work_QueueGetCount(const Work_Queue_TypeDef* Queue)
+{
+    return MPSC_RingGetCount(&Queue->Ring);
+}
+
+/**
+  * @brief  获取丢弃的工作数
+  * @param  Queue: 队列
+  * @param  Clear: 读取后清零
+  * @retval 丢弃的工作数
+  */
+uint32_t Work_QueueGetDropped(Work_Queue_TypeDef* Queue, bool Clear)
+{
+    return MPSC_RingGetDropped(&Queue->Ring, Clear);
+}
+
+/**
+  * @brief  获取队列深度的最大值
+  * @param  Queue: 队列
+  * @param  Clear: 读取后清零
+  * @retval 最大工作数
+  */
+uint32_t Work_QueueGetHighWater(Work_Queue_TypeDef* Queue, bool Clear)
+{
+    return MPSC_RingGetHighWater(&Queue->Ring, Clear);
+}
@@ -0,0 +1,67 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WORK_QUEUE_H
+#define __WORK_QUEUE_H
+
+#include "mpsc_ring.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 延迟工作队列：在MPSC_Ring上存放(函数, 参数)，
+ * 多个中断(可相互嵌套)写入，单一上下文读取执行，不需要关中断。
+ * 本文件不访问寄存器，可在PC上编译验证。
+ */
+typedef void(*Work_Function_t)(void* Argument);
+
+typedef struct
+{
+    Work_Function_t Function;
+    void* Argument;
+} Work_Item_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t Seq;
+    Work_Item_TypeDef Item;
+} Work_QueueCell_TypeDef;
+
+typedef struct
+{
+    MPSC_Ring_TypeDef Ring;
+} Work_Queue_TypeDef;
+
+bool     Work_QueueInit(Work_Queue_TypeDef* Queue, Work_QueueCell_TypeDef* Cells, uint32_t Size);
+bool     Work_QueuePost(Work_Queue_TypeDef* Queue, Work_Function_t Function, void* Argument);
+bool     Work_QueuePop(Work_Queue_TypeDef* Queue, Work_Item_TypeDef* Item);
+uint32_t Work_QueueGetCount(const Work_Queue_TypeDef* Queue);
+uint32_t Work_QueueGetDropped(Work_Queue_TypeDef* Queue, bool Clear);
+uint32_t Work_QueueGetHighWater(Work_Queue_TypeDef* Queue, bool Clear);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __WORK_QUEUE_H */
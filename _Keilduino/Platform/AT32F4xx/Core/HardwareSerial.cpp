@@ -223,6 +223,16 @@ void HardwareSerial::flush(void)
     _rxBufferHead = _rxBufferTail;
 }
 
+/**
+  * @brief  不等待即可写入的字节数
+  * @param  无
+  * @retval 发送数据寄存器为空时为1，否则为0
+  */
+int HardwareSerial::availableForWrite(void)
+{
+    return (USART_GetFlagStatus(_USARTx, USART_FLAG_TDE) != RESET) ? 1 : 0;
+}
+
 /**
   * @brief  串口写入一个字节
   * @param  写入的字节
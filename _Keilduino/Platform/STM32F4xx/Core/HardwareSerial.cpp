@@ -241,6 +241,16 @@ void HardwareSerial::flush(void)
     _rx_buffer_head = _rx_buffer_tail;
 }
 
+/**
+  * @brief  不等待即可写入的字节数
+  * @param  无
+  * @retval 发送数据寄存器为空时为1，否则为0
+  */
+int HardwareSerial::availableForWrite(void)
+{
+    return (USART_GetFlagStatus(USARTx, USART_FLAG_TXE) != RESET) ? 1 : 0;
+}
+
 /**
   * @brief  串口写入一个字节
   * @param  写入的字节
@@ -0,0 +1,26 @@
+# BinLog round trip: test_binlog_ring writes log.bin/expected.txt,
+# binlog_decode.py decodes log.bin against the test binary's own format strings.
+#   cmake -DTEST=<exe> -DPYTHON=<python3> -DDECODER=<binlog_decode.py> -DWORK_DIR=<dir> -P binlog_decode.cmake
+file(MAKE_DIRECTORY ${WORK_DIR})
+
+execute_process(COMMAND ${TEST} ${WORK_DIR} RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${TEST} failed: ${result}")
+endif()
+
+execute_process(
+    COMMAND ${PYTHON} ${DECODER} ${TEST} ${WORK_DIR}/log.bin
+    OUTPUT_FILE ${WORK_DIR}/decoded.txt
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${DECODER} failed: ${result}")
+endif()
+
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -E compare_files ${WORK_DIR}/expected.txt ${WORK_DIR}/decoded.txt
+    RESULT_VARIABLE result
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "decoded log differs: ${WORK_DIR}/expected.txt ${WORK_DIR}/decoded.txt")
+endif()
@@ -0,0 +1,114 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#define _GNU_SOURCE
+#include "coroutine_port_host.h"
+#include <ucontext.h>
+
+/*
+ * 协程移植层的PC实现：用ucontext切换上下文，时基为模拟毫秒数，
+ * 空闲等待时时基加1(相当于等到下一个SysTick)。
+ * 每个协程的ucontext放在按对象查找的表中，Coroutine_TypeDef::SP不使用。
+ */
+#define PORT_CONTEXT_MAX    16
+
+typedef struct
+{
+    const Coroutine_TypeDef* Owner;
+    ucontext_t Context;
+} Port_Context_TypeDef;
+
+static Port_Context_TypeDef Port_Context[PORT_CONTEXT_MAX];
+
+volatile uint32_t Port_Tick;
+volatile bool Port_SwitchEnable = true;
+uint32_t Port_SwitchCount;
+uint32_t Port_IdleCount;
+
+static ucontext_t* Port_GetContext(const Coroutine_TypeDef* Co)
+{
+    int i;
+    int empty = -1;
+
+    for(i = 0; i < PORT_CONTEXT_MAX; i++)
+    {
+        if(Port_Context[i].Owner == Co)
+        {
+            return &Port_Context[i].Context;
+        }
+        if(empty < 0 && !Port_Context[i].Owner)
+        {
+            empty = i;
+        }
+    }
+
+    if(empty < 0)
+    {
+        abort();
+    }
+
+    Port_Context[empty].Owner = Co;
+    return &Port_Context[empty].Context;
+}
+
+/*调度核心在切换前已更新当前协程*/
+static void Port_Trampoline(void)
+{
+    Coroutine_Entry(Coroutine_GetCurrent());
+}
+
+void Coroutine_PortInit(void)
+{
+}
+
+void Coroutine_PortStackInit(Coroutine_TypeDef* Co)
+{
+    ucontext_t* ctx = Port_GetContext(Co);
+
+    getcontext(ctx);
+    ctx->uc_stack.ss_sp = Co->Stack;
+    ctx->uc_stack.ss_size = Co->StackSize;
+    ctx->uc_link = NULL;
+    makecontext(ctx, Port_Trampoline, 0);
+}
+
+void Coroutine_PortSwitch(Coroutine_TypeDef* From, Coroutine_TypeDef* To)
+{
+    Port_SwitchCount++;
+    swapcontext(Port_GetContext(From), Port_GetContext(To));
+}
+
+uint32_t Coroutine_PortGetTick(void)
+{
+    return Port_Tick;
+}
+
+bool Coroutine_PortCanSwitch(void)
+{
+    return Port_SwitchEnable;
+}
+
+void Coroutine_PortIdle(void)
+{
+    Port_IdleCount++;
+    Port_Tick++;
+}
@@ -0,0 +1,63 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __MCU_CORE_H
+#define __MCU_CORE_H
+
+/*
+ * 主机编译ArduinoAPI(Print/Stream/WString)时代替平台的mcu_core.h，
+ * 只提供这些文件用到的类型和时间函数。
+ */
+#include <stdint.h>
+#include "mcu_config.h"
+
+typedef enum
+{
+    INPUT,
+    INPUT_PULLUP,
+    INPUT_PULLDOWN,
+    INPUT_ANALOG,
+    INPUT_ANALOG_DMA,
+    OUTPUT,
+    OUTPUT_OPEN_DRAIN,
+    OUTPUT_AF_OD,
+    OUTPUT_AF_PP,
+    PWM
+} PinMode_TypeDef;
+
+#define sei()
+#define cli()
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+uint32_t millis(void);
+uint32_t micros(void);
+void delay_ms(uint32_t ms);
+void delay_us(uint32_t us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __TEST_H
+#define __TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * 主机测试公用的检查宏：失败时打印位置并计数，不中断后续检查，
+ * main() 以 TEST_RESULT() 返回，失败数非0时 ctest 判定为失败。
+ */
+static int Test_FailCount = 0;
+
+#define TEST_CHECK(expr) \
+do { \
+    if(!(expr)) \
+    { \
+        printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+        Test_FailCount++; \
+    } \
+} while(0)
+
+#define TEST_CHECK_MSG(expr, ...) \
+do { \
+    if(!(expr)) \
+    { \
+        printf("%s:%d: check failed: %s: ", __FILE__, __LINE__, #expr); \
+        printf(__VA_ARGS__); \
+        printf("\n"); \
+        Test_FailCount++; \
+    } \
+} while(0)
+
+#define TEST_RESULT() \
+    (printf("%s: %d failure(s)\n", Test_FailCount ? "FAIL" : "PASS", Test_FailCount), Test_FailCount ? 1 : 0)
+
+#endif /* __TEST_H */
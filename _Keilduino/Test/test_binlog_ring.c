@@ -0,0 +1,404 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "binlog_ring.h"
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * 单元检查：初始化参数、记录布局、缓冲满丢弃与丢弃数报告、末尾分段读取；
+ * 部分写入：输出每次随机接收0~N个字节(包括从字中间断开)，
+ * 收到的字节流必须与参考模型逐字节一致，不能重复或遗漏；
+ * 带目录参数运行时，额外生成 log.bin 和 expected.txt，
+ * 由 binlog_decode.py 读取本程序自身的格式串解码后比对(见 binlog_decode.cmake)。
+ */
+#define TEST_RING_SIZE      64
+#define TEST_RECORD_NUM     50000
+#define TEST_STREAM_MAX     (TEST_RECORD_NUM * (BINLOG_HEADER_WORDS + 8) * 4)
+
+static uint32_t Buffer[TEST_RING_SIZE];
+static BinLog_Ring_TypeDef Ring;
+
+static uint32_t Random_State = 12345;
+
+static uint32_t Random_Next(void)
+{
+    Random_State = Random_State * 1103515245 + 12345;
+    return Random_State >> 16;
+}
+
+/*按随机长度接收的输出，记录收到的字节流*/
+typedef struct
+{
+    uint8_t* Data;
+    uint32_t Length;
+    uint32_t MaxChunk;
+    uint32_t Calls;
+} Test_Sink_TypeDef;
+
+static uint32_t Test_SinkOutput(void* UserData, const uint8_t* Data, uint32_t Length)
+{
+    Test_Sink_TypeDef* sink = (Test_Sink_TypeDef*)UserData;
+    uint32_t accept = Random_Next() % (sink->MaxChunk + 1);
+
+    if(accept > Length)
+    {
+        accept = Length;
+    }
+
+    memcpy(sink->Data + sink->Length, Data, accept);
+    sink->Length += accept;
+    sink->Calls++;
+    return accept;
+}
+
+/*参考模型：按记录格式直接拼出应收到的字节流*/
+typedef struct
+{
+    uint8_t* Data;
+    uint32_t Length;
+    uint32_t Pending;
+} Test_Model_TypeDef;
+
+static void Test_ModelPut(Test_Model_TypeDef* model, uint32_t value)
+{
+    memcpy(model->Data + model->Length, &value, sizeof(value));
+    model->Length += sizeof(value);
+}
+
+static void Test_ModelWrite(Test_Model_TypeDef* model, uint32_t Id, uint32_t Timestamp, const uint32_t* Args, uint8_t NArgs)
+{
+    uint32_t pending = (model->Pending > 0xFFFF) ? 0xFFFF : model->Pending;
+    uint8_t i;
+
+    Test_ModelPut(model, BINLOG_SYNC | ((uint32_t)NArgs << 8) | (pending << 16));
+    Test_ModelPut(model, Id);
+    Test_ModelPut(model, Timestamp);
+    for(i = 0; i < NArgs; i++)
+    {
+        Test_ModelPut(model, Args[i]);
+    }
+    model->Pending = 0;
+}
+
+static void Test_Init(void)
+{
+    uint32_t small[8];
+
+    TEST_CHECK(!BinLog_RingInit(&Ring, NULL, TEST_RING_SIZE));
+    TEST_CHECK(!BinLog_RingInit(&Ring, small, 8));
+    TEST_CHECK(!BinLog_RingInit(&Ring, Buffer, 48));
+    TEST_CHECK(BinLog_RingInit(&Ring, Buffer, TEST_RING_SIZE));
+    TEST_CHECK(BinLog_RingGetUsed(&Ring) == 0);
+}
+
+static void Test_Layout(void)
+{
+    const uint32_t args[2] = { 0x11223344, 0xFFFFFFFF };
+    const uint8_t* data;
+    uint32_t words[5];
+    uint32_t length;
+
+    BinLog_RingInit(&Ring, Buffer, TEST_RING_SIZE);
+    TEST_CHECK(BinLog_RingWrite(&Ring, 0x08001234, 1000, args, 2));
+    TEST_CHECK(BinLog_RingGetUsed(&Ring) == 5);
+
+    length = BinLog_RingPeek(&Ring, &data);
+    TEST_CHECK(length == sizeof(words));
+    memcpy(words, data, sizeof(words));
+    TEST_CHECK(words[0] == (BINLOG_SYNC | (2 << 8)));
+    TEST_CHECK(words[1] == 0x08001234);
+    TEST_CHECK(words[2] == 1000);
+    TEST_CHECK(words[3] == 0x11223344);
+    TEST_CHECK(words[4] == 0xFFFFFFFF);
+
+    /*只读走3个字节，剩余部分从断开处继续*/
+    BinLog_RingConsume(&Ring, 3);
+    TEST_CHECK(BinLog_RingGetUsed(&Ring) == 5);
+    length = BinLog_RingPeek(&Ring, &data);
+    TEST_CHECK(length == sizeof(words) - 3);
+    TEST_CHECK(data[0] == ((const uint8_t*)words)[3]);
+
+    BinLog_RingConsume(&Ring, 2);
+    TEST_CHECK(BinLog_RingGetUsed(&Ring) == 4);
+    length = BinLog_RingPeek(&Ring, &data);
+    TEST_CHECK(length == 4 * 4 - 1);
+    TEST_CHECK(data[0] == ((const uint8_t*)words)[5]);
+
+    BinLog_RingConsume(&Ring, length);
+    TEST_CHECK(BinLog_RingGetUsed(&Ring) == 0);
+    TEST_CHECK(BinLog_RingPeek(&Ring, &data) == 0);
+}
+
+static void Test_Full(void)
+{
+    const uint32_t args[5] = { 0 };
+    const uint8_t* data;
+    uint32_t words[8];
+    uint32_t length;
+    int i;
+
+    BinLog_RingInit(&Ring, Buffer, TEST_RING_SIZE);
+
+    /*每条8个字，刚好写满*/
+    for(i = 0; i < TEST_RING_SIZE / 8; i++)
+    {
+        TEST_CHECK(BinLog_RingWrite(&Ring, 1, i, args, 5));
+    }
+    TEST_CHECK(BinLog_RingGetUsed(&Ring) == TEST_RING_SIZE);
+    TEST_CHECK(!BinLog_RingWrite(&Ring, 2, 0, NULL, 0));
+    TEST_CHECK(!BinLog_RingWrite(&Ring, 2, 0, NULL, 0));
+    TEST_CHECK(Ring.Dropped == 2);
+
+    /*头部字只发送了一部分时仍占用空间*/
+    BinLog_RingConsume(&Ring, 7 * 4 + 3);
+    TEST_CHECK(!BinLog_RingWrite(&Ring, 2, 0, args, 5));
+    BinLog_RingConsume(&Ring, 1);
+    TEST_CHECK(BinLog_RingWrite(&Ring, 3, 0, args, 5));
+    TEST_CHECK(Ring.Dropped == 3);
+
+    /*丢弃数在下一条成功写入的记录中报告，跨越缓冲末尾时分两段读取*/
+    length = BinLog_RingPeek(&Ring, &data);
+    TEST_CHECK(length == (TEST_RING_SIZE - 8) * 4);
+    BinLog_RingConsume(&Ring, length);
+    length = BinLog_RingPeek(&Ring, &data);
+    TEST_CHECK(length == sizeof(words));
+    memcpy(words, data, sizeof(words));
+    TEST_CHECK(words[0] == (BINLOG_SYNC | (5 << 8) | (3 << 16)));
+    TEST_CHECK(words[1] == 3);
+}
+
+static uint32_t Test_NullOutput(void* UserData, const uint8_t* Data, uint32_t Length)
+{
+    (void)Data;
+    *(uint32_t*)UserData += Length;
+    return Length;
+}
+
+static void Test_DrainLimit(void)
+{
+    const uint32_t args[5] = { 0 };
+    uint32_t total = 0;
+    int i;
+
+    BinLog_RingInit(&Ring, Buffer, TEST_RING_SIZE);
+    for(i = 0; i < TEST_RING_SIZE / 8; i++)
+    {
+        BinLog_RingWrite(&Ring, 1, i, args, 5);
+    }
+    BinLog_RingConsume(&Ring, 5 * 4);
+
+    /*MaxBytes可以不是4的倍数，末尾段和开头段合并计算*/
+    TEST_CHECK(BinLog_RingDrain(&Ring, Test_NullOutput, &total, 7) == 7);
+    TEST_CHECK(BinLog_RingDrain(&Ring, Test_NullOutput, &total, 0) == TEST_RING_SIZE * 4 - 27);
+    TEST_CHECK(total == TEST_RING_SIZE * 4 - 20);
+    TEST_CHECK(BinLog_RingGetUsed(&Ring) == 0);
+    TEST_CHECK(BinLog_RingDrain(&Ring, Test_NullOutput, &total, 0) == 0);
+}
+
+static void Test_PartialWrite(void)
+{
+    static uint8_t expected[TEST_STREAM_MAX];
+    static uint8_t received[TEST_STREAM_MAX];
+    Test_Model_TypeDef model = { expected, 0, 0 };
+    Test_Sink_TypeDef sink = { received, 0, 0, 0 };
+    uint32_t args[8];
+    uint32_t drops = 0;
+    uint32_t i;
+
+    BinLog_RingInit(&Ring, Buffer, TEST_RING_SIZE);
+
+    for(i = 0; i < TEST_RECORD_NUM; i++)
+    {
+        uint8_t nargs = Random_Next() % 9;
+        uint8_t j;
+
+        for(j = 0; j < nargs; j++)
+        {
+            args[j] = Random_Next() ^ (i << 16);
+        }
+
+        if(BinLog_RingWrite(&Ring, 0x1000 + i, i * 7, args, nargs))
+        {
+            Test_ModelWrite(&model, 0x1000 + i, i * 7, args, nargs);
+        }
+        else
+        {
+            model.Pending++;
+            drops++;
+        }
+
+        /*输出较慢，每次只接收很少字节，并随机限制每次发送的总量*/
+        sink.MaxChunk = 1 + Random_Next() % 40;
+        BinLog_RingDrain(&Ring, Test_SinkOutput, &sink, Random_Next() % 64);
+        BinLog_RingDrain(&Ring, Test_SinkOutput, &sink, Random_Next() % 64);
+    }
+
+    sink.MaxChunk = 5;
+    while(BinLog_RingGetUsed(&Ring))
+    {
+        BinLog_RingDrain(&Ring, Test_SinkOutput, &sink, 0);
+    }
+
+    TEST_CHECK_MSG(drops > 0 && drops < TEST_RECORD_NUM / 2, "drops=%u", (unsigned)drops);
+    TEST_CHECK(Ring.Dropped == drops);
+    TEST_CHECK_MSG(sink.Length == model.Length, "received=%u expected=%u", (unsigned)sink.Length, (unsigned)model.Length);
+    TEST_CHECK(memcmp(received, expected, model.Length) == 0);
+    printf("partial write: %u records, %u dropped, %u bytes in %u output calls\n",
+           (unsigned)TEST_RECORD_NUM, (unsigned)drops, (unsigned)sink.Length, (unsigned)sink.Calls);
+}
+
+/*解码器比对：格式串ID为本程序中格式串的地址(需要非PIE链接，地址在32位以内)*/
+static uint32_t Test_FloatBits(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static int Test_RoundTrip(const char* dir)
+{
+    static const char* const names[] = { "motor", "imu", "gps" };
+    static uint8_t received[TEST_STREAM_MAX];
+    Test_Sink_TypeDef sink = { received, 0, 0, 0 };
+    char path[512];
+    FILE* fp_log;
+    FILE* fp_txt;
+    uint32_t timestamp = 0xFFFFF000;
+    uint32_t time_base = 0;
+    uint32_t last = 0;
+    uint32_t pending = 0;
+    int first = 1;
+    int i;
+
+    if((uintptr_t)&Test_RoundTrip > 0xFFFFFFFF || (uintptr_t)"" > 0xFFFFFFFF)
+    {
+        printf("round trip: format strings above 4GB, link with -no-pie\n");
+        return 1;
+    }
+
+    snprintf(path, sizeof(path), "%s/expected.txt", dir);
+    fp_txt = fopen(path, "w");
+    snprintf(path, sizeof(path), "%s/log.bin", dir);
+    fp_log = fopen(path, "wb");
+    if(!fp_txt || !fp_log)
+    {
+        printf("round trip: cannot open output in %s\n", dir);
+        return 1;
+    }
+
+    BinLog_RingInit(&Ring, Buffer, TEST_RING_SIZE);
+
+    for(i = 0; i < 2000; i++)
+    {
+        const char* fmt;
+        uint32_t args[4];
+        uint8_t nargs;
+        char text[128];
+        int value = (int)Random_Next() - 32768;
+        float f = (float)value / 64.0f;
+
+        switch(i % 4)
+        {
+        case 0:
+            fmt = "boot %d, flags 0x%08x";
+            args[0] = (uint32_t)value;
+            args[1] = Random_Next() << 8;
+            nargs = 2;
+            snprintf(text, sizeof(text), fmt, value, (unsigned)args[1]);
+            break;
+        case 1:
+            fmt = "%s: speed=%.3f rpm";
+            args[0] = (uint32_t)(uintptr_t)names[i % 3];
+            args[1] = Test_FloatBits(f);
+            nargs = 2;
+            snprintf(text, sizeof(text), fmt, names[i % 3], (double)f);
+            break;
+        case 2:
+            fmt = "tick %u %c%c";
+            args[0] = (uint32_t)i;
+            args[1] = 'A' + i % 26;
+            args[2] = 'a' + i % 26;
+            nargs = 3;
+            snprintf(text, sizeof(text), fmt, (unsigned)i, 'A' + i % 26, 'a' + i % 26);
+            break;
+        default:
+            fmt = "idle";
+            nargs = 0;
+            snprintf(text, sizeof(text), "%s", fmt);
+            break;
+        }
+
+        timestamp += 100 + Random_Next() % 1000;
+        if(BinLog_RingWrite(&Ring, (uint32_t)(uintptr_t)fmt, timestamp, args, nargs))
+        {
+            if(!first)
+            {
+                time_base += timestamp - last;
+            }
+            first = 0;
+            last = timestamp;
+
+            if(pending)
+            {
+                fprintf(fp_txt, "<%u messages dropped>\n", (unsigned)pending);
+                pending = 0;
+            }
+            fprintf(fp_txt, "[%10u] %s\n", (unsigned)time_base, text);
+        }
+        else
+        {
+            pending++;
+        }
+
+        sink.MaxChunk = 1 + Random_Next() % 9;
+        BinLog_RingDrain(&Ring, Test_SinkOutput, &sink, 0);
+    }
+
+    sink.MaxChunk = 7;
+    while(BinLog_RingGetUsed(&Ring))
+    {
+        BinLog_RingDrain(&Ring, Test_SinkOutput, &sink, 0);
+    }
+
+    fwrite(received, 1, sink.Length, fp_log);
+    fclose(fp_log);
+    fclose(fp_txt);
+    printf("round trip: %u bytes written to %s\n", (unsigned)sink.Length, dir);
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc > 1)
+    {
+        return Test_RoundTrip(argv[1]);
+    }
+
+    Test_Init();
+    Test_Layout();
+    Test_Full();
+    Test_DrainLimit();
+    Test_PartialWrite();
+    return TEST_RESULT();
+}
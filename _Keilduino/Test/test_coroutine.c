@@ -0,0 +1,187 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "coroutine_port_host.h"
+#include <string.h>
+
+/*
+ * 用ucontext移植层运行调度核心：检查轮转顺序、睡眠唤醒时间、
+ * 协程结束后移出调度环、不能切换时的返回值和重复创建。
+ */
+#define TEST_STACK_SIZE     (64 * 1024)
+
+static uint32_t Stack_A[TEST_STACK_SIZE / 4];
+static uint32_t Stack_B[TEST_STACK_SIZE / 4];
+static uint32_t Stack_C[TEST_STACK_SIZE / 4];
+static Coroutine_TypeDef Co_A, Co_B, Co_C;
+
+static char Log[64];
+static int Log_Len;
+
+static void Log_Put(char c)
+{
+    if(Log_Len < (int)sizeof(Log) - 1)
+    {
+        Log[Log_Len++] = c;
+        Log[Log_Len] = '\0';
+    }
+}
+
+static void Log_Clear(void)
+{
+    Log_Len = 0;
+    Log[0] = '\0';
+}
+
+static void Yield_Task(void* UserData)
+{
+    char name = *(const char*)UserData;
+    int i;
+
+    for(i = 0; i < 3; i++)
+    {
+        Log_Put(name);
+        Coroutine_Yield();
+    }
+}
+
+static void Test_NotCreated(void)
+{
+    TEST_CHECK(Coroutine_GetCurrent() == NULL);
+    TEST_CHECK(!Coroutine_Yield());
+    TEST_CHECK(!Coroutine_Delay(10));
+
+    Port_SwitchEnable = false;
+    TEST_CHECK(!Coroutine_Create(&Co_A, Stack_A, sizeof(Stack_A), Yield_Task, "a"));
+    Port_SwitchEnable = true;
+    TEST_CHECK(!Coroutine_Create(&Co_A, Stack_A, 128, Yield_Task, "a"));
+    TEST_CHECK(Coroutine_GetCurrent() == NULL);
+}
+
+/*新协程插在当前协程之前，按创建顺序在主循环之后轮转*/
+static void Test_RoundRobin(void)
+{
+    int i;
+
+    Log_Clear();
+    TEST_CHECK(Coroutine_Create(&Co_A, Stack_A, sizeof(Stack_A), Yield_Task, "a"));
+    TEST_CHECK(Coroutine_Create(&Co_B, Stack_B, sizeof(Stack_B), Yield_Task, "b"));
+
+    /*运行中的协程不能重新创建*/
+    TEST_CHECK(!Coroutine_Create(&Co_A, Stack_C, sizeof(Stack_C), Yield_Task, "c"));
+
+    for(i = 0; i < 5; i++)
+    {
+        Log_Put('m');
+        TEST_CHECK(Coroutine_Yield());
+    }
+
+    TEST_CHECK_MSG(strcmp(Log, "mabmabmabmm") == 0, "log %s", Log);
+    TEST_CHECK(Coroutine_IsDone(&Co_A) && Coroutine_IsDone(&Co_B));
+
+    /*已结束的协程不再被调度*/
+    i = Port_SwitchCount;
+    TEST_CHECK(Coroutine_Yield());
+    TEST_CHECK(Port_SwitchCount == (uint32_t)i);
+
+    TEST_CHECK(Coroutine_GetStackFree(&Co_A) > 0 && Coroutine_GetStackFree(&Co_A) < sizeof(Stack_A));
+}
+
+/*睡眠到时间后恰好唤醒，全部睡眠时空闲等待*/
+static uint32_t Wake_Tick[2];
+
+static void Sleep_Task(void* UserData)
+{
+    int index = (int)(intptr_t)UserData;
+    uint32_t start = Port_Tick;
+
+    TEST_CHECK(Coroutine_Delay(index ? 7 : 3));
+    Wake_Tick[index] = Port_Tick - start;
+}
+
+static void Test_Delay(void)
+{
+    uint32_t start;
+
+    Port_Tick = 0xFFFFFFFE;//跨过回绕
+    start = Port_Tick;
+    TEST_CHECK(Coroutine_Create(&Co_A, Stack_A, sizeof(Stack_A), Sleep_Task, (void*)0));
+    TEST_CHECK(Coroutine_Create(&Co_B, Stack_B, sizeof(Stack_B), Sleep_Task, (void*)1));
+
+    Port_IdleCount = 0;
+    TEST_CHECK(Coroutine_Delay(10));
+    TEST_CHECK(Port_Tick - start == 10);
+    TEST_CHECK(Port_IdleCount == 10);
+    TEST_CHECK(Wake_Tick[0] == 3 && Wake_Tick[1] == 7);
+    TEST_CHECK(Coroutine_IsDone(&Co_A) && Coroutine_IsDone(&Co_B));
+}
+
+/*协程中创建协程、在协程中不能切换时Yield返回false*/
+static void Child_Task(void* UserData)
+{
+    (void)UserData;
+    Log_Put('c');
+    Coroutine_Yield();
+    Log_Put('c');
+}
+
+static void Parent_Task(void* UserData)
+{
+    (void)UserData;
+    Log_Put('p');
+    TEST_CHECK(Coroutine_Create(&Co_C, Stack_C, sizeof(Stack_C), Child_Task, NULL));
+    TEST_CHECK(!Coroutine_Create(&Co_A, Stack_A, sizeof(Stack_A), Parent_Task, NULL));
+
+    Port_SwitchEnable = false;
+    TEST_CHECK(!Coroutine_Yield());
+    Port_SwitchEnable = true;
+
+    Coroutine_Yield();
+    Log_Put('p');
+}
+
+static void Test_Nested(void)
+{
+    int i;
+
+    Log_Clear();
+    TEST_CHECK(Coroutine_Create(&Co_A, Stack_A, sizeof(Stack_A), Parent_Task, NULL));
+    for(i = 0; i < 3; i++)
+    {
+        Log_Put('m');
+        Coroutine_Yield();
+    }
+
+    /*子协程插在父协程之前，主循环之后*/
+    TEST_CHECK_MSG(strcmp(Log, "mpmcpmc") == 0, "log %s", Log);
+    TEST_CHECK(Coroutine_IsDone(&Co_A) && Coroutine_IsDone(&Co_C));
+}
+
+int main(void)
+{
+    Test_NotCreated();
+    Test_RoundRobin();
+    Test_Delay();
+    Test_Nested();
+    return TEST_RESULT();
+}
@@ -0,0 +1,213 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "debounce_filter.h"
+
+static uint32_t Test_Rand(void)
+{
+    static uint32_t state = 0xDEADBEEF;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/*
+ * 垂直计数器与逐路计数的参考模型比较：
+ * 与状态不同的采样连续4次才翻转，中间出现一次相同即清零。
+ */
+static void Test_Integrate(void)
+{
+    Debounce_Filter_TypeDef filter;
+    uint32_t state = 0;
+    uint8_t cnt[DEBOUNCE_FILTER_INPUTS] = { 0 };
+    int step;
+
+    Debounce_FilterInit(&filter, 0, 0, 0);
+
+    for(step = 0; step < 100000; step++)
+    {
+        /*每路以不同概率抖动，覆盖长时间稳定和频繁翻转*/
+        uint32_t noise = Test_Rand() & Test_Rand() & Test_Rand();
+        uint32_t sample = (step & 0x100) ? (0xA5A5A5A5 ^ noise) : noise;
+        uint32_t expectToggle = 0;
+        uint32_t toggle;
+        uint8_t i;
+
+        for(i = 0; i < DEBOUNCE_FILTER_INPUTS; i++)
+        {
+            uint32_t bit = 1UL << i;
+            if((sample ^ state) & bit)
+            {
+                if(++cnt[i] == 4)
+                {
+                    cnt[i] = 0;
+                    expectToggle |= bit;
+                }
+            }
+            else
+            {
+                cnt[i] = 0;
+            }
+        }
+        state ^= expectToggle;
+
+        toggle = Debounce_FilterIntegrate(&filter, sample);
+        TEST_CHECK_MSG(toggle == expectToggle, "step %d toggle %08X expect %08X",
+                       step, (unsigned)toggle, (unsigned)expectToggle);
+        TEST_CHECK(filter.State == state);
+        if(Test_FailCount)
+        {
+            return;
+        }
+    }
+}
+
+static int Test_CollectEvents(Debounce_Filter_TypeDef* filter, Debounce_Event_TypeDef* events, int max)
+{
+    int n = 0;
+    while(n < max && Debounce_FilterGetEvent(filter, &events[n]))
+    {
+        n++;
+    }
+    return n;
+}
+
+/*按下/释放、长按和连发事件的时序，以及可以停止采样的时机*/
+static void Test_Events(void)
+{
+    Debounce_Filter_TypeDef filter;
+    Debounce_Event_TypeDef events[DEBOUNCE_FILTER_EVENT_SIZE];
+    int i, n;
+
+    /*长按10次采样，连发间隔3次*/
+    Debounce_FilterInit(&filter, 0, 10, 3);
+
+    /*稳定的空闲状态不需要继续采样*/
+    TEST_CHECK(!Debounce_FilterUpdate(&filter, 0));
+
+    /*第4次采样才产生按下*/
+    for(i = 0; i < 3; i++)
+    {
+        TEST_CHECK(Debounce_FilterUpdate(&filter, 1U << 5));
+        TEST_CHECK(Test_CollectEvents(&filter, events, 16) == 0);
+    }
+    TEST_CHECK(Debounce_FilterUpdate(&filter, 1U << 5));
+    n = Test_CollectEvents(&filter, events, 16);
+    TEST_CHECK(n == 1 && events[0].Index == 5 && events[0].Event == DEBOUNCE_EVENT_PRESS);
+
+    /*按住10次采样后长按，之后每3次连发*/
+    for(i = 1; i <= 19; i++)
+    {
+        TEST_CHECK(Debounce_FilterUpdate(&filter, 1U << 5));
+        n = Test_CollectEvents(&filter, events, 16);
+        if(i == 10)
+        {
+            TEST_CHECK_MSG(n == 1 && events[0].Event == DEBOUNCE_EVENT_LONG_PRESS, "sample %d", i);
+        }
+        else if(i > 10 && (i - 10) % 3 == 0)
+        {
+            TEST_CHECK_MSG(n == 1 && events[0].Event == DEBOUNCE_EVENT_REPEAT, "sample %d", i);
+        }
+        else
+        {
+            TEST_CHECK_MSG(n == 0, "sample %d: %d events", i, n);
+        }
+    }
+
+    /*释放时一次抖动使计数清零，之后连续4次才释放*/
+    Debounce_FilterUpdate(&filter, 0);
+    Debounce_FilterUpdate(&filter, 0);
+    Debounce_FilterUpdate(&filter, 1U << 5);
+    Test_CollectEvents(&filter, events, 16);
+    for(i = 0; i < 3; i++)
+    {
+        int k;
+        Debounce_FilterUpdate(&filter, 0);
+        n = Test_CollectEvents(&filter, events, 16);
+
+        /*状态仍为按下，连发可以继续，但不能提前释放*/
+        for(k = 0; k < n; k++)
+        {
+            TEST_CHECK(events[k].Event != DEBOUNCE_EVENT_RELEASE);
+        }
+    }
+    TEST_CHECK(!Debounce_FilterUpdate(&filter, 0));
+    n = Test_CollectEvents(&filter, events, 16);
+    TEST_CHECK(n == 1 && events[0].Index == 5 && events[0].Event == DEBOUNCE_EVENT_RELEASE);
+    TEST_CHECK(filter.State == 0);
+}
+
+/*不连发时长按只报告一次，之后不再需要计时*/
+static void Test_LongOnce(void)
+{
+    Debounce_Filter_TypeDef filter;
+    Debounce_Event_TypeDef events[DEBOUNCE_FILTER_EVENT_SIZE];
+    int i, longCount = 0;
+    bool busy = true;
+
+    Debounce_FilterInit(&filter, 0, 5, 0);
+    for(i = 0; i < 50; i++)
+    {
+        int n, k;
+        busy = Debounce_FilterUpdate(&filter, 1);
+        n = Test_CollectEvents(&filter, events, 16);
+        for(k = 0; k < n; k++)
+        {
+            longCount += (events[k].Event == DEBOUNCE_EVENT_LONG_PRESS);
+        }
+    }
+    TEST_CHECK(longCount == 1);
+    TEST_CHECK(!busy);
+}
+
+/*事件队列满时丢弃并计数*/
+static void Test_Overflow(void)
+{
+    Debounce_Filter_TypeDef filter;
+    Debounce_Event_TypeDef events[DEBOUNCE_FILTER_INPUTS];
+    int i, n;
+
+    Debounce_FilterInit(&filter, 0, 0, 0);
+    for(i = 0; i < 4; i++)
+    {
+        Debounce_FilterUpdate(&filter, 0xFFFFFFFF);
+    }
+
+    n = Test_CollectEvents(&filter, events, DEBOUNCE_FILTER_INPUTS);
+    TEST_CHECK(n == DEBOUNCE_FILTER_EVENT_SIZE - 1);
+    TEST_CHECK(filter.EventDropped == DEBOUNCE_FILTER_INPUTS - (DEBOUNCE_FILTER_EVENT_SIZE - 1));
+    for(i = 0; i < n; i++)
+    {
+        TEST_CHECK(events[i].Index == i && events[i].Event == DEBOUNCE_EVENT_PRESS);
+    }
+}
+
+int main(void)
+{
+    Test_Integrate();
+    Test_Events();
+    Test_LongOnce();
+    Test_Overflow();
+    return TEST_RESULT();
+}
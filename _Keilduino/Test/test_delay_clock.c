@@ -0,0 +1,248 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#define _POSIX_C_SOURCE 200809L
+#include "test.h"
+#include "delay_clock.h"
+#include <signal.h>
+#include <string.h>
+#include <sys/time.h>
+
+/*
+ * 用定时信号模拟中断：信号处理函数在主线程任意位置抢占读取方，
+ * 推进模拟的周期计数器和SysTick，节拍挂起后随机延迟若干次才执行"SysTick中断"，
+ * 与关中断或被更高优先级中断阻塞的情形相同。
+ * 读取方检查各时钟都落在读取前后的真实时间之间，且单调不减。
+ */
+#define SIM_CPM             288U                // 288MHz
+#define SIM_LOAD            (SIM_CPM * 1000U)   // 1ms节拍
+#define SIM_PENDSTSET       (1UL << 26)
+#define SIM_START           0xF0000000ULL       // DWT很快回绕
+
+static volatile uint64_t Sim_Cycles;
+static volatile uint32_t Sim_DWT;
+static volatile uint32_t Sim_Val;
+static volatile uint32_t Sim_Icsr;
+static volatile uint32_t Sim_TickCount;
+static volatile uint32_t Sim_Signals;
+static volatile uint32_t Sim_LateTicks;
+
+static DelayClock_TypeDef Clock;
+static DelayClock_SysTick_TypeDef Tick;
+
+static uint32_t Sim_Rand(void)
+{
+    static uint32_t state = 0x1234567;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static void Sim_SysTickISR(void)
+{
+    Sim_Icsr &= ~SIM_PENDSTSET;
+    Sim_TickCount++;
+    DelayClock_Update(&Clock, Sim_DWT);
+}
+
+/*推进硬件，VAL和挂起位在同一次推进中改变，与硬件在同一个周期改变一致*/
+static void Sim_Step(uint32_t step)
+{
+    uint64_t base = Sim_Cycles - SIM_START;
+    uint64_t phase = base % SIM_LOAD;
+
+    /*节拍已挂起时不能再跨过下一个节拍，否则硬件也会丢失节拍*/
+    if((Sim_Icsr & SIM_PENDSTSET) && phase + step >= SIM_LOAD)
+    {
+        Sim_SysTickISR();
+    }
+
+    if(phase + step >= SIM_LOAD)
+    {
+        Sim_Icsr |= SIM_PENDSTSET;
+    }
+
+    Sim_Cycles += step;
+    Sim_DWT = (uint32_t)Sim_Cycles;
+    Sim_Val = SIM_LOAD - 1 - (uint32_t)((Sim_Cycles - SIM_START) % SIM_LOAD);
+}
+
+static void Sim_SignalHandler(int sig)
+{
+    (void)sig;
+    Sim_Signals++;
+
+    Sim_Step(1 + Sim_Rand() % (SIM_LOAD / 2));
+
+    /*挂起的节拍有一半概率推迟到之后的信号中执行*/
+    if(Sim_Icsr & SIM_PENDSTSET)
+    {
+        if(Sim_Rand() & 1)
+        {
+            Sim_SysTickISR();
+        }
+        else
+        {
+            Sim_LateTicks++;
+        }
+    }
+}
+
+static void Sim_Reset(void)
+{
+    Sim_Cycles = SIM_START;
+    Sim_DWT = (uint32_t)SIM_START;
+    Sim_Val = SIM_LOAD - 1;
+    Sim_Icsr = 0;
+    Sim_TickCount = 0;
+
+    DelayClock_Init(&Clock, SIM_CPM, Sim_DWT);
+
+    Tick.TickCount = &Sim_TickCount;
+    Tick.Val = &Sim_Val;
+    Tick.Icsr = &Sim_Icsr;
+    Tick.PendMask = SIM_PENDSTSET;
+    Tick.Load = SIM_LOAD;
+    Tick.CyclesPerMicros = SIM_CPM;
+    Tick.TickMicros = 1000;
+}
+
+/*VAL已重装但节拍中断尚未执行，必须补上一个节拍，否则时间倒退近1ms*/
+static void Test_PendingTick(void)
+{
+    uint32_t before, after;
+
+    Sim_Reset();
+    Sim_Step(SIM_LOAD - 10);
+    before = DelayClock_SysTickMicros(&Tick);
+
+    Sim_Step(20);
+    TEST_CHECK(Sim_Icsr & SIM_PENDSTSET);
+    after = DelayClock_SysTickMicros(&Tick);
+    TEST_CHECK_MSG(after >= before && after == 1000, "before %u after %u", (unsigned)before, (unsigned)after);
+
+    Sim_SysTickISR();
+    TEST_CHECK(DelayClock_SysTickMicros(&Tick) == after);
+}
+
+/*快照与DWT回绕：连续推进并在每个节拍更新，64位值与真实时间一致*/
+static void Test_Wrap(void)
+{
+    DelayClock_Snapshot_TypeDef snapshot;
+    int i;
+
+    Sim_Reset();
+    for(i = 0; i < 50000; i++)
+    {
+        Sim_Step(SIM_LOAD / 3 + 7);
+        if(Sim_Icsr & SIM_PENDSTSET)
+        {
+            Sim_SysTickISR();
+        }
+
+        DelayClock_Read(&Clock, &snapshot);
+        TEST_CHECK(DelayClock_ToCycles(&snapshot, Sim_DWT) == Sim_Cycles);
+        TEST_CHECK(DelayClock_ToMicros(&Clock, &snapshot, Sim_DWT) == Sim_Cycles / SIM_CPM);
+        TEST_CHECK(DelayClock_ToNanos(&Clock, &snapshot, Sim_DWT) == Sim_Cycles * 1000 / SIM_CPM);
+        if(Test_FailCount)
+        {
+            return;
+        }
+    }
+
+    /*至少跨过一次32位回绕*/
+    TEST_CHECK(Sim_Cycles - SIM_START > 0x100000000ULL);
+}
+
+static void Test_Stress(void)
+{
+    struct sigaction sa;
+    struct itimerval timer;
+    uint32_t lastMicros = 0;
+    uint64_t lastCycles = 0, lastMicros64 = 0, lastNanos = 0;
+    uint64_t reads = 0;
+
+    Sim_Reset();
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = Sim_SignalHandler;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGALRM, &sa, NULL);
+
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = 20;
+    timer.it_value = timer.it_interval;
+    setitimer(ITIMER_REAL, &timer, NULL);
+
+    /*模拟时间跨过两次DWT回绕*/
+    while(Sim_Cycles - SIM_START < 0x200000000ULL && Test_FailCount < 10)
+    {
+        DelayClock_Snapshot_TypeDef snapshot;
+        uint64_t t0 = Sim_Cycles;
+        uint32_t us = DelayClock_SysTickMicros(&Tick);
+        uint64_t cycles, us64, ns;
+        uint64_t t1;
+
+        DelayClock_Read(&Clock, &snapshot);
+        cycles = DelayClock_ToCycles(&snapshot, Sim_DWT);
+        DelayClock_Read(&Clock, &snapshot);
+        us64 = DelayClock_ToMicros(&Clock, &snapshot, Sim_DWT);
+        DelayClock_Read(&Clock, &snapshot);
+        ns = DelayClock_ToNanos(&Clock, &snapshot, Sim_DWT);
+        t1 = Sim_Cycles;
+
+        /*SysTick微秒数从节拍起点算起，VAL的计数偏差最多1微秒*/
+        TEST_CHECK_MSG(us >= (uint32_t)((t0 - SIM_START) / SIM_CPM)
+                       && us <= (uint32_t)((t1 - SIM_START) / SIM_CPM) + 1,
+                       "micros %u outside [%u, %u]", (unsigned)us,
+                       (unsigned)((t0 - SIM_START) / SIM_CPM), (unsigned)((t1 - SIM_START) / SIM_CPM));
+        TEST_CHECK_MSG(cycles >= t0 && cycles <= t1, "cycles64 %llu outside [%llu, %llu]",
+                       (unsigned long long)cycles, (unsigned long long)t0, (unsigned long long)t1);
+        TEST_CHECK(us64 >= t0 / SIM_CPM && us64 <= t1 / SIM_CPM);
+        TEST_CHECK(ns >= t0 * 1000 / SIM_CPM && ns <= t1 * 1000 / SIM_CPM);
+
+        TEST_CHECK(us >= lastMicros);
+        TEST_CHECK(cycles >= lastCycles && us64 >= lastMicros64 && ns >= lastNanos);
+        lastMicros = us;
+        lastCycles = cycles;
+        lastMicros64 = us64;
+        lastNanos = ns;
+        reads++;
+    }
+
+    timer.it_value.tv_usec = 0;
+    timer.it_interval.tv_usec = 0;
+    setitimer(ITIMER_REAL, &timer, NULL);
+
+    printf("stress: %llu reads, %u interrupts, %u delayed ticks\n",
+           (unsigned long long)reads, (unsigned)Sim_Signals, (unsigned)Sim_LateTicks);
+}
+
+int main(void)
+{
+    Test_PendingTick();
+    Test_Wrap();
+    Test_Stress();
+    return TEST_RESULT();
+}
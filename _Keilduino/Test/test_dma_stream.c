@@ -0,0 +1,182 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "dma_stream.h"
+#include <string.h>
+
+/*
+ * 模拟DMA循环播放双缓冲：每个半缓冲播放完后产生一次事件，
+ * 检查播放出的序列为源数据加保持值，且在最后一个有效半缓冲后结束。
+ */
+typedef struct
+{
+    uint32_t Total;     // 源数据总单元数
+    uint32_t Pos;       // 已填充位置
+    uint32_t Last;      // 最后填入的值，用于补齐
+    uint32_t Calls;     // Fill调用次数
+} Source_TypeDef;
+
+static uint16_t Source_Fill(void* Half, uint16_t Length, void* UserData)
+{
+    Source_TypeDef* src = (Source_TypeDef*)UserData;
+    uint32_t* half = (uint32_t*)Half;
+    uint16_t i;
+
+    src->Calls++;
+    for(i = 0; i < Length && src->Pos < src->Total; i++)
+    {
+        half[i] = ++src->Pos;
+    }
+    return i;
+}
+
+static void Source_Pad(void* Half, uint16_t Filled, uint16_t Length, void* UserData)
+{
+    Source_TypeDef* src = (Source_TypeDef*)UserData;
+    uint32_t* half = (uint32_t*)Half;
+    uint16_t i;
+
+    if(Filled > 0)
+    {
+        src->Last = half[Filled - 1];
+    }
+    for(i = Filled; i < Length; i++)
+    {
+        half[i] = src->Last;
+    }
+}
+
+static void Test_Play(uint32_t total, uint16_t halfLength)
+{
+    static uint32_t buffer[2 * 64];
+    static uint32_t played[4096];
+    DMA_Stream_TypeDef stream;
+    Source_TypeDef src = { 0 };
+    uint32_t count = 0;
+    uint32_t events = 0;
+    bool second = false;
+    bool done = false;
+    uint32_t i;
+
+    src.Total = total;
+    DMA_Stream_Start(&stream, buffer, halfLength, sizeof(uint32_t), Source_Fill, Source_Pad, &src);
+
+    while(!done && count + halfLength <= sizeof(played) / sizeof(played[0]))
+    {
+        /*DMA播放当前半缓冲，然后产生半传输或全传输事件*/
+        memcpy(played + count, buffer + (second ? halfLength : 0), halfLength * sizeof(uint32_t));
+        count += halfLength;
+        done = DMA_Stream_Event(&stream, second);
+        second = !second;
+        events++;
+    }
+
+    TEST_CHECK_MSG(done, "total=%u half=%u never finished", (unsigned)total, halfLength);
+
+    /*有效数据所在的半缓冲全部播放后立即结束，不多播放*/
+    {
+        uint32_t halves = total / halfLength + 1;
+        if(total == 0)
+        {
+            halves = 1;
+        }
+        TEST_CHECK_MSG(events == halves, "total=%u half=%u events=%u expect %u",
+                       (unsigned)total, halfLength, (unsigned)events, (unsigned)halves);
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        uint32_t expect = (i < total) ? i + 1 : total;
+        if(played[i] != expect)
+        {
+            TEST_CHECK_MSG(false, "total=%u half=%u played[%u]=%u expect %u",
+                           (unsigned)total, halfLength, (unsigned)i, (unsigned)played[i], (unsigned)expect);
+            break;
+        }
+    }
+
+    /*数据结束后不再调用Fill*/
+    TEST_CHECK(src.Calls == (total + halfLength) / halfLength);
+}
+
+static uint16_t Overfill_Fill(void* Half, uint16_t Length, void* UserData)
+{
+    (void)Half;
+    (void)UserData;
+    return Length + 5;
+}
+
+static void Overfill_Pad(void* Half, uint16_t Filled, uint16_t Length, void* UserData)
+{
+    (void)Half;
+    (void)UserData;
+    TEST_CHECK(Filled <= Length);
+}
+
+static uint16_t Endless_Fill(void* Half, uint16_t Length, void* UserData)
+{
+    (void)Half;
+    (void)UserData;
+    return Length;
+}
+
+static void Test_Endless(void)
+{
+    static uint16_t buffer[2 * 3 * 8];
+    DMA_Stream_TypeDef stream;
+    int i;
+
+    /*单元为3个半字的帧*/
+    DMA_Stream_Start(&stream, buffer, 8, 3 * sizeof(uint16_t), Endless_Fill, Overfill_Pad, NULL);
+    for(i = 0; i < 100; i++)
+    {
+        TEST_CHECK(!DMA_Stream_Event(&stream, i & 1));
+    }
+}
+
+int main(void)
+{
+    static const uint16_t halves[] = { 1, 2, 7, 64 };
+    DMA_Stream_TypeDef stream;
+    uint32_t total;
+    unsigned h;
+
+    for(h = 0; h < sizeof(halves) / sizeof(halves[0]); h++)
+    {
+        for(total = 0; total <= 300; total++)
+        {
+            Test_Play(total, halves[h]);
+        }
+    }
+
+    Test_Endless();
+
+    /*Fill返回值超过Length时截断*/
+    {
+        static uint32_t buffer[8];
+        DMA_Stream_Start(&stream, buffer, 4, sizeof(uint32_t), Overfill_Fill, Overfill_Pad, NULL);
+        TEST_CHECK(!DMA_Stream_Event(&stream, false));
+    }
+
+    return TEST_RESULT();
+}
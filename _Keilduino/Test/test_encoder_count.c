@@ -0,0 +1,223 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "encoder_count.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 模拟编码器计数器：随机游走、在回绕点附近来回抖动，溢出标志置位后延迟若干步才进入中断，
+ * 中断和读取都按encoder.c的方式调用，扩展后的计数值必须始终等于真实位置。
+ * 重点是上溢后倒退一步(方向位已为向下、计数器仍在下半区)和下溢后前进一步的情形。
+ * 另检查A/B相引脚组合的各种错误码及其优先顺序。
+ */
+#define TEST_STEPS          200000
+#define TEST_LATENCY_MAX    4
+
+typedef struct
+{
+    uint64_t Range;
+    uint32_t Cnt;
+    bool Flag;          /* 溢出标志 */
+    int64_t High;       /* 中断维护的溢出部分 */
+    int64_t Position;   /* 真实位置 */
+} Test_Encoder_TypeDef;
+
+static uint32_t Random_State = 1;
+
+static uint32_t Random_Next(void)
+{
+    Random_State = Random_State * 1103515245 + 12345;
+    return Random_State >> 16;
+}
+
+static void Test_Init(Test_Encoder_TypeDef* enc, uint64_t range, uint32_t cnt)
+{
+    enc->Range = range;
+    enc->Cnt = cnt;
+    enc->Flag = false;
+    enc->High = 0;
+    enc->Position = cnt;
+}
+
+/*计数器走一步，回绕时置溢出标志*/
+static void Test_Step(Test_Encoder_TypeDef* enc, bool up)
+{
+    if(up)
+    {
+        enc->Cnt = (enc->Cnt == (uint32_t)(enc->Range - 1)) ? 0 : enc->Cnt + 1;
+        enc->Flag |= (enc->Cnt == 0);
+        enc->Position++;
+    }
+    else
+    {
+        enc->Flag |= (enc->Cnt == 0);
+        enc->Cnt = (enc->Cnt == 0) ? (uint32_t)(enc->Range - 1) : enc->Cnt - 1;
+        enc->Position--;
+    }
+}
+
+/*Encoder_EventHandler*/
+static void Test_Interrupt(Test_Encoder_TypeDef* enc)
+{
+    enc->Flag = false;
+    enc->High += Encoder_OverflowStep(enc->Cnt, enc->Range);
+}
+
+/*Encoder_ReadCount*/
+static int64_t Test_Read(const Test_Encoder_TypeDef* enc)
+{
+    return Encoder_ExtendCount(enc->High, enc->Cnt, enc->Flag, enc->Range);
+}
+
+static bool Test_WouldWrap(const Test_Encoder_TypeDef* enc, bool up)
+{
+    return up ? (enc->Cnt == (uint32_t)(enc->Range - 1)) : (enc->Cnt == 0);
+}
+
+/*
+ * 随机游走：Bias为向上的概率(1/256)；中断延迟为0~TEST_LATENCY_MAX步，
+ * 但在下一次回绕之前一定已经处理(两次溢出合并成一个标志无法区分，这是硬件限制)
+ */
+static void Test_Walk(uint64_t range, uint32_t start, uint32_t bias, const char* name)
+{
+    Test_Encoder_TypeDef enc;
+    uint32_t latency = 0;
+    int errors = 0;
+    int wraps = 0;
+    int i;
+
+    Test_Init(&enc, range, start);
+
+    for(i = 0; i < TEST_STEPS; i++)
+    {
+        bool up = (Random_Next() & 0xFF) < bias;
+
+        if(enc.Flag && (latency == 0 || Test_WouldWrap(&enc, up)))
+        {
+            Test_Interrupt(&enc);
+        }
+
+        if(Test_WouldWrap(&enc, up))
+        {
+            wraps++;
+            latency = Random_Next() % (TEST_LATENCY_MAX + 1);
+        }
+        else if(latency)
+        {
+            latency--;
+        }
+
+        Test_Step(&enc, up);
+
+        if(Test_Read(&enc) != enc.Position && errors++ < 5)
+        {
+            TEST_CHECK_MSG(false, "%s step=%d cnt=%u position=%lld read=%lld",
+                name, i, enc.Cnt, (long long)enc.Position, (long long)Test_Read(&enc));
+        }
+    }
+
+    if(enc.Flag)
+    {
+        Test_Interrupt(&enc);
+    }
+    TEST_CHECK_MSG(enc.High + enc.Cnt == enc.Position, "%s final", name);
+    TEST_CHECK_MSG(wraps > 0, "%s no wrap", name);
+}
+
+/*回绕点附近的固定序列：上溢后倒退、下溢后前进，中断在抖动之后才处理*/
+static void Test_Dither(uint64_t range)
+{
+    Test_Encoder_TypeDef enc;
+
+    /*Range-1 -> 0(上溢) -> 1 -> 0，中断时方向为向下，计数器为0*/
+    Test_Init(&enc, range, (uint32_t)(range - 1));
+    Test_Step(&enc, true);
+    Test_Step(&enc, true);
+    Test_Step(&enc, false);
+    TEST_CHECK(enc.Flag && enc.Cnt == 0);
+    TEST_CHECK(Test_Read(&enc) == enc.Position);
+    Test_Interrupt(&enc);
+    TEST_CHECK(enc.High == (int64_t)range);
+    TEST_CHECK(Test_Read(&enc) == enc.Position);
+
+    /*0 -> Range-1(下溢) -> Range-2 -> Range-1，中断时方向为向上*/
+    Test_Init(&enc, range, 0);
+    Test_Step(&enc, false);
+    Test_Step(&enc, false);
+    Test_Step(&enc, true);
+    TEST_CHECK(enc.Flag && enc.Cnt == (uint32_t)(range - 1));
+    TEST_CHECK(Test_Read(&enc) == enc.Position);
+    Test_Interrupt(&enc);
+    TEST_CHECK(enc.High == -(int64_t)range);
+    TEST_CHECK(Test_Read(&enc) == -1);
+
+    /*接近半个范围的延迟仍能判断*/
+    TEST_CHECK(Encoder_OverflowStep((uint32_t)(range / 2 - 1), range) == (int64_t)range);
+    TEST_CHECK(Encoder_OverflowStep((uint32_t)(range / 2), range) == -(int64_t)range);
+}
+
+static void Test_CheckPins(void)
+{
+    static const int timerA = 0, timerB = 0;
+    const Encoder_PinInfo_TypeDef ch1 = { &timerA, 1, true };
+    const Encoder_PinInfo_TypeDef ch2 = { &timerA, 2, true };
+    const Encoder_PinInfo_TypeDef ch3 = { &timerA, 3, true };
+    const Encoder_PinInfo_TypeDef otherCh2 = { &timerB, 2, true };
+    const Encoder_PinInfo_TypeDef basicCh1 = { &timerB, 1, false };
+    const Encoder_PinInfo_TypeDef basicCh2 = { &timerB, 2, false };
+    const Encoder_PinInfo_TypeDef noTimer = { 0, 0, false };
+    const Encoder_PinInfo_TypeDef noChannel = { &timerA, 0, true };
+
+    TEST_CHECK(Encoder_CheckPinInfo(1, &ch1, 2, &ch2) == ENCODER_OK);
+    TEST_CHECK(Encoder_CheckPinInfo(2, &ch2, 1, &ch1) == ENCODER_OK);
+
+    TEST_CHECK(Encoder_CheckPinInfo(1, &noTimer, 2, &ch2) == ENCODER_ERR_PIN);
+    TEST_CHECK(Encoder_CheckPinInfo(1, &ch1, 2, &noTimer) == ENCODER_ERR_PIN);
+    TEST_CHECK(Encoder_CheckPinInfo(1, &ch1, 2, &noChannel) == ENCODER_ERR_PIN);
+    TEST_CHECK(Encoder_CheckPinInfo(1, &ch1, 1, &ch2) == ENCODER_ERR_PIN);
+
+    TEST_CHECK(Encoder_CheckPinInfo(1, &ch1, 2, &otherCh2) == ENCODER_ERR_TIMER_MISMATCH);
+    TEST_CHECK(Encoder_CheckPinInfo(1, &ch1, 2, &ch3) == ENCODER_ERR_CHANNEL);
+    TEST_CHECK(Encoder_CheckPinInfo(1, &ch1, 2, &ch1) == ENCODER_ERR_CHANNEL);
+    TEST_CHECK(Encoder_CheckPinInfo(1, &basicCh1, 2, &basicCh2) == ENCODER_ERR_TIMER_TYPE);
+
+    /*定时器不一致优先于通道错误，通道错误优先于定时器类型*/
+    TEST_CHECK(Encoder_CheckPinInfo(1, &ch3, 2, &otherCh2) == ENCODER_ERR_TIMER_MISMATCH);
+    TEST_CHECK(Encoder_CheckPinInfo(1, &basicCh1, 2, &basicCh1) == ENCODER_ERR_CHANNEL);
+}
+
+int main(void)
+{
+    Test_Dither(0x10000);
+    Test_Dither(0x100000000ULL);
+
+    /*16位：随机游走(均匀和偏向一侧)，从回绕点附近开始；32位只做抖动*/
+    Test_Walk(0x10000, 0xFFFE, 128, "16bit dither");
+    Test_Walk(0x10000, 0, 200, "16bit forward");
+    Test_Walk(0x10000, 5, 56, "16bit backward");
+    Test_Walk(0x100000000ULL, 0xFFFFFFFEUL, 128, "32bit dither");
+
+    Test_CheckPins();
+    return TEST_RESULT();
+}
@@ -0,0 +1,327 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "gpio_batch.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/*
+ * 以库函数gpio_init()的逐引脚读改写作为参考模型：配置表按顺序逐条、逐引脚写入端口寄存器；
+ * 批量配置按端口合并后每个寄存器只写一次，两者最终的寄存器值必须一致。
+ * 覆盖同一引脚重复出现(以后面的为准)、一次配置多个端口、
+ * INPUT_ANALOG_DMA/PWM与无效引脚被跳过且不改动寄存器，以及多引脚掩码的单次配置。
+ */
+#define TEST_PORT_MAX       8
+#define TEST_PIN_MAX        (TEST_PORT_MAX * GPIO_BATCH_PORT_PINS)
+#define TEST_CONFIG_MAX     64
+#define TEST_ROUNDS         2000
+
+typedef struct
+{
+    volatile uint32_t cfgr;
+    volatile uint32_t omode;
+    volatile uint32_t odrvr;
+    volatile uint32_t pull;
+} Test_Port_TypeDef;
+
+static uint32_t Random_State = 1;
+
+static uint32_t Random_Next(void)
+{
+    Random_State = Random_State * 1103515245 + 12345;
+    return Random_State >> 16;
+}
+
+static uint32_t Random_Word(void)
+{
+    return (Random_Next() << 16) ^ Random_Next();
+}
+
+/*与gpio.c改为查表前的if-else分支相同，返回false表示该模式不配置GPIO*/
+static bool Test_ModeFields(PinMode_TypeDef mode, uint32_t* cfg, uint32_t* otype, uint32_t* pull)
+{
+    *otype = GPIO_BATCH_OUTPUT_PUSH_PULL;
+    *pull = GPIO_BATCH_PULL_NONE;
+
+    switch(mode)
+    {
+    case INPUT:
+        *cfg = GPIO_BATCH_MODE_INPUT;
+        break;
+    case INPUT_PULLUP:
+        *cfg = GPIO_BATCH_MODE_INPUT;
+        *pull = GPIO_BATCH_PULL_UP;
+        break;
+    case INPUT_PULLDOWN:
+        *cfg = GPIO_BATCH_MODE_INPUT;
+        *pull = GPIO_BATCH_PULL_DOWN;
+        break;
+    case INPUT_ANALOG:
+        *cfg = GPIO_BATCH_MODE_ANALOG;
+        break;
+    case OUTPUT:
+        *cfg = GPIO_BATCH_MODE_OUTPUT;
+        break;
+    case OUTPUT_OPEN_DRAIN:
+        *cfg = GPIO_BATCH_MODE_OUTPUT;
+        *otype = GPIO_BATCH_OUTPUT_OPEN_DRAIN;
+        break;
+    case OUTPUT_AF_PP:
+        *cfg = GPIO_BATCH_MODE_MUX;
+        break;
+    case OUTPUT_AF_OD:
+        *cfg = GPIO_BATCH_MODE_MUX;
+        *otype = GPIO_BATCH_OUTPUT_OPEN_DRAIN;
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+/*gpio_init()：对掩码中的每个引脚依次读改写四个寄存器*/
+static void Test_GpioInit(Test_Port_TypeDef* port, uint16_t pins, PinMode_TypeDef mode, uint32_t drive)
+{
+    uint32_t cfg, otype, pull;
+    uint32_t i;
+
+    if(!Test_ModeFields(mode, &cfg, &otype, &pull))
+    {
+        return;
+    }
+
+    for(i = 0; i < GPIO_BATCH_PORT_PINS; i++)
+    {
+        if(pins & (1U << i))
+        {
+            port->cfgr  = (port->cfgr  & ~(0x03U << (i * 2))) | (cfg << (i * 2));
+            port->omode = (port->omode & ~(0x01U << i)) | (otype << i);
+            port->odrvr = (port->odrvr & ~(0x03U << (i * 2))) | (drive << (i * 2));
+            port->pull  = (port->pull  & ~(0x03U << (i * 2))) | (pull << (i * 2));
+        }
+    }
+}
+
+/*参考：逐条调用pinMode()，返回配置成功的条目数*/
+static uint16_t Test_ModelInit(Test_Port_TypeDef* ports, const PinConfig_TypeDef* config, uint16_t count, uint32_t drive)
+{
+    uint16_t success = 0;
+    uint32_t cfg, otype, pull;
+    uint16_t i;
+
+    for(i = 0; i < count; i++)
+    {
+        if(config[i].Pin >= TEST_PIN_MAX || !Test_ModeFields(config[i].Mode, &cfg, &otype, &pull))
+        {
+            continue;
+        }
+        Test_GpioInit(
+            &ports[config[i].Pin / GPIO_BATCH_PORT_PINS],
+            (uint16_t)(1U << (config[i].Pin % GPIO_BATCH_PORT_PINS)),
+            config[i].Mode,
+            drive
+        );
+        success++;
+    }
+    return success;
+}
+
+/*与GPIO_InitBatch相同：合并后只写有引脚的端口*/
+static uint16_t Test_BatchInit(Test_Port_TypeDef* ports, const PinConfig_TypeDef* config, uint16_t count, uint32_t drive)
+{
+    GPIO_PortConfig_TypeDef portConfig[TEST_PORT_MAX];
+    uint16_t success;
+    uint32_t i;
+
+    memset(portConfig, 0, sizeof(portConfig));
+    success = GPIO_Batch_Build(portConfig, TEST_PORT_MAX, config, count, drive);
+
+    for(i = 0; i < TEST_PORT_MAX; i++)
+    {
+        GPIO_Batch_Apply(&portConfig[i], &ports[i].cfgr, &ports[i].omode, &ports[i].odrvr, &ports[i].pull);
+    }
+    return success;
+}
+
+static void Test_RandomPorts(Test_Port_TypeDef* ports)
+{
+    uint32_t i;
+    for(i = 0; i < TEST_PORT_MAX; i++)
+    {
+        ports[i].cfgr = Random_Word();
+        ports[i].omode = Random_Word() & 0xFFFF;
+        ports[i].odrvr = Random_Word();
+        ports[i].pull = Random_Word();
+    }
+}
+
+static bool Test_PortsEqual(const Test_Port_TypeDef* a, const Test_Port_TypeDef* b)
+{
+    uint32_t i;
+    for(i = 0; i < TEST_PORT_MAX; i++)
+    {
+        if(a[i].cfgr != b[i].cfgr || a[i].omode != b[i].omode
+                || a[i].odrvr != b[i].odrvr || a[i].pull != b[i].pull)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*批量与逐引脚的结果比较，寄存器初值随机*/
+static void Test_Compare(const PinConfig_TypeDef* config, uint16_t count, uint32_t drive)
+{
+    Test_Port_TypeDef model[TEST_PORT_MAX];
+    Test_Port_TypeDef batch[TEST_PORT_MAX];
+    uint16_t expected, actual;
+
+    Test_RandomPorts(model);
+    memcpy(batch, model, sizeof(batch));
+
+    expected = Test_ModelInit(model, config, count, drive);
+    actual = Test_BatchInit(batch, config, count, drive);
+
+    TEST_CHECK_MSG(actual == expected, "count=%u expected=%u actual=%u", count, expected, actual);
+    TEST_CHECK_MSG(Test_PortsEqual(model, batch), "count=%u drive=%u", count, drive);
+}
+
+static void Test_Cases(void)
+{
+    /*重复引脚：PA3先上拉后推挽输出，PB0先开漏后模拟*/
+    static const PinConfig_TypeDef duplicate[] =
+    {
+        { 3, INPUT_PULLUP },
+        { 16, OUTPUT_OPEN_DRAIN },
+        { 3, OUTPUT },
+        { 16, INPUT_ANALOG },
+        { 3, INPUT_PULLDOWN }
+    };
+
+    /*多个端口：PA、PC、PH各有引脚，端口边界PA15/PB0、PG15/PH0*/
+    static const PinConfig_TypeDef ports[] =
+    {
+        { 0, OUTPUT_AF_PP },
+        { 15, OUTPUT_AF_OD },
+        { 16, INPUT },
+        { 32 + 7, OUTPUT },
+        { 111, INPUT_PULLUP },
+        { 112, OUTPUT_OPEN_DRAIN },
+        { 127, INPUT_ANALOG }
+    };
+
+    /*跳过：INPUT_ANALOG_DMA/PWM和越界引脚，也不影响同一引脚之前的配置*/
+    static const PinConfig_TypeDef skipped[] =
+    {
+        { 5, OUTPUT },
+        { 5, PWM },
+        { 6, INPUT_ANALOG_DMA },
+        { 48, PWM },
+        { TEST_PIN_MAX, OUTPUT },
+        { 255, INPUT }
+    };
+
+    Test_Port_TypeDef before[TEST_PORT_MAX];
+    Test_Port_TypeDef after[TEST_PORT_MAX];
+
+    Test_Compare(duplicate, sizeof(duplicate) / sizeof(duplicate[0]), 1);
+    Test_Compare(ports, sizeof(ports) / sizeof(ports[0]), 2);
+    Test_Compare(skipped, sizeof(skipped) / sizeof(skipped[0]), 3);
+
+    /*只有被跳过的条目时不改动任何寄存器*/
+    Test_RandomPorts(before);
+    memcpy(after, before, sizeof(after));
+    TEST_CHECK(Test_BatchInit(after, skipped + 1, 5, 1) == 0);
+    TEST_CHECK(Test_PortsEqual(before, after));
+
+    TEST_CHECK(GPIO_Batch_GetModeInfo(INPUT_ANALOG_DMA) == NULL);
+    TEST_CHECK(GPIO_Batch_GetModeInfo(PWM) == NULL);
+    TEST_CHECK(GPIO_Batch_GetModeInfo(PWM + 1) == NULL);
+    TEST_CHECK(GPIO_Batch_GetModeInfo(OUTPUT) != NULL);
+}
+
+/*GPIOx_Init：一次配置多个引脚的掩码*/
+static void Test_Mask(void)
+{
+    int round;
+
+    for(round = 0; round < TEST_ROUNDS; round++)
+    {
+        Test_Port_TypeDef model[1];
+        Test_Port_TypeDef batch[1];
+        GPIO_PortConfig_TypeDef config;
+        PinMode_TypeDef mode = (PinMode_TypeDef)(Random_Next() % (PWM + 1));
+        uint16_t pins = (uint16_t)Random_Word();
+        uint32_t drive = Random_Next() % 4;
+        const GPIO_ModeInfo_TypeDef* modeInfo = GPIO_Batch_GetModeInfo(mode);
+
+        Test_RandomPorts(model);
+        memcpy(batch, model, sizeof(batch));
+
+        Test_GpioInit(&model[0], pins, mode, drive);
+
+        if(modeInfo != NULL)
+        {
+            memset(&config, 0, sizeof(config));
+            GPIO_Batch_Add(&config, pins, modeInfo, drive);
+            GPIO_Batch_Apply(&config, &batch[0].cfgr, &batch[0].omode, &batch[0].odrvr, &batch[0].pull);
+        }
+
+        TEST_CHECK_MSG(
+            model[0].cfgr == batch[0].cfgr && model[0].omode == batch[0].omode
+            && model[0].odrvr == batch[0].odrvr && model[0].pull == batch[0].pull,
+            "round=%d mode=%d pins=0x%04X", round, (int)mode, pins
+        );
+    }
+}
+
+/*随机配置表：引脚集中在少数几个引脚上以制造大量重复*/
+static void Test_Random(void)
+{
+    PinConfig_TypeDef config[TEST_CONFIG_MAX];
+    int round;
+
+    for(round = 0; round < TEST_ROUNDS; round++)
+    {
+        uint16_t count = (uint16_t)(Random_Next() % (TEST_CONFIG_MAX + 1));
+        uint32_t span = (round & 1) ? 24 : (TEST_PIN_MAX + 4);
+        uint16_t i;
+
+        for(i = 0; i < count; i++)
+        {
+            config[i].Pin = (uint8_t)(Random_Next() % span);
+            config[i].Mode = (PinMode_TypeDef)(Random_Next() % (PWM + 1));
+        }
+
+        Test_Compare(config, count, Random_Next() % 4);
+    }
+}
+
+int main(void)
+{
+    Test_Cases();
+    Test_Mask();
+    Test_Random();
+    return TEST_RESULT();
+}
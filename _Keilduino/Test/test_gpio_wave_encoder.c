@@ -0,0 +1,261 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "gpio_wave_encoder.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/*
+ * 把生成的scr字序列依次作用到模拟的16位端口上，得到每个时隙的引脚电平，
+ * 再从电平波形中解码：WS2812每bit 3个时隙、高电平1个时隙为0/2个时隙为1，
+ * 多通道各引脚独立解码出各自的数据；STEP上升沿位置等于间隔的累加，
+ * 总时隙数等于DIR建立时间加上间隔之和；缓冲不足或参数错误时返回0且不写缓冲。
+ */
+#define TEST_BUFFER_SIZE    4096
+#define TEST_SENTINEL       0xDEADBEEFUL
+
+static uint32_t Buffer[TEST_BUFFER_SIZE];
+static uint16_t Levels[TEST_BUFFER_SIZE];
+
+/*按scr语义回放：低16位置位，高16位清零(同一引脚同时置位和清零时置位优先)*/
+static void Test_Replay(const uint32_t* words, uint32_t count, uint16_t initial)
+{
+    uint16_t port = initial;
+    uint32_t i;
+
+    for(i = 0; i < count; i++)
+    {
+        port &= (uint16_t)~(words[i] >> 16);
+        port |= (uint16_t)words[i];
+        Levels[i] = port;
+    }
+}
+
+static int Test_Pin(uint32_t slot, uint16_t mask)
+{
+    return (Levels[slot] & mask) ? 1 : 0;
+}
+
+/*从引脚波形解码WS2812数据，时序不符时返回false*/
+static bool Test_DecodeWS2812(uint16_t mask, uint32_t words, uint8_t* out)
+{
+    uint32_t bit;
+
+    if(words % GPIO_WAVE_WS2812_SLOTS_PER_BIT)
+    {
+        return false;
+    }
+
+    memset(out, 0, words / GPIO_WAVE_WS2812_SLOTS_PER_BIT / 8);
+    for(bit = 0; bit < words / GPIO_WAVE_WS2812_SLOTS_PER_BIT; bit++)
+    {
+        uint32_t slot = bit * GPIO_WAVE_WS2812_SLOTS_PER_BIT;
+        int h0 = Test_Pin(slot, mask);
+        int h1 = Test_Pin(slot + 1, mask);
+        int h2 = Test_Pin(slot + 2, mask);
+
+        /*每bit以上升沿开始，以低电平结束*/
+        if(!h0 || h2)
+        {
+            return false;
+        }
+        if(h1)
+        {
+            out[bit / 8] |= (uint8_t)(0x80 >> (bit % 8));
+        }
+    }
+    return true;
+}
+
+static void Test_WS2812(void)
+{
+    const uint8_t data[3] = { 0x00, 0xFF, 0xA5 };
+    uint8_t decoded[3];
+    uint32_t words;
+    uint32_t i;
+
+    words = GPIO_Wave_EncodeWS2812(Buffer, TEST_BUFFER_SIZE, 1 << 5, data, sizeof(data));
+    TEST_CHECK(words == GPIO_WAVE_WS2812_WORDS(3));
+    TEST_CHECK(words == 3 * 8 * 3);
+
+    /*0: 1个时隙高电平，1: 2个时隙高电平，周期3个时隙(2.4MHz时为417ns/833ns，1.25us)*/
+    Test_Replay(Buffer, words, 0);
+    TEST_CHECK(Test_DecodeWS2812(1 << 5, words, decoded));
+    TEST_CHECK(memcmp(decoded, data, sizeof(data)) == 0);
+    TEST_CHECK(Test_Pin(0, 1 << 5) == 1 && Test_Pin(1, 1 << 5) == 0);
+    TEST_CHECK(Test_Pin(24, 1 << 5) == 1 && Test_Pin(25, 1 << 5) == 1 && Test_Pin(26, 1 << 5) == 0);
+    TEST_CHECK(GPIO_WAVE_WS2812_SLOT_FREQ / GPIO_WAVE_WS2812_SLOTS_PER_BIT == 800000);
+
+    /*只操作数据引脚，其他引脚不受影响*/
+    for(i = 0; i < words; i++)
+    {
+        TEST_CHECK(((Buffer[i] | (Buffer[i] >> 16)) & (uint16_t)~(1 << 5)) == 0);
+    }
+    Test_Replay(Buffer, words, 0x8001);
+    TEST_CHECK((Levels[words - 1] & 0x8001) == 0x8001);
+}
+
+static void Test_Parallel(void)
+{
+    static uint8_t lane[4][16];
+    const uint8_t* data[4];
+    const uint16_t mask[4] = { 1 << 0, 1 << 3, 1 << 8, 1 << 15 };
+    uint8_t decoded[16];
+    uint32_t words;
+    int i, j;
+
+    for(i = 0; i < 4; i++)
+    {
+        for(j = 0; j < 16; j++)
+        {
+            lane[i][j] = (uint8_t)(i * 71 + j * 13 + (j << i));
+        }
+        data[i] = lane[i];
+    }
+
+    words = GPIO_Wave_EncodeWS2812Parallel(Buffer, TEST_BUFFER_SIZE, mask, data, 4, 16);
+    TEST_CHECK(words == GPIO_WAVE_WS2812_WORDS(16));
+
+    /*所有通道同时上升，各自在第2/3个时隙下降，每个通道独立解码*/
+    Test_Replay(Buffer, words, 0);
+    for(i = 0; i < 4; i++)
+    {
+        TEST_CHECK_MSG(Test_DecodeWS2812(mask[i], words, decoded), "lane %d", i);
+        TEST_CHECK_MSG(memcmp(decoded, lane[i], 16) == 0, "lane %d", i);
+    }
+    for(i = 0; i < (int)words; i += GPIO_WAVE_WS2812_SLOTS_PER_BIT)
+    {
+        TEST_CHECK(Buffer[i] == GPIO_WAVE_SET(0x8109));
+        TEST_CHECK(Buffer[i + 2] == GPIO_WAVE_RESET(0x8109));
+    }
+
+    TEST_CHECK(GPIO_Wave_EncodeWS2812Parallel(Buffer, TEST_BUFFER_SIZE, mask, data, 0, 16) == 0);
+}
+
+static void Test_StepDir(void)
+{
+    const uint16_t intervals[6] = { 40, 30, 20, 20, 30, 40 };
+    GPIO_Wave_StepDir_TypeDef config;
+    uint32_t words;
+    uint32_t expected = 0;
+    uint32_t edge;
+    uint32_t slot;
+    int rising = 0;
+    int i;
+
+    config.StepMask = 1 << 2;
+    config.DirMask = 1 << 3;
+    config.Dir = 1;
+    config.PulseSlots = 5;
+    config.DirSetupSlots = 10;
+
+    words = GPIO_Wave_EncodeStepDir(Buffer, TEST_BUFFER_SIZE, &config, intervals, 6);
+
+    /*总时隙数 = DIR字 + 建立时间 + 间隔之和，即要求的运动时间*/
+    for(i = 0; i < 6; i++)
+    {
+        expected += intervals[i];
+    }
+    TEST_CHECK(words == 1 + 10 + expected);
+
+    Test_Replay(Buffer, words, 0);
+    TEST_CHECK(Test_Pin(0, 1 << 3) == 1);
+
+    /*上升沿位于建立时间之后，相邻上升沿间隔等于Intervals，高电平宽度为PulseSlots*/
+    edge = 1 + 10;
+    for(slot = 0; slot < words; slot++)
+    {
+        int level = Test_Pin(slot, 1 << 2);
+        int last = slot ? Test_Pin(slot - 1, 1 << 2) : 0;
+
+        TEST_CHECK(Test_Pin(slot, 1 << 3) == 1);
+        if(level && !last)
+        {
+            TEST_CHECK_MSG(slot == edge, "step %d at %u, expected %u", rising, (unsigned)slot, (unsigned)edge);
+            TEST_CHECK(Test_Pin(slot + config.PulseSlots - 1, 1 << 2) == 1);
+            TEST_CHECK(Test_Pin(slot + config.PulseSlots, 1 << 2) == 0);
+            edge += intervals[rising];
+            rising++;
+        }
+    }
+    TEST_CHECK(rising == 6);
+    TEST_CHECK(edge == words);
+    TEST_CHECK(Test_Pin(words - 1, 1 << 2) == 0);
+
+    /*反方向，不输出DIR时没有建立时间*/
+    config.Dir = 0;
+    words = GPIO_Wave_EncodeStepDir(Buffer, TEST_BUFFER_SIZE, &config, intervals, 1);
+    TEST_CHECK(words == 1 + 10 + 40);
+    Test_Replay(Buffer, words, 0xFFFF);
+    TEST_CHECK(Test_Pin(0, 1 << 3) == 0);
+
+    config.DirMask = 0;
+    words = GPIO_Wave_EncodeStepDir(Buffer, TEST_BUFFER_SIZE, &config, intervals, 6);
+    TEST_CHECK(words == expected);
+    TEST_CHECK(Buffer[0] == GPIO_WAVE_SET(1 << 2));
+
+    /*间隔不大于脉宽、脉宽为0：参数错误*/
+    config.PulseSlots = 20;
+    TEST_CHECK(GPIO_Wave_EncodeStepDir(Buffer, TEST_BUFFER_SIZE, &config, intervals, 6) == 0);
+    config.PulseSlots = 0;
+    TEST_CHECK(GPIO_Wave_EncodeStepDir(Buffer, TEST_BUFFER_SIZE, &config, intervals, 6) == 0);
+}
+
+static void Test_BufferSize(void)
+{
+    const uint8_t data[4] = { 1, 2, 3, 4 };
+    const uint16_t intervals[3] = { 10, 10, 10 };
+    GPIO_Wave_StepDir_TypeDef config = { 1, 2, 1, 2, 3 };
+    uint32_t need;
+    int i;
+
+    for(i = 0; i < TEST_BUFFER_SIZE; i++)
+    {
+        Buffer[i] = TEST_SENTINEL;
+    }
+
+    /*缓冲刚好够用时成功，少一个字时返回0且不写入*/
+    need = GPIO_WAVE_WS2812_WORDS(4);
+    TEST_CHECK(GPIO_Wave_EncodeWS2812(Buffer, need - 1, 1, data, 4) == 0);
+    TEST_CHECK(Buffer[0] == TEST_SENTINEL);
+    TEST_CHECK(GPIO_Wave_EncodeWS2812(Buffer, need, 1, data, 4) == need);
+    TEST_CHECK(Buffer[need] == TEST_SENTINEL);
+
+    Buffer[0] = TEST_SENTINEL;
+    need = 1 + 3 + 30;
+    TEST_CHECK(GPIO_Wave_EncodeStepDir(Buffer, need - 1, &config, intervals, 3) == 0);
+    TEST_CHECK(Buffer[0] == TEST_SENTINEL);
+    TEST_CHECK(GPIO_Wave_EncodeStepDir(Buffer, need, &config, intervals, 3) == need);
+
+    TEST_CHECK(GPIO_Wave_EncodeWS2812(Buffer, 0, 1, data, 0) == 0);
+}
+
+int main(void)
+{
+    Test_WS2812();
+    Test_Parallel();
+    Test_StepDir();
+    Test_BufferSize();
+    return TEST_RESULT();
+}
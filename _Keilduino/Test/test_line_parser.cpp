@@ -0,0 +1,432 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "Arduino.h"
+#include "Stream.h"
+#include "LineParser.h"
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include <time.h>
+
+/*
+ * LineParser功能测试，以及与Stream::parseInt/parseFloat的对比：
+ * 整行数据已在接收缓冲中时的解析速度、结果是否与strtof一致，
+ * 以及数据中断时Stream等待超时而LineParser立即返回。
+ */
+
+/*内存数据流，Limit模拟已收到的字节数*/
+class MemStream : public Stream
+{
+public:
+    const char* Data;
+    size_t Length;
+    size_t Pos;
+    size_t Limit;
+
+    MemStream(const char* data, size_t length)
+        : Data(data), Length(length), Pos(0), Limit(length)
+    {
+    }
+    virtual int available()
+    {
+        return (int)(Limit - Pos);
+    }
+    virtual int read()
+    {
+        return (Pos < Limit) ? (uint8_t)Data[Pos++] : -1;
+    }
+    virtual int peek()
+    {
+        return (Pos < Limit) ? (uint8_t)Data[Pos] : -1;
+    }
+    virtual size_t write(uint8_t)
+    {
+        return 1;
+    }
+};
+
+static uint32_t Test_Rand(void)
+{
+    static uint32_t state = 0x6C078965;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static double Test_Seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static bool Float_Same(float a, float b)
+{
+    return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+/*任意分块送入，与按行切分的结果相同；'\r'和空行忽略，超长行整行丢弃*/
+static void Test_Feed(void)
+{
+    static const char text[] =
+        "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n"
+        "\r\n"
+        "G1 X10.5  Y-3 F1500\n"
+        "this line is far too long for the buffer and must be dropped entirely\n"
+        "ok\n";
+    static const char* const lines[] =
+    {
+        "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47",
+        "G1 X10.5  Y-3 F1500",
+        "ok"
+    };
+    char buffer[68];
+    int round;
+
+    for(round = 0; round < 200; round++)
+    {
+        LineParser parser(buffer, sizeof(buffer));
+        size_t pos = 0;
+        int line = 0;
+
+        while(pos < sizeof(text) - 1)
+        {
+            uint16_t chunk = 1 + Test_Rand() % 16;
+            uint16_t used;
+
+            if(chunk > sizeof(text) - 1 - pos)
+                chunk = sizeof(text) - 1 - pos;
+
+            parser.feed(text + pos, chunk, &used);
+            pos += used;
+
+            if(parser.available())
+            {
+                TEST_CHECK(line < 3 && strcmp(parser.getLine(), lines[line]) == 0);
+                TEST_CHECK(parser.getLength() == strlen(lines[line]));
+                line++;
+                parser.next();
+            }
+        }
+        TEST_CHECK(line == 3);
+        TEST_CHECK(parser.getOverflowCount() == 1);
+    }
+}
+
+/*从Stream读取：只取已收到的数据，不完整时立即返回并保留*/
+static void Test_FeedStream(void)
+{
+    static const char text[] = "12,,-7,3.25\nnext\n";
+    MemStream stream(text, sizeof(text) - 1);
+    char buffer[32];
+    LineParser parser(buffer, sizeof(buffer));
+    LineParser::Token_t token;
+    long i;
+    float f;
+
+    stream.Limit = 5;
+    TEST_CHECK(!parser.feed(stream));
+    TEST_CHECK(stream.Pos == 5);
+    stream.Limit = sizeof(text) - 1;
+    TEST_CHECK(parser.feed(stream));
+    TEST_CHECK(stream.Pos == 12);//一行后停止读取
+
+    /*NMEA风格：空字段保留*/
+    TEST_CHECK(parser.nextInt(&i) && i == 12);
+    TEST_CHECK(parser.nextToken(&token) && token.length == 0);
+    TEST_CHECK(parser.nextInt(&i) && i == -7);
+    TEST_CHECK(parser.nextFloat(&f) && f == 3.25f);
+    TEST_CHECK(!parser.nextToken(&token));
+    parser.rewind();
+    TEST_CHECK(parser.nextInt(&i) && i == 12);
+
+    parser.next();
+    TEST_CHECK(parser.feed(stream) && strcmp(parser.getLine(), "next") == 0);
+
+    /*G代码风格：合并连续分隔符*/
+    {
+        static const char gcode[] = "G1  X10.5   Y-3\n";
+        parser.next();
+        parser.setDelimiters(" ", true);
+        TEST_CHECK(parser.feed(gcode, sizeof(gcode) - 1));
+        TEST_CHECK(parser.nextToken(&token) && token.length == 2 && memcmp(token.str, "G1", 2) == 0);
+        TEST_CHECK(parser.nextToken(&token) && LineParser::parseFloat(token.str + 1, token.length - 1, &f) && f == 10.5f);
+        TEST_CHECK(parser.nextToken(&token) && LineParser::parseFloat(token.str + 1, token.length - 1, &f) && f == -3.0f);
+        TEST_CHECK(!parser.nextToken(&token));
+    }
+}
+
+static void Test_ParseInt(void)
+{
+    static const struct
+    {
+        const char* str;
+        bool ok;
+        long value;
+    } cases[] =
+    {
+        { "0", true, 0 },
+        { "-0", true, 0 },
+        { "+15", true, 15 },
+        { "2147483647", true, 2147483647L },
+        { "-2147483648", true, -2147483647L - 1 },
+        { "", false, 0 },
+        { "-", false, 0 },
+        { "12a", false, 0 },
+        { " 1", false, 0 },
+        { "1.5", false, 0 },
+    };
+    char text[32];
+    long value;
+    unsigned i;
+
+    for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        bool ok = LineParser::parseInt(cases[i].str, strlen(cases[i].str), &value);
+        TEST_CHECK_MSG(ok == cases[i].ok && (!ok || value == cases[i].value), "\"%s\"", cases[i].str);
+    }
+
+    /*溢出*/
+    snprintf(text, sizeof(text), "%ld0", LONG_MAX);
+    TEST_CHECK(!LineParser::parseInt(text, strlen(text), &value));
+    snprintf(text, sizeof(text), "%lu", (unsigned long)LONG_MAX + 1);
+    TEST_CHECK(!LineParser::parseInt(text, strlen(text), &value));
+    snprintf(text, sizeof(text), "%ld", LONG_MIN);
+    TEST_CHECK(LineParser::parseInt(text, strlen(text), &value) && value == LONG_MIN);
+
+    for(i = 0; i < 100000; i++)
+    {
+        long expect = (long)(int32_t)Test_Rand();
+        snprintf(text, sizeof(text), "%ld", expect);
+        TEST_CHECK(LineParser::parseInt(text, strlen(text), &value) && value == expect);
+    }
+}
+
+/*与strtof逐位比较：随机小数、科学计数、长尾数、边界值*/
+static void Test_ParseFloat(void)
+{
+    static const char* const cases[] =
+    {
+        "0", "-0", "0.0", "1", "0.1", "3.4028235e38", "1.17549435e-38", "1e-45", "1e39",
+        "16777217", "0.000000000000000000000000000000000000000000001",
+        "123456789012345678901234567890", "9007199254740993", "1.00000005960464477539062",
+        "1.000000059604644775390625", "1.000000059604644775390626", ".5", "5.", "-.25e+2",
+    };
+    static const char* const bad[] = { "", "-", ".", "e5", "1e", "1e+", "1.2.3", "0x10", "1 ", "inf", "nan" };
+    char text[48];
+    float value;
+    unsigned i;
+    uint32_t mismatch = 0;
+
+    for(i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        float expect = strtof(cases[i], NULL);
+        TEST_CHECK_MSG(LineParser::parseFloat(cases[i], strlen(cases[i]), &value) && Float_Same(value, expect),
+                       "\"%s\": %.9g expect %.9g", cases[i], value, expect);
+    }
+
+    for(i = 0; i < sizeof(bad) / sizeof(bad[0]); i++)
+    {
+        TEST_CHECK_MSG(!LineParser::parseFloat(bad[i], strlen(bad[i]), &value), "\"%s\"", bad[i]);
+    }
+
+    for(i = 0; i < 1000000; i++)
+    {
+        uint32_t r = Test_Rand();
+        int len;
+        float expect;
+
+        switch(i % 4)
+        {
+        case 0:
+            len = snprintf(text, sizeof(text), "%s%u.%0*u", (r & 1) ? "-" : "",
+                           Test_Rand() % 100000, (int)(1 + r % 6), Test_Rand() % 1000000);
+            break;
+        case 1:
+            len = snprintf(text, sizeof(text), "%ue%d", Test_Rand(), (int)(r % 80) - 40);
+            break;
+        case 2:
+            len = snprintf(text, sizeof(text), "%u%09u.%u", Test_Rand(), Test_Rand() % 1000000000, Test_Rand());
+            break;
+        default:
+        {
+            /*float的两个相邻值的中点附近*/
+            uint32_t bits = 0x3F800000 + (r & 0x7FFFFF);
+            float f;
+            memcpy(&f, &bits, sizeof(f));
+            len = snprintf(text, sizeof(text), "%.*g", 8 + (int)(r >> 28) % 10, f);
+            break;
+        }
+        }
+
+        expect = strtof(text, NULL);
+        if(!LineParser::parseFloat(text, (uint16_t)len, &value) || !Float_Same(value, expect))
+        {
+            if(mismatch++ < 5)
+                printf("parseFloat(\"%s\") = %.9g, strtof %.9g\n", text, value, expect);
+        }
+    }
+    TEST_CHECK_MSG(mismatch == 0, "%u mismatches", (unsigned)mismatch);
+}
+
+static void Test_Nmea(void)
+{
+    static const char good[] = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47";
+    static const char lower[] = "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*39";
+    char text[sizeof(good)];
+
+    TEST_CHECK(LineParser::nmeaCheck(good, sizeof(good) - 1));
+    TEST_CHECK(LineParser::nmeaCheck(lower, sizeof(lower) - 1));
+    TEST_CHECK(LineParser::nmeaChecksum(good + 1, sizeof(good) - 5) == 0x47);
+
+    memcpy(text, good, sizeof(good));
+    text[10] = '8';
+    TEST_CHECK(!LineParser::nmeaCheck(text, sizeof(good) - 1));
+    TEST_CHECK(!LineParser::nmeaCheck(good, sizeof(good) - 2));
+    TEST_CHECK(!LineParser::nmeaCheck("GPGGA*00", 8));
+}
+
+/*
+ * 对比：G代码行 "G1 Xx Yy Zz Fn"，整段数据已在接收缓冲中
+ *  Stream: parseInt/parseFloat逐字符timedRead/timedPeek
+ *  LineParser: feed按块读取一行，字段就地转换
+ */
+#define BENCH_LINES 20000
+
+static void Test_Benchmark(void)
+{
+    static char text[BENCH_LINES * 48];
+    static float expect[BENCH_LINES][3];
+    size_t length = 0;
+    uint32_t streamInexact = 0, parserInexact = 0;
+    long streamSum = 0, parserSum = 0;
+    double t0, tStream, tParser;
+    int n, k;
+
+    for(n = 0; n < BENCH_LINES; n++)
+    {
+        char x[16], y[16], z[16];
+        snprintf(x, sizeof(x), "%d.%03u", (int)(Test_Rand() % 400) - 200, Test_Rand() % 1000);
+        snprintf(y, sizeof(y), "%d.%04u", (int)(Test_Rand() % 400) - 200, Test_Rand() % 10000);
+        snprintf(z, sizeof(z), "%u.%02u", Test_Rand() % 50, Test_Rand() % 100);
+        expect[n][0] = strtof(x, NULL);
+        expect[n][1] = strtof(y, NULL);
+        expect[n][2] = strtof(z, NULL);
+        length += snprintf(text + length, sizeof(text) - length, "G1 X%s Y%s Z%s F%u\n", x, y, z, 100 + Test_Rand() % 5000);
+    }
+
+    {
+        MemStream stream(text, length);
+        stream.setTimeout(0);
+        t0 = Test_Seconds();
+        for(n = 0; n < BENCH_LINES; n++)
+        {
+            streamSum += stream.parseInt();
+            for(k = 0; k < 3; k++)
+            {
+                float v = stream.parseFloat();
+                streamInexact += !Float_Same(v, expect[n][k]);
+            }
+            streamSum += stream.parseInt();
+        }
+        tStream = Test_Seconds() - t0;
+    }
+
+    {
+        MemStream stream(text, length);
+        char buffer[64];
+        LineParser parser(buffer, sizeof(buffer));
+        LineParser::Token_t token;
+
+        parser.setDelimiters(" ", true);
+        t0 = Test_Seconds();
+        for(n = 0; n < BENCH_LINES; n++)
+        {
+            long value;
+
+            if(!parser.feed(stream))
+                break;
+            parser.nextToken(&token);
+            LineParser::parseInt(token.str + 1, token.length - 1, &value);
+            parserSum += value;
+            for(k = 0; k < 3; k++)
+            {
+                float v = 0;
+                parser.nextToken(&token);
+                LineParser::parseFloat(token.str + 1, token.length - 1, &v);
+                parserInexact += !Float_Same(v, expect[n][k]);
+            }
+            parser.nextToken(&token);
+            LineParser::parseInt(token.str + 1, token.length - 1, &value);
+            parserSum += value;
+            parser.next();
+        }
+        tParser = Test_Seconds() - t0;
+        TEST_CHECK(n == BENCH_LINES);
+    }
+
+    TEST_CHECK(parserSum == streamSum);
+    TEST_CHECK(parserInexact == 0);
+    printf("benchmark (%d lines): Stream %.0f ns/line, %u of %d floats differ from strtof\n",
+           BENCH_LINES, tStream * 1e9 / BENCH_LINES, (unsigned)streamInexact, BENCH_LINES * 3);
+    printf("benchmark (%d lines): LineParser %.0f ns/line, %u differ\n",
+           BENCH_LINES, tParser * 1e9 / BENCH_LINES, (unsigned)parserInexact);
+
+    /*半行数据后输入中断：Stream等待完整的超时，LineParser立即返回*/
+    {
+        static const char partial[] = "G1 X12.5";
+        MemStream stream(partial, sizeof(partial) - 1);
+        char buffer[64];
+        LineParser parser(buffer, sizeof(buffer));
+        double tWait, tFeed;
+
+        stream.setTimeout(50);
+        t0 = Test_Seconds();
+        stream.parseInt();
+        stream.parseFloat();
+        tWait = Test_Seconds() - t0;
+
+        stream.Pos = 0;
+        t0 = Test_Seconds();
+        TEST_CHECK(!parser.feed(stream));
+        tFeed = Test_Seconds() - t0;
+
+        TEST_CHECK(tWait >= 0.045);
+        TEST_CHECK(tFeed < 0.005);
+        printf("stalled input: Stream blocked %.1f ms, LineParser returned after %.1f us\n",
+               tWait * 1e3, tFeed * 1e6);
+    }
+}
+
+int main(void)
+{
+    Test_Feed();
+    Test_FeedStream();
+    Test_ParseInt();
+    Test_ParseFloat();
+    Test_Nmea();
+    Test_Benchmark();
+    return TEST_RESULT();
+}
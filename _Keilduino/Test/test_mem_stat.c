@@ -0,0 +1,210 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "mem_stat.h"
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * 分配块：头/金丝雀布局和对齐、越界写和头被改写的检测、重复释放、统计计数；
+ * 随机分配/释放与参考模型比较当前/峰值用量；
+ * 填充/扫描：模拟栈和堆的高水位；碎片率。
+ */
+#define TEST_SLOT_NUM   64
+
+static uint32_t Random_State = 7;
+
+static uint32_t Random_Next(void)
+{
+    Random_State = Random_State * 1103515245 + 12345;
+    return Random_State >> 16;
+}
+
+/*与 mem_diag.c 相同：向底层申请 MemStat_BlockSize 字节后建立块*/
+static void* Test_Malloc(MemStat_Heap_TypeDef* heap, uint32_t size)
+{
+    void* raw = malloc(MemStat_BlockSize(size));
+    if(!raw)
+    {
+        MemStat_OnFail(heap);
+        return NULL;
+    }
+    return MemStat_BlockInit(heap, raw, size);
+}
+
+static void Test_Free(MemStat_Heap_TypeDef* heap, void* ptr)
+{
+    free(MemStat_BlockRelease(heap, ptr));
+}
+
+static void Test_Block(void)
+{
+    MemStat_Heap_TypeDef heap;
+    uint8_t* a;
+    uint8_t* b;
+    uint8_t raw[64];
+    uint8_t* c;
+
+    MemStat_HeapInit(&heap);
+    TEST_CHECK(MemStat_BlockSize(10) == 10 + MEM_STAT_OVERHEAD);
+    TEST_CHECK(MemStat_BlockSize(0xFFFFFFFFUL) == 0);
+    TEST_CHECK(MemStat_BlockSize(0xFFFFFFFFUL - MEM_STAT_OVERHEAD) == 0xFFFFFFFFUL);
+
+    a = (uint8_t*)Test_Malloc(&heap, 10);
+    b = (uint8_t*)Test_Malloc(&heap, 0);
+    TEST_CHECK(((uintptr_t)a & 7) == 0);
+    TEST_CHECK(MemStat_BlockGetSize(a) == 10 && MemStat_BlockGetSize(b) == 0);
+    TEST_CHECK(MemStat_BlockCheck(a) && MemStat_BlockCheck(b));
+    TEST_CHECK(heap.AllocCount == 2 && heap.LiveBlocks == 2 && heap.LiveBytes == 10);
+    TEST_CHECK(heap.LargestAlloc == 10);
+
+    /*写满用户区不影响检查，多写一个字节被发现*/
+    memset(a, 0xFF, 10);
+    TEST_CHECK(MemStat_BlockCheck(a));
+    a[10] ^= 1;
+    TEST_CHECK(!MemStat_BlockCheck(a));
+    Test_Free(&heap, a);
+    TEST_CHECK(heap.CorruptCount == 1);
+    TEST_CHECK(heap.FreeCount == 1 && heap.LiveBlocks == 1 && heap.LiveBytes == 0);
+    Test_Free(&heap, b);
+    TEST_CHECK(heap.CorruptCount == 1);
+    TEST_CHECK(heap.PeakBlocks == 2 && heap.PeakBytes == 10);
+
+    /*重复释放和头被改写：不交还底层，不改动用量*/
+    c = (uint8_t*)MemStat_BlockInit(&heap, raw, 16);
+    TEST_CHECK(MemStat_BlockRelease(&heap, c) == raw);
+    TEST_CHECK(MemStat_BlockRelease(&heap, c) == NULL);
+    TEST_CHECK(heap.CorruptCount == 2);
+    c = (uint8_t*)MemStat_BlockInit(&heap, raw, 16);
+    raw[0] ^= 0x80;
+    TEST_CHECK(!MemStat_BlockCheck(c));
+    TEST_CHECK(MemStat_BlockRelease(&heap, c) == NULL);
+    TEST_CHECK(heap.CorruptCount == 3);
+    TEST_CHECK(heap.LiveBlocks == 1 && heap.LiveBytes == 16);
+
+    MemStat_OnFail(&heap);
+    TEST_CHECK(heap.FailCount == 1);
+}
+
+static void Test_Random(void)
+{
+    MemStat_Heap_TypeDef heap;
+    uint8_t* slots[TEST_SLOT_NUM] = { 0 };
+    uint32_t sizes[TEST_SLOT_NUM] = { 0 };
+    uint32_t liveBytes = 0, liveBlocks = 0, peakBytes = 0, largest = 0;
+    uint32_t allocs = 0, frees = 0;
+    int i;
+
+    MemStat_HeapInit(&heap);
+
+    for(i = 0; i < 200000; i++)
+    {
+        uint32_t slot = Random_Next() % TEST_SLOT_NUM;
+
+        if(slots[slot])
+        {
+            TEST_CHECK(MemStat_BlockCheck(slots[slot]));
+            TEST_CHECK(MemStat_BlockGetSize(slots[slot]) == sizes[slot]);
+            Test_Free(&heap, slots[slot]);
+            slots[slot] = NULL;
+            liveBytes -= sizes[slot];
+            liveBlocks--;
+            frees++;
+        }
+        else
+        {
+            uint32_t size = Random_Next() % 300;
+            slots[slot] = (uint8_t*)Test_Malloc(&heap, size);
+            memset(slots[slot], (int)slot, size);
+            sizes[slot] = size;
+            liveBytes += size;
+            liveBlocks++;
+            allocs++;
+            peakBytes = (liveBytes > peakBytes) ? liveBytes : peakBytes;
+            largest = (size > largest) ? size : largest;
+        }
+
+        TEST_CHECK(heap.LiveBytes == liveBytes && heap.LiveBlocks == liveBlocks);
+    }
+
+    for(i = 0; i < TEST_SLOT_NUM; i++)
+    {
+        if(slots[i])
+        {
+            Test_Free(&heap, slots[i]);
+            frees++;
+        }
+    }
+
+    TEST_CHECK(heap.AllocCount == allocs && heap.FreeCount == frees);
+    TEST_CHECK(heap.LiveBlocks == 0 && heap.LiveBytes == 0);
+    TEST_CHECK(heap.PeakBytes == peakBytes && heap.LargestAlloc == largest);
+    TEST_CHECK(heap.CorruptCount == 0 && heap.FailCount == 0);
+}
+
+static void Test_Paint(void)
+{
+    uint32_t stack[64];
+    uint32_t heap[64];
+
+    /*栈从高地址向下生长，已用24字*/
+    MemStat_Paint(stack, stack + 64);
+    memset(stack + 40, 0, 24 * sizeof(uint32_t));
+    TEST_CHECK(MemStat_UnusedFromBottom(stack, stack + 64) == 40 * 4);
+    TEST_CHECK(MemStat_UnusedFromTop(stack, stack + 64) == 0);
+
+    /*堆从低地址向上分配，已用10字*/
+    MemStat_Paint(heap, heap + 64);
+    memset(heap, 0, 10 * sizeof(uint32_t));
+    TEST_CHECK(MemStat_UnusedFromTop(heap, heap + 64) == 54 * 4);
+    TEST_CHECK(MemStat_UnusedFromBottom(heap, heap + 64) == 0);
+
+    /*全部未用、全部已用、空范围*/
+    MemStat_Paint(heap, heap + 64);
+    TEST_CHECK(MemStat_UnusedFromBottom(heap, heap + 64) == 64 * 4);
+    TEST_CHECK(MemStat_UnusedFromTop(heap, heap + 64) == 64 * 4);
+    memset(heap, 0, sizeof(heap));
+    TEST_CHECK(MemStat_UnusedFromBottom(heap, heap + 64) == 0);
+    TEST_CHECK(MemStat_UnusedFromTop(heap, heap + 64) == 0);
+    TEST_CHECK(MemStat_UnusedFromBottom(heap, heap) == 0);
+    MemStat_Paint(heap + 8, heap + 4);
+    TEST_CHECK(heap[4] == 0);
+}
+
+static void Test_Fragmentation(void)
+{
+    TEST_CHECK(MemStat_Fragmentation(0, 0) == 0);
+    TEST_CHECK(MemStat_Fragmentation(1000, 1000) == 0);
+    TEST_CHECK(MemStat_Fragmentation(500, 1000) == 50);
+    TEST_CHECK(MemStat_Fragmentation(1, 1000) == 100);
+    TEST_CHECK(MemStat_Fragmentation(0xF0000000UL, 0xFFFFFFFFUL) == 7);
+}
+
+int main(void)
+{
+    Test_Block();
+    Test_Random();
+    Test_Paint();
+    Test_Fragmentation();
+    return TEST_RESULT();
+}
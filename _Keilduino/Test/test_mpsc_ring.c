@@ -0,0 +1,362 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#define _POSIX_C_SOURCE 200809L
+#include "test.h"
+#include "mpsc_ring.h"
+#include "work_queue.h"
+#include "exti_queue.h"
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/time.h>
+
+/*
+ * 单线程检查满/空、回绕、丢弃和最大深度；
+ * 多线程压力测试：多个生产者线程并发写入，一个消费者读取，
+ * 每个生产者的数据必须按顺序、不重复、不撕裂地到达，丢弃数与失败的写入数一致。
+ * (x86的存储顺序与单核上编译器屏障的保证相同；满/空时让出CPU，单核机器上也能推进)
+ * 嵌套测试用定时信号模拟高优先级中断：在主循环写入的任意位置抢占，
+ * 自己写入并读出全部数据，检查被打断的写入不会被提前读到。
+ */
+#define TEST_RING_SIZE      64
+#define TEST_PRODUCER_NUM   4
+#define TEST_ITEM_NUM       200000
+
+typedef struct
+{
+    uint32_t Producer;
+    uint32_t Seq;
+    uint32_t Check;
+} Test_Item_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t Seq;
+    Test_Item_TypeDef Item;
+} Test_Cell_TypeDef;
+
+static Test_Cell_TypeDef Cells[TEST_RING_SIZE];
+static MPSC_Ring_TypeDef Ring;
+
+static uint32_t Test_Check(uint32_t Producer, uint32_t Seq)
+{
+    return (Producer * 0x9E3779B9U) ^ (Seq * 0x85EBCA6BU) ^ 0x5A5A5A5AU;
+}
+
+static void Test_Single(void)
+{
+    Test_Item_TypeDef item, out;
+    Test_Cell_TypeDef small[3];
+    uint32_t i, round;
+
+    TEST_CHECK(!MPSC_RING_INIT(&Ring, small, 3));
+    TEST_CHECK(!MPSC_RING_INIT(&Ring, small, 1));
+    TEST_CHECK(MPSC_RING_INIT(&Ring, Cells, TEST_RING_SIZE));
+    TEST_CHECK(!MPSC_RingPop(&Ring, &out));
+
+    for(round = 0; round < 1000; round++)
+    {
+        uint32_t n = 1 + round % TEST_RING_SIZE;
+
+        for(i = 0; i < n; i++)
+        {
+            item.Producer = round;
+            item.Seq = i;
+            item.Check = Test_Check(round, i);
+            TEST_CHECK(MPSC_RingPush(&Ring, &item));
+        }
+        TEST_CHECK(MPSC_RingGetCount(&Ring) == n);
+
+        for(i = 0; i < n; i++)
+        {
+            TEST_CHECK(MPSC_RingPop(&Ring, &out));
+            TEST_CHECK(out.Producer == round && out.Seq == i && out.Check == Test_Check(round, i));
+        }
+        TEST_CHECK(!MPSC_RingPop(&Ring, &out));
+    }
+
+    /*满时丢弃*/
+    for(i = 0; i < TEST_RING_SIZE + 5; i++)
+    {
+        item.Seq = i;
+        TEST_CHECK(MPSC_RingPush(&Ring, &item) == (i < TEST_RING_SIZE));
+    }
+    TEST_CHECK(MPSC_RingGetDropped(&Ring, true) == 5);
+    TEST_CHECK(MPSC_RingGetDropped(&Ring, false) == 0);
+    TEST_CHECK(MPSC_RingGetHighWater(&Ring, true) == TEST_RING_SIZE);
+    TEST_CHECK(MPSC_RingGetHighWater(&Ring, false) == 0);
+    TEST_CHECK(MPSC_RingPop(&Ring, &out) && out.Seq == 0);
+}
+
+/*两个队列只是MPSC_Ring的类型封装*/
+static int Work_Called;
+
+static void Work_Function(void* Argument)
+{
+    Work_Called += *(int*)Argument;
+}
+
+static void Test_Wrappers(void)
+{
+    static Work_QueueCell_TypeDef workCells[4];
+    static EXTI_QueueCell_TypeDef extiCells[4];
+    Work_Queue_TypeDef work;
+    EXTI_Queue_TypeDef exti;
+    Work_Item_TypeDef workItem;
+    EXTI_Event_TypeDef event, out;
+    int arg = 3;
+
+    TEST_CHECK(!Work_QueueInit(&work, NULL, 4));
+    TEST_CHECK(Work_QueueInit(&work, workCells, 4));
+    TEST_CHECK(Work_QueuePost(&work, Work_Function, &arg));
+    TEST_CHECK(Work_QueueGetCount(&work) == 1 && Work_QueueGetHighWater(&work, false) == 1);
+    TEST_CHECK(Work_QueuePop(&work, &workItem));
+    workItem.Function(workItem.Argument);
+    TEST_CHECK(Work_Called == 3);
+
+    TEST_CHECK(EXTI_QueueInit(&exti, extiCells, 4));
+    event.Timestamp = 0x12345678;
+    event.Line = 7;
+    event.Level = 1;
+    TEST_CHECK(EXTI_QueuePush(&exti, &event));
+    TEST_CHECK(EXTI_QueuePop(&exti, &out));
+    TEST_CHECK(out.Timestamp == 0x12345678 && out.Line == 7 && out.Level == 1);
+    TEST_CHECK(EXTI_QueueGetDropped(&exti, false) == 0);
+}
+
+typedef struct
+{
+    pthread_t Thread;
+    uint32_t Id;
+    bool Retry;             // 失败后重试同一个数据
+    uint32_t Pushed;
+    uint32_t Failed;
+} Producer_TypeDef;
+
+static Producer_TypeDef Producers[TEST_PRODUCER_NUM];
+static volatile bool Start;
+
+static void* Producer_Thread(void* Arg)
+{
+    Producer_TypeDef* p = (Producer_TypeDef*)Arg;
+    Test_Item_TypeDef item;
+    uint32_t seq = 0;
+
+    while(!Start)
+    {
+        sched_yield();
+    }
+
+    item.Producer = p->Id;
+    while(seq < TEST_ITEM_NUM)
+    {
+        item.Seq = seq;
+        item.Check = Test_Check(p->Id, seq);
+        if(MPSC_RingPush(&Ring, &item))
+        {
+            p->Pushed++;
+            seq++;
+        }
+        else
+        {
+            p->Failed++;
+            if(!p->Retry)
+            {
+                seq++;
+            }
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void Test_Threads(bool Retry)
+{
+    uint32_t next[TEST_PRODUCER_NUM] = { 0 };
+    uint32_t received = 0, pushed = 0, failed = 0;
+    uint32_t i;
+    bool running = true;
+
+    TEST_CHECK(MPSC_RING_INIT(&Ring, Cells, TEST_RING_SIZE));
+    Start = false;
+
+    for(i = 0; i < TEST_PRODUCER_NUM; i++)
+    {
+        memset(&Producers[i], 0, sizeof(Producers[i]));
+        Producers[i].Id = i;
+        Producers[i].Retry = Retry;
+        pthread_create(&Producers[i].Thread, NULL, Producer_Thread, &Producers[i]);
+    }
+    Start = true;
+
+    while(running)
+    {
+        Test_Item_TypeDef item;
+
+        if(!MPSC_RingPop(&Ring, &item))
+        {
+            /*生产者全部结束且队列已空*/
+            uint32_t done = 0;
+            for(i = 0; i < TEST_PRODUCER_NUM; i++)
+            {
+                done += (Producers[i].Pushed + (Retry ? 0 : Producers[i].Failed) == TEST_ITEM_NUM);
+            }
+            running = !(done == TEST_PRODUCER_NUM && MPSC_RingGetCount(&Ring) == 0);
+            sched_yield();
+            continue;
+        }
+
+        received++;
+        if(item.Producer >= TEST_PRODUCER_NUM || item.Check != Test_Check(item.Producer, item.Seq))
+        {
+            TEST_CHECK_MSG(0, "torn item %u/%u", (unsigned)item.Producer, (unsigned)item.Seq);
+            break;
+        }
+
+        /*同一生产者按顺序到达；重试时不能有空缺*/
+        TEST_CHECK_MSG(Retry ? item.Seq == next[item.Producer] : item.Seq >= next[item.Producer],
+                       "producer %u: got %u expect %u", (unsigned)item.Producer,
+                       (unsigned)item.Seq, (unsigned)next[item.Producer]);
+        next[item.Producer] = item.Seq + 1;
+        if(Test_FailCount > 10)
+        {
+            break;
+        }
+    }
+
+    for(i = 0; i < TEST_PRODUCER_NUM; i++)
+    {
+        pthread_join(Producers[i].Thread, NULL);
+        pushed += Producers[i].Pushed;
+        failed += Producers[i].Failed;
+    }
+
+    TEST_CHECK_MSG(received == pushed, "received %u pushed %u", (unsigned)received, (unsigned)pushed);
+    TEST_CHECK(MPSC_RingGetDropped(&Ring, false) == failed);
+    TEST_CHECK(MPSC_RingGetHighWater(&Ring, false) <= TEST_RING_SIZE);
+    printf("threads(%s): %u items, %u full, high water %u\n", Retry ? "retry" : "drop",
+           (unsigned)received, (unsigned)failed, (unsigned)MPSC_RingGetHighWater(&Ring, false));
+}
+
+/*信号处理函数：生产者1，同时是唯一的读取者*/
+static volatile uint32_t Nested_Next[2];
+static volatile uint32_t Nested_Seq;
+static volatile uint32_t Nested_Received;
+static volatile uint32_t Nested_Failed;
+static volatile uint32_t Nested_Errors;
+static volatile uint32_t Nested_Signals;
+
+static void Nested_Pop(void)
+{
+    Test_Item_TypeDef item;
+
+    while(MPSC_RingPop(&Ring, &item))
+    {
+        Nested_Received++;
+        if(item.Producer > 1 || item.Check != Test_Check(item.Producer, item.Seq)
+                || item.Seq < Nested_Next[item.Producer])
+        {
+            Nested_Errors++;
+            continue;
+        }
+        Nested_Next[item.Producer] = item.Seq + 1;
+    }
+}
+
+static void Nested_SignalHandler(int sig)
+{
+    Test_Item_TypeDef item;
+
+    (void)sig;
+    Nested_Signals++;
+
+    item.Producer = 1;
+    item.Seq = Nested_Seq++;
+    item.Check = Test_Check(1, item.Seq);
+    if(!MPSC_RingPush(&Ring, &item))
+    {
+        Nested_Failed++;
+    }
+
+    Nested_Pop();
+}
+
+static void Test_Nested(void)
+{
+    struct sigaction sa;
+    struct itimerval timer;
+    Test_Item_TypeDef item;
+    uint32_t seq = 0, failed = 0;
+
+    TEST_CHECK(MPSC_RING_INIT(&Ring, Cells, TEST_RING_SIZE));
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = Nested_SignalHandler;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGALRM, &sa, NULL);
+
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = 20;
+    timer.it_value = timer.it_interval;
+    setitimer(ITIMER_REAL, &timer, NULL);
+
+    item.Producer = 0;
+    while(Nested_Signals < 30000)
+    {
+        /*保持队列不满，让信号多在写入过程中到来*/
+        if(MPSC_RingGetCount(&Ring) >= TEST_RING_SIZE / 2)
+        {
+            continue;
+        }
+        item.Seq = seq;
+        item.Check = Test_Check(0, seq);
+        if(!MPSC_RingPush(&Ring, &item))
+        {
+            failed++;
+        }
+        seq++;
+    }
+
+    timer.it_value.tv_usec = 0;
+    timer.it_interval.tv_usec = 0;
+    setitimer(ITIMER_REAL, &timer, NULL);
+    Nested_Pop();
+
+    TEST_CHECK_MSG(Nested_Errors == 0, "%u bad items", (unsigned)Nested_Errors);
+    TEST_CHECK(Nested_Received + failed + Nested_Failed == seq + Nested_Seq);
+    TEST_CHECK(MPSC_RingGetDropped(&Ring, false) == failed + Nested_Failed);
+    printf("nested: %u items, %u interrupts, %u full\n",
+           (unsigned)Nested_Received, (unsigned)Nested_Signals, (unsigned)(failed + Nested_Failed));
+}
+
+int main(void)
+{
+    Test_Single();
+    Test_Wrappers();
+    Test_Threads(true);
+    Test_Threads(false);
+    Test_Nested();
+    return TEST_RESULT();
+}
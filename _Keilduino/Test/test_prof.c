@@ -0,0 +1,198 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "prof_probe.h"
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * 模拟计数器：每次读取后前进 Test_ReadCost 个周期，代表探针自身的开销；
+ * 按 prof.c 的方式校准开销，再按 PROF_BEGIN/PROF_END 的顺序测量已知长度的代码段，
+ * 扣除开销后必须得到准确的周期数，包括计数器回绕。
+ * 另检查探针列表、清除、直方图分桶、平均值和百分位数。
+ */
+#define TEST_CALIBRATE_TIMES    8
+
+static uint32_t Test_Counter;
+static uint32_t Test_ReadCost;
+static ProfProbe_List_TypeDef List;
+
+static uint32_t Test_Read(void)
+{
+    uint32_t now = Test_Counter;
+    Test_Counter += Test_ReadCost;
+    return now;
+}
+
+/*与 Prof_Init 相同：空探针的最小周期数即开销*/
+static void Test_Calibrate(void)
+{
+    uint32_t overhead = UINT32_MAX;
+    int i;
+
+    List.Overhead = 0;
+    for(i = 0; i < TEST_CALIBRATE_TIMES; i++)
+    {
+        uint32_t start = Test_Read();
+        uint32_t cycles = ProfProbe_Elapsed(&List, start, Test_Read());
+
+        if(cycles < overhead)
+        {
+            overhead = cycles;
+        }
+    }
+    List.Overhead = overhead;
+}
+
+/*PROF_BEGIN; 执行Work个周期; PROF_END*/
+static void Test_Section(Prof_Probe_TypeDef* probe, uint32_t work)
+{
+    uint32_t start = Test_Read();
+    Test_Counter += work;
+    ProfProbe_Record(&List, probe, ProfProbe_Elapsed(&List, start, Test_Read()));
+}
+
+static void Test_Overhead(void)
+{
+    Prof_Probe_TypeDef probe = PROF_PROBE_INIT(probe);
+    const uint32_t works[] = { 0, 1, 7, 100, 1000, 123456 };
+    unsigned i;
+
+    ProfProbe_ListInit(&List);
+    Test_Counter = 1000;
+    Test_ReadCost = 13;
+    Test_Calibrate();
+    TEST_CHECK(List.Overhead == 13);
+
+    for(i = 0; i < sizeof(works) / sizeof(works[0]); i++)
+    {
+        uint64_t sum = probe.Stat.Sum;
+        Test_Section(&probe, works[i]);
+        TEST_CHECK_MSG(probe.Stat.Sum - sum == works[i], "work=%u recorded=%u", (unsigned)works[i], (unsigned)(probe.Stat.Sum - sum));
+    }
+    TEST_CHECK(probe.Stat.Count == 6);
+    TEST_CHECK(probe.Stat.Min == 0 && probe.Stat.Max == 123456);
+    TEST_CHECK(probe.Stat.Sum == 0 + 1 + 7 + 100 + 1000 + 123456);
+
+    /*计数器回绕*/
+    ProfStat_Reset(&probe.Stat);
+    Test_Counter = 0xFFFFFFF0UL;
+    Test_Section(&probe, 100);
+    TEST_CHECK(probe.Stat.Count == 1 && probe.Stat.Min == 100);
+
+    /*小于开销(如被更快的路径读取)时为0，不下溢*/
+    TEST_CHECK(ProfProbe_Elapsed(&List, 5, 10) == 0);
+    TEST_CHECK(ProfProbe_Elapsed(&List, 0xFFFFFFFFUL, 20) == 8);
+}
+
+static void Test_List(void)
+{
+    Prof_Probe_TypeDef a = PROF_PROBE_INIT(a);
+    Prof_Probe_TypeDef b = PROF_PROBE_INIT(b);
+    Prof_Probe_TypeDef c = PROF_PROBE_INIT(c);
+    Prof_Probe_TypeDef* probe;
+
+    ProfProbe_ListInit(&List);
+    TEST_CHECK(ProfProbe_GetNext(&List, NULL) == NULL);
+    TEST_CHECK(strcmp(a.Name, "a") == 0);
+
+    /*按首次记录的顺序加入列表，重复记录不重复加入*/
+    ProfProbe_Record(&List, &b, 10);
+    ProfProbe_Record(&List, &a, 20);
+    ProfProbe_Record(&List, &b, 30);
+    ProfProbe_Record(&List, &c, 40);
+    ProfProbe_Record(&List, &a, 50);
+
+    probe = ProfProbe_GetNext(&List, NULL);
+    TEST_CHECK(probe == &b);
+    probe = ProfProbe_GetNext(&List, probe);
+    TEST_CHECK(probe == &a);
+    probe = ProfProbe_GetNext(&List, probe);
+    TEST_CHECK(probe == &c);
+    TEST_CHECK(ProfProbe_GetNext(&List, probe) == NULL);
+
+    TEST_CHECK(a.Stat.Count == 2 && b.Stat.Count == 2 && c.Stat.Count == 1);
+    TEST_CHECK(ProfStat_GetMean(&a.Stat) == 35 && ProfStat_GetMean(&b.Stat) == 20);
+
+    /*清除一个或全部，列表保持不变*/
+    ProfProbe_Reset(&List, &a);
+    TEST_CHECK(a.Stat.Count == 0 && b.Stat.Count == 2);
+    ProfProbe_Reset(&List, NULL);
+    TEST_CHECK(b.Stat.Count == 0 && c.Stat.Count == 0 && c.Stat.Max == 0);
+    ProfProbe_Record(&List, &a, 1);
+    TEST_CHECK(ProfProbe_GetNext(&List, &c) == NULL);
+    TEST_CHECK(ProfProbe_GetNext(&List, NULL) == &b);
+}
+
+static void Test_Stat(void)
+{
+    ProfStat_TypeDef stat;
+    uint32_t i;
+
+    TEST_CHECK(ProfStat_Bucket(0) == 0);
+    TEST_CHECK(ProfStat_Bucket(1) == 1);
+    TEST_CHECK(ProfStat_Bucket(2) == 2 && ProfStat_Bucket(3) == 2);
+    TEST_CHECK(ProfStat_Bucket(4) == 3);
+    TEST_CHECK(ProfStat_Bucket(0x3FFFFFFFUL) == 30);
+    TEST_CHECK(ProfStat_Bucket(0x40000000UL) == PROF_STAT_BUCKETS - 1);
+    TEST_CHECK(ProfStat_Bucket(0xFFFFFFFFUL) == PROF_STAT_BUCKETS - 1);
+    TEST_CHECK(ProfStat_BucketLow(0) == 0 && ProfStat_BucketLow(1) == 1 && ProfStat_BucketLow(5) == 16);
+
+    for(i = 0; i < 32; i++)
+    {
+        TEST_CHECK(ProfStat_BucketLow(ProfStat_Bucket(1UL << i)) <= (1UL << i));
+    }
+
+    ProfStat_Reset(&stat);
+    TEST_CHECK(ProfStat_GetMean(&stat) == 0 && ProfStat_GetPercentile(&stat, 99) == 0);
+
+    /*99个样本100周期，1个样本5000周期*/
+    for(i = 0; i < 99; i++)
+    {
+        ProfStat_Add(&stat, 100);
+    }
+    ProfStat_Add(&stat, 5000);
+    TEST_CHECK(stat.Count == 100 && stat.Min == 100 && stat.Max == 5000);
+    TEST_CHECK(ProfStat_GetMean(&stat) == 149);
+    TEST_CHECK(stat.Hist[ProfStat_Bucket(100)] == 99 && stat.Hist[ProfStat_Bucket(5000)] == 1);
+    TEST_CHECK(ProfStat_GetPercentile(&stat, 50) == 127);
+    TEST_CHECK(ProfStat_GetPercentile(&stat, 99) == 127);
+    TEST_CHECK(ProfStat_GetPercentile(&stat, 100) == 5000);
+    TEST_CHECK(ProfStat_GetPercentile(&stat, 200) == 5000);
+
+    /*平均值四舍五入，总和不溢出*/
+    ProfStat_Reset(&stat);
+    ProfStat_Add(&stat, 0xFFFFFFFFUL);
+    ProfStat_Add(&stat, 0xFFFFFFFFUL);
+    ProfStat_Add(&stat, 0);
+    TEST_CHECK(ProfStat_GetMean(&stat) == 0xAAAAAAAAUL);
+    TEST_CHECK(stat.Min == 0);
+}
+
+int main(void)
+{
+    Test_Overhead();
+    Test_List();
+    Test_Stat();
+    return TEST_RESULT();
+}
@@ -0,0 +1,173 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "timer_factor.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * 死区编码：按数据手册的四段公式解码DTC，结果不能短于设定值，且是所有可表示值中最短的；
+ * 各段的边界(127/128, 254/256, 504/512)编码到正确的段，1008可表示、1009必须失败；
+ * 纳秒换算为时钟周期时向上取整。
+ */
+
+/* 1GHz时钟下1纳秒即1个周期，便于直接按周期数检查 */
+#define TEST_CLOCK_1NS      1000000000U
+#define TEST_DEADTIME_MAX   1008
+
+/* DTC[7:5]: 0xx: DTC[7:0]; 10x: (64+DTC[5:0])*2; 110: (32+DTC[4:0])*8; 111: (32+DTC[4:0])*16 */
+static uint32_t Test_Decode(uint8_t dtc)
+{
+    if((dtc & 0x80) == 0)
+    {
+        return dtc;
+    }
+    if((dtc & 0xC0) == 0x80)
+    {
+        return (64 + (dtc & 0x3F)) * 2;
+    }
+    if((dtc & 0xE0) == 0xC0)
+    {
+        return (32 + (dtc & 0x1F)) * 8;
+    }
+    return (32 + (dtc & 0x1F)) * 16;
+}
+
+/* 所有DTC值中不短于ticks的最短死区 */
+static uint32_t Test_BestTicks(uint32_t ticks)
+{
+    uint32_t best = UINT32_MAX;
+    uint32_t dtc;
+
+    for(dtc = 0; dtc <= 0xFF; dtc++)
+    {
+        uint32_t dt = Test_Decode((uint8_t)dtc);
+        if(dt >= ticks && dt < best)
+        {
+            best = dt;
+        }
+    }
+    return best;
+}
+
+static void Test_Boundary(uint32_t ticks, uint8_t expected)
+{
+    uint8_t dtc = 0;
+    bool ok = PWM_DeadTimeEncode(TEST_CLOCK_1NS, ticks, &dtc);
+
+    TEST_CHECK_MSG(ok && dtc == expected, "ticks=%u ok=%d dtc=0x%02X expected=0x%02X",
+        ticks, ok, dtc, expected);
+}
+
+static void Test_Boundaries(void)
+{
+    uint8_t dtc = 0x5A;
+
+    Test_Boundary(0, 0x00);
+    Test_Boundary(127, 0x7F);
+    Test_Boundary(128, 0x80);   /* (64+0)*2 */
+    Test_Boundary(129, 0x81);   /* 130 */
+    Test_Boundary(254, 0xBF);   /* (64+63)*2 */
+    Test_Boundary(255, 0xC0);   /* 256 */
+    Test_Boundary(256, 0xC0);   /* (32+0)*8 */
+    Test_Boundary(504, 0xDF);   /* (32+31)*8 */
+    Test_Boundary(505, 0xE0);   /* 512 */
+    Test_Boundary(512, 0xE0);   /* (32+0)*16 */
+    Test_Boundary(1008, 0xFF);  /* (32+31)*16 */
+
+    /* 超出范围不能截短为0xFF，且不改动输出 */
+    TEST_CHECK(!PWM_DeadTimeEncode(TEST_CLOCK_1NS, TEST_DEADTIME_MAX + 1, &dtc));
+    TEST_CHECK(dtc == 0x5A);
+    TEST_CHECK(!PWM_DeadTimeEncode(TEST_CLOCK_1NS, UINT32_MAX, &dtc));
+    TEST_CHECK(!PWM_DeadTimeEncode(UINT32_MAX, UINT32_MAX, &dtc));
+}
+
+/* 0~1008个周期逐个检查：解码不短于设定值，且为最短的可表示值 */
+static void Test_Exhaustive(void)
+{
+    uint32_t ticks;
+    int errors = 0;
+
+    for(ticks = 0; ticks <= TEST_DEADTIME_MAX; ticks++)
+    {
+        uint8_t dtc;
+        bool ok = PWM_DeadTimeEncode(TEST_CLOCK_1NS, ticks, &dtc);
+        uint32_t dt = ok ? Test_Decode(dtc) : 0;
+
+        if((!ok || dt != Test_BestTicks(ticks)) && errors++ < 10)
+        {
+            TEST_CHECK_MSG(false, "ticks=%u ok=%d decoded=%u best=%u", ticks, ok, dt, Test_BestTicks(ticks));
+        }
+    }
+}
+
+/* 纳秒换算：288MHz下1个周期约3.47纳秒，不足一个周期也要进位 */
+static void Test_Rounding(void)
+{
+    const uint32_t clock = 288000000U;
+    uint32_t ns;
+    int errors = 0;
+
+    for(ns = 0; ns <= 3600; ns++)
+    {
+        uint8_t dtc;
+        bool ok = PWM_DeadTimeEncode(clock, ns, &dtc);
+        /* 死区 >= ns 即 dt * 1e9 >= ns * clock */
+        uint64_t need = (uint64_t)ns * clock;
+        bool fits = ((uint64_t)TEST_DEADTIME_MAX * 1000000000U >= need);
+
+        if(ok != fits)
+        {
+            if(errors++ < 10)
+            {
+                TEST_CHECK_MSG(false, "ns=%u ok=%d fits=%d", ns, ok, fits);
+            }
+            continue;
+        }
+
+        if(ok)
+        {
+            uint32_t ticks = (uint32_t)((need + 999999999U) / 1000000000U);
+            uint32_t dt = Test_Decode(dtc);
+
+            if(((uint64_t)dt * 1000000000U < need || dt != Test_BestTicks(ticks)) && errors++ < 10)
+            {
+                TEST_CHECK_MSG(false, "ns=%u decoded=%u ticks=%u", ns, dt, ticks);
+            }
+        }
+    }
+
+    /* 1纳秒不能被截断为0 */
+    {
+        uint8_t dtc = 0;
+        TEST_CHECK(PWM_DeadTimeEncode(clock, 1, &dtc) && dtc == 1);
+    }
+}
+
+int main(void)
+{
+    Test_Boundaries();
+    Test_Exhaustive();
+    Test_Rounding();
+    return TEST_RESULT();
+}
@@ -0,0 +1,115 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "timer_factor.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Timer_GetClockMax() 的典型值和低速时钟 */
+static const uint32_t Test_Clocks[] = { 288000000U, 240000000U, 200000000U, 144000000U, 8000000U };
+
+/* 从分频1开始逐个尝试，第一个四舍五入后周期不超过65536的分频即为答案 */
+static bool BruteForce_CalcPeriod(uint32_t clock, uint32_t freq, uint32_t* period, uint32_t* prescaler)
+{
+    uint64_t psc;
+
+    for(psc = 1; psc <= 0x10000; psc++)
+    {
+        uint64_t den = psc * freq;
+        uint64_t p = ((uint64_t)clock * 1000 + den / 2) / den;
+
+        if(p <= 0x10000)
+        {
+            if(p < 2)
+            {
+                return false;
+            }
+            *period = (uint32_t)p;
+            *prescaler = (uint32_t)psc;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t Test_Rand(void)
+{
+    static uint32_t state = 0x2545F491;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static void Test_Check(uint32_t clock, uint32_t freq)
+{
+    uint32_t period = 0, prescaler = 0;
+    uint32_t refPeriod = 0, refPrescaler = 0;
+    bool ok = PWM_CalcPeriod(clock, freq, &period, &prescaler);
+    bool refOk = BruteForce_CalcPeriod(clock, freq, &refPeriod, &refPrescaler);
+
+    TEST_CHECK_MSG(ok == refOk, "clock=%u freq=%umHz ok=%d ref=%d",
+                   (unsigned)clock, (unsigned)freq, ok, refOk);
+    if(ok && refOk)
+    {
+        TEST_CHECK_MSG(period == refPeriod && prescaler == refPrescaler,
+                       "clock=%u freq=%umHz %u/%u ref %u/%u",
+                       (unsigned)clock, (unsigned)freq,
+                       (unsigned)period, (unsigned)prescaler,
+                       (unsigned)refPeriod, (unsigned)refPrescaler);
+    }
+}
+
+int main(void)
+{
+    unsigned c;
+    uint32_t dummy;
+    int i;
+
+    for(c = 0; c < sizeof(Test_Clocks) / sizeof(Test_Clocks[0]); c++)
+    {
+        const uint32_t clock = Test_Clocks[c];
+        uint64_t freq;
+
+        /* 低频端：分频接近上限 */
+        for(freq = 1; freq <= 2000; freq++)
+        {
+            Test_Check(clock, (uint32_t)freq);
+        }
+
+        /* 按约0.1%的步长覆盖整个范围，包括周期恰好跨过65536和2的边界 */
+        for(freq = 2000; freq <= 0xFFFFFFFFULL; freq += freq / 1024 + 1)
+        {
+            Test_Check(clock, (uint32_t)freq);
+        }
+
+        for(i = 0; i < 20000; i++)
+        {
+            Test_Check(clock, Test_Rand());
+        }
+    }
+
+    TEST_CHECK(!PWM_CalcPeriod(288000000U, 0, &dummy, &dummy));
+
+    return TEST_RESULT();
+}
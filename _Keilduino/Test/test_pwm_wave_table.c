@@ -0,0 +1,296 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "pwm_wave_table.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+/*
+ * 正弦表：峰值/谷值在Top/2±Amplitude上，幅度超过Top/2时限幅到0~Top，任何值都不超过Top；
+ * DDS：相位步进的频率误差不超过半个分辨率(SampleFreq/2^33)，长时间运行的周期数与频率一致，
+ * 分段填充与一次填充结果相同，改频率时相位连续；
+ * 交错布局：DMA突发每次溢出依次写Channels个比较值，缓冲第frame帧第ch个值即通道ch的第frame个采样，
+ * OscFill按Stride写入时不能碰到其他通道的位置。
+ */
+#define TEST_TABLE_BITS     8
+#define TEST_TABLE_SIZE     (1U << TEST_TABLE_BITS)
+#define TEST_FRAMES         200
+#define TEST_CHANNELS_MAX   4
+#define TEST_SENTINEL       0xBEEF
+
+static uint16_t Table[TEST_TABLE_SIZE];
+
+static void Test_TableRange(uint16_t top, uint16_t amplitude, uint16_t expectMin, uint16_t expectMax)
+{
+    uint16_t min = 0xFFFF, max = 0;
+    uint32_t i;
+
+    PWM_Wave_MakeSineTable(Table, TEST_TABLE_BITS, top, amplitude);
+
+    for(i = 0; i < TEST_TABLE_SIZE; i++)
+    {
+        if(Table[i] < min)
+        {
+            min = Table[i];
+        }
+        if(Table[i] > max)
+        {
+            max = Table[i];
+        }
+    }
+
+    TEST_CHECK_MSG(max <= top, "top=%u amp=%u max=%u", top, amplitude, max);
+    TEST_CHECK_MSG(min == expectMin && max == expectMax,
+        "top=%u amp=%u min=%u max=%u expected %u~%u", top, amplitude, min, max, expectMin, expectMax);
+
+    /*波峰在1/4周期，波谷在3/4周期*/
+    TEST_CHECK_MSG(Table[TEST_TABLE_SIZE / 4] == expectMax && Table[TEST_TABLE_SIZE * 3 / 4] == expectMin,
+        "top=%u amp=%u peak=%u trough=%u", top, amplitude, Table[TEST_TABLE_SIZE / 4], Table[TEST_TABLE_SIZE * 3 / 4]);
+}
+
+static void Test_Sine(void)
+{
+    uint32_t i;
+
+    /*中心Top/2，幅度在范围内*/
+    Test_TableRange(1000, 400, 100, 900);
+    Test_TableRange(1000, 500, 0, 1000);
+    Test_TableRange(1000, 0, 500, 500);
+
+    /*幅度超过Top/2时限幅，不能回绕或超过Top*/
+    Test_TableRange(1000, 501, 0, 1000);
+    Test_TableRange(1000, 0xFFFF, 0, 1000);
+    Test_TableRange(0xFFFF, 0xFFFF, 0, 0xFFFF);
+    Test_TableRange(999, 600, 0, 999);
+    Test_TableRange(1, 1, 0, 1);
+    Test_TableRange(0, 100, 0, 0);
+
+    /*半周期对称：Table[i] + Table[i+N/2]在Top±1内；与双精度参考相差不超过1*/
+    PWM_Wave_MakeSineTable(Table, TEST_TABLE_BITS, 4800, 2000);
+    for(i = 0; i < TEST_TABLE_SIZE / 2; i++)
+    {
+        int sum = Table[i] + Table[i + TEST_TABLE_SIZE / 2];
+        double ref = 2400.0 + 2000.0 * sin(2.0 * M_PI * i / TEST_TABLE_SIZE);
+
+        TEST_CHECK_MSG(sum >= 4799 && sum <= 4801, "i=%u sum=%d", i, sum);
+        TEST_CHECK_MSG(fabs(Table[i] - ref) <= 1.0, "i=%u value=%u ref=%f", i, Table[i], ref);
+    }
+}
+
+static void Test_Dds(void)
+{
+    static const uint32_t sampleFreqs[] = { 20000, 48000, 100000, 1000000 };
+    static const uint32_t freqs[] = { 1, 50, 60, 400, 1000, 4999, 9999 };
+    unsigned s, f;
+
+    for(s = 0; s < sizeof(sampleFreqs) / sizeof(sampleFreqs[0]); s++)
+    {
+        uint32_t sampleFreq = sampleFreqs[s];
+
+        for(f = 0; f < sizeof(freqs) / sizeof(freqs[0]); f++)
+        {
+            uint32_t freq = freqs[f];
+            uint32_t step = PWM_Wave_FreqToStep(freq, sampleFreq);
+            /*实际频率 = step * SampleFreq / 2^32，误差不超过半个分辨率*/
+            int64_t err = (int64_t)((uint64_t)step * sampleFreq) - (int64_t)((uint64_t)freq << 32);
+            int64_t limit = sampleFreq / 2;
+
+            if((uint64_t)freq * 2 >= sampleFreq)
+            {
+                TEST_CHECK(step == 0);
+                continue;
+            }
+
+            TEST_CHECK_MSG(err <= limit && err >= -limit,
+                "freq=%u sample=%u step=%u err=%lld", freq, sampleFreq, step, (long long)err);
+        }
+
+        /*奈奎斯特频率及以上不输出*/
+        TEST_CHECK(PWM_Wave_FreqToStep(sampleFreq / 2, sampleFreq) == 0);
+        TEST_CHECK(PWM_Wave_FreqToStep(sampleFreq, sampleFreq) == 0);
+        TEST_CHECK(PWM_Wave_FreqToStep(sampleFreq / 2 - 1, sampleFreq) != 0);
+    }
+    TEST_CHECK(PWM_Wave_FreqToStep(1, 0) == 0);
+
+    /*运行SampleFreq个采样(1秒)，相位回绕次数即频率*/
+    {
+        PWM_Wave_Osc_TypeDef osc;
+        uint16_t dummy;
+        uint64_t phase = 0;
+        uint32_t wraps = 0;
+        uint32_t i;
+
+        PWM_Wave_MakeSineTable(Table, TEST_TABLE_BITS, 1000, 400);
+        PWM_Wave_OscInit(&osc, Table, TEST_TABLE_BITS, 50, 48000, 0);
+        for(i = 0; i < 48000; i++)
+        {
+            PWM_Wave_OscFill(&osc, &dummy, 1, 1);
+            phase += osc.Step;
+            if(phase >> 32)
+            {
+                wraps++;
+                phase &= 0xFFFFFFFFULL;
+            }
+        }
+        TEST_CHECK_MSG(wraps == 50 || wraps == 49, "wraps=%u", wraps);
+        TEST_CHECK((uint32_t)phase == osc.Phase);
+    }
+
+    /*多相：0/120/240度相隔1/3周期*/
+    TEST_CHECK(PWM_Wave_DegreeToPhase(0) == 0);
+    TEST_CHECK(PWM_Wave_DegreeToPhase(90) == 0x40000000UL);
+    TEST_CHECK(PWM_Wave_DegreeToPhase(180) == 0x80000000UL);
+    TEST_CHECK(PWM_Wave_DegreeToPhase(360) == 0);
+    TEST_CHECK(PWM_Wave_DegreeToPhase(450) == 0x40000000UL);
+    {
+        uint32_t p120 = PWM_Wave_DegreeToPhase(120);
+        uint32_t p240 = PWM_Wave_DegreeToPhase(240);
+        int64_t err = (int64_t)((uint64_t)p120 * 3) - ((int64_t)1 << 32);
+        TEST_CHECK_MSG(err >= -2 && err <= 2, "p120=%u err=%lld", p120, (long long)err);
+        TEST_CHECK(p240 - p120 - p120 <= 1 || p120 + p120 - p240 <= 1);
+    }
+}
+
+/*分段填充与一次填充结果相同；中途改频率相位连续*/
+static void Test_Continuity(void)
+{
+    PWM_Wave_Osc_TypeDef whole, parts;
+    uint16_t a[TEST_FRAMES], b[TEST_FRAMES];
+    uint16_t done = 0;
+    uint16_t chunk = 1;
+
+    PWM_Wave_MakeSineTable(Table, TEST_TABLE_BITS, 1000, 400);
+    PWM_Wave_OscInit(&whole, Table, TEST_TABLE_BITS, 137, 20000, PWM_Wave_DegreeToPhase(33));
+    parts = whole;
+
+    PWM_Wave_OscFill(&whole, a, TEST_FRAMES, 1);
+    while(done < TEST_FRAMES)
+    {
+        uint16_t n = (chunk < TEST_FRAMES - done) ? chunk : (uint16_t)(TEST_FRAMES - done);
+        PWM_Wave_OscFill(&parts, b + done, n, 1);
+        done += n;
+        chunk = chunk * 2 + 1;
+    }
+    TEST_CHECK(memcmp(a, b, sizeof(a)) == 0);
+    TEST_CHECK(whole.Phase == parts.Phase);
+
+    /*改频率不改相位：下一个采样从当前相位开始*/
+    {
+        uint32_t phase = whole.Phase;
+        uint16_t next;
+
+        PWM_Wave_OscSetFreq(&whole, 2000, 20000);
+        TEST_CHECK(whole.Phase == phase);
+        PWM_Wave_OscFill(&whole, &next, 1, 1);
+        TEST_CHECK(next == Table[phase >> (32 - TEST_TABLE_BITS)]);
+        TEST_CHECK(whole.Phase == phase + PWM_Wave_FreqToStep(2000, 20000));
+    }
+}
+
+/*交错布局：Buffer[frame * Channels + ch]为通道ch的第frame个采样*/
+static void Test_Layout(void)
+{
+    static uint16_t lanes[TEST_CHANNELS_MAX][TEST_FRAMES];
+    static uint16_t buffer[TEST_FRAMES * TEST_CHANNELS_MAX + 1];
+    const uint16_t* lanePtr[TEST_CHANNELS_MAX];
+    uint8_t channels;
+    uint32_t i;
+
+    for(channels = 1; channels <= TEST_CHANNELS_MAX; channels++)
+    {
+        uint8_t ch;
+        uint16_t frame;
+        bool ok = true;
+
+        for(ch = 0; ch < channels; ch++)
+        {
+            for(frame = 0; frame < TEST_FRAMES; frame++)
+            {
+                lanes[ch][frame] = (uint16_t)(ch * 1000 + frame);
+            }
+            lanePtr[ch] = lanes[ch];
+        }
+
+        for(i = 0; i < sizeof(buffer) / sizeof(buffer[0]); i++)
+        {
+            buffer[i] = TEST_SENTINEL;
+        }
+        PWM_Wave_Interleave(buffer, lanePtr, channels, TEST_FRAMES);
+
+        for(i = 0; i < (uint32_t)TEST_FRAMES * channels; i++)
+        {
+            ok &= (buffer[i] == lanes[i % channels][i / channels]);
+        }
+        TEST_CHECK_MSG(ok, "channels=%u", channels);
+        TEST_CHECK_MSG(buffer[TEST_FRAMES * channels] == TEST_SENTINEL, "channels=%u overrun", channels);
+    }
+
+    /*三相振荡器按Stride写入同一缓冲，每个位置只被一个通道写一次，等同于先生成再交错*/
+    {
+        PWM_Wave_Osc_TypeDef osc[3];
+        static uint16_t direct[TEST_FRAMES * 3 + 1];
+        bool ok = true;
+        uint8_t ch;
+
+        PWM_Wave_MakeSineTable(Table, TEST_TABLE_BITS, 1000, 500);
+        for(i = 0; i < sizeof(direct) / sizeof(direct[0]); i++)
+        {
+            direct[i] = TEST_SENTINEL;
+        }
+
+        for(ch = 0; ch < 3; ch++)
+        {
+            PWM_Wave_OscInit(&osc[ch], Table, TEST_TABLE_BITS, 50, 20000, PWM_Wave_DegreeToPhase(ch * 120));
+            PWM_Wave_OscFill(&osc[ch], direct + ch, TEST_FRAMES, 3);
+        }
+        TEST_CHECK(direct[TEST_FRAMES * 3] == TEST_SENTINEL);
+
+        for(ch = 0; ch < 3; ch++)
+        {
+            PWM_Wave_OscInit(&osc[ch], Table, TEST_TABLE_BITS, 50, 20000, PWM_Wave_DegreeToPhase(ch * 120));
+            PWM_Wave_OscFill(&osc[ch], lanes[ch], TEST_FRAMES, 1);
+            lanePtr[ch] = lanes[ch];
+        }
+        PWM_Wave_Interleave(buffer, lanePtr, 3, TEST_FRAMES);
+        TEST_CHECK(memcmp(direct, buffer, TEST_FRAMES * 3 * sizeof(uint16_t)) == 0);
+
+        /*三相平衡：每帧三个值之和约为3倍中心值*/
+        for(i = 0; i < TEST_FRAMES; i++)
+        {
+            int sum = direct[i * 3] + direct[i * 3 + 1] + direct[i * 3 + 2];
+            ok &= (sum >= 1500 - 30 && sum <= 1500 + 30);
+        }
+        TEST_CHECK(ok);
+    }
+}
+
+int main(void)
+{
+    Test_Sine();
+    Test_Dds();
+    Test_Continuity();
+    Test_Layout();
+    return TEST_RESULT();
+}
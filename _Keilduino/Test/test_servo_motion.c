@@ -0,0 +1,328 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "servo_motion.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+/*
+ * 按帧数移动：中间帧不越过目标、与线性插值相差不超过1微秒，恰好在第Frames帧精确到达(Q16无余数)，
+ * 之前不报告完成；限速移动：每帧变化不超过速度对应的步进，帧数为距离/步进向上取整；
+ * 中途改目标从当前位置出发；时间换算向上取整并限幅；
+ * 角度换算的端点、限幅、反向映射和四舍五入与双精度参考一致；
+ * 通道容量为一帧内(扣除起始余量)能放下的最大舵机数，超过255时限幅。
+ */
+#define TEST_ROUNDS         3000
+#define TEST_FRAME_TIME     20000
+
+static uint32_t Random_State = 1;
+
+static uint32_t Random_Next(void)
+{
+    Random_State = Random_State * 1103515245 + 12345;
+    return Random_State >> 16;
+}
+
+/*运行一次按帧数的移动并检查每一帧*/
+static void Test_FramesMove(uint16_t start, uint16_t target, uint16_t frames)
+{
+    Servo_Motion_TypeDef motion;
+    int errors = 0;
+    uint32_t k;
+
+    Servo_MotionInit(&motion, start);
+    Servo_MotionSetTargetFrames(&motion, target, frames);
+
+    if(frames == 0 || start == target)
+    {
+        TEST_CHECK(Servo_MotionIsDone(&motion));
+        TEST_CHECK(Servo_MotionGetPulse(&motion) == target);
+        TEST_CHECK(Servo_MotionUpdate(&motion) == target);
+        return;
+    }
+
+    for(k = 1; k <= frames; k++)
+    {
+        uint16_t pulse;
+        double ideal = start + ((double)target - start) * k / frames;
+
+        TEST_CHECK(!Servo_MotionIsDone(&motion));
+        pulse = Servo_MotionUpdate(&motion);
+
+        /*不越过目标，与线性插值相差不超过1微秒*/
+        if(((target > start) ? (pulse > target) : (pulse < target)) || fabs(pulse - ideal) > 1.0)
+        {
+            if(errors++ < 3)
+            {
+                TEST_CHECK_MSG(false, "%u->%u frames=%u k=%u pulse=%u ideal=%.2f",
+                    start, target, frames, k, pulse, ideal);
+            }
+        }
+    }
+
+    /*最后一帧精确到达，之后保持不动*/
+    TEST_CHECK_MSG(Servo_MotionIsDone(&motion) && motion.Position == ((uint32_t)target << 16),
+        "%u->%u frames=%u position=0x%08X", start, target, frames, motion.Position);
+    TEST_CHECK(Servo_MotionUpdate(&motion) == target);
+    TEST_CHECK(Servo_MotionUpdate(&motion) == target);
+}
+
+static void Test_Frames(void)
+{
+    int round;
+
+    /*端点与最小距离：1微秒分3帧，Q16步进有余数，最后一帧补齐*/
+    Test_FramesMove(1000, 1001, 3);
+    Test_FramesMove(1001, 1000, 3);
+    Test_FramesMove(500, 2500, 1);
+    Test_FramesMove(2500, 500, 2);
+    Test_FramesMove(0, 0xFFFF, 7);
+    Test_FramesMove(0xFFFF, 0, 0xFFFF);
+    Test_FramesMove(1500, 1500, 10);
+    Test_FramesMove(1500, 2000, 0);
+
+    for(round = 0; round < TEST_ROUNDS; round++)
+    {
+        uint16_t start = (uint16_t)(500 + Random_Next() % 2001);
+        uint16_t target = (uint16_t)(500 + Random_Next() % 2001);
+        uint16_t frames = (uint16_t)(Random_Next() % 300);
+
+        Test_FramesMove(start, target, frames);
+    }
+}
+
+/*限速移动：帧数 = ceil(距离/步进)，每帧变化不超过步进(四舍五入后最多多1微秒)*/
+static void Test_SpeedMove(uint16_t start, uint16_t target, uint32_t speed, uint32_t frameTime)
+{
+    Servo_Motion_TypeDef motion;
+    uint64_t step = (((uint64_t)speed * frameTime) << 16) / 1000000;
+    uint64_t distance = (uint64_t)((target > start) ? target - start : start - target) << 16;
+    uint64_t expectFrames;
+    uint32_t frames = 0;
+    uint16_t last = start;
+    int errors = 0;
+
+    if(step == 0)
+    {
+        step = 1;
+    }
+    expectFrames = (distance + step - 1) / step;
+    if(expectFrames > 0xFFFF)
+    {
+        expectFrames = 0xFFFF;
+    }
+
+    Servo_MotionInit(&motion, start);
+    Servo_MotionSetTarget(&motion, target, speed, frameTime);
+
+    while(!Servo_MotionIsDone(&motion) && frames <= 0x10000)
+    {
+        uint16_t pulse = Servo_MotionUpdate(&motion);
+        uint32_t delta = (pulse > last) ? pulse - last : last - pulse;
+
+        if(expectFrames < 0xFFFF && (uint64_t)delta > ((step + 0xFFFF) >> 16) + 1 && errors++ < 3)
+        {
+            TEST_CHECK_MSG(false, "%u->%u speed=%u frame=%u delta=%u", start, target, speed, frames, delta);
+        }
+        last = pulse;
+        frames++;
+    }
+
+    TEST_CHECK_MSG(frames == expectFrames, "%u->%u speed=%u frames=%u expected=%u",
+        start, target, speed, frames, (uint32_t)expectFrames);
+    TEST_CHECK(Servo_MotionGetPulse(&motion) == target);
+}
+
+static void Test_Speed(void)
+{
+    Servo_Motion_TypeDef motion;
+    int round;
+
+    /*100us/s，20ms一帧 => 2us/帧，500us需要250帧*/
+    Test_SpeedMove(1000, 1500, 100, TEST_FRAME_TIME);
+    Test_SpeedMove(1500, 1000, 100, TEST_FRAME_TIME);
+    /*步进不整除距离：3us/帧，100us需要34帧*/
+    Test_SpeedMove(1000, 1100, 150, TEST_FRAME_TIME);
+    /*极快：一帧到达；极慢：步进为最小Q16单位，帧数限幅*/
+    Test_SpeedMove(500, 2500, 0xFFFFFFFFUL, TEST_FRAME_TIME);
+    Test_SpeedMove(500, 2500, 1, 1);
+
+    for(round = 0; round < TEST_ROUNDS / 10; round++)
+    {
+        uint16_t start = (uint16_t)(500 + Random_Next() % 2001);
+        uint16_t target = (uint16_t)(500 + Random_Next() % 2001);
+        uint32_t speed = 1 + Random_Next() % 20000;
+
+        Test_SpeedMove(start, target, speed, TEST_FRAME_TIME);
+    }
+
+    /*速度0立即到达*/
+    Servo_MotionInit(&motion, 1000);
+    Servo_MotionSetTarget(&motion, 2000, 0, TEST_FRAME_TIME);
+    TEST_CHECK(Servo_MotionIsDone(&motion) && Servo_MotionGetPulse(&motion) == 2000);
+
+    /*中途改目标：从当前(非整数微秒的)位置出发，仍精确到达*/
+    Servo_MotionInit(&motion, 1000);
+    Servo_MotionSetTargetFrames(&motion, 1001, 3);
+    Servo_MotionUpdate(&motion);
+    Servo_MotionSetTargetFrames(&motion, 900, 4);
+    {
+        int k;
+        for(k = 0; k < 4; k++)
+        {
+            TEST_CHECK(!Servo_MotionIsDone(&motion));
+            Servo_MotionUpdate(&motion);
+        }
+    }
+    TEST_CHECK(Servo_MotionIsDone(&motion) && motion.Position == (900U << 16));
+}
+
+static void Test_Duration(void)
+{
+    TEST_CHECK(Servo_DurationToFrames(1000, TEST_FRAME_TIME) == 50);
+    TEST_CHECK(Servo_DurationToFrames(1001, TEST_FRAME_TIME) == 51);
+    TEST_CHECK(Servo_DurationToFrames(1, TEST_FRAME_TIME) == 1);
+    TEST_CHECK(Servo_DurationToFrames(0, TEST_FRAME_TIME) == 0);
+    TEST_CHECK(Servo_DurationToFrames(1000, 0) == 0);
+    TEST_CHECK(Servo_DurationToFrames(0xFFFFFFFFUL, TEST_FRAME_TIME) == 0xFFFF);
+    TEST_CHECK(Servo_DurationToFrames(0xFFFFFFFFUL, 1) == 0xFFFF);
+}
+
+/*参考：双精度线性插值，四舍五入(远离0)*/
+static uint16_t Test_AngleRef(int32_t angle, int32_t minAngle, int32_t maxAngle, uint16_t minPulse, uint16_t maxPulse)
+{
+    int32_t low = (minAngle < maxAngle) ? minAngle : maxAngle;
+    int32_t high = (minAngle < maxAngle) ? maxAngle : minAngle;
+    double offset;
+
+    if(angle < low)
+    {
+        angle = low;
+    }
+    if(angle > high)
+    {
+        angle = high;
+    }
+
+    offset = ((double)angle - minAngle) * ((double)maxPulse - minPulse) / ((double)maxAngle - minAngle);
+    offset = (offset >= 0) ? floor(offset + 0.5) : ceil(offset - 0.5);
+    return (uint16_t)(minPulse + (int32_t)offset);
+}
+
+static void Test_Angle(void)
+{
+    int round;
+
+    /*端点与限幅*/
+    TEST_CHECK(Servo_AngleToPulse(0, 0, 180, 500, 2500) == 500);
+    TEST_CHECK(Servo_AngleToPulse(180, 0, 180, 500, 2500) == 2500);
+    TEST_CHECK(Servo_AngleToPulse(90, 0, 180, 500, 2500) == 1500);
+    TEST_CHECK(Servo_AngleToPulse(-30, 0, 180, 500, 2500) == 500);
+    TEST_CHECK(Servo_AngleToPulse(270, 0, 180, 500, 2500) == 2500);
+    TEST_CHECK(Servo_AngleToPulse(-100000, -90, 90, 1000, 2000) == 1000);
+    TEST_CHECK(Servo_AngleToPulse(100000, -90, 90, 1000, 2000) == 2000);
+
+    /*反向：角度或脉宽的方向相反*/
+    TEST_CHECK(Servo_AngleToPulse(0, 180, 0, 500, 2500) == 2500);
+    TEST_CHECK(Servo_AngleToPulse(180, 180, 0, 500, 2500) == 500);
+    TEST_CHECK(Servo_AngleToPulse(200, 180, 0, 500, 2500) == 500);
+    TEST_CHECK(Servo_AngleToPulse(0, 0, 180, 2500, 500) == 2500);
+    TEST_CHECK(Servo_AngleToPulse(180, 0, 180, 2500, 500) == 500);
+
+    /*退化区间返回最小脉宽*/
+    TEST_CHECK(Servo_AngleToPulse(45, 90, 90, 1200, 1800) == 1200);
+
+    /*四舍五入：1度 = 5.555...微秒，0.5微秒处远离0*/
+    TEST_CHECK(Servo_AngleToPulse(1, 0, 180, 1000, 2000) == 1006);
+    TEST_CHECK(Servo_AngleToPulse(1, 0, 4, 1000, 1002) == 1001);     /* 0.5 */
+    TEST_CHECK(Servo_AngleToPulse(1, 0, 4, 1002, 1000) == 1001);     /* -0.5 */
+    TEST_CHECK(Servo_AngleToPulse(3, 0, 4, 1000, 1002) == 1002);     /* 1.5 */
+
+    /*随机区间(百分之一度)与参考比较*/
+    for(round = 0; round < TEST_ROUNDS * 10; round++)
+    {
+        int32_t minAngle = (int32_t)(Random_Next() % 36001) - 18000;
+        int32_t maxAngle = (int32_t)(Random_Next() % 36001) - 18000;
+        int32_t angle = (int32_t)(Random_Next() % 40001) - 20000;
+        uint16_t minPulse = (uint16_t)(400 + Random_Next() % 2200);
+        uint16_t maxPulse = (uint16_t)(400 + Random_Next() % 2200);
+        uint16_t pulse, ref;
+
+        if(minAngle == maxAngle)
+        {
+            continue;
+        }
+
+        pulse = Servo_AngleToPulse(angle, minAngle, maxAngle, minPulse, maxPulse);
+        ref = Test_AngleRef(angle, minAngle, maxAngle, minPulse, maxPulse);
+        if(pulse != ref)
+        {
+            TEST_CHECK_MSG(false, "angle=%d range=%d~%d pulse=%u~%u got=%u ref=%u",
+                angle, minAngle, maxAngle, minPulse, maxPulse, pulse, ref);
+            break;
+        }
+    }
+}
+
+static void Test_Lane(void)
+{
+    uint32_t frameTime;
+
+    /*20ms帧，2500us脉宽，100us余量：(20000-100)/2600 = 7*/
+    TEST_CHECK(Servo_LaneCapacity(20000, 2500, 100) == 7);
+    TEST_CHECK(Servo_LaneCapacity(20000, 2500, 0) == 8);
+
+    /*帧太短放不下一个*/
+    TEST_CHECK(Servo_LaneCapacity(2600, 2500, 100) == 0);
+    TEST_CHECK(Servo_LaneCapacity(2700, 2500, 100) == 1);
+    TEST_CHECK(Servo_LaneCapacity(100, 2500, 100) == 0);
+    TEST_CHECK(Servo_LaneCapacity(0, 2500, 100) == 0);
+    TEST_CHECK(Servo_LaneCapacity(20000, 0, 0) == 0);
+
+    /*超过255时限幅，不能回绕*/
+    TEST_CHECK(Servo_LaneCapacity(1000000, 1, 0) == 0xFF);
+    TEST_CHECK(Servo_LaneCapacity(0xFFFFFFFFUL, 0, 1) == 0xFF);
+    TEST_CHECK(Servo_LaneCapacity(256 * 100, 100, 0) == 0xFF);
+    TEST_CHECK(Servo_LaneCapacity(255 * 100 + 99, 100, 0) == 0xFF);
+    TEST_CHECK(Servo_LaneCapacity(254 * 100 + 99, 100, 0) == 254);
+    TEST_CHECK(Servo_LaneCapacity(0xFFFFFFFFUL, 0xFFFF, 0xFFFF) == 0xFF);
+
+    /*容量为最大值：起始余量 + n个(脉宽+余量)放得下，n+1个放不下*/
+    for(frameTime = 0; frameTime <= 25000; frameTime += 37)
+    {
+        uint8_t n = Servo_LaneCapacity(frameTime, 2000, 150);
+        TEST_CHECK_MSG((uint32_t)n * 2150 + 150 <= frameTime || n == 0, "frame=%u n=%u", frameTime, n);
+        TEST_CHECK_MSG((uint32_t)(n + 1) * 2150 + 150 > frameTime, "frame=%u n=%u", frameTime, n);
+    }
+}
+
+int main(void)
+{
+    Test_Frames();
+    Test_Speed();
+    Test_Duration();
+    Test_Angle();
+    Test_Lane();
+    return TEST_RESULT();
+}
@@ -0,0 +1,214 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "Spectrum.h"
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+/*
+ * Spectrum 可移植实数FFT与参考DFT(双精度直接计算)对比：
+ * 各种点数、窗函数、去直流开关下的幅值谱，正弦幅值和频率、频带能量、重叠帧数。
+ */
+
+#ifndef M_PI
+#  define M_PI 3.14159265358979323846
+#endif
+
+static uint32_t Test_Seed = 12345;
+
+static float Test_Random(void)
+{
+    Test_Seed = Test_Seed * 1664525U + 1013904223U;
+    return (float)((Test_Seed >> 8) & 0xFFFF) / 65536.0f - 0.5f;
+}
+
+static double Test_Window(Spectrum::Window_t window, int i, int n)
+{
+    double x = 2.0 * M_PI * i / n;
+    switch(window)
+    {
+    case Spectrum::WINDOW_HANN:
+        return 0.5 - 0.5 * cos(x);
+    case Spectrum::WINDOW_HAMMING:
+        return 0.54 - 0.46 * cos(x);
+    case Spectrum::WINDOW_BLACKMAN:
+        return 0.42 - 0.5 * cos(x) + 0.08 * cos(2 * x);
+    default:
+        return 1.0;
+    }
+}
+
+/* 参考：去直流 -> 加窗 -> 直接DFT -> 单边幅值 */
+static void Test_ReferenceMagnitude(
+    const std::vector<float>& input, Spectrum::Window_t window, bool removeDC, std::vector<double>& mag)
+{
+    const int n = (int)input.size();
+    double mean = 0, s1 = 0;
+    std::vector<double> x(n);
+
+    if(removeDC)
+    {
+        for(int i = 0; i < n; i++)
+        {
+            mean += input[i];
+        }
+        mean /= n;
+    }
+
+    for(int i = 0; i < n; i++)
+    {
+        double w = Test_Window(window, i, n);
+        x[i] = (input[i] - mean) * w;
+        s1 += w;
+    }
+
+    mag.assign(n / 2, 0);
+    for(int k = 0; k < n / 2; k++)
+    {
+        double re = 0, im = 0;
+        for(int i = 0; i < n; i++)
+        {
+            double a = 2.0 * M_PI * (double)((long)k * i % n) / n;
+            re += x[i] * cos(a);
+            im -= x[i] * sin(a);
+        }
+        mag[k] = sqrt(re * re + im * im) * (k ? 2.0 : 1.0) / s1;
+    }
+}
+
+static void Test_CompareReference(uint16_t n, Spectrum::Window_t window, bool removeDC)
+{
+    Spectrum spectrum;
+    std::vector<float> input(n);
+    std::vector<double> ref;
+    double peak = 0, maxErr = 0;
+
+    for(int i = 0; i < n; i++)
+    {
+        input[i] = 1.5f
+                   + 0.8f * (float)sin(2 * M_PI * 5.0 * i / n)
+                   + 0.3f * (float)cos(2 * M_PI * (n / 4 + 0.37) * i / n)
+                   + 0.05f * Test_Random();
+    }
+
+    TEST_CHECK(spectrum.begin(n, 1000.0f, window));
+    spectrum.setRemoveDC(removeDC);
+    TEST_CHECK(spectrum.push(input.data(), n) == 1);
+    TEST_CHECK(spectrum.available());
+    TEST_CHECK(!spectrum.available());
+
+    Test_ReferenceMagnitude(input, window, removeDC, ref);
+
+    const float* mag = spectrum.getMagnitude();
+    for(int k = 0; k < n / 2; k++)
+    {
+        peak = fmax(peak, ref[k]);
+        maxErr = fmax(maxErr, fabs(mag[k] - ref[k]));
+    }
+
+    TEST_CHECK_MSG(maxErr <= 2e-5 * peak + 1e-7,
+                   "n=%u window=%d dc=%d err=%g peak=%g", n, (int)window, (int)removeDC, maxErr, peak);
+}
+
+static void Test_SinePeak(void)
+{
+    const uint16_t n = 1024;
+    const float rate = 8000.0f;
+    const float freq = 1234.5f;
+    const float amp = 0.7f;
+    Spectrum spectrum;
+    Spectrum::Peak_t peaks[2];
+    std::vector<float> input(n);
+
+    for(int i = 0; i < n; i++)
+    {
+        input[i] = amp * (float)sin(2 * M_PI * freq * i / rate);
+    }
+
+    TEST_CHECK(spectrum.begin(n, rate, Spectrum::WINDOW_BLACKMAN));
+    spectrum.push(input.data(), n);
+
+    TEST_CHECK(spectrum.findPeaks(peaks, 2, 0.01f) == 1);
+    TEST_CHECK_MSG(fabsf(peaks[0].frequency - freq) < 0.1f * rate / n, "freq=%f", peaks[0].frequency);
+    /* Blackman窗扇贝损失小于1.2dB */
+    TEST_CHECK_MSG(peaks[0].magnitude > amp * 0.86f && peaks[0].magnitude <= amp * 1.01f,
+                   "mag=%f", peaks[0].magnitude);
+
+    /* 正弦的均方值为 A^2/2 */
+    float energy = spectrum.getBandEnergy(freq - 200, freq + 200);
+    TEST_CHECK_MSG(fabsf(energy - amp * amp / 2) < amp * amp / 2 * 0.02f, "energy=%f", energy);
+}
+
+static void Test_Overlap(void)
+{
+    const uint16_t n = 256;
+    Spectrum spectrum;
+    std::vector<uint16_t> block(100, 2048);
+    uint32_t frames = 0;
+
+    TEST_CHECK(spectrum.begin(n, 1000.0f, Spectrum::WINDOW_HANN, n * 3 / 4));
+
+    /* 第一帧需要n点，之后每 n/4 点一帧 */
+    for(int i = 0; i < 20; i++)
+    {
+        frames += spectrum.push(block.data(), (uint16_t)block.size());
+    }
+
+    TEST_CHECK(frames == (2000 - n) / (n / 4) + 1);
+    TEST_CHECK(spectrum.getFrameCount() == frames);
+}
+
+static void Test_InvalidArgs(void)
+{
+    Spectrum spectrum;
+    TEST_CHECK(!spectrum.begin(16, 1000.0f));
+    TEST_CHECK(!spectrum.begin(1000, 1000.0f));
+    TEST_CHECK(!spectrum.begin(8192, 1000.0f));
+    TEST_CHECK(!spectrum.begin(64, 1000.0f, Spectrum::WINDOW_HANN, 64));
+    TEST_CHECK(!spectrum.begin(64, 0.0f));
+    TEST_CHECK(spectrum.push((const float*)NULL, 0) == 0);
+}
+
+int main(void)
+{
+    const Spectrum::Window_t windows[] =
+    {
+        Spectrum::WINDOW_RECTANGLE, Spectrum::WINDOW_HANN, Spectrum::WINDOW_HAMMING, Spectrum::WINDOW_BLACKMAN
+    };
+
+    for(uint16_t n = SPECTRUM_FFT_SIZE_MIN; n <= SPECTRUM_FFT_SIZE_MAX; n <<= 1)
+    {
+        for(unsigned w = 0; w < sizeof(windows) / sizeof(windows[0]); w++)
+        {
+            Test_CompareReference(n, windows[w], true);
+        }
+        Test_CompareReference(n, Spectrum::WINDOW_HANN, false);
+    }
+
+    Test_SinePeak();
+    Test_Overlap();
+    Test_InvalidArgs();
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,320 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "stdio_buffer.h"
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * 输出端模拟带发送缓冲的串口：每次只接收 availableForWrite 个字节，
+ * Wait 回调代表时间流逝，串口发出若干字节。
+ * 检查三种缓冲模式的发送时机、三种满缓冲策略、RAM日志读出，
+ * 随机长度写入在阻塞/丢弃策略下收到的字节流与参考模型一致，以及行编辑器。
+ */
+#define TEST_STREAM_MAX     (1 << 20)
+
+typedef struct
+{
+    uint8_t Data[TEST_STREAM_MAX];
+    uint32_t Length;    // 已接收(已进入发送缓冲)的字节数
+    uint32_t TxFree;    // 发送缓冲剩余空间
+    uint32_t TxSize;
+    uint32_t Waits;
+} Test_Uart_TypeDef;
+
+static Test_Uart_TypeDef Uart;
+
+static uint32_t Random_State = 1;
+
+static uint32_t Random_Next(void)
+{
+    Random_State = Random_State * 1103515245 + 12345;
+    return Random_State >> 16;
+}
+
+static void Test_UartInit(uint32_t txSize)
+{
+    Uart.Length = 0;
+    Uart.TxFree = txSize;
+    Uart.TxSize = txSize;
+    Uart.Waits = 0;
+}
+
+/*按 availableForWrite 接收，与 rt_sys.cpp 的不阻塞Print输出端相同*/
+static uint32_t Test_UartWrite(void* UserData, const uint8_t* Data, uint32_t Length)
+{
+    Test_Uart_TypeDef* uart = (Test_Uart_TypeDef*)UserData;
+    uint32_t n = (Length < uart->TxFree) ? Length : uart->TxFree;
+
+    memcpy(uart->Data + uart->Length, Data, n);
+    uart->Length += n;
+    uart->TxFree -= n;
+    return n;
+}
+
+/*等待期间串口发出几个字节*/
+static void Test_UartWait(void)
+{
+    uint32_t sent = 1 + Random_Next() % 8;
+
+    Uart.TxFree = (Uart.TxFree + sent > Uart.TxSize) ? Uart.TxSize : Uart.TxFree + sent;
+    Uart.Waits++;
+}
+
+static void Test_Write(StdioBuf_TypeDef* buf, const char* str)
+{
+    StdioBuf_Write(buf, (const uint8_t*)str, strlen(str));
+}
+
+static void Test_Modes(void)
+{
+    uint8_t buffer[32];
+    StdioBuf_TypeDef buf;
+
+    /*无缓冲：写入后立即发送*/
+    Test_UartInit(64);
+    StdioBuf_Init(&buf, buffer, sizeof(buffer), STDIO_BUF_NONE, STDIO_POLICY_BLOCK);
+    StdioBuf_SetSink(&buf, Test_UartWrite, &Uart, Test_UartWait);
+    Test_Write(&buf, "abc");
+    TEST_CHECK(Uart.Length == 3 && memcmp(Uart.Data, "abc", 3) == 0);
+
+    /*行缓冲：换行之前不发送*/
+    Test_UartInit(64);
+    StdioBuf_Init(&buf, buffer, sizeof(buffer), STDIO_BUF_LINE, STDIO_POLICY_DROP);
+    StdioBuf_SetSink(&buf, Test_UartWrite, &Uart, Test_UartWait);
+    Test_Write(&buf, "value=");
+    TEST_CHECK(Uart.Length == 0);
+    TEST_CHECK(StdioBuf_Process(&buf) == 0);
+    Test_Write(&buf, "12\nnext");
+    TEST_CHECK(Uart.Length == 13 && memcmp(Uart.Data, "value=12\nnext", 13) == 0);
+
+    /*发送缓冲满时剩余部分由 Process 继续发送*/
+    Test_UartInit(4);
+    StdioBuf_Init(&buf, buffer, sizeof(buffer), STDIO_BUF_LINE, STDIO_POLICY_DROP);
+    StdioBuf_SetSink(&buf, Test_UartWrite, &Uart, Test_UartWait);
+    Test_Write(&buf, "hello\n");
+    TEST_CHECK(Uart.Length == 4);
+    TEST_CHECK(StdioBuf_GetCount(&buf) == 2);
+    TEST_CHECK(StdioBuf_Process(&buf) == 0);
+    Uart.TxFree = 4;
+    TEST_CHECK(StdioBuf_Process(&buf) == 2);
+    TEST_CHECK(Uart.Length == 6 && memcmp(Uart.Data, "hello\n", 6) == 0);
+    TEST_CHECK(Uart.Waits == 0);
+
+    /*全缓冲：满或 flush 时发送*/
+    Test_UartInit(64);
+    StdioBuf_Init(&buf, buffer, sizeof(buffer), STDIO_BUF_FULL, STDIO_POLICY_BLOCK);
+    StdioBuf_SetSink(&buf, Test_UartWrite, &Uart, Test_UartWait);
+    Test_Write(&buf, "line1\nline2\n");
+    TEST_CHECK(Uart.Length == 0);
+    TEST_CHECK(StdioBuf_Process(&buf) == 0);
+    TEST_CHECK(StdioBuf_Flush(&buf, true));
+    TEST_CHECK(Uart.Length == 12);
+    Test_Write(&buf, "0123456789abcdef0123456789abcdefXY");
+    TEST_CHECK(Uart.Length == 12 + 32);
+    TEST_CHECK(StdioBuf_GetCount(&buf) == 2);
+}
+
+static void Test_Block(void)
+{
+    uint8_t buffer[16];
+    StdioBuf_TypeDef buf;
+    char text[200];
+    int i;
+
+    /*发送缓冲比数据小得多，阻塞策略等待串口发送，不丢数据*/
+    for(i = 0; i < (int)sizeof(text); i++)
+    {
+        text[i] = 'a' + i % 26;
+    }
+
+    Test_UartInit(8);
+    StdioBuf_Init(&buf, buffer, sizeof(buffer), STDIO_BUF_NONE, STDIO_POLICY_BLOCK);
+    StdioBuf_SetSink(&buf, Test_UartWrite, &Uart, Test_UartWait);
+    TEST_CHECK(StdioBuf_Write(&buf, (const uint8_t*)text, sizeof(text)) == sizeof(text));
+    TEST_CHECK(Uart.Length == sizeof(text) && memcmp(Uart.Data, text, sizeof(text)) == 0);
+    TEST_CHECK(StdioBuf_GetDropped(&buf, false) == 0);
+    TEST_CHECK(Uart.Waits > 0);
+}
+
+static void Test_DropOverwrite(void)
+{
+    uint8_t buffer[8];
+    uint8_t out[16];
+    StdioBuf_TypeDef buf;
+
+    /*输出端一直忙：丢弃放不下的新数据*/
+    Test_UartInit(0);
+    StdioBuf_Init(&buf, buffer, sizeof(buffer), STDIO_BUF_NONE, STDIO_POLICY_DROP);
+    StdioBuf_SetSink(&buf, Test_UartWrite, &Uart, Test_UartWait);
+    TEST_CHECK(StdioBuf_Write(&buf, (const uint8_t*)"0123456789", 10) == 8);
+    TEST_CHECK(StdioBuf_Write(&buf, (const uint8_t*)"ab", 2) == 0);
+    TEST_CHECK(StdioBuf_GetDropped(&buf, true) == 4);
+    TEST_CHECK(StdioBuf_GetDropped(&buf, false) == 0);
+    TEST_CHECK(Uart.Waits == 0);
+    Uart.TxFree = 16;
+    TEST_CHECK(StdioBuf_Flush(&buf, false));
+    TEST_CHECK(Uart.Length == 8 && memcmp(Uart.Data, "01234567", 8) == 0);
+
+    /*没有输出端：RAM日志保留最新的数据*/
+    StdioBuf_Init(&buf, buffer, sizeof(buffer), STDIO_BUF_FULL, STDIO_POLICY_OVERWRITE);
+    Test_Write(&buf, "0123456789");
+    Test_Write(&buf, "abc");
+    TEST_CHECK(StdioBuf_GetCount(&buf) == 8);
+    TEST_CHECK(StdioBuf_GetDropped(&buf, false) == 5);
+    TEST_CHECK(StdioBuf_Read(&buf, out, 3) == 3 && memcmp(out, "567", 3) == 0);
+    TEST_CHECK(StdioBuf_Read(&buf, out, sizeof(out)) == 5 && memcmp(out, "89abc", 5) == 0);
+    TEST_CHECK(StdioBuf_Read(&buf, out, sizeof(out)) == 0);
+
+    /*一次写入超过缓冲大小，只保留末尾*/
+    Test_Write(&buf, "ABCDEFGHIJKLMNOPQRST");
+    TEST_CHECK(StdioBuf_Read(&buf, out, sizeof(out)) == 8 && memcmp(out, "MNOPQRST", 8) == 0);
+}
+
+static void Test_Random(StdioBuf_Policy_t policy)
+{
+    static uint8_t expected[TEST_STREAM_MAX];
+    uint8_t buffer[64];
+    uint8_t data[100];
+    StdioBuf_TypeDef buf;
+    uint32_t expectedLength = 0;
+    uint32_t dropped = 0;
+    int i;
+
+    Test_UartInit(16);
+    StdioBuf_Init(&buf, buffer, sizeof(buffer), STDIO_BUF_NONE, policy);
+    StdioBuf_SetSink(&buf, Test_UartWrite, &Uart, Test_UartWait);
+
+    for(i = 0; i < 5000; i++)
+    {
+        uint32_t length = Random_Next() % sizeof(data);
+        uint32_t accepted;
+        uint32_t j;
+
+        buf.Mode = (StdioBuf_Mode_t)(Random_Next() % 3);
+        for(j = 0; j < length; j++)
+        {
+            data[j] = (Random_Next() % 8 == 0) ? '\n' : (uint8_t)(' ' + Random_Next() % 90);
+        }
+
+        accepted = StdioBuf_Write(&buf, data, length);
+        memcpy(expected + expectedLength, data, accepted);
+        expectedLength += accepted;
+        dropped += length - accepted;
+        if(policy == STDIO_POLICY_BLOCK)
+        {
+            TEST_CHECK(accepted == length);
+        }
+
+        /*主循环：串口发出一些字节，再处理待发送的数据*/
+        if(Random_Next() % 2)
+        {
+            Test_UartWait();
+        }
+        StdioBuf_Process(&buf);
+    }
+
+    while(StdioBuf_GetCount(&buf))
+    {
+        Test_UartWait();
+        StdioBuf_Flush(&buf, false);
+    }
+
+    TEST_CHECK(StdioBuf_GetDropped(&buf, false) == dropped);
+    TEST_CHECK_MSG(Uart.Length == expectedLength, "received=%u expected=%u", (unsigned)Uart.Length, (unsigned)expectedLength);
+    TEST_CHECK(memcmp(Uart.Data, expected, expectedLength) == 0);
+    if(policy == STDIO_POLICY_DROP)
+    {
+        TEST_CHECK(dropped > 0);
+    }
+    printf("random %s: %u bytes, %u dropped, %u waits\n",
+           policy == STDIO_POLICY_BLOCK ? "block" : "drop",
+           (unsigned)expectedLength, (unsigned)dropped, (unsigned)Uart.Waits);
+}
+
+static void Test_Input(StdioLine_TypeDef* line, StdioBuf_TypeDef* echo, const char* str)
+{
+    while(*str)
+    {
+        StdioLine_Input(line, *str++, echo);
+    }
+}
+
+static void Test_LineEditor(void)
+{
+    char lineBuffer[8];
+    uint8_t echoBuffer[64];
+    uint8_t out[16];
+    StdioLine_TypeDef line;
+    StdioBuf_TypeDef echo;
+
+    StdioBuf_Init(&echo, echoBuffer, sizeof(echoBuffer), STDIO_BUF_FULL, STDIO_POLICY_DROP);
+    StdioLine_Init(&line, lineBuffer, sizeof(lineBuffer), true);
+
+    /*退格、DEL、Ctrl+U，控制字符忽略*/
+    Test_Input(&line, &echo, "ab\bc\x7F" "d\x01");
+    TEST_CHECK(!line.Ready);
+    TEST_CHECK(StdioLine_Read(&line, out, sizeof(out)) == 0);
+    Test_Input(&line, &echo, "\x15xy\r");
+    TEST_CHECK(line.Ready);
+    TEST_CHECK(StdioLine_Read(&line, out, 2) == 2 && memcmp(out, "xy", 2) == 0);
+    TEST_CHECK(StdioLine_Read(&line, out, sizeof(out)) == 1 && out[0] == '\n');
+    TEST_CHECK(!line.Ready);
+    TEST_CHECK(StdioBuf_Read(&echo, out, sizeof(out)) == 16);
+    TEST_CHECK(memcmp(out, "ab\b \bc\b \bd\b \b\b \b", 16) == 0);
+    TEST_CHECK(StdioBuf_Read(&echo, out, sizeof(out)) == 4 && memcmp(out, "xy\r\n", 4) == 0);
+
+    /*"\r\n"只结束一行(读取一行之后才继续输入，与rt_sys相同)，单独的'\n'也结束一行*/
+    Test_Input(&line, &echo, "\n");
+    TEST_CHECK(!line.Ready);
+    Test_Input(&line, &echo, "\n");
+    TEST_CHECK(line.Ready);
+    TEST_CHECK(StdioLine_Read(&line, out, sizeof(out)) == 1 && out[0] == '\n');
+
+    /*一行已完成时不再接收字符*/
+    Test_Input(&line, &echo, "1\r2");
+    TEST_CHECK(StdioLine_Read(&line, out, sizeof(out)) == 2 && memcmp(out, "1\n", 2) == 0);
+    TEST_CHECK(!line.Ready);
+
+    /*超过 Size - 1 的字符丢弃*/
+    Test_Input(&line, &echo, "123456789\r");
+    TEST_CHECK(StdioLine_Read(&line, out, sizeof(out)) == 8 && memcmp(out, "1234567\n", 8) == 0);
+
+    /*关闭回显*/
+    StdioBuf_Read(&echo, out, sizeof(out));
+    StdioBuf_Read(&echo, out, sizeof(out));
+    line.Echo = false;
+    Test_Input(&line, &echo, "ok\r");
+    TEST_CHECK(StdioBuf_GetCount(&echo) == 0);
+}
+
+int main(void)
+{
+    Test_Modes();
+    Test_Block();
+    Test_DropOverwrite();
+    Test_Random(STDIO_POLICY_BLOCK);
+    Test_Random(STDIO_POLICY_DROP);
+    Test_LineEditor();
+    return TEST_RESULT();
+}
@@ -0,0 +1,338 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "MillisTaskManager.h"
+#include <string.h>
+
+/*
+ * 用模拟时钟驱动调度器：周期任务按间隔累加触发，不随调度延迟漂移；
+ * 随机操作序列与按定义逐个扫描的参考模型比较执行顺序和下一个到期时间。
+ */
+#define TEST_TASK_NUM       8
+#define TEST_LOG_SIZE       256
+
+static uint8_t Run_Log[TEST_LOG_SIZE];
+static uint32_t Run_Count;
+static uint32_t Run_Time;
+static MillisTaskManager* Run_Manager;
+
+template<int ID> static void Task_Function()
+{
+    if(Run_Count < TEST_LOG_SIZE)
+        Run_Log[Run_Count] = ID;
+    Run_Count++;
+}
+
+static MillisTaskManager::void_TaskFunction_t const Task_Functions[TEST_TASK_NUM] =
+{
+    Task_Function<0>, Task_Function<1>, Task_Function<2>, Task_Function<3>,
+    Task_Function<4>, Task_Function<5>, Task_Function<6>, Task_Function<7>
+};
+
+static uint32_t Test_Rand(void)
+{
+    static uint32_t state = 0x2545F491;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/*周期任务：第k次执行对应计划时间 start + k*interval，调度间隔不整除周期时也不漂移*/
+static uint32_t Drift_Deadline;
+static uint32_t Drift_Runs;
+static uint32_t Drift_MaxLate;
+
+static void Drift_Task()
+{
+    uint32_t late = Run_Time - Drift_Deadline;
+
+    TEST_CHECK_MSG((int32_t)late >= 0, "ran %d early", -(int32_t)late);
+    if(late > Drift_MaxLate)
+        Drift_MaxLate = late;
+    Drift_Deadline += 10;
+    Drift_Runs++;
+}
+
+static void Test_NoDrift()
+{
+    MillisTaskManager mtm(4);
+    uint32_t start = 0xFFFFF000;//跨过32位回绕
+
+    Run_Time = start;
+    mtm.Running(Run_Time);
+    mtm.TaskRegister(0, Drift_Task, 10);
+    Drift_Deadline = start + 10;
+    Drift_Runs = 0;
+    Drift_MaxLate = 0;
+
+    while(Run_Time - start < 100000)
+    {
+        Run_Time += (Test_Rand() & 1) ? 3 : 7;//每次调度都晚于计划时间
+        mtm.Running(Run_Time);
+    }
+
+    TEST_CHECK_MSG(Drift_Runs == (Run_Time - start) / 10, "%u runs in %u", (unsigned)Drift_Runs, (unsigned)(Run_Time - start));
+    TEST_CHECK(Drift_MaxLate < 7);
+    TEST_CHECK(mtm.GetNextTaskTime(Run_Time) == Drift_Deadline - Run_Time);
+}
+
+/*同一轮到期的任务按优先级执行，同优先级按到期时间、ID*/
+static void Test_Priority()
+{
+    MillisTaskManager mtm(TEST_TASK_NUM);
+    static const uint8_t expect[] = { 3, 1, 2, 0 };
+
+    Run_Count = 0;
+    mtm.Running(0);
+    mtm.TaskRegister(0, Task_Functions[0], 10);
+    mtm.TaskRegister(1, Task_Functions[1], 20);
+    mtm.TaskRegister(2, Task_Functions[2], 5);
+    mtm.TaskRegister(3, Task_Functions[3], 30);
+    mtm.TaskSetPriority(1, 1);
+    mtm.TaskSetPriority(3, 2);
+
+    TEST_CHECK(mtm.GetNextTaskTime(0) == 5);
+    mtm.Running(30);
+    TEST_CHECK(Run_Count == 4 && memcmp(Run_Log, expect, 4) == 0);
+
+    /*落后多个周期时只执行一次，下一次对齐到原周期网格*/
+    Run_Count = 0;
+    mtm.Running(30);
+    TEST_CHECK(Run_Count == 0);
+    TEST_CHECK(mtm.GetNextTaskTime(30) == 5);
+}
+
+/*单次任务执行一次后关闭，重新开启后从上一次调度时间开始计时*/
+static void Once_Task()
+{
+    Run_Count++;
+    if(Run_Count == 1)
+        Run_Manager->TaskStateCtrl(Once_Task, true);//执行中重新开启
+}
+
+static void Logout_Task()
+{
+    Run_Count++;
+    Run_Manager->TaskLogout(Logout_Task);
+}
+
+static void Test_OneShot()
+{
+    MillisTaskManager mtm(4);
+
+    Run_Manager = &mtm;
+    Run_Count = 0;
+    mtm.Running(100);
+    mtm.TaskRegisterOnce(0, Once_Task, 50);
+    TEST_CHECK(mtm.GetNextTaskTime(100) == 50);
+    mtm.Running(149);
+    TEST_CHECK(Run_Count == 0);
+    mtm.Running(150);
+    TEST_CHECK(Run_Count == 1);
+    TEST_CHECK(mtm.GetNextTaskTime(150) == 50);
+    mtm.Running(200);
+    TEST_CHECK(Run_Count == 2);
+    TEST_CHECK(mtm.GetNextTaskTime(200) == 0xFFFFFFFF);
+    mtm.Running(1000);
+    TEST_CHECK(Run_Count == 2);
+
+    /*执行中注销自己*/
+    Run_Count = 0;
+    mtm.TaskRegister(1, Logout_Task, 10);
+    mtm.Running(1010);
+    mtm.Running(1020);
+    TEST_CHECK(Run_Count == 1);
+    TEST_CHECK(mtm.TaskFind(Logout_Task) == -1);
+
+    /*间隔为0的任务每次调度执行一次*/
+    Run_Count = 0;
+    mtm.TaskRegister(2, Task_Functions[2], 0);
+    mtm.Running(1020);
+    mtm.Running(1020);
+    mtm.Running(1021);
+    TEST_CHECK(Run_Count == 3);
+}
+
+/*参考模型：每次调度扫描全部任务*/
+typedef struct {
+    bool Used;
+    bool State;
+    bool OneShot;
+    uint8_t Priority;
+    uint32_t Interval;
+    uint32_t TimePoint;
+} Model_TypeDef;
+
+static Model_TypeDef Model[TEST_TASK_NUM];
+static uint32_t Model_TimeSeed;
+
+static bool Model_Due(int id, uint32_t now)
+{
+    const Model_TypeDef* m = &Model[id];
+    return m->Used && m->State && (int32_t)(now - (m->TimePoint + m->Interval)) >= 0;
+}
+
+static bool Model_Before(int a, int b)
+{
+    int32_t diff = (int32_t)((Model[a].TimePoint + Model[a].Interval) - (Model[b].TimePoint + Model[b].Interval));
+    if(Model[a].Priority != Model[b].Priority)
+        return Model[a].Priority > Model[b].Priority;
+    if(diff != 0)
+        return diff < 0;
+    return a < b;
+}
+
+static uint32_t Model_Running(uint32_t now, uint8_t* log)
+{
+    uint8_t order[TEST_TASK_NUM];
+    uint32_t count = 0;
+
+    Model_TimeSeed = now;
+    for(int i = 0; i < TEST_TASK_NUM; i++)
+    {
+        if(!Model_Due(i, now))
+            continue;
+        uint32_t j = count++;
+        while(j > 0 && Model_Before(i, order[j - 1]))
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    for(uint32_t k = 0; k < count; k++)
+    {
+        Model_TypeDef* m = &Model[order[k]];
+        log[k] = order[k];
+        if(m->OneShot)
+        {
+            m->State = false;
+            continue;
+        }
+        m->TimePoint += m->Interval;
+        if((int32_t)(now - (m->TimePoint + m->Interval)) >= 0)
+            m->TimePoint = m->Interval ? now - (now - m->TimePoint) % m->Interval : now;
+    }
+    return count;
+}
+
+static uint32_t Model_NextTime(uint32_t now)
+{
+    int32_t best = 0x7FFFFFFF;
+    bool found = false;
+
+    for(int i = 0; i < TEST_TASK_NUM; i++)
+    {
+        if(!Model[i].Used || !Model[i].State)
+            continue;
+        int32_t remain = (int32_t)(Model[i].TimePoint + Model[i].Interval - now);
+        if(!found || remain < best)
+            best = remain;
+        found = true;
+    }
+    if(!found)
+        return 0xFFFFFFFF;
+    return best > 0 ? best : 0;
+}
+
+static void Test_Random()
+{
+    MillisTaskManager mtm(TEST_TASK_NUM);
+    uint8_t expect[TEST_TASK_NUM];
+    uint32_t now = 0xFFF00000;
+
+    memset(Model, 0, sizeof(Model));
+    mtm.Running(now);
+    Model_TimeSeed = now;
+
+    for(int step = 0; step < 200000 && Test_FailCount < 10; step++)
+    {
+        uint32_t r = Test_Rand();
+        int id = r % TEST_TASK_NUM;
+        Model_TypeDef* m = &Model[id];
+        uint32_t interval = (r >> 8) % 8 == 0 ? 0 : (r >> 12) % 60;
+
+        switch((r >> 4) % 10)
+        {
+        case 0:
+        case 1:
+            mtm.TaskRegister(id, Task_Functions[id], interval, (r >> 20) & 3);
+            m->Used = true;
+            m->State = (r >> 20) & 3;
+            m->OneShot = false;
+            m->Interval = interval;
+            m->TimePoint = Model_TimeSeed;
+            break;
+        case 2:
+            mtm.TaskRegisterOnce(id, Task_Functions[id], interval);
+            m->Used = true;
+            m->State = true;
+            m->OneShot = true;
+            m->Interval = interval;
+            m->TimePoint = Model_TimeSeed;
+            break;
+        case 3:
+            TEST_CHECK(mtm.TaskLogout(id));
+            memset(m, 0, sizeof(*m));
+            break;
+        case 4:
+            TEST_CHECK(mtm.TaskStateCtrl(id, (r >> 20) & 1));
+            if(((r >> 20) & 1) && !m->State)
+                m->TimePoint = Model_TimeSeed;
+            m->State = (r >> 20) & 1;
+            break;
+        case 5:
+            TEST_CHECK(mtm.TaskSetIntervalTime(id, interval));
+            m->Interval = interval;
+            break;
+        case 6:
+            TEST_CHECK(mtm.TaskSetPriority(id, (r >> 20) % 3));
+            m->Priority = (r >> 20) % 3;
+            break;
+        default:
+            now += ((r >> 20) % 64 == 0) ? 5000 : (r >> 20) % 25;//偶尔大幅落后
+            Run_Count = 0;
+            mtm.Running(now);
+            {
+                uint32_t count = Model_Running(now, expect);
+                TEST_CHECK_MSG(Run_Count == count && memcmp(Run_Log, expect, count) == 0,
+                               "step %d: ran %u tasks, model %u", step, (unsigned)Run_Count, (unsigned)count);
+            }
+            break;
+        }
+
+        TEST_CHECK_MSG(mtm.GetNextTaskTime(now) == Model_NextTime(now), "step %d: next %u, model %u",
+                       step, (unsigned)mtm.GetNextTaskTime(now), (unsigned)Model_NextTime(now));
+    }
+}
+
+int main()
+{
+    Test_NoDrift();
+    Test_Priority();
+    Test_OneShot();
+    Test_Random();
+    return TEST_RESULT();
+}
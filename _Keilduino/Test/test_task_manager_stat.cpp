@@ -0,0 +1,143 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include <string.h>
+#include <stdint.h>
+
+/*
+ * 用模拟的周期计数器替换DWT，直接编译调度器源文件：
+ * 任务按已知周期数推进计数器(中途回绕)，检查执行时间、触发延迟、错过周期、CPU占用率和输出。
+ */
+static uint32_t Test_Cycle = 0xFFFFF000;
+
+#define MTM_USE_STAT        1
+#define MTM_GET_CYCLE()     (Test_Cycle)
+#define MTM_CYCLE_INIT()    do{}while(0)
+#include "MillisTaskManager.cpp"
+
+class StringPrint : public Print {
+public:
+    char Buffer[2048];
+    size_t Length;
+
+    StringPrint() : Length(0) { Buffer[0] = '\0'; }
+    virtual size_t write(uint8_t c)
+    {
+        if(Length + 1 >= sizeof(Buffer))
+            return 0;
+        Buffer[Length++] = c;
+        Buffer[Length] = '\0';
+        return 1;
+    }
+};
+
+static uint64_t Busy_Cycles;
+static uint32_t B_Runs;
+
+static void Busy(uint32_t cycles)
+{
+    Test_Cycle += cycles;
+    Busy_Cycles += cycles;
+}
+
+static void Task_A()
+{
+    Busy(100);
+}
+
+static void Task_B()
+{
+    Busy((B_Runs++ & 1) ? 600 : 200);
+}
+
+static void Task_C()
+{
+    Busy(50);
+}
+
+static void Test_Stat()
+{
+    MillisTaskManager mtm(4);
+    MillisTaskManager::TaskStat_TypeDef stat;
+    uint32_t start = Test_Cycle;
+    uint32_t now = 0;
+    StringPrint out;
+
+    mtm.TaskRegister(0, Task_A, 1);
+    mtm.TaskRegister(1, Task_B, 2);
+
+    for(int i = 0; i < 1000; i++)
+    {
+        now++;
+        Test_Cycle += 300;//空闲
+        mtm.Running(now);
+    }
+    mtm.Running(now);//收尾，不执行任务
+
+    TEST_CHECK(mtm.TaskGetStat(0, &stat));
+    TEST_CHECK(stat.RunCount == 1000 && stat.CycleMin == 100 && stat.CycleMax == 100 && stat.CycleSum == 100000);
+    TEST_CHECK(stat.LateMax == 0 && stat.MissCount == 0);
+
+    TEST_CHECK(mtm.TaskGetStat(1, &stat));
+    TEST_CHECK(stat.RunCount == 500 && stat.CycleMin == 200 && stat.CycleMax == 600 && stat.CycleSum == 200000);
+
+    {
+        double expect = (double)Busy_Cycles * 100.0 / (double)(uint32_t)(Test_Cycle - start);
+        float usage = mtm.GetCPUUsage();
+        TEST_CHECK_MSG(usage > expect - 0.01 && usage < expect + 0.01, "usage %f expect %f", usage, expect);
+    }
+
+    mtm.TaskStatDump(&out);
+    TEST_CHECK_MSG(strstr(out.Buffer, "CPU usage: 50.0%") != NULL, "%s", out.Buffer);
+    TEST_CHECK(strstr(out.Buffer, "1000      100       100       100       0         0") != NULL);
+    TEST_CHECK(strstr(out.Buffer, "500       200       400       600       0         0") != NULL);
+
+    /*触发延迟与错过周期：间隔10，在47才调度，计划20执行，30、40错过*/
+    mtm.TaskLogout(Task_A);
+    mtm.TaskLogout(Task_B);
+    mtm.TaskStatReset();
+    TEST_CHECK(mtm.GetCPUUsage() == 0.0f);
+    mtm.Running(0);
+    mtm.TaskRegister(2, Task_C, 10);
+    mtm.Running(10);
+    mtm.Running(13);
+    mtm.Running(47);
+    mtm.Running(53);
+    TEST_CHECK(mtm.TaskGetStat(2, &stat));
+    TEST_CHECK_MSG(stat.RunCount == 3 && stat.MissCount == 2, "runs %u miss %u",
+                   (unsigned)stat.RunCount, (unsigned)stat.MissCount);
+    TEST_CHECK_MSG(stat.LateMax == 27 && stat.LateLast == 3, "late max %u last %u",
+                   (unsigned)stat.LateMax, (unsigned)stat.LateLast);
+    TEST_CHECK(mtm.GetNextTaskTime(53) == 7);
+
+    /*注销后统计清零*/
+    mtm.TaskLogout(2);
+    TEST_CHECK(mtm.TaskGetStat(2, &stat) && stat.RunCount == 0);
+    TEST_CHECK(!mtm.TaskGetStat(4, &stat));
+}
+
+int main()
+{
+    Test_Stat();
+    return TEST_RESULT();
+}
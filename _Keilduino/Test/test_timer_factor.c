@@ -0,0 +1,331 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#define _POSIX_C_SOURCE 199309L
+#include "test.h"
+#include "timer_factor.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+/* Timer_GetClockMax() 的典型值：APB时钟的2倍 */
+static const uint32_t Test_Clocks[] = { 288000000U, 240000000U, 144000000U, 72000000U };
+
+/* 乘积P对应的频率误差 |clock/P - freq| = |clock - freq*P| / P，以分数形式精确比较 */
+typedef struct
+{
+    uint64_t Num;
+    uint64_t Den;
+} FreqError_t;
+
+static FreqError_t FreqError(uint32_t freq, uint32_t clock, uint64_t prodect)
+{
+    FreqError_t err;
+    uint64_t fp = (uint64_t)freq * prodect;
+    err.Num = fp > clock ? fp - clock : clock - fp;
+    err.Den = prodect;
+    return err;
+}
+
+static int FreqError_Compare(FreqError_t a, FreqError_t b)
+{
+    unsigned __int128 l = (unsigned __int128)a.Num * b.Den;
+    unsigned __int128 r = (unsigned __int128)b.Num * a.Den;
+    return l < r ? -1 : (l > r ? 1 : 0);
+}
+
+/* 穷举所有分频值，求误差下限作为参考 */
+static FreqError_t BruteForce_Best(uint32_t freq, uint32_t clock)
+{
+    const uint64_t target = clock / freq;
+    FreqError_t best = FreqError(freq, clock, 1);
+    uint32_t f2;
+
+    for(f2 = 1; f2 <= 0xFFFF; f2++)
+    {
+        /* 每个f2下只有不大于和大于clock/freq的两个相邻乘积可能最优 */
+        uint64_t f1 = target / f2;
+        uint64_t cand[2];
+        int i;
+
+        cand[0] = f1;
+        cand[1] = f1 + 1;
+        for(i = 0; i < 2; i++)
+        {
+            FreqError_t err;
+            if(cand[i] == 0 || cand[i] > 0xFFFF)
+            {
+                continue;
+            }
+            err = FreqError(freq, clock, cand[i] * f2);
+            if(FreqError_Compare(err, best) < 0)
+            {
+                best = err;
+            }
+        }
+    }
+    return best;
+}
+
+/* 修改前的实现，作为回归比较和性能基准 */
+static int fast_isqrt_ref(int n)
+{
+    int x = n;
+    int cm = 0;
+    int dm = 1 << 30;
+
+    while(dm > n)
+    {
+        dm >>= 2;
+    }
+
+    while (dm)
+    {
+        if (x >= cm + dm)
+        {
+            x -= cm + dm;
+            cm = (cm >> 1) + dm;
+        }
+        else
+        {
+            cm >>= 1;
+        }
+        dm >>= 2;
+    }
+
+    return cm;
+}
+
+static bool Timer_FreqFactorization_Ref(
+    uint32_t freq,
+    uint32_t clock,
+    uint16_t* factor1,
+    uint16_t* factor2,
+    int32_t* error
+)
+{
+    uint32_t targetProdect;
+    uint16_t fct1;
+    uint16_t fct2;
+    uint16_t fct1_save = 1;
+    uint16_t fct2_save = 1;
+    uint16_t fct_max;
+    uint16_t max_error = 0xFFFF;
+
+    if(freq == 0 || freq > clock)
+    {
+        return false;
+    }
+
+    targetProdect = clock / freq;
+    fct1 = fast_isqrt_ref(targetProdect);
+    fct_max = (targetProdect < 0xFFFF) ? targetProdect : 0xFFFF;
+
+    for(; fct1 > 1; fct1--)
+    {
+        for(fct2 = fct1; fct2 < fct_max; fct2++)
+        {
+            int32_t newerr = fct1 * fct2 - targetProdect;
+
+            if(newerr < 0)
+            {
+                newerr = -newerr;
+            }
+
+            if(newerr < max_error)
+            {
+                max_error = (uint16_t)newerr;
+
+                fct1_save = fct1;
+                fct2_save = fct2;
+
+                if(max_error == 0)
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    *factor1 = fct1_save;
+    *factor2 = fct2_save;
+    *error = (freq - clock / (fct1_save * fct2_save));
+
+    return true;
+}
+
+static uint32_t Test_Rand(void)
+{
+    static uint32_t state = 0x12345678;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static double Test_GetTime(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* 检查分解结果合法且误差等于穷举得到的下限 */
+static void Test_CheckOptimal(uint32_t freq, uint32_t clock)
+{
+    uint16_t factor1 = 0, factor2 = 0;
+    int32_t error = 0;
+    uint32_t prodect;
+    FreqError_t best;
+
+    if(!Timer_FreqFactorization(freq, clock, &factor1, &factor2, &error))
+    {
+        TEST_CHECK_MSG(false, "freq=%u clock=%u rejected", (unsigned)freq, (unsigned)clock);
+        return;
+    }
+
+    TEST_CHECK_MSG(factor1 >= 1 && factor2 >= 1 && factor1 >= factor2,
+                   "freq=%u clock=%u factors %u*%u", (unsigned)freq, (unsigned)clock, factor1, factor2);
+    if(factor1 == 0 || factor2 == 0)
+    {
+        return;
+    }
+
+    prodect = (uint32_t)factor1 * factor2;
+    TEST_CHECK_MSG(error == (int32_t)(freq - clock / prodect),
+                   "freq=%u clock=%u error %d", (unsigned)freq, (unsigned)clock, (int)error);
+
+    best = BruteForce_Best(freq, clock);
+    TEST_CHECK_MSG(FreqError_Compare(FreqError(freq, clock, prodect), best) == 0,
+                   "freq=%u clock=%u %u*%u not optimal",
+                   (unsigned)freq, (unsigned)clock, factor1, factor2);
+}
+
+static void Test_Optimal(void)
+{
+    unsigned c;
+    uint32_t freq;
+    int i;
+
+    for(c = 0; c < sizeof(Test_Clocks) / sizeof(Test_Clocks[0]); c++)
+    {
+        const uint32_t clock = Test_Clocks[c];
+
+        /* 低频段：乘积超过0xFFFF，两个因数都需要搜索 */
+        for(freq = 1; freq <= 300; freq++)
+        {
+            Test_CheckOptimal(freq, clock);
+        }
+
+        /* 全频段随机取样，包含clock附近的极端值 */
+        for(i = 0; i < 1000; i++)
+        {
+            Test_CheckOptimal(1 + Test_Rand() % clock, clock);
+        }
+
+        for(freq = clock - 16; freq <= clock; freq++)
+        {
+            Test_CheckOptimal(freq, clock);
+        }
+        Test_CheckOptimal(clock / 2 + 1, clock);
+    }
+}
+
+/* 与修改前的实现比较：误差不大于原结果 */
+static void Test_NoRegression(void)
+{
+    unsigned c;
+    int i;
+
+    for(c = 0; c < sizeof(Test_Clocks) / sizeof(Test_Clocks[0]); c++)
+    {
+        const uint32_t clock = Test_Clocks[c];
+
+        for(i = 0; i < 200; i++)
+        {
+            /* 原实现在乘积较大时很慢，只取乘积不超过约30000的频率 */
+            uint32_t freq = clock / 30000 + Test_Rand() % (clock / 2);
+            uint16_t f1 = 1, f2 = 1, r1 = 1, r2 = 1;
+            int32_t err, rerr;
+
+            TEST_CHECK(Timer_FreqFactorization(freq, clock, &f1, &f2, &err));
+            TEST_CHECK(Timer_FreqFactorization_Ref(freq, clock, &r1, &r2, &rerr));
+            TEST_CHECK_MSG(FreqError_Compare(FreqError(freq, clock, (uint64_t)f1 * f2),
+                                             FreqError(freq, clock, (uint64_t)r1 * r2)) <= 0,
+                           "freq=%u clock=%u new %u*%u ref %u*%u",
+                           (unsigned)freq, (unsigned)clock, f1, f2, r1, r2);
+        }
+    }
+}
+
+static void Test_Invalid(void)
+{
+    uint16_t f1, f2;
+    int32_t err;
+
+    TEST_CHECK(!Timer_FreqFactorization(0, 288000000U, &f1, &f2, &err));
+    TEST_CHECK(!Timer_FreqFactorization(288000001U, 288000000U, &f1, &f2, &err));
+}
+
+typedef bool (*Factorization_t)(uint32_t, uint32_t, uint16_t*, uint16_t*, int32_t*);
+
+static double Benchmark_Run(Factorization_t func, uint32_t freqMin, uint32_t freqMax, int count)
+{
+    const uint32_t clock = 288000000U;
+    volatile uint32_t sink = 0;
+    double start = Test_GetTime();
+    int i;
+
+    for(i = 0; i < count; i++)
+    {
+        uint32_t freq = freqMin + (uint32_t)((uint64_t)(freqMax - freqMin) * i / count);
+        uint16_t f1, f2;
+        int32_t err;
+        func(freq, clock, &f1, &f2, &err);
+        sink += f1 + f2;
+    }
+    (void)sink;
+
+    return (Test_GetTime() - start) * 1e6 / count;
+}
+
+static void Benchmark(void)
+{
+    printf("benchmark @288MHz (us/call)    new        ref\n");
+    printf("  10kHz-1MHz            %10.3f %10.3f\n",
+           Benchmark_Run(Timer_FreqFactorization, 10000, 1000000, 2000),
+           Benchmark_Run(Timer_FreqFactorization_Ref, 10000, 1000000, 200));
+    printf("  1kHz-10kHz            %10.3f %10.3f\n",
+           Benchmark_Run(Timer_FreqFactorization, 1000, 10000, 2000),
+           Benchmark_Run(Timer_FreqFactorization_Ref, 1000, 10000, 10));
+    printf("  1Hz-1kHz              %10.3f %10s\n",
+           Benchmark_Run(Timer_FreqFactorization, 1, 1000, 2000), "-");
+}
+
+int main(void)
+{
+    Test_Invalid();
+    Test_Optimal();
+    Test_NoRegression();
+    Benchmark();
+    return TEST_RESULT();
+}
@@ -0,0 +1,271 @@
+/*
+ * MIT License
+ * Copyright (c) 2023 _VIFEXTech
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test.h"
+#include "timer_wheel.h"
+
+/*
+ * 用模拟时间驱动时间轮，与简单的参考模型比较：
+ * 回调时刻必须恰好等于到期时间，推进后不能有已过期但未执行的节点。
+ */
+#define TEST_TIMER_NUM      64
+
+typedef struct
+{
+    TimerWheel_Node_TypeDef Node;
+    bool Pending;
+    uint32_t Expire;
+    uint32_t Period;
+    uint32_t Fired;
+} TestTimer_TypeDef;
+
+static TimerWheel_TypeDef Wheel;
+static TestTimer_TypeDef Timers[TEST_TIMER_NUM];
+
+static uint32_t Test_Rand(void)
+{
+    static uint32_t state = 0x9E3779B9;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static void Model_Callback(void* UserData)
+{
+    TestTimer_TypeDef* t = (TestTimer_TypeDef*)UserData;
+
+    TEST_CHECK_MSG(t->Pending, "timer %d fired while stopped", (int)(t - Timers));
+    TEST_CHECK_MSG(Wheel.Now == t->Expire, "timer %d fired at %u, expire %u",
+                   (int)(t - Timers), (unsigned)Wheel.Now, (unsigned)t->Expire);
+    t->Fired++;
+
+    if(t->Period)
+    {
+        t->Expire += t->Period;
+    }
+    else
+    {
+        t->Pending = false;
+    }
+}
+
+static void Model_Add(TestTimer_TypeDef* t, uint32_t Expire, uint32_t Period)
+{
+    TimerWheel_Add(&Wheel, &t->Node, Expire, Period);
+    t->Pending = true;
+    t->Expire = ((int32_t)(Expire - Wheel.Now) <= 0) ? Wheel.Now + 1 : Expire;
+    t->Period = Period;
+}
+
+static void Model_Check(uint32_t now)
+{
+    int i;
+    for(i = 0; i < TEST_TIMER_NUM; i++)
+    {
+        TestTimer_TypeDef* t = &Timers[i];
+        TEST_CHECK_MSG(TimerWheel_IsPending(&t->Node) == t->Pending, "timer %d pending mismatch", i);
+        if(t->Pending)
+        {
+            TEST_CHECK_MSG((int32_t)(t->Expire - now) > 0, "timer %d overdue: expire %u now %u",
+                           i, (unsigned)t->Expire, (unsigned)now);
+        }
+    }
+}
+
+static uint32_t Random_Delay(void)
+{
+    /*多数为短延时，少数覆盖所有级别*/
+    switch(Test_Rand() % 4)
+    {
+    case 0:
+        return Test_Rand() % 16;
+    case 1:
+        return Test_Rand() % 5000;
+    case 2:
+        return Test_Rand() % 1000000;
+    default:
+        return Test_Rand() >> (1 + Test_Rand() % 31);
+    }
+}
+
+static void Test_Random(uint32_t start)
+{
+    uint32_t now = start;
+    int step;
+    int i;
+
+    TimerWheel_Init(&Wheel, now);
+    for(i = 0; i < TEST_TIMER_NUM; i++)
+    {
+        TimerWheel_NodeInit(&Timers[i].Node, Model_Callback, &Timers[i]);
+        Timers[i].Pending = false;
+        Timers[i].Fired = 0;
+    }
+
+    for(step = 0; step < 200000; step++)
+    {
+        TestTimer_TypeDef* t = &Timers[Test_Rand() % TEST_TIMER_NUM];
+        uint32_t op = Test_Rand() % 8;
+
+        if(op < 4)
+        {
+            uint32_t period = (Test_Rand() % 4 == 0) ? 1 + Test_Rand() % 20000 : 0;
+            Model_Add(t, now + Random_Delay(), period);
+        }
+        else if(op == 4)
+        {
+            bool pending = TimerWheel_Remove(&Wheel, &t->Node);
+            TEST_CHECK(pending == t->Pending);
+            t->Pending = false;
+        }
+
+        /*推进：多数为小步，偶尔跨越很长时间(间隔小于2^31)，
+         *长跨越前停止周期节点，避免回调次数过多
+         */
+        if(Test_Rand() % 64 == 0)
+        {
+            for(i = 0; i < TEST_TIMER_NUM; i++)
+            {
+                if(Timers[i].Pending && Timers[i].Period)
+                {
+                    TimerWheel_Remove(&Wheel, &Timers[i].Node);
+                    Timers[i].Pending = false;
+                }
+            }
+            now += Test_Rand() >> 2;
+        }
+        else
+        {
+            now += Test_Rand() % 3000;
+        }
+
+        TimerWheel_Advance(&Wheel, now);
+        TEST_CHECK(Wheel.Now == now);
+        Model_Check(now);
+
+        if(Test_FailCount > 20)
+        {
+            return;
+        }
+    }
+}
+
+/*逐个时间单位推进，NextEvent给出的时刻必须是下一个需要处理的时刻*/
+static void Test_NextEvent(void)
+{
+    uint32_t now = 0xFFFFF000;
+    int i;
+
+    TimerWheel_Init(&Wheel, now);
+    for(i = 0; i < 8; i++)
+    {
+        TimerWheel_NodeInit(&Timers[i].Node, Model_Callback, &Timers[i]);
+        Timers[i].Fired = 0;
+        Model_Add(&Timers[i], now + (1U << (i * 3)) + i, 0);
+    }
+
+    while(Wheel.Count)
+    {
+        uint32_t delta;
+        TEST_CHECK(TimerWheel_NextEvent(&Wheel, &delta));
+        TEST_CHECK(delta > 0);
+        now += delta;
+        TimerWheel_Advance(&Wheel, now);
+        Model_Check(now);
+    }
+
+    for(i = 0; i < 8; i++)
+    {
+        TEST_CHECK(Timers[i].Fired == 1);
+    }
+}
+
+/*回调中以当前时间重新添加自身，推迟到下一时刻，推进必须能结束*/
+static uint32_t ReAdd_Count;
+
+static void ReAdd_Callback(void* UserData)
+{
+    TimerWheel_Node_TypeDef* node = (TimerWheel_Node_TypeDef*)UserData;
+    ReAdd_Count++;
+    if(ReAdd_Count < 1000)
+    {
+        TimerWheel_Add(&Wheel, node, Wheel.Now, 0);
+    }
+}
+
+static void Test_ReAddSameTick(void)
+{
+    TimerWheel_Node_TypeDef node;
+
+    TimerWheel_Init(&Wheel, 100);
+    TimerWheel_NodeInit(&node, ReAdd_Callback, &node);
+    ReAdd_Count = 0;
+
+    TimerWheel_Add(&Wheel, &node, 105, 0);
+    TimerWheel_Advance(&Wheel, 105);
+    TEST_CHECK(ReAdd_Count == 1);
+    TEST_CHECK(TimerWheel_IsPending(&node));
+
+    TimerWheel_Advance(&Wheel, 110);
+    TEST_CHECK(ReAdd_Count == 6);
+
+    /*添加到当前时间或更早，在下一时刻执行*/
+    ReAdd_Count = 1000;
+    TimerWheel_Add(&Wheel, &node, Wheel.Now - 50, 0);
+    TimerWheel_Advance(&Wheel, Wheel.Now);
+    TEST_CHECK(ReAdd_Count == 1000);
+    TimerWheel_Advance(&Wheel, Wheel.Now + 1);
+    TEST_CHECK(ReAdd_Count == 1001);
+    TEST_CHECK(!TimerWheel_IsPending(&node));
+}
+
+/*
+ * 软件定时器中时间轮的当前时间最多落后计数器0x40000000，
+ * 最大延时0x3C000000须按时到期，不能被当作已过期
+ */
+static void Test_SoftTimerLag(void)
+{
+    const uint32_t idleMax = 0x40000000UL;
+    const uint32_t delayMax = 0x3C000000UL;
+    uint32_t counter = 0x12345678 + idleMax;
+
+    TimerWheel_Init(&Wheel, 0x12345678);
+    TimerWheel_NodeInit(&Timers[0].Node, Model_Callback, &Timers[0]);
+    Timers[0].Fired = 0;
+    Model_Add(&Timers[0], counter + delayMax, 0);
+
+    TimerWheel_Advance(&Wheel, counter + delayMax - 1);
+    TEST_CHECK(Timers[0].Fired == 0);
+    TimerWheel_Advance(&Wheel, counter + delayMax);
+    TEST_CHECK(Timers[0].Fired == 1);
+}
+
+int main(void)
+{
+    Test_Random(0);
+    Test_Random(0xFFFF0000);
+    Test_NextEvent();
+    Test_ReAddSameTick();
+    Test_SoftTimerLag();
+    return TEST_RESULT();
+}
@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+#
+# MIT License
+# Copyright (c) 2023 _VIFEXTech
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+"""
+BINLOG 解码器：读取固件(.axf/.elf)中的格式串，把串口收到的二进制日志还原为文本。
+
+用法:
+    binlog_decode.py firmware.axf log.bin [--clock 288000000]
+    binlog_decode.py firmware.axf - < /dev/ttyUSB0
+
+记录格式见 Core/binlog_ring.h，只使用Python标准库。
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+HEADER_WORDS = 3
+MAX_ARGS = 8
+
+FORMAT_SPEC = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|j|z|t|L)?([diouxXcsfFeEgGaAp%])")
+
+
+class Firmware:
+    """按地址读取固件中已加载段的内容(ELF32/ELF64，小端)"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF":
+            raise ValueError("%s: not an ELF file" % path)
+        if data[5] != 1:
+            raise ValueError("%s: only little-endian ELF is supported" % path)
+
+        self.segments = []
+        if data[4] == 1:
+            phoff, = struct.unpack_from("<I", data, 0x1C)
+            phentsize, phnum = struct.unpack_from("<HH", data, 0x2A)
+            for i in range(phnum):
+                p_type, p_offset, p_vaddr, _, p_filesz = struct.unpack_from("<IIIII", data, phoff + i * phentsize)
+                self._add(data, p_type, p_offset, p_vaddr, p_filesz)
+        else:
+            phoff, = struct.unpack_from("<Q", data, 0x20)
+            phentsize, phnum = struct.unpack_from("<HH", data, 0x36)
+            for i in range(phnum):
+                p_type, _, p_offset, p_vaddr, _, p_filesz = struct.unpack_from("<IIQQQQ", data, phoff + i * phentsize)
+                self._add(data, p_type, p_offset, p_vaddr, p_filesz)
+
+    def _add(self, data, p_type, offset, vaddr, size):
+        PT_LOAD = 1
+        if p_type == PT_LOAD and size:
+            self.segments.append((vaddr, data[offset:offset + size]))
+
+    def string(self, addr):
+        for base, content in self.segments:
+            if base <= addr < base + len(content):
+                end = content.find(b"\0", addr - base)
+                if end < 0:
+                    return None
+                return content[addr - base:end].decode("utf-8", "replace")
+        return None
+
+
+def format_message(fw, fmt, args):
+    """按格式串解释32位参数"""
+    out = []
+    pos = 0
+    args = list(args)
+
+    def take():
+        return args.pop(0) if args else 0
+
+    for m in FORMAT_SPEC.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, prec, _, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        if width == "*":
+            width = str(struct.unpack("<i", struct.pack("<I", take()))[0])
+        if prec == "*":
+            prec = str(take())
+        spec = "%" + flags + (width or "") + ("." + prec if prec is not None else "")
+        value = take()
+        if conv in "di":
+            out.append((spec + "d") % struct.unpack("<i", struct.pack("<I", value))[0])
+        elif conv == "o" and "#" in flags:
+            out.append((spec.replace("#", "") + "s") % ("0%o" % value if value else "0"))
+        elif conv in "ouxX":
+            out.append((spec + conv.replace("u", "d")) % value)
+        elif conv == "c":
+            out.append((spec + "c") % chr(value & 0xFF))
+        elif conv == "p":
+            out.append("0x%08x" % value)
+        elif conv == "s":
+            text = fw.string(value)
+            out.append((spec + "s") % (text if text is not None else "<0x%08x>" % value))
+        else:
+            f = struct.unpack("<f", struct.pack("<I", value))[0]
+            out.append((spec + conv.replace("F", "f").replace("a", "e").replace("A", "E")) % f)
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+def decode(fw, data, clock=0):
+    """解码二进制日志，返回文本行的列表；同步错误时逐字节重新同步"""
+    lines = []
+    pos = 0
+    time_base = 0
+    last_ts = None
+
+    while pos + HEADER_WORDS * 4 <= len(data):
+        head, fmt_id, ts = struct.unpack_from("<III", data, pos)
+        nargs = (head >> 8) & 0xFF
+        dropped = head >> 16
+        fmt = fw.string(fmt_id) if (head & 0xFF) == SYNC and nargs <= MAX_ARGS else None
+        if fmt is None:
+            pos += 1
+            continue
+
+        size = (HEADER_WORDS + nargs) * 4
+        if pos + size > len(data):
+            break
+        args = struct.unpack_from("<%dI" % nargs, data, pos + HEADER_WORDS * 4)
+        pos += size
+
+        if last_ts is not None:
+            time_base += (ts - last_ts) & 0xFFFFFFFF
+        last_ts = ts
+
+        if dropped:
+            lines.append("<%s%d messages dropped>" % ("at least " if dropped == 0xFFFF else "", dropped))
+        stamp = "[%12.6f]" % (time_base / clock) if clock else "[%10d]" % time_base
+        lines.append("%s %s" % (stamp, format_message(fw, fmt, args)))
+
+    return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode BINLOG binary stream")
+    parser.add_argument("firmware", help="firmware image with format strings (.axf/.elf)")
+    parser.add_argument("log", help="binary log file, '-' for stdin")
+    parser.add_argument("--clock", type=float, default=0, help="timestamp clock in Hz, prints seconds")
+    args = parser.parse_args()
+
+    fw = Firmware(args.firmware)
+    if args.log == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.log, "rb") as f:
+            data = f.read()
+
+    for line in decode(fw, data, args.clock):
+        print(line)
+
+
+if __name__ == "__main__":
+    main()